@@ -85,7 +85,8 @@ enum PIXEL_FORMAT {
 enum UNDIST_MODE {
 	UNDIST_NONE,
 	UNDIST_STD,
-	UNDIST_LUT
+	UNDIST_LUT,
+	UNDIST_GRID
 };
 
 
@@ -127,6 +128,44 @@ enum POSE_ESTIMATOR {
 	POSE_ESTIMATOR_RPP					// new "Robust Planar Pose" estimator
 };
 
+enum MULTI_POSE_ESTIMATOR {
+	MULTI_POSE_ESTIMATOR_DEFAULT,		// multi-marker estimator that belongs to the selected POSE_ESTIMATOR
+	MULTI_POSE_ESTIMATOR_RANSAC			// RANSAC over single-marker hypotheses with outlier rejection
+};
+
+enum AUTO_THRESHOLD_MODE {
+	AUTO_THRESHOLD_RANDOM,				// retry with random thresholds (original behavior)
+	AUTO_THRESHOLD_HISTOGRAM			// retry with Otsu thresholds from a luminance histogram
+};
+
+enum EARLY_REJECT_REASON {
+	EARLY_REJECT_BORDER,				// part of the black border is not dark
+	EARLY_REJECT_CONTRAST,				// the inside is not brighter than the border (e.g. a dark screen)
+	EARLY_REJECT_EMPTY,					// nothing dark inside the border (e.g. a window or picture frame)
+	EARLY_REJECT_NUM_REASONS
+};
+
+enum CANDIDATE_REJECT_REASON {
+	CANDIDATE_REJECT_AREA,				// label is smaller or larger than a marker can be
+	CANDIDATE_REJECT_CLIP,				// label touches the border of the (searched part of the) image
+	CANDIDATE_REJECT_CONTOUR,			// the contour of the label could not be followed
+	CANDIDATE_REJECT_SQUARE,			// the contour is no quadrilateral
+	CANDIDATE_REJECT_OVERLAP,			// the center lies inside a larger candidate
+	CANDIDATE_REJECT_EARLY,				// early reject test, see EARLY_REJECT_REASON
+	CANDIDATE_REJECT_LINE,				// fitting the four sides failed
+	CANDIDATE_REJECT_CF,				// decoded with a confidence below 0.5 (id set to -1)
+	CANDIDATE_REJECT_NUM_REASONS
+};
+
+enum FRAME_STAGE {
+	FRAME_STAGE_LABELING,				// thresholding and connected components
+	FRAME_STAGE_CONTOUR,				// contour following and square test
+	FRAME_STAGE_DECODE,					// line fitting and pattern decoding
+	FRAME_STAGE_DETECT,					// all of marker detection, including the three stages above
+	FRAME_STAGE_POSE,					// pose estimation
+	FRAME_STAGE_NUM
+};
+
 
 class TrackerSingleMarker;
 class MemoryManager;
@@ -145,6 +184,48 @@ struct CornerPoint
 
 typedef std::vector<CornerPoint> CornerPoints;
 
+
+// counters of one calc(), see Tracker::getFrameStats(). the detection fields are
+// summed over all labeling passes of the frame (auto threshold retries, multiple
+// thresholds, stereo), the pose fields over all markers or configs that were posed.
+struct FrameStats
+{
+	int numLabels;										// connected components
+	int numCandidates;									// squares that reached decoding
+	int numMarkers;										// identified markers returned by detection
+	int numRejected[CANDIDATE_REJECT_NUM_REASONS];
+	int threshold;										// threshold the markers were found with
+	int numRetries;										// labeling passes with another threshold (auto threshold)
+	bool unchanged;										// motion gate: the results of the last frame were returned
+	bool tracked;										// corner tracking followed all markers, nothing was labeled
+	unsigned int nanoseconds[FRAME_STAGE_NUM];
+
+	int numPoses;										// pose estimations
+	int poseIterations;									// refinement passes of all pose estimations (0 for RPP)
+	float poseError;									// error of the last pose estimation, -1 if there was none
+};
+
+
+// means and maxima over the last frames, see Tracker::getFrameStatsSummary()
+struct FrameStatsSummary
+{
+	enum {
+		WINDOW = 64										// frames the values are taken from
+	};
+
+	int numFrames;										// detected frames in the window
+	float meanLabels, meanCandidates, meanMarkers;
+	float meanRejected[CANDIDATE_REJECT_NUM_REASONS];
+	float meanThreshold, meanRetries;
+	float unchangedRate, trackedRate, detectionRate;	// fraction of the frames (detectionRate: at least one marker)
+	float meanMicroseconds[FRAME_STAGE_NUM];
+	float maxMicroseconds[FRAME_STAGE_NUM];
+
+	int numPoseFrames;									// frames in the window that ran pose estimation
+	float meanPoseIterations;
+	float meanPoseError, maxPoseError;					// frames whose last pose estimation succeeded
+};
+
 #ifndef _ARTKP_NO_MEMORYMANAGER_
 ARTOOLKITPLUS_API void setMemoryManager(MemoryManager* nManager);
 
@@ -58,6 +58,27 @@ public:
 
 	virtual void observ2Ideal(ARFloat ox, ARFloat oy, ARFloat *ix, ARFloat *iy) = 0;
 	virtual void ideal2Observ(ARFloat ix, ARFloat iy, ARFloat *ox, ARFloat *oy) = 0;
+
+	/// Undistorts nNum points given as separate x and y arrays
+	/**
+	 *  Same as calling observ2Ideal() for each point. The camera models
+	 *  shipped with ARToolKitPlus override this with vectorized versions
+	 *  which stop iterating once all points of a block have converged.
+	 *  The output arrays may be the same as the input arrays.
+	 */
+	virtual void observ2IdealBatch(const ARFloat *ox, const ARFloat *oy, ARFloat *ix, ARFloat *iy, int nNum)
+	{
+		for(int i=0; i<nNum; i++)
+			observ2Ideal(ox[i], oy[i], ix+i, iy+i);
+	}
+
+	/// Distorts nNum points given as separate x and y arrays (see observ2IdealBatch())
+	virtual void ideal2ObservBatch(const ARFloat *ix, const ARFloat *iy, ARFloat *ox, ARFloat *oy, int nNum)
+	{
+		for(int i=0; i<nNum; i++)
+			ideal2Observ(ix[i], iy[i], ox+i, oy+i);
+	}
+
 	virtual bool loadFromFile(const char* filename) = 0;
 	virtual Camera* clone() = 0;
 	virtual bool changeFrameSize(const int frameWidth, const int frameHeight) = 0;
@@ -47,6 +47,7 @@ namespace ARToolKitPlus {
 
 #define CAMERA_ADV_HEADER "ARToolKitPlus_CamCal_Rev02"
 #define CAMERA_ADV_MAX_UNDIST_ITERATIONS 20
+#define CAMERA_ADV_UNDIST_TOLERANCE 0.0001		// pixels, used by observ2IdealBatch() to stop early
 
 class CameraAdvImpl : public Camera
 {
@@ -57,6 +58,8 @@ public:
 
 	virtual void observ2Ideal(ARFloat ox, ARFloat oy, ARFloat *ix, ARFloat *iy);
 	virtual void ideal2Observ(ARFloat ix, ARFloat iy, ARFloat *ox, ARFloat *oy);
+	virtual void observ2IdealBatch(const ARFloat *ox, const ARFloat *oy, ARFloat *ix, ARFloat *iy, int nNum);
+	virtual void ideal2ObservBatch(const ARFloat *ix, const ARFloat *iy, ARFloat *ox, ARFloat *oy, int nNum);
 	virtual bool loadFromFile(const char* filename);
 	virtual Camera* clone();
 	virtual bool changeFrameSize(const int frameWidth, const int frameHeight);
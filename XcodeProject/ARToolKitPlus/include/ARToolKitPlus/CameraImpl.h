@@ -53,6 +53,8 @@ public:
 
 	virtual void observ2Ideal(ARFloat ox, ARFloat oy, ARFloat *ix, ARFloat *iy);
 	virtual void ideal2Observ(ARFloat ix, ARFloat iy, ARFloat *ox, ARFloat *oy);
+	virtual void observ2IdealBatch(const ARFloat *ox, const ARFloat *oy, ARFloat *ix, ARFloat *iy, int nNum);
+	virtual void ideal2ObservBatch(const ARFloat *ix, const ARFloat *iy, ARFloat *ox, ARFloat *oy, int nNum);
 	virtual bool loadFromFile(const char* filename);
 	virtual Camera* clone();
 	virtual bool changeFrameSize(const int frameWidth, const int frameHeight);
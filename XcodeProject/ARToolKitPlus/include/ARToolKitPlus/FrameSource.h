@@ -0,0 +1,106 @@
+/* ========================================================================
+* PROJECT: ARToolKitPlus
+* ========================================================================
+* This work is based on the original ARToolKit developed by
+*   Hirokazu Kato
+*   Mark Billinghurst
+*   HITLab, University of Washington, Seattle
+* http://www.hitl.washington.edu/artoolkit/
+*
+* Copyright of the derived and new portions of this work
+*     (C) 2006 Graz University of Technology
+*
+* This framework is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 2 of the License, or
+* (at your option) any later version.
+*
+* This framework is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this framework; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+* For further information please contact 
+*   Dieter Schmalstieg
+*   <schmalstieg@icg.tu-graz.ac.at>
+*   Graz University of Technology, 
+*   Institut for Computer Graphics and Vision,
+*   Inffeldgasse 16a, 8010 Graz, Austria.
+* ========================================================================
+** @author   Daniel Wagner
+*
+* $Id$
+* @file
+* ======================================================================== */
+
+#ifndef __ARTOOLKITPLUS_FRAMESOURCE_HEADERFILE__
+#define __ARTOOLKITPLUS_FRAMESOURCE_HEADERFILE__
+
+#include <ARToolKitPlus/ARToolKitPlus.h>
+#include <stddef.h>
+
+
+namespace ARToolKitPlus
+{
+
+
+/// Interface for image sources that lend their buffers to the caller
+/**
+ *  acquire() leases the next frame, release() gives it back. The frame data stays in a
+ *  buffer owned by the source and is delivered in the source's own pixel format (set the
+ *  tracker to getPixelFormat()), so nothing is converted or copied on the way to calc().
+ *
+ *  A source has getNumBuffers() buffers that can be leased at the same time: with two or
+ *  three the caller can work on one frame (or hand several to a TrackerPipeline) while
+ *  the source already provides the next. acquire() returns NULL while all are leased.
+ *
+ *  FrameSource replaces the deprecated ImageGrabber.
+ */
+class FrameSource
+{
+public:
+	/// A leased frame
+	struct Frame {
+		const unsigned char*	data;
+		size_t					size;			// bytes of data
+		int						width, height;
+		PIXEL_FORMAT			format;
+		unsigned int			frameId;		// running number of the frame, starts at 0
+		double					timestamp;		// milliseconds since the first frame
+	};
+
+	virtual ~FrameSource()  {}
+
+	/// Leases the next frame
+	/**
+	 *  Returns NULL at the end of the stream or if all buffers are leased. If the next
+	 *  frame is not available yet acquire() waits for it, or returns NULL if nWait is false.
+	 */
+	virtual const Frame* acquire(bool nWait=true) = 0;
+
+	/// Gives a frame returned by acquire() back to the source
+	virtual void release(const Frame* nFrame) = 0;
+
+	/// Returns true after the last frame was acquired
+	virtual bool isEndOfStream() const = 0;
+
+	/// Returns the number of frames that can be leased at the same time
+	virtual int getNumBuffers() const = 0;
+
+	virtual int getWidth() const = 0;
+	virtual int getHeight() const = 0;
+	virtual PIXEL_FORMAT getPixelFormat() const = 0;
+
+	/// Returns the nominal frame rate of the stream (0 if unknown)
+	virtual double getFrameRate() const = 0;
+};
+
+
+}  // namespace ARToolKitPlus
+
+
+#endif //__ARTOOLKITPLUS_FRAMESOURCE_HEADERFILE__
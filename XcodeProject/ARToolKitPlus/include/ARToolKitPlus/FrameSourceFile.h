@@ -0,0 +1,162 @@
+/* ========================================================================
+* PROJECT: ARToolKitPlus
+* ========================================================================
+* This work is based on the original ARToolKit developed by
+*   Hirokazu Kato
+*   Mark Billinghurst
+*   HITLab, University of Washington, Seattle
+* http://www.hitl.washington.edu/artoolkit/
+*
+* Copyright of the derived and new portions of this work
+*     (C) 2006 Graz University of Technology
+*
+* This framework is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 2 of the License, or
+* (at your option) any later version.
+*
+* This framework is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this framework; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+* For further information please contact 
+*   Dieter Schmalstieg
+*   <schmalstieg@icg.tu-graz.ac.at>
+*   Graz University of Technology, 
+*   Institut for Computer Graphics and Vision,
+*   Inffeldgasse 16a, 8010 Graz, Austria.
+* ========================================================================
+** @author   Daniel Wagner
+*
+* $Id$
+* @file
+* ======================================================================== */
+
+#ifndef __ARTOOLKITPLUS_FRAMESOURCEFILE_HEADERFILE__
+#define __ARTOOLKITPLUS_FRAMESOURCEFILE_HEADERFILE__
+
+#include <ARToolKitPlus/FrameSource.h>
+#include <stdio.h>
+#include <vector>
+
+
+namespace ARToolKitPlus
+{
+
+
+/// A FrameSource that replays a recording from a file
+/**
+ *  Two file types are supported:
+ *  - YUV4MPEG2 (.y4m) with any chroma subsampling. Only the Y plane is delivered,
+ *    as PIXEL_FORMAT_LUM.
+ *  - raw frames of a fixed size in any PIXEL_FORMAT, stored back to back behind an
+ *    optional file header.
+ *
+ *  On POSIX systems the file is memory mapped and frames point right into the mapping.
+ *  The kernel is asked to read the next frames ahead (madvise) while the current ones
+ *  are processed, and pages of released frames are dropped again, so replaying hours
+ *  of footage does not fill the memory. If the file can not be mapped (and on Windows)
+ *  frames are read into getNumBuffers() buffers of their own.
+ *
+ *  By default frames are delivered as fast as they are acquired. With setRealTime()
+ *  acquire() holds each frame back until its timestamp has passed since the first one.
+ */
+class ARTOOLKITPLUS_API FrameSourceFile : public FrameSource
+{
+public:
+	FrameSourceFile();
+	~FrameSourceFile();
+
+	/// Opens a YUV4MPEG2 file
+	bool openY4M(const char* nFileName);
+
+	/// Opens a file of raw frames
+	/**
+	 *  Frames have nWidth x nHeight pixels in nFormat and start nHeaderSize bytes into the file.
+	 *  nFrameRate is only used for timestamps and real-time replay.
+	 */
+	bool openRaw(const char* nFileName, int nWidth, int nHeight, PIXEL_FORMAT nFormat,
+				 double nFrameRate=30.0, size_t nHeaderSize=0);
+
+	/// Closes the file; all leased frames become invalid
+	void close();
+
+	bool isOpen() const  {  return frameSize>0;  }
+
+	/// Sets the number of frames that can be leased at once (default 3, call before opening)
+	void setNumBuffers(int nNumBuffers);
+
+	/// Delivers frames at the frame rate of the recording instead of as fast as possible
+	void setRealTime(bool nEnable)  {  realTime = nEnable;  }
+
+	/// Starts over at the first frame after the last one
+	void setLoop(bool nEnable)  {  loop = nEnable;  }
+
+	/// Continues with the nFrame'th frame of the file
+	bool seek(unsigned int nFrame);
+
+	/// Returns the number of frames in the file
+	unsigned int getNumFrames() const;
+
+	/// Returns true if frames are delivered from a memory mapping
+	bool isMemoryMapped() const  {  return mapping!=NULL;  }
+
+	// FrameSource interface
+	const Frame* acquire(bool nWait=true);
+	void release(const Frame* nFrame);
+	bool isEndOfStream() const  {  return endOfStream;  }
+	int getNumBuffers() const  {  return numBuffers;  }
+	int getWidth() const  {  return width;  }
+	int getHeight() const  {  return height;  }
+	PIXEL_FORMAT getPixelFormat() const  {  return format;  }
+	double getFrameRate() const  {  return frameRate;  }
+
+protected:
+	typedef unsigned long long FileOffset;
+
+	struct Buffer {
+		Frame			frame;
+		unsigned char*	memory;			// only used if the file is not mapped
+		FileOffset		offset;
+		bool			leased;
+	};
+
+	bool openFile(const char* nFileName);
+	bool readAt(FileOffset nOffset, void* nData, size_t nSize);
+	FileOffset getFrameOffset(unsigned int nFrame) const;
+	void prefetch(unsigned int nFrame);
+	void allocBuffers();
+
+	int						width, height;
+	PIXEL_FORMAT			format;
+	double					frameRate;
+	size_t					frameSize;		// bytes delivered per frame
+
+	FileOffset				fileSize, headerSize,
+							frameStride;	// bytes from one frame to the next in the file
+	unsigned int			numFrames;
+	std::vector<FileOffset>	frameOffsets;	// Y4M only, if the frame headers differ in length
+
+	int						numBuffers;
+	std::vector<Buffer>		buffers;
+
+	unsigned int			nextFrame,		// index into the file
+							numDelivered;
+	bool					realTime, loop, endOfStream;
+	double					startTime;
+
+	unsigned char*			mapping;
+	int						fd;
+	FILE*					file;
+};
+
+
+}  // namespace ARToolKitPlus
+
+
+#endif //__ARTOOLKITPLUS_FRAMESOURCEFILE_HEADERFILE__
@@ -45,7 +45,7 @@
 namespace ARToolKitPlus {
 
 
-// This class is depricated
+// This class is depricated, use FrameSource instead
 class ImageGrabber
 {
 public:
@@ -70,7 +70,8 @@ public:
 	/**
 	 *  A default implementation is provided which should usually be sufficient.
 	 *  Only in rare cases it will make sense to override this method and
-	 *  create a custom implementation.
+	 *  create a custom implementation. Messages are cut at 511 characters.
+	 *  See LoggerAsync for a Logger that keeps formatting off the calling thread.
 	 */
 	virtual void artLogEx(const char* nStr, ...)
 	{
@@ -78,7 +79,13 @@ public:
 		va_list marker;
 
 		va_start(marker, nStr);
-		vsprintf(tmpString, nStr, marker);
+#if defined(_MSC_VER) || defined(_WIN32_WCE)
+		_vsnprintf(tmpString, sizeof(tmpString)-1, nStr, marker);
+		tmpString[sizeof(tmpString)-1] = 0;
+#else
+		vsnprintf(tmpString, sizeof(tmpString), nStr, marker);
+#endif
+		va_end(marker);
 
 		//if(tmpString[strlen(tmpString)-1] == '\n')  // was bringt das?
 		//	tmpString[strlen(tmpString)-1] = 0;
@@ -0,0 +1,135 @@
+/* ========================================================================
+* PROJECT: ARToolKitPlus
+* ========================================================================
+* This work is based on the original ARToolKit developed by
+*   Hirokazu Kato
+*   Mark Billinghurst
+*   HITLab, University of Washington, Seattle
+* http://www.hitl.washington.edu/artoolkit/
+*
+* Copyright of the derived and new portions of this work
+*     (C) 2006 Graz University of Technology
+*
+* This framework is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 2 of the License, or
+* (at your option) any later version.
+*
+* This framework is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this framework; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+* For further information please contact 
+*   Dieter Schmalstieg
+*   <schmalstieg@icg.tu-graz.ac.at>
+*   Graz University of Technology, 
+*   Institut for Computer Graphics and Vision,
+*   Inffeldgasse 16a, 8010 Graz, Austria.
+* ========================================================================
+** @author   Daniel Wagner
+*
+* $Id$
+* @file
+* ======================================================================== */
+
+
+#ifndef __ARTOOLKITPLUS_LOGGERASYNC_HEADERFILE__
+#define __ARTOOLKITPLUS_LOGGERASYNC_HEADERFILE__
+
+#include <ARToolKitPlus/ARToolKitPlus.h>
+#include <ARToolKitPlus/Logger.h>
+
+#if !defined(_MSC_VER) && !defined(_WIN32_WCE)
+#  include <pthread.h>
+#endif
+
+
+namespace ARToolKitPlus
+{
+
+
+/// A Logger that formats messages on a background thread
+/**
+ *  artLogEx() does not format its message. It copies the format string pointer and the
+ *  raw arguments (the characters of %s arguments) into a ring owned by the calling thread
+ *  and returns. Each thread gets a ring of its own on its first message, so recording
+ *  needs no lock: the ring is a single producer / single consumer queue. A background
+ *  thread formats the messages and passes them to the target Logger's artLog(), which
+ *  is therefore always called on that thread.
+ *
+ *  Format strings must stay valid until the messages are formatted; string literals
+ *  always do. Wide character arguments (%ls, %lc) are not supported.
+ *
+ *  The formatting thread picks up new messages every few milliseconds, or right away if a
+ *  ring gets half full. If a ring is full the message is dropped; the number of lost
+ *  messages is reported with the next message of that thread (or when the thread exits). Messages with the same format string are
+ *  limited to nMaxPerSecond per thread, the number of suppressed ones is appended to
+ *  the next message of that format which gets through. artLog() messages are limited
+ *  per string pointer instead, as they all share the format "%s".
+ *
+ *  Without pthreads (Windows, Windows CE) messages are formatted and passed on right away.
+ */
+class ARTOOLKITPLUS_API LoggerAsync : public Logger
+{
+public:
+	/// Starts the formatting thread; nTarget receives the formatted messages
+	/**
+	 *  nRingSize is the size in bytes of each thread's ring. nMaxPerSecond is the rate
+	 *  limit per format string and thread, 0 disables rate limiting.
+	 */
+	LoggerAsync(Logger* nTarget, int nRingSize=64*1024, int nMaxPerSecond=10);
+
+	/// Passes all pending messages on and stops the formatting thread
+	/**
+	 *  No other thread may log while the logger is destroyed.
+	 */
+	~LoggerAsync();
+
+	void artLog(const char* nStr);
+
+	void artLogEx(const char* nStr, ...);
+
+	/// Returns when all messages logged before have been passed to the target
+	void flush();
+
+	/// Changes the rate limit per format string and thread (0 for no limit)
+	void setRateLimit(int nMaxPerSecond)  {  maxPerSecond = nMaxPerSecond;  }
+
+protected:
+	struct Ring;
+
+	// nRateKey selects the rate limit: the format string, or the string of artLog()
+	void record(const void* nRateKey, const char* nFormat, va_list nArgs);
+	void recordEx(const void* nRateKey, const char* nFormat, ...);
+
+	Logger*				target;
+	int					ringSize, maxPerSecond;
+
+#if !defined(_MSC_VER) && !defined(_WIN32_WCE)
+	Ring* getRing();
+	bool drain(bool nFinal=false);
+	void format(const char* nRecord);
+
+	static void* threadMain(void* nLogger);
+	static void releaseRing(void* nRing);
+
+	Ring*				rings;				// all rings, guarded by mutex
+	pthread_key_t		ringKey;			// ring of the calling thread
+	pthread_t			thread;
+	pthread_mutex_t		mutex;
+	pthread_cond_t		wakeup, flushed;
+	unsigned int		flushRequests, flushesDone;
+	bool				running, quit;
+#endif
+};
+
+
+}  // namespace ARToolKitPlus
+
+
+#endif //__ARTOOLKITPLUS_LOGGERASYNC_HEADERFILE__
@@ -0,0 +1,151 @@
+/* ========================================================================
+* PROJECT: ARToolKitPlus
+* ========================================================================
+* This work is based on the original ARToolKit developed by
+*   Hirokazu Kato
+*   Mark Billinghurst
+*   HITLab, University of Washington, Seattle
+* http://www.hitl.washington.edu/artoolkit/
+*
+* Copyright of the derived and new portions of this work
+*     (C) 2006 Graz University of Technology
+*
+* This framework is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 2 of the License, or
+* (at your option) any later version.
+*
+* This framework is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this framework; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+* For further information please contact 
+*   Dieter Schmalstieg
+*   <schmalstieg@icg.tu-graz.ac.at>
+*   Graz University of Technology, 
+*   Institut for Computer Graphics and Vision,
+*   Inffeldgasse 16a, 8010 Graz, Austria.
+* ========================================================================
+** @author   Daniel Wagner
+*
+* $Id$
+* @file
+* ======================================================================== */
+
+#ifndef __ARTOOLKITPLUS_MEMORYMANAGERARENA_HEADERFILE__
+#define __ARTOOLKITPLUS_MEMORYMANAGERARENA_HEADERFILE__
+
+#include "MemoryManager.h"
+
+
+namespace ARToolKitPlus
+{
+
+
+/// A MemoryManager that hands out memory by bumping a pointer through large mapped blocks
+/**
+ *  init() maps an initial block (mmap on POSIX systems, malloc elsewhere). If a request
+ *  does not fit anymore another block of at least nNumGrowBytes is mapped. With
+ *  nNumGrowBytes==0 the arena has a fixed size and getMemory() returns NULL when it is full.
+ *  releaseMemory() does nothing: memory is only given back by rewind(), reset() and deinit().
+ *
+ *  The arena is used in two roles:
+ *  - as the persistent MemoryManager (see setMemoryManager()) which holds the tables
+ *    and patterns a tracker allocates during initialization.
+ *  - as per-frame scratch memory: each tracker owns one arena which is reset() at the
+ *    start of arDetectMarker(). Temporary matrices are taken from it and given back
+ *    by rewinding to a Mark (see MemoryManagerArena::Scope). reset() merges all blocks
+ *    into a single one, so after the first frames no more memory has to be mapped.
+ *
+ *  setUseHugePages(true) requests blocks with MAP_HUGETLB (Linux only). If no huge pages
+ *  are available the arena silently falls back to normal pages.
+ */
+class ARTOOLKITPLUS_API MemoryManagerArena : public MemoryManager
+{
+public:
+	/// Position inside the arena as returned by getMark()
+	struct Mark {
+		void*	block;
+		size_t	used;
+	};
+
+	/// Rewinds an arena to the position it had at construction time when going out of scope
+	class Scope {
+	public:
+		Scope(MemoryManagerArena& nArena) : arena(nArena), mark(nArena.getMark())  {}
+		~Scope()  {  arena.rewind(mark);  }
+
+	protected:
+		MemoryManagerArena&	arena;
+		Mark				mark;
+	};
+
+	MemoryManagerArena();
+	~MemoryManagerArena();
+
+	bool init(size_t nNumInitialBytes, size_t nNumGrowBytes=0);
+	bool deinit();
+	bool didInit();
+
+	unsigned int getBytesAllocated()  {  return (unsigned int)fullSize;  }
+
+	void* getMemory(size_t nNumBytes);
+	void releaseMemory(void* nMemoryBlock);
+
+	/// Enables mapping new blocks with huge pages (has to be called before init())
+	void setUseHugePages(bool nEnable)  {  useHugePages = nEnable;  }
+
+	/// Returns true if at least one block is backed by huge pages
+	bool getUsesHugePages() const  {  return usesHugePages;  }
+
+	/// Returns the current position; everything allocated afterwards is released by rewind()
+	Mark getMark() const;
+
+	/// Releases all memory allocated since nMark was taken
+	void rewind(const Mark& nMark);
+
+	/// Releases all memory and merges grown blocks into a single block
+	void reset();
+
+	/// Returns the number of bytes currently handed out
+	size_t getBytesUsed() const;
+
+	/// Returns the largest number of bytes that was handed out at any time
+	size_t getPeakBytesUsed() const  {  return peakUsed;  }
+
+	/// Returns the number of blocks mapped by the arena
+	int getNumBlocks() const  {  return numBlocks;  }
+
+protected:
+	struct Block {
+		Block*	next;
+		size_t	size;		// usable bytes behind the block header
+		size_t	mapSize;	// size of the whole mapping
+		size_t	used;
+		bool	hugePages;
+	};
+
+	Block* mapBlock(size_t nMinBytes);
+	void unmapBlock(Block* nBlock);
+
+	bool	_didInit;
+	bool	useHugePages, usesHugePages;
+
+	Block	*first, *current;
+	int		numBlocks;
+
+	size_t	fullSize,
+			growSize,
+			peakUsed;
+};
+
+
+}  // namespace ARToolKitPlus
+
+
+#endif //__ARTOOLKITPLUS_MEMORYMANAGERARENA_HEADERFILE__
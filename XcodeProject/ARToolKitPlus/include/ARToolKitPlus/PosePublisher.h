@@ -0,0 +1,194 @@
+/* ========================================================================
+* PROJECT: ARToolKitPlus
+* ========================================================================
+* This work is based on the original ARToolKit developed by
+*   Hirokazu Kato
+*   Mark Billinghurst
+*   HITLab, University of Washington, Seattle
+* http://www.hitl.washington.edu/artoolkit/
+*
+* Copyright of the derived and new portions of this work
+*     (C) 2006 Graz University of Technology
+*
+* This framework is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 2 of the License, or
+* (at your option) any later version.
+*
+* This framework is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this framework; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+* For further information please contact 
+*   Dieter Schmalstieg
+*   <schmalstieg@icg.tu-graz.ac.at>
+*   Graz University of Technology, 
+*   Institut for Computer Graphics and Vision,
+*   Inffeldgasse 16a, 8010 Graz, Austria.
+* ========================================================================
+** @author   Daniel Wagner
+*
+* $Id$
+* @file
+* ======================================================================== */
+
+
+#ifndef __ARTOOLKITPLUS_POSEPUBLISHER_HEADERFILE__
+#define __ARTOOLKITPLUS_POSEPUBLISHER_HEADERFILE__
+
+#include <ARToolKitPlus/TrackerSingleMarker.h>
+#include <ARToolKitPlus/TrackerMultiMarker.h>
+
+
+namespace ARToolKitPlus
+{
+
+
+enum {
+	PUBLISH_MAX_MARKERS = 64,
+	PUBLISH_MAX_POSES = 16
+};
+
+
+/// A marker as written into shared memory
+/**
+ *  The published structures only use fixed size types (float instead of ARFloat),
+ *  so processes built with a different ARFloat can read them.
+ */
+struct PublishedMarker {
+	int				id;
+	float			cf;
+	float			vertex[4][2];
+};
+
+/// A pose as written into shared memory
+struct PublishedPose {
+	int				id;					// marker id (single marker tracker) or config index (multi marker tracker)
+	float			trans[3][4];		// see getARMatrix()
+};
+
+/// The results of one frame as written into shared memory
+struct PublishedFrame {
+	unsigned int	sequence;			// number of frames published before this one
+	unsigned int	frameId;			// as passed to publish()
+	double			timestamp;			// as passed to publish(), e.g. the capture time
+	double			publishTime;		// milliseconds since 1970 when the frame was published
+	int				numMarkers, numPoses;
+	PublishedMarker	markers[PUBLISH_MAX_MARKERS];
+	PublishedPose	poses[PUBLISH_MAX_POSES];
+};
+
+
+/// Writes tracking results into a POSIX shared memory ring for other processes
+/**
+ *  The shared memory object holds a header and a ring of nNumSlots frames. Each slot is
+ *  guarded by a sequence lock: its counter is odd while the publisher writes the slot.
+ *  PoseSubscriber copies a slot and checks that the counter did not change meanwhile,
+ *  so readers never block the publisher and neither side makes a system call per frame.
+ *  The last nNumSlots frames stay readable, which lets slow readers catch up.
+ *
+ *  There must only be one publisher per shared memory object, and publish() must not
+ *  be called from several threads at once. Only available with POSIX shared memory
+ *  (create() fails on Windows).
+ */
+class ARTOOLKITPLUS_API PosePublisher
+{
+public:
+	PosePublisher();
+	~PosePublisher();
+
+	/// Creates (or replaces) the shared memory object nName, e.g. "/artkp_poses"
+	bool create(const char* nName, int nNumSlots=64);
+
+	/// Unmaps and removes the shared memory object
+	void close();
+
+	bool isOpen() const  {  return header!=NULL;  }
+
+	/// Publishes a frame; sequence and publishTime are filled in
+	bool publish(const PublishedFrame& nFrame);
+
+	/// Publishes the markers found by TrackerSingleMarker::calc()
+	/**
+	 *  nMarkers and nNumMarkers are the marker info returned by calc(), nMarkerId is its
+	 *  return value. If nMarkerId is a valid id the tracker's pose is published as well.
+	 */
+	bool publish(const TrackerSingleMarker* nTracker, const ARMarkerInfo* nMarkers, int nNumMarkers,
+				 int nMarkerId, unsigned int nFrameId, double nTimestamp=0.0);
+
+	/// Publishes the markers and the poses of all tracked configs after TrackerMultiMarker::calc()
+	bool publish(const TrackerMultiMarker* nTracker, unsigned int nFrameId, double nTimestamp=0.0);
+
+	/// Returns the number of frames published so far
+	unsigned int getNumPublished() const;
+
+protected:
+	friend class PoseSubscriber;
+
+	struct Header;
+	struct Slot;
+
+	PublishedFrame*		beginFrame();
+	void				endFrame();
+
+	Header*				header;
+	Slot*				slots;
+	size_t				size;
+	char*				name;
+};
+
+
+/// Reads the tracking results written by a PosePublisher in another process
+/**
+ *  Reading copies a frame out of the ring without any locks or system calls. A read fails
+ *  if the frame has already been overwritten (or the publisher kept overwriting the slot
+ *  while it was copied), so a reader that falls more than the ring size behind loses frames.
+ */
+class ARTOOLKITPLUS_API PoseSubscriber
+{
+public:
+	PoseSubscriber();
+	~PoseSubscriber();
+
+	/// Maps the shared memory object created by PosePublisher::create()
+	bool open(const char* nName);
+
+	/// Unmaps the shared memory object
+	void close();
+
+	bool isOpen() const  {  return header!=NULL;  }
+
+	/// Returns the number of frames published so far
+	unsigned int getNumPublished() const;
+
+	/// Returns the number of frames the ring holds
+	int getNumSlots() const;
+
+	/// Copies the most recent frame; returns false if nothing was published yet
+	bool readLatest(PublishedFrame& nFrame) const;
+
+	/// Copies the frame with PublishedFrame::sequence==nSequence
+	/**
+	 *  Returns false if that frame was not published yet or was already overwritten.
+	 */
+	bool read(unsigned int nSequence, PublishedFrame& nFrame) const;
+
+protected:
+	typedef PosePublisher::Header Header;
+	typedef PosePublisher::Slot Slot;
+
+	const Header*		header;
+	const Slot*			slots;
+	size_t				size;
+};
+
+
+}  // namespace ARToolKitPlus
+
+
+#endif //__ARTOOLKITPLUS_POSEPUBLISHER_HEADERFILE__
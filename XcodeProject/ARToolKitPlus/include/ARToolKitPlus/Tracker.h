@@ -101,6 +101,10 @@ public:
 	 *  can take quite a while. Consequently caching will speedup the start phase.
 	 *  If set to true and no cache file could be found a new one will be created.
 	 *  The cache file will get the same name as the camera file with the added extension '.LUT'
+	 *  It stores the frame size and a fingerprint of the camera model; a cache file
+	 *  that does not match the current camera is rebuilt. Valid cache files are mapped
+	 *  into memory instead of being read where the platform supports it.
+	 *  Without caching the table is built band by band as the tracker first needs it.
 	 */
 	virtual void setLoadUndistLUT(bool nSet) = 0;
 
@@ -118,6 +122,10 @@ public:
 
 
 	/// calculates the transformation matrix between camera and the given multi-marker config
+	/**
+	 *  configs built by the application get their lookup table and work buffers on
+	 *  first use; release them with arMultiFreeConfig() before the config is freed.
+	 */
 	virtual ARFloat arMultiGetTransMat(ARMarkerInfo *marker_info, int marker_num, ARMultiMarkerInfoT *config) = 0;
 	/// calculates the transformation matrix between camera and the given marker
 	virtual ARFloat arGetTransMat(ARMarkerInfo *marker_info, ARFloat center[2], ARFloat width, ARFloat conv[3][4]) = 0;
@@ -140,8 +148,21 @@ public:
 	virtual int arMultiFreeConfig( ARMultiMarkerInfoT *config ) = 0;
 
 	/// reads a standard artoolkit multimarker config file
+	/**
+	 *  binary config bundles written by arMultiWriteConfigBundle() are
+	 *  detected automatically and loaded without parsing.
+	 */
 	virtual ARMultiMarkerInfoT *arMultiReadConfigFile(const char *filename) = 0;
 
+	/// converts a standard artoolkit multimarker config file into a binary bundle
+	/**
+	 *  the bundle contains the marker layout and all template patterns
+	 *  (already converted using the current binary marker threshold) so that
+	 *  it can be mapped into memory at startup instead of being parsed.
+	 *  returns 0 on success and -1 on failure.
+	 */
+	virtual int arMultiWriteConfigBundle(const char *nConfigFile, const char *nBundleFile) = 0;
+
 	/// activates binary markers
 	/**
 	 *  markers are converted to pure black/white during loading
@@ -174,6 +195,141 @@ public:
 	 */
 	virtual void activateVignettingCompensation(bool nEnable, int nCorners=0, int nLeftRight=0, int nTopBottom=0) = 0;
 
+
+	/// activates adaptive thresholding: each pixel is compared against the mean of its neighborhood
+	/**
+	 *  instead of the global threshold the labeling compares each pixel against the mean
+	 *  luminance of the nWindowSize x nWindowSize box around it (in labeling resolution) and
+	 *  treats it as black if it is at least nOffsetPercent percent darker. this copes with
+	 *  shadows and mixed lighting in a single pass, so auto threshold retries are skipped
+	 *  while it is active. id-markers are decoded with a threshold taken from each marker's
+	 *  own pattern. nWindowSize=0 selects 1/8 of the image width; the window should be
+	 *  clearly larger than the marker border width in pixels.
+	 *  vignetting compensation has no effect in this mode.
+	 */
+	virtual void activateAdaptiveThreshold(bool nEnable, int nWindowSize=0, int nOffsetPercent=15) = 0;
+
+
+	/// Returns true if adaptive thresholding is activated
+	virtual bool isAdaptiveThresholdActivated() const = 0;
+
+
+	/// activates marker detection at several thresholds per frame
+	/**
+	 *  the image is binarized at nNumThresholds (2..8) thresholds in one pass, one bit-plane
+	 *  per threshold. each plane is then labeled and searched for markers; squares found at
+	 *  more than one threshold are reported once (the one with the best confidence).
+	 *  the thresholds are the current threshold and values nSpacing apart below and above it.
+	 *  auto threshold retries are not needed in this mode, but the auto threshold still
+	 *  moves the center threshold. this mode has no effect while adaptive thresholding is active.
+	 */
+	virtual void activateMultiThreshold(bool nEnable, int nNumThresholds=3, int nSpacing=32) = 0;
+
+
+	/// Returns true if multi-threshold detection is activated
+	virtual bool isMultiThresholdActivated() const = 0;
+
+
+	/// activates motion gating: frames that did not change are not searched again
+	/**
+	 *  every frame is reduced to the mean luminance of each 4x4 pixel block and compared
+	 *  against the last processed frame. if no block mean changed by more than nTolerance,
+	 *  the markers (and poses) of the last frame are returned without looking at the image
+	 *  again. if only parts of the image changed, only the rectangle around the changed
+	 *  32x32 pixel tiles (grown to contain every known marker it touches) is labeled; the
+	 *  markers outside of it are taken over from the last frame. meant for static or mostly
+	 *  static cameras. a new threshold forces a complete frame (the auto threshold only if
+	 *  it moved by more than nTolerance), other setting changes take effect with the next
+	 *  changed frame; calling activateMotionGate() again forces one. the auto threshold is
+	 *  only updated on complete frames. vignetting compensation disables the partial processing.
+	 */
+	virtual void activateMotionGate(bool nEnable, int nTolerance=8) = 0;
+
+
+	/// Returns true if motion gating is activated
+	virtual bool isMotionGateActivated() const = 0;
+
+
+	/// activates corner tracking: markers are followed from frame to frame between full detections
+	/**
+	 *  after a full detection (keyframe) the four vertices of every identified marker are
+	 *  followed through the next frames by a pyramidal Lucas-Kanade tracker on a half
+	 *  resolution luminance image, so these frames need no labeling. the tracked markers keep
+	 *  their id, direction and confidence and go straight into the pose estimation. a frame
+	 *  is only accepted if every marker could be followed reliably (converged, small residual,
+	 *  still a convex square, the black border darker than its surroundings), otherwise it gets
+	 *  a full detection. after nMaxTrackedFrames tracked frames in a row a full detection is
+	 *  forced; markers that come into view are only found by full detections.
+	 *  the auto threshold is only updated on full detections.
+	 */
+	virtual void activateCornerTracking(bool nEnable, int nMaxTrackedFrames=10) = 0;
+
+
+	/// Returns true if corner tracking is activated
+	virtual bool isCornerTrackingActivated() const = 0;
+
+
+	/// activates the decode cache (default: activated)
+	/**
+	 *  a candidate square that lies where a marker was identified in the last frame (same
+	 *  test as the tracking history of arDetectMarker()) is only checked against that marker's
+	 *  code in its expected orientation instead of being decoded against all codes and
+	 *  rotations. if the check fails, or more than one marker of the last frame fits, the
+	 *  candidate is decoded as usual. only arDetectMarker() keeps a history, so the
+	 *  TrackerMultiMarker only profits if it does not use arDetectMarkerLite().
+	 */
+	virtual void activateDecodeCache(bool nEnable) = 0;
+
+
+	/// Returns true if the decode cache is activated
+	virtual bool isDecodeCacheActivated() const = 0;
+
+
+	/// activates a cheap test that rejects candidate squares before they are decoded
+	/**
+	 *  a few points in the middle of the expected black border and at the cell centers of
+	 *  the inside are sampled through the homography of the raw contour vertices, before
+	 *  line fitting and pattern extraction. a candidate is rejected if the inside is less
+	 *  than nMinContrast grey values brighter than the border, if more than one border
+	 *  sample is bright (only tested for borders that are at least 4 pixels wide in the
+	 *  image), or if there is nothing dark inside. this removes most of the
+	 *  frames, screens and posters of a cluttered scene, but it also needs a border width
+	 *  (setBorderWidth()) that fits the markers. default: deactivated.
+	 */
+	virtual void activateEarlyReject(bool nEnable, int nMinContrast=32) = 0;
+
+
+	/// Returns true if the early reject test is activated
+	virtual bool isEarlyRejectActivated() const = 0;
+
+
+	/// Returns the number of candidates the early reject test removed for nReason in the last frame
+	virtual int getNumEarlyRejects(EARLY_REJECT_REASON nReason) const = 0;
+
+
+	/// Returns the counters and stage timings of the last frame
+	/**
+	 *  the statistics are always collected (a few clock reads and counters per frame),
+	 *  there is no need to build with _USE_PROFILING_. the detection fields belong to
+	 *  the last detected frame, the pose fields to the last posed one: with a
+	 *  TrackerPipeline these are two different frames.
+	 */
+	virtual const FrameStats& getFrameStats() const = 0;
+
+
+	/// Fills nSummary with means and maxima over the last FrameStatsSummary::WINDOW frames
+	/**
+	 *  thresholds, retries and pose values are averaged over the frames they apply to:
+	 *  the threshold over labeled frames, the pose values and the pose timing over
+	 *  frames with at least one pose estimation. use it to watch the effect of
+	 *  thresholds, area limits and tracking modes on a running system.
+	 */
+	virtual void getFrameStatsSummary(FrameStatsSummary& nSummary) const = 0;
+
+
+	/// Clears the statistics of the last frames
+	virtual void resetFrameStats() = 0;
+
 	
 	/// changes the resolution of the camera after the camerafile was already loaded
 	virtual void changeCameraSize(int nWidth, int nHeight) = 0;
@@ -183,9 +339,25 @@ public:
 	/**
 	 * Default value is UNDIST_STD which means that
 	 * artoolkit's standard undistortion method is used.
+	 * UNDIST_LUT uses a per pixel lookup table (4 bytes per pixel,
+	 * images up to 1024x1024, integer input coordinates).
+	 * UNDIST_GRID interpolates bilinearly between undistorted grid nodes:
+	 * any resolution, subpixel input and at most 0.01 pixels off the exact
+	 * camera model. The node distance is chosen per camera (2-16 pixels),
+	 * which typically needs 1/30 to 1/130 of the memory of UNDIST_LUT.
+	 * Strongly distorted cameras may miss the 0.01 pixels even at 2 pixels,
+	 * see getUndistGridError().
 	 */
 	virtual void setUndistortionMode(UNDIST_MODE nMode) = 0;
 
+	/// Returns the largest deviation (pixels) of UNDIST_GRID from the exact camera model
+	/**
+	 * Builds the grid if it does not exist yet. Values above 0.01 mean that
+	 * even the finest node distance did not reach the intended accuracy.
+	 * Returns -1 if UNDIST_GRID is not active or no camera is loaded.
+	 */
+	virtual ARFloat getUndistGridError() = 0;
+
 	/// Changes the Pose Estimation Algorithm
 	/**
 	* POSE_ESTIMATOR_ORIGINAL (default): arGetTransMat()
@@ -206,6 +378,16 @@ public:
 	 *  track the pose of these 4 points.
 	 */
 	virtual void setHullMode(HULL_TRACKING_MODE nMode) = 0;
+
+	/// Changes the multi-marker pose estimation algorithm
+	/**
+	 *  MULTI_POSE_ESTIMATOR_DEFAULT: use the estimator that belongs to setPoseEstimator()
+	 *  MULTI_POSE_ESTIMATOR_RANSAC: builds board pose hypotheses from single markers
+	 *  (biggest first), keeps the one most markers agree with and refines it using only
+	 *  those markers. Wrongly decoded ids hence no longer spoil the board pose.
+	 *  Hull tracking (setHullMode()) takes precedence over this setting.
+	 */
+	virtual void setMultiPoseEstimator(MULTI_POSE_ESTIMATOR nMethod) = 0;
 
 	/// Sets a new relative border width. ARToolKit's default value is 0.25
 	/**
@@ -242,10 +424,28 @@ public:
 	 *  A value of 2 means that ARToolKitPlus will analyze the image a second time with an other treshold value
 	 *  if it does not find a marker the first time. Each unsuccessful try uses less processing power
 	 *  than a single full successful position estimation.
+	 *  In AUTO_THRESHOLD_HISTOGRAM mode this is the maximum number of histogram candidates
+	 *  that are tried (at most 15).
 	 */
 	virtual void setNumAutoThresholdRetries(int nNumRetries) = 0;
 
 
+	/// Selects how retry thresholds are chosen when no marker was found (Default: AUTO_THRESHOLD_RANDOM)
+	/**
+	 *  AUTO_THRESHOLD_RANDOM picks random values, so the number of retries needed
+	 *  (and thereby the frame time) varies from frame to frame.
+	 *  AUTO_THRESHOLD_HISTOGRAM builds a luminance histogram from a subsampled copy
+	 *  of the frame after the first attempt failed and tries the Otsu threshold, the two
+	 *  thresholds of a three-class Otsu split and then values that bisect the remaining
+	 *  luminance range. The sequence only depends on the image, so results are reproducible.
+	 */
+	virtual void setAutoThresholdMode(AUTO_THRESHOLD_MODE nMode) = 0;
+
+
+	/// Returns the current auto threshold mode
+	virtual AUTO_THRESHOLD_MODE getAutoThresholdMode() const = 0;
+
+
 	/// Sets an image processing mode (half or full resolution)
 	/**
 	 *  Half resolution is faster but less accurate. When using
@@ -255,6 +455,20 @@ public:
 	virtual void setImageProcessingMode(IMAGE_PROC_MODE nMode) = 0;
 
 
+	/// Sets the maximum number of connected regions the labeling step may create per frame
+	/**
+	 *  0 (default) derives the budget from the image size. Budgets up to 32767 use
+	 *  16-bit labels, larger budgets switch the label image to 32-bit. The work tables
+	 *  start small and grow by doubling until they reach the budget; a frame that needs
+	 *  more labels than the budget is skipped.
+	 */
+	virtual void setLabelBudget(int nMaxLabels) = 0;
+
+
+	/// Returns the label budget in effect for the current image size
+	virtual int getLabelBudget() const = 0;
+
+
 	/// Returns an opengl-style modelview transformation matrix
 	virtual const ARFloat* getModelViewMatrix() const = 0;
 
@@ -295,6 +509,34 @@ public:
 	virtual void setCamera(Camera* nCamera, ARFloat nNearClip, ARFloat nFarClip) = 0;
 
 
+	/// Sets the right camera for stereo tracking
+	/**
+	 *  Stereo tracking works on image pairs of two synchronized cameras, see calcStereo()
+	 *  of TrackerSingleMarker and TrackerMultiMarker. The camera of loadCameraFile() or
+	 *  setCamera() is the left camera, nCamera the right one. Both images must have the
+	 *  same size and pixel format. nRightFromLeft is the calibrated extrinsic between the
+	 *  cameras: it maps points from left to right camera coordinates (in millimeters).
+	 *
+	 *  Markers are matched by id across both images. Their corners are triangulated,
+	 *  the model is aligned to the triangulated corners and the pose is refined on the
+	 *  reprojection error in both images. Poses are relative to the left camera.
+	 *  The right image is labeled by a second thread while the calling thread labels
+	 *  the left one, so a memory manager set with setMemoryManager() has to be thread safe.
+	 *  The right image is undistorted with the camera model (UNDIST_STD) unless the
+	 *  undistortion mode is UNDIST_NONE. Image pairs are always processed completely:
+	 *  the motion gate, corner tracking, multi-threshold detection and the decode cache
+	 *  only work for mono images.
+	 *
+	 *  On destruction the tracker destroys the currently set right camera.
+	 *  Pass NULL to turn stereo tracking off (nRightFromLeft is ignored then).
+	 */
+	virtual void setStereoCamera(Camera* nCamera, const ARFloat nRightFromLeft[3][4]) = 0;
+
+
+	/// Returns the right camera of stereo tracking (NULL if stereo tracking is off)
+	virtual Camera* getStereoCamera() = 0;
+
+
 	/// Calculates the OpenGL transformation matrix for a specific marker info
 	virtual ARFloat calcOpenGLMatrixFromMarker(ARMarkerInfo* nMarkerInfo, ARFloat nPatternCenter[2], ARFloat nPatternSize, ARFloat *nOpenGLMatrix) = 0;
 
@@ -47,10 +47,25 @@
 #include <ARToolKitPlus/matrix.h>
 #include <ARToolKitPlus/Tracker.h>
 #include <ARToolKitPlus/MemoryManager.h>
+#include <ARToolKitPlus/MemoryManagerArena.h>
 #include <ARToolKitPlus/Camera.h>
 #include <ARToolKitPlus/CameraFactory.h>
 #include <ARToolKitPlus/extra/BCH.h>
 #include <ARToolKitPlus/extra/Hull.h>
+#include <ARToolKitPlus/extra/FixedVector.h>
+#include <vector>
+
+// bands of the undistortion table may be built while other threads read it
+// (stereo labeling, TrackerPipeline), see arParamObserv2Ideal_LUT().
+// histogram threshold retries label two candidates at once, see arDetectMarkerRetries()
+// multi-marker configs are posed on several threads, see TrackerMultiMarkerImpl::calcPose()
+#if !defined(_MSC_VER) && !defined(_WIN32_WCE)
+#  define UNDIST_LUT_USE_THREADS
+#  define AR_AUTO_THRESHOLD_USE_THREADS
+#  define AR_MULTI_POSE_USE_THREADS
+#  include <pthread.h>
+#  include <unistd.h>
+#endif
 
 
 #define AR_TEMPL_FUNC template <int __PATTERN_SIZE_X, int __PATTERN_SIZE_Y, int __PATTERN_SAMPLE_NUM, int __MAX_LOAD_PATTERNS, int __MAX_IMAGE_PATTERNS>
@@ -82,6 +97,49 @@ template<class T> T* artkp_Alloc(size_t size)
 }
 
 
+// RGB565 to gray conversion tables (see getLUM8_from_RGB565() in config.h):
+// the gray value is linear in the bits of the pixel, so the high and the
+// low byte can be looked up separately and summed up.
+//
+const unsigned char RGB565_to_LUM8_hi[256] = {
+	  0,  20,  40,  60,  80, 100, 120, 140,   2,  22,  42,  62,  82, 102, 122, 142,
+	  4,  24,  44,  64,  84, 104, 124, 144,   6,  26,  46,  66,  86, 106, 126, 146,
+	  8,  28,  48,  68,  88, 108, 128, 148,  10,  30,  50,  70,  90, 110, 130, 150,
+	 12,  32,  52,  72,  92, 112, 132, 152,  14,  34,  54,  74,  94, 114, 134, 154,
+	 16,  36,  56,  76,  96, 116, 136, 156,  18,  38,  58,  78,  98, 118, 138, 158,
+	 20,  40,  60,  80, 100, 120, 140, 160,  22,  42,  62,  82, 102, 122, 142, 162,
+	 24,  44,  64,  84, 104, 124, 144, 164,  26,  46,  66,  86, 106, 126, 146, 166,
+	 28,  48,  68,  88, 108, 128, 148, 168,  30,  50,  70,  90, 110, 130, 150, 170,
+	 32,  52,  72,  92, 112, 132, 152, 172,  34,  54,  74,  94, 114, 134, 154, 174,
+	 36,  56,  76,  96, 116, 136, 156, 176,  38,  58,  78,  98, 118, 138, 158, 178,
+	 40,  60,  80, 100, 120, 140, 160, 180,  42,  62,  82, 102, 122, 142, 162, 182,
+	 44,  64,  84, 104, 124, 144, 164, 184,  46,  66,  86, 106, 126, 146, 166, 186,
+	 48,  68,  88, 108, 128, 148, 168, 188,  50,  70,  90, 110, 130, 150, 170, 190,
+	 52,  72,  92, 112, 132, 152, 172, 192,  54,  74,  94, 114, 134, 154, 174, 194,
+	 56,  76,  96, 116, 136, 156, 176, 196,  58,  78,  98, 118, 138, 158, 178, 198,
+	 60,  80, 100, 120, 140, 160, 180, 200,  62,  82, 102, 122, 142, 162, 182, 202
+};
+
+const unsigned char RGB565_to_LUM8_lo[256] = {
+	  0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,  15,
+	 16,  17,  18,  19,  20,  21,  22,  23,  24,  25,  26,  27,  28,  29,  30,  31,
+	  2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,  15,  16,  17,
+	 18,  19,  20,  21,  22,  23,  24,  25,  26,  27,  28,  29,  30,  31,  32,  33,
+	  5,   6,   7,   8,   9,  10,  11,  12,  13,  14,  15,  16,  17,  18,  19,  20,
+	 21,  22,  23,  24,  25,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,
+	  7,   8,   9,  10,  11,  12,  13,  14,  15,  16,  17,  18,  19,  20,  21,  22,
+	 23,  24,  25,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,
+	 10,  11,  12,  13,  14,  15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25,
+	 26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,  41,
+	 12,  13,  14,  15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25,  26,  27,
+	 28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,  41,  42,  43,
+	 15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25,  26,  27,  28,  29,  30,
+	 31,  32,  33,  34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,
+	 17,  18,  19,  20,  21,  22,  23,  24,  25,  26,  27,  28,  29,  30,  31,  32,
+	 33,  34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48
+};
+
+
 /// TrackerImpl implements the Tracker interface
 template <int __PATTERN_SIZE_X, int __PATTERN_SIZE_Y, int __PATTERN_SAMPLE_NUM, int __MAX_LOAD_PATTERNS, int __MAX_IMAGE_PATTERNS>
 class TrackerImpl : public Tracker
@@ -94,13 +152,22 @@ public:
 
 		MAX_LOAD_PATTERNS = __MAX_LOAD_PATTERNS,
 		MAX_IMAGE_PATTERNS = __MAX_IMAGE_PATTERNS,
-		WORK_SIZE = 1024*MAX_IMAGE_PATTERNS,
 
-#ifdef SMALL_LUM8_TABLE
-		LUM_TABLE_SIZE = (0xffff >> 6) + 1,
-#else
-		LUM_TABLE_SIZE = 0xffff + 1,
-#endif
+		LABEL_INITIAL_CAPACITY = 4096,	// labels the work tables can hold before they have to grow
+		LABEL_MAX_16BIT = 32767,		// largest label budget that fits int16_t labels
+		LABEL_AUTO_PIXELS = 16,			// automatic label budget: one label per this many pixels
+
+		UNDIST_GRID_MAX_STEP = 16,		// node distance (pixels) tried first for UNDIST_GRID
+		UNDIST_GRID_MIN_STEP = 2,
+
+		FRAME_SCRATCH_SIZE = 64*1024,	// initial (and grow) size of the per-frame scratch arena
+		POSE_SCRATCH_SIZE = 16*1024,	// initial (and grow) size of the pose estimation scratch arena
+
+		ADAPTIVE_MAX_WINDOW = 255,		// largest box filter window for adaptive thresholding
+		ADAPTIVE_BLOCK_SIZE = 4,		// adaptive thresholding uses one threshold per 4x4 pixels
+		ADAPTIVE_MIN_CONTRAST = 32,		// id-patterns with less contrast are decoded with the global threshold
+
+		MULTI_THRESHOLD_MAX = 8,		// bit-planes per byte for multi-threshold detection
 	};
 
 
@@ -142,6 +209,9 @@ public:
 	virtual ARFloat arMultiGetTransMat(ARMarkerInfo *marker_info, int marker_num, ARMultiMarkerInfoT *config);
 
     virtual ARFloat arMultiGetTransMatHull(ARMarkerInfo *marker_info, int marker_num, ARMultiMarkerInfoT *config);
+
+	/// RANSAC multi-marker pose estimator (see setMultiPoseEstimator())
+	virtual ARFloat arMultiGetTransMatRansac(ARMarkerInfo *marker_info, int marker_num, ARMultiMarkerInfoT *config);
 
 	/// calculates the transformation matrix between camera and the given marker
 	virtual ARFloat arGetTransMat(ARMarkerInfo *marker_info, ARFloat center[2], ARFloat width, ARFloat conv[3][4]);
@@ -162,6 +232,8 @@ public:
 
 	virtual ARMultiMarkerInfoT *arMultiReadConfigFile(const char *filename);
 
+	virtual int arMultiWriteConfigBundle(const char *nConfigFile, const char *nBundleFile);
+
 	virtual void activateBinaryMarker(int nThreshold)  {  binaryMarkerThreshold = nThreshold;  }
 
 	/// Activate the usage of id-based markers rather than template based markers
@@ -187,6 +259,99 @@ public:
 	virtual void activateVignettingCompensation(bool nEnable, int nCorners=0, int nLeftRight=0, int nTopBottom=0);
 
 
+	/// activates adaptive thresholding: each pixel is compared against the mean of its neighborhood
+	/**
+	 *  a pixel is black if it is at least nOffsetPercent percent darker than the mean of the
+	 *  nWindowSize x nWindowSize box around it (nWindowSize=0: 1/8 of the image width).
+	 *  see Tracker::activateAdaptiveThreshold() for details.
+	 */
+	virtual void activateAdaptiveThreshold(bool nEnable, int nWindowSize=0, int nOffsetPercent=15);
+
+
+	/// Returns true if adaptive thresholding is activated
+	virtual bool isAdaptiveThresholdActivated() const  {  return adaptiveThreshold.enabled;  }
+
+
+	/// activates marker detection at several thresholds per frame
+	/**
+	 *  nNumThresholds (2..8) bit-planes are created in a single pass over the image and
+	 *  labeled one after another. see Tracker::activateMultiThreshold() for details.
+	 */
+	virtual void activateMultiThreshold(bool nEnable, int nNumThresholds=3, int nSpacing=32);
+
+
+	/// Returns true if multi-threshold detection is activated
+	virtual bool isMultiThresholdActivated() const  {  return multiThreshold.enabled;  }
+
+
+	/// activates motion gating: frames that did not change are not searched again
+	/**
+	 *  each frame is compared against the last processed one on a grid of 4x4 pixel means.
+	 *  see Tracker::activateMotionGate() for details.
+	 */
+	virtual void activateMotionGate(bool nEnable, int nTolerance=8);
+
+
+	/// Returns true if motion gating is activated
+	virtual bool isMotionGateActivated() const  {  return motionGate.enabled;  }
+
+
+	/// activates corner tracking between full detections
+	/**
+	 *  the vertices of known markers are followed with a pyramidal Lucas-Kanade tracker
+	 *  for up to nMaxTrackedFrames frames. see Tracker::activateCornerTracking() for details.
+	 */
+	virtual void activateCornerTracking(bool nEnable, int nMaxTrackedFrames=10);
+
+
+	/// Returns true if corner tracking is activated
+	virtual bool isCornerTrackingActivated() const  {  return cornerTracking.enabled;  }
+
+
+	/// activates verifying instead of decoding markers known from the last frame
+	/**
+	 *  see Tracker::activateDecodeCache() for details.
+	 */
+	virtual void activateDecodeCache(bool nEnable)  {  decodeCache.enabled = nEnable;  }
+
+
+	/// Returns true if the decode cache is activated
+	virtual bool isDecodeCacheActivated() const  {  return decodeCache.enabled;  }
+
+
+	/// activates rejecting candidates by a few samples of their border and inside
+	/**
+	 *  see Tracker::activateEarlyReject() for details.
+	 */
+	virtual void activateEarlyReject(bool nEnable, int nMinContrast=32);
+
+
+	/// Returns true if the early reject test is activated
+	virtual bool isEarlyRejectActivated() const  {  return earlyReject.enabled;  }
+
+
+	/// Returns the number of candidates rejected for nReason in the last frame
+	virtual int getNumEarlyRejects(EARLY_REJECT_REASON nReason) const;
+
+
+	/// Returns the counters and stage timings of the last frame
+	/**
+	 *  see Tracker::getFrameStats() for details.
+	 */
+	virtual const FrameStats& getFrameStats() const  {  return frameStats.frame;  }
+
+
+	/// Fills nSummary with means and maxima over the last frames
+	/**
+	 *  see Tracker::getFrameStatsSummary() for details.
+	 */
+	virtual void getFrameStatsSummary(FrameStatsSummary& nSummary) const;
+
+
+	/// Clears the statistics of the last frames
+	virtual void resetFrameStats();
+
+
 	/// Calculates the camera matrix from an ARToolKit camera file.
 	/**
 	 * This method retrieves the OpenGL projection matrix that is stored
@@ -205,9 +370,16 @@ public:
 	/**
 	 * Default value is UNDIST_STD which means that
 	 * artoolkit's standard undistortion method is used.
+	 * See Tracker::setUndistortionMode() for the other modes.
 	 */
 	virtual void setUndistortionMode(UNDIST_MODE nMode);
 
+	/// Returns the largest deviation (pixels) of UNDIST_GRID from the exact camera model
+	/**
+	 * See Tracker::getUndistGridError().
+	 */
+	virtual ARFloat getUndistGridError();
+
 	/// Changes the Pose Estimation Algorithm
 	/**
 	* POSE_ESTIMATOR_ORIGINAL (default): arGetTransMat()
@@ -229,6 +401,16 @@ public:
 	 *  track the pose of these 4 points.
 	 */
 	virtual void setHullMode(HULL_TRACKING_MODE nMode)  {  hullTrackingMode = nMode;  }
+
+	/// Changes the multi-marker pose estimation algorithm
+	/**
+	 *  MULTI_POSE_ESTIMATOR_DEFAULT: use the estimator that belongs to setPoseEstimator()
+	 *  MULTI_POSE_ESTIMATOR_RANSAC: builds board pose hypotheses from single markers
+	 *  (biggest first), keeps the one most markers agree with and refines it using only
+	 *  those markers. Wrongly decoded ids hence no longer spoil the board pose.
+	 *  Hull tracking (setHullMode()) takes precedence over this setting.
+	 */
+	virtual void setMultiPoseEstimator(MULTI_POSE_ESTIMATOR nMethod)  {  multiPoseEstimator = nMethod;  }
 
 	/// Sets a new relative border width. ARToolKit's default value is 0.25
 	/**
@@ -265,7 +447,15 @@ public:
 	 *  if it does not find a marker the first time. Each unsuccessful try uses less processing power
 	 *  than a single full successful position estimation.
 	 */
-	virtual void setNumAutoThresholdRetries(int nNumRetries)  {  autoThreshold.numRandomRetries = nNumRetries>=1 ? nNumRetries : 1;  }
+	virtual void setNumAutoThresholdRetries(int nNumRetries)  {  autoThreshold.numRetries = nNumRetries>=1 ? nNumRetries : 1;  }
+
+
+	/// Selects how retry thresholds are chosen when no marker was found (Default: AUTO_THRESHOLD_RANDOM)
+	virtual void setAutoThresholdMode(AUTO_THRESHOLD_MODE nMode)  {  autoThreshold.mode = nMode;  }
+
+
+	/// Returns the current auto threshold mode
+	virtual AUTO_THRESHOLD_MODE getAutoThresholdMode() const  {  return autoThreshold.mode;  }
 
 
 	/// Sets an image processing mode (half or full resolution)
@@ -277,6 +467,20 @@ public:
 	virtual void setImageProcessingMode(IMAGE_PROC_MODE nMode)  {  arImageProcMode = (nMode==IMAGE_HALF_RES ? AR_IMAGE_PROC_IN_HALF : AR_IMAGE_PROC_IN_FULL);  }
 
 
+	/// Sets the maximum number of connected regions the labeling step may create per frame
+	/**
+	 *  0 (default) derives the budget from the image size. Budgets up to 32767 use
+	 *  16-bit labels, larger budgets switch the label image to 32-bit. The work tables
+	 *  start small and grow by doubling until they reach the budget; a frame that needs
+	 *  more labels than the budget is skipped.
+	 */
+	virtual void setLabelBudget(int nMaxLabels)  {  labelBudget = nMaxLabels>0 ? nMaxLabels : 0;  }
+
+
+	/// Returns the label budget in effect for the current image size
+	virtual int getLabelBudget() const  {  return getLabelLimit(labelBudget, screenWidth, screenHeight);  }
+
+
 	/// Returns an opengl-style modelview transformation matrix
 	virtual const ARFloat* getModelViewMatrix() const  {  return gl_para;  }
 
@@ -313,6 +517,17 @@ public:
 	virtual void setCamera(Camera* nCamera, ARFloat nNearClip, ARFloat nFarClip);
 
 
+	/// Sets the right camera for stereo tracking
+	/**
+	 *  see Tracker::setStereoCamera() for details.
+	 */
+	virtual void setStereoCamera(Camera* nCamera, const ARFloat nRightFromLeft[3][4]);
+
+
+	/// Returns the right camera of stereo tracking (NULL if stereo tracking is off)
+	virtual Camera* getStereoCamera()  {  return stereo.camera;  }
+
+
 	virtual ARFloat calcOpenGLMatrixFromMarker(ARMarkerInfo* nMarkerInfo, ARFloat nPatternCenter[2], ARFloat nPatternSize, ARFloat *nOpenGLMatrix);
 
 
@@ -321,7 +536,7 @@ public:
 
 	virtual ARFloat executeMultiMarkerPoseEstimator(ARMarkerInfo *marker_info, int marker_num, ARMultiMarkerInfoT *config);
 	
-	virtual const CornerPoints& getTrackedCorners() const  {  return trackedCorners;  }
+	virtual const CornerPoints& getTrackedCorners() const  {  return pose.trackedCorners;  }
 
 protected:
 	bool checkPixelFormat();
@@ -341,11 +556,18 @@ protected:
 	static bool convertProjectionMatrixToOpenGLStyle2(ARFloat cparam[3][4], int width, int height, ARFloat gnear, ARFloat gfar, ARFloat m[16]);
 
 
-	ARMarkerInfo2* arDetectMarker2(int16_t *limage, int label_num, int *label_ref,
+	template<class LABEL_T>
+	ARMarkerInfo2* arDetectMarker2(LABEL_T *limage, int label_num, int *label_ref,
+								   int *warea, ARFloat *wpos, int *wclip,
+								   int area_max, int area_min, ARFloat factor, int *marker_num);
+
+	// runs arDetectMarker2() on the label image with the label type currently in use
+	ARMarkerInfo2* arDetectMarker2(void *limage, int label_num, int *label_ref,
 								   int *warea, ARFloat *wpos, int *wclip,
 								   int area_max, int area_min, ARFloat factor, int *marker_num);
 
-	int arGetContour(int16_t *limage, int *label_ref, int label, int clip[4], ARMarkerInfo2 *marker_infoTWO);
+	template<class LABEL_T>
+	int arGetContour(LABEL_T *limage, int *label_ref, int label, int clip[4], ARMarkerInfo2 *marker_infoTWO);
 
 	int check_square(int area, ARMarkerInfo2 *marker_infoTWO, ARFloat factor);
 
@@ -355,6 +577,12 @@ protected:
 	int arGetPatt(uint8_t *image, int *x_coord, int *y_coord, int *vertex,
 				  uint8_t ext_pat[PATTERN_HEIGHT][PATTERN_WIDTH][3]);
 
+	// returns the EARLY_REJECT_REASON of a candidate or -1 if it might be a marker
+	int arEarlyReject(uint8_t *image, int *x_coord, int *y_coord, int *vertex);
+
+	// luminance ((r+g+b)/3) of the image at marker coordinates (xw,yw), -1 if outside
+	int arSampleMarkerLum(uint8_t *image, const ARFloat para[3][3], ARFloat xw, ARFloat yw);
+
 	int pattern_match( uint8_t *data, int *code, int *dir, ARFloat *cf);
 
 	int downsamplePattern(uint8_t* data, unsigned char* imgPtr);
@@ -363,6 +591,15 @@ protected:
 
 	int bitfield_check_BCH(uint8_t *data, int *code, int *dir, ARFloat *cf, int thresh);
 
+	// decode cache: checks only the code and direction predicted by arPredictCode()
+	bool pattern_verify(uint8_t *data, int code, int dir, ARFloat *cf);
+
+	bool bitfield_verify(uint8_t *data, int code, int dir, ARFloat *cf, int thresh);
+
+	// returns the prev_info entry the candidate belongs to (-1 if none or ambiguous)
+	// and the candidate's direction if it shows that marker
+	int arPredictCode(const ARMarkerInfo& nCandidate, int *nDir);
+
 	void gen_evec(void);
 
 	ARMarkerInfo* arGetMarkerInfo(uint8_t *image, ARMarkerInfo2 *marker_info2, int *marker_num, int thresh);
@@ -404,17 +641,95 @@ protected:
 
 	ARFloat arGetTransMatContSub(ARMarkerInfo *marker_info, ARFloat prev_conv[3][4], ARFloat center[2], ARFloat width, ARFloat conv[3][4]);
 
+	// arStereo.cpp: detects the markers of both images of a stereo pair. the right image
+	// is labeled on a second thread (l_imageR, workR, ...) while the left one is labeled here.
+	int arDetectMarkerStereo(uint8_t *dataL, uint8_t *dataR, int thresh,
+							 ARMarkerInfo **marker_infoL, int *marker_numL, ARMarkerInfo **marker_infoR, int *marker_numR);
+
+	// pose of a marker seen in both images from its triangulated corners, -1 if they do not agree
+	ARFloat arGetTransMatStereo(ARMarkerInfo *marker_infoL, ARMarkerInfo *marker_infoR, ARFloat center[2], ARFloat width, ARFloat conv[3][4]);
+
+	// pose of a multi-marker config from all of its markers seen in both images. also sets config->transR
+	ARFloat arMultiGetTransMatStereo(ARMarkerInfo *marker_infoL, int marker_numL, ARMarkerInfo *marker_infoR, int marker_numR,
+									 ARMultiMarkerInfoT *config);
+
+	// triangulates the first num corners of poseState().stereo.pos2dL/pos2dR and fits stereo.pos3d to them
+	ARFloat arStereoFitPose(int num, ARFloat conv[3][4]);
+
+	static void* arStereoLabelThread(void *nJob);
+
+	void freeStereoBuffers();
+
+
+
+	// returns the label image: int16_t or int32_t entries, depending on labelSize.
+	// LorR selects the buffers: 1 left (l_imageL, workL, ...), 0 right (stereo tracking)
+	void* arLabeling(uint8_t *image, int thresh,int *label_num, int **area,
+						ARFloat **pos, int **clip, int **label_ref, int LorR=1 );
 
 
-	int16_t* arLabeling(uint8_t *image, int thresh,int *label_num, int **area,
-						ARFloat **pos, int **clip, int **label_ref );
+	template<class LABEL_T> LABEL_T* arLabeling_ABGR(uint8_t *image, int thresh,int *label_num, int **area, ARFloat **pos, int **clip, int **label_ref, int LorR);
+	template<class LABEL_T> LABEL_T* arLabeling_BGR(uint8_t *image, int thresh,int *label_num, int **area, ARFloat **pos, int **clip, int **label_ref, int LorR);
+	template<class LABEL_T> LABEL_T* arLabeling_RGB(uint8_t *image, int thresh,int *label_num, int **area, ARFloat **pos, int **clip, int **label_ref, int LorR);
+	template<class LABEL_T> LABEL_T* arLabeling_RGB565(uint8_t *image, int thresh,int *label_num, int **area, ARFloat **pos, int **clip, int **label_ref, int LorR);
+	template<class LABEL_T> LABEL_T* arLabeling_LUM(uint8_t *image, int thresh,int *label_num, int **area, ARFloat **pos, int **clip, int **label_ref, int LorR);
 
+	// labels bit nBit of a mask that already has labeling resolution (see arBuildAdaptiveMask()
+	// and arBuildThresholdPlanes()): set bits are black
+	void* arLabelingMask(uint8_t *mask, int nBit, int *label_num, int **area,
+						ARFloat **pos, int **clip, int **label_ref, int LorR=1 );
 
-	int16_t* arLabeling_ABGR(uint8_t *image, int thresh,int *label_num, int **area, ARFloat **pos, int **clip, int **label_ref);
-	int16_t* arLabeling_BGR(uint8_t *image, int thresh,int *label_num, int **area, ARFloat **pos, int **clip, int **label_ref);
-	int16_t* arLabeling_RGB(uint8_t *image, int thresh,int *label_num, int **area, ARFloat **pos, int **clip, int **label_ref);
-	int16_t* arLabeling_RGB565(uint8_t *image, int thresh,int *label_num, int **area, ARFloat **pos, int **clip, int **label_ref);
-	int16_t* arLabeling_LUM(uint8_t *image, int thresh,int *label_num, int **area, ARFloat **pos, int **clip, int **label_ref);
+	template<class LABEL_T> LABEL_T* arLabeling_MASK(uint8_t *mask, int thresh,int *label_num, int **area, ARFloat **pos, int **clip, int **label_ref, int LorR);
+
+	// arAdaptiveThreshold.cpp: black (1) / white (0) mask in labeling resolution, taken from frameScratch
+	uint8_t* arBuildAdaptiveMask(uint8_t *image);
+
+	// arMultiThreshold.cpp: one bit-plane per threshold in labeling resolution, taken from frameScratch
+	uint8_t* arBuildThresholdPlanes(uint8_t *image, const int *nThresholds, int nNum);
+
+	// detection at multiThreshold.num thresholds, returns marker_infoL or NULL if labeling failed
+	ARMarkerInfo* arDetectMarkerMultiThreshold(uint8_t *dataPtr, int nThresh, int *marker_num);
+
+	// arMotionGate.cpp: compares the frame against the last processed one, sets up labelRegion
+	// and returns MotionGate::FRAME_UNCHANGED, FRAME_PARTIAL or FRAME_FULL
+	int arCheckMotionGate(uint8_t *dataPtr, int nThresh);
+
+	// adds the markers of the last frame that lie outside of labelRegion to wmarker_info
+	// (partial frames only), keeps the detections and updates the reference block means
+	void arUpdateMotionGate();
+
+	// keeps / restores the final result of arDetectMarker() for unchanged frames
+	void arStoreMotionGateResult(int nThresh);
+	ARMarkerInfo* arGetMotionGateResult(int *marker_num);
+
+	// arCornerTracking.cpp: follows the markers of the last frame into this one. true if all of
+	// them were tracked (wmarker_info/wmarker_num then hold them), false if a full detection is needed
+	bool arTrackMarkerCorners(uint8_t *dataPtr);
+
+	// after a full detection: the identified markers of wmarker_info are followed from now on
+	void arUpdateCornerTracking(uint8_t *dataPtr);
+
+	void arBuildTrackingPyramid(uint8_t *dataPtr, const ARFloat nCorners[][4][2], int nNum);
+
+	// corner positions are given on the first pyramid level
+	bool arTrackCorner(ARFloat nX, ARFloat nY, ARFloat *nNewX, ARFloat *nNewY);
+	bool arCheckTrackedBorder(const ARFloat nCorners[4][2]);
+
+	static bool arSampleTrackingWindow(const uint8_t *nImage, int nWidth, const int nRegion[4], ARFloat nX, ARFloat nY,
+									   int nRadius, ARFloat *nWindow);
+
+	// arFrameStats.cpp: the detection fields of frameStats.frame are cleared by arStatsBeginDetect()
+	// and stored by arStatsEndDetect(), the pose fields by arStatsBeginPose()/arStatsEndPose().
+	// the two pairs may run on different threads (see TrackerPipeline). nNum is -1 if detection
+	// failed. calc(), calcDetect() and calcStereo() set frameStats.poseFollows before detecting:
+	// those frames are queued for the pose stage and must be followed by one arStatsBeginPose().
+	void arStatsBeginDetect(int nThresh);
+	void arStatsEndDetect(const ARMarkerInfo *nMarkers, int nNum);
+	void arStatsBeginPose();
+	void arStatsEndPose();
+
+	// monotonic clock in nanoseconds
+	static uint64_t arStatsClock();
 
 	//int16_t* labeling2(uint8_t *image, int thresh,int *label_num, int **area,
 	//				   ARFloat **pos, int **clip, int **label_ref, int LorR );
@@ -423,6 +738,28 @@ protected:
 	//				   ARFloat **pos, int **clip, int **label_ref, int LorR );
 
 
+	// arAutoThreshold.cpp: threshold for retry nRetry of the current frame, -1 if there is none left
+	int arGetRetryThreshold(uint8_t *image, int nRetry, int nFirstThresh);
+
+	// retries of a frame whose first attempt (nFirstThresh) found no marker. nThresh is set to the
+	// threshold of the last attempt. returns -1 if a stage of the last attempt failed, else the number of markers
+	int arDetectMarkerRetries(uint8_t *dataPtr, int nFirstThresh, int &nThresh);
+
+	// contour extraction and decoding of one label image, same return value as arDetectMarkerRetries()
+	int arDetectMarkerLabels(uint8_t *dataPtr, int nThresh, void *limage, int label_num, int *area, ARFloat *pos, int *clip, int *label_ref);
+
+	static void* arRetryLabelThread(void *nJob);
+
+	// the right label buffers are needed for stereo tracking and for histogram retries
+	bool needsRightLabelBuffers() const;
+
+	void arBuildThresholdHistogram(uint8_t *image);
+
+	void arBuildThresholdCandidates(uint8_t *image, int nFirstThresh);
+
+	void addThresholdCandidate(int nThresh, int nFirstThresh, int nMaxCandidates);
+
+
 	int arActivatePatt(int patno);
 
 	int arDeactivatePatt(int patno);
@@ -433,6 +770,24 @@ protected:
 
 	int verify_markers(ARMarkerInfo *marker_info, int marker_num, ARMultiMarkerInfoT *config);
 
+	/// Creates the patt_id lookup table and the per-frame work buffers of a multi-marker config
+	bool arMultiCreateConfigIndex(ARMultiMarkerInfoT *config);
+
+	/// Releases everything allocated by arMultiCreateConfigIndex(), does nothing for other configs
+	void arMultiFreeConfigIndex(ARMultiMarkerInfoT *config);
+
+	/// Returns true if arMultiCreateConfigIndex() built the index of the config and it was not freed yet
+	bool arMultiHasConfigIndex(const ARMultiMarkerInfoT *config) const;
+
+	/// Loads a binary multi-marker config bundle (called by arMultiReadConfigFile())
+	ARMultiMarkerInfoT *arMultiReadConfigBundle(const char *filename);
+
+	/// Unmaps the bundle a multi-marker config was loaded from by arMultiReadConfigBundle()
+	void arMultiFreeConfigBundle(ARMultiMarkerInfoT *config);
+
+	/// Returns true if the config was loaded by arMultiReadConfigBundle() and not freed yet
+	bool arMultiIsConfigBundle(const ARMultiMarkerInfoT *config) const;
+
 	int arInitCparam( Camera *pCam );
 
 	int arGetLine(int x_coord[], int y_coord[], int coord_num, int vertex[], ARFloat line[4][3], ARFloat v[4][2]);
@@ -443,7 +798,7 @@ protected:
 
 	static int arUtilMatInv(ARFloat s[3][4], ARFloat d[3][4]);
 
-	static int arMatrixPCA(ARMat *input, ARMat *evec, ARVec *ev, ARVec *mean);
+	static int arMatrixPCA(ARMat *input, ARMat *evec, ARVec *ev, ARVec *mean, MemoryManagerArena *arena);
 
 	static int arMatrixPCA2(ARMat *input, ARMat *evec, ARVec *ev);
 
@@ -459,6 +814,8 @@ protected:
 
 	int arParamObserv2Ideal_LUT(Camera* pCam, ARFloat ox, ARFloat oy, ARFloat *ix, ARFloat *iy);
 
+	int arParamObserv2Ideal_grid(Camera* pCam, ARFloat ox, ARFloat oy, ARFloat *ix, ARFloat *iy);
+
 	int arParamObserv2Ideal_std(Camera* pCam, ARFloat ox, ARFloat oy, ARFloat *ix, ARFloat *iy);
 	int arParamIdeal2Observ_std(Camera* pCam, ARFloat ix, ARFloat iy, ARFloat *ox, ARFloat *oy);
 
@@ -469,11 +826,32 @@ protected:
 
 	void buildUndistO2ITable(Camera* pCam);
 
-	void checkRGB565LUT();
+	void buildUndistO2ITile(Camera* pCam, int nTile);
+
+	void initUndistTables();
+
+	bool loadUndistO2ICache(const char* nFileName, uint32_t nCameraHash);
+
+	void buildUndistGrid(Camera* pCam);
+
+	void lookupUndistGrid(ARFloat ox, ARFloat oy, ARFloat *ix, ARFloat *iy) const;
+
+	void freeUndistTables();
 
 	// calculates amount of data that will be allocated via artkp_Alloc()
+	// for images up to MAX_BUFFER_WIDTH x MAX_BUFFER_HEIGHT
 	static size_t getDynamicMemoryRequirements();
 
+	// calculates amount of data that will be allocated via artkp_Alloc()
+	// for a nWidth x nHeight camera and a label budget (0 = automatic)
+	static size_t getDynamicMemoryRequirements(int nWidth, int nHeight, int nLabelBudget=0);
+
+	// label budget that is used for an image size (nLabelBudget==0: automatic)
+	static int getLabelLimit(int nLabelBudget, int nWidth, int nHeight);
+
+	// grows the labeling work tables (by doubling) to hold at least nNumLabels labels
+	bool growLabelTables(int nNumLabels, int LorR=1);
+
 	Profiler& getProfiler()  {  return profiler;  }
 
 
@@ -502,7 +880,11 @@ protected:
 	struct AutoThreshold {
 		enum {
 			MINLUM0 = 255,
-			MAXLUM0 = 0
+			MAXLUM0 = 0,
+
+			MAX_CANDIDATES = 16,	// histogram thresholds queued per frame
+			SAMPLE_STEP = 4,		// histogram uses every 4th pixel of every 4th row
+			MIN_DISTANCE = 8		// candidates closer than this to a queued/tried threshold are dropped
 		};
 
 		void reset()
@@ -533,10 +915,142 @@ protected:
 
 		bool enable;
 		int minLum,maxLum;
-		int numRandomRetries;
+		int numRetries;
+
+		AUTO_THRESHOLD_MODE mode;
+		bool parallel;				// histogram retries label two candidates at once (more than one core)
+		unsigned int histogram[256];
+		int candidates[MAX_CANDIDATES];
+		int numCandidates;
 	} autoThreshold;
 
 
+	// arMotionGate.cpp
+	//
+	struct MotionGate {
+		enum {
+			BLOCK_SIZE = 4,				// the frame signature is the mean of every 4x4 pixels
+			SAMPLE_STEP = 2,			// ...sampled at every 2nd pixel of every 2nd row
+			TILE_BLOCKS = 8,			// changes are tracked on tiles of 8x8 blocks (32x32 pixels)
+			MAX_PARTIAL_AREA = 50,		// changed regions larger than this (percent) are processed completely
+
+			FRAME_UNCHANGED = 0,		// cached results are returned
+			FRAME_PARTIAL,				// only labelRegion is searched
+			FRAME_FULL
+		};
+
+		bool enabled;
+		int tolerance;					// largest change of a block mean that is ignored
+		int state;						// FRAME_* of the last frame
+		bool markersUnchanged;			// the last frame has the same markers as the one before (poses can be kept)
+
+		uint8_t *reference;				// block means of the processed image regions
+		uint8_t *blocks;				// block means of the current frame, taken from frameScratch
+		int blocksX, blocksY;
+		int regionX0, regionY0, regionX1, regionY1;		// FRAME_PARTIAL: labelRegion in pixels
+		bool valid;						// false: the next frame is processed completely
+		int thresh;						// settings the reference was processed with
+		int imageProcMode;
+		PIXEL_FORMAT pixelFormat;
+
+		ARMarkerInfo detected[MAX_IMAGE_PATTERNS];	// detections, before the tracking history was applied
+		int numDetected;
+		ARMarkerInfo output[MAX_IMAGE_PATTERNS];	// what arDetectMarker() returned
+		int numOutput;
+	} motionGate;
+
+
+	// arCornerTracking.cpp
+	//
+	struct CornerTracking {
+		enum {
+			LEVELS = 3,					// pyramid of 1/2, 1/4 and 1/8 of the camera resolution
+			WINDOW_RADIUS = 3,			// corners are followed with 7x7 pixel windows
+			MARGIN = 48,				// pixels around the markers the pyramids are built for
+			MAX_ITERATIONS = 10,		// Lucas-Kanade iterations per pyramid level
+			MIN_EIGEN = 8,				// smaller eigenvalue of the gradient matrix, per window pixel
+			MAX_RESIDUAL = 24,			// largest mean grey value difference of a tracked window
+			MIN_BORDER_CONTRAST = 16	// the black border is at least this much darker than its surroundings
+		};
+
+		bool enabled;
+		int maxFrames;					// tracked frames in a row before a full detection is forced
+		int numFrames;					// tracked frames since the last full detection
+		bool tracked;					// the current frame was tracked
+		bool valid;						// pyramid[prev] and the markers belong to the last frame
+
+		uint8_t *memory;				// both pyramids
+		uint8_t *pyramid[2][LEVELS];
+		int width[LEVELS], height[LEVELS];
+		int region[2][LEVELS][4];		// part of each level that was built: x0,y0,x1,y1 (exclusive)
+		int prev;						// pyramid of the last frame
+
+		ARMarkerInfo markers[MAX_IMAGE_PATTERNS];		// the markers that are followed
+		ARFloat corners[MAX_IMAGE_PATTERNS][4][2];		// ...their vertices in observed (distorted) pixels
+		int numMarkers;
+	} cornerTracking;
+
+
+	// arGetMarkerInfo.cpp
+	//
+	struct DecodeCache {
+		bool enabled;
+		int numHistory;					// prev_info entries arGetMarkerInfo() may use, 0 outside of arDetectMarker()
+		int predictedId;				// set per candidate for arGetCode(), -1: decode
+		int predictedDir;
+		ARFloat predictedCf;
+	} decodeCache;
+
+
+	// arGetCode.cpp
+	//
+	struct EarlyReject {
+		enum {
+			BORDER_SAMPLES = 4,			// samples per side, in the middle of the black border
+			INTERIOR_SAMPLES = 6,		// 6x6 samples inside the border
+			MAX_BRIGHT_BORDER = 1,		// border samples that may be bright (blur, noise)
+			MIN_BORDER_PIXELS = 4		// narrower borders (in the image) are not tested
+		};
+
+		bool enabled;
+		int minContrast;
+		int numRejected[EARLY_REJECT_NUM_REASONS];	// reset at the start of every frame
+	} earlyReject;
+
+
+	// arFrameStats.cpp
+	//
+	struct Statistics {
+		FrameStats frame;							// the frame being detected / posed, then the last one
+		FrameStats history[FrameStatsSummary::WINDOW];
+		unsigned int numDetected;					// frames stored, history index is count % WINDOW
+		unsigned int poseFrames[FrameStatsSummary::WINDOW];	// frames waiting for the pose stage
+		bool poseFollows;							// the running detection gets a pose stage
+		unsigned int numQueued;						// added by arStatsEndDetect()
+		unsigned int numPosed;						// taken by arStatsBeginPose()
+		unsigned int poseFrame;						// frame of the running pose stage
+		uint64_t detectBegin;
+		uint64_t poseBegin;
+	} frameStats;
+
+
+	// arStereo.cpp
+	//
+	struct Stereo {
+		enum {
+			MAX_CORNER_ERROR = 16,		// squared reprojection error (pixels) of a triangulated corner
+			MIN_CORNERS = 3,			// corners that have to agree for a stereo pose
+			MAX_ITERATIONS = 10			// refinement steps on the reprojection error
+		};
+
+		Camera *camera;							// right camera, NULL: stereo tracking is off
+		ARFloat rightFromLeft[3][4];			// calibrated extrinsic, left to right camera coordinates
+
+		ARMarkerInfo markerL[MAX_IMAGE_PATTERNS];
+		ARMarkerInfo markerR[MAX_IMAGE_PATTERNS];
+	} stereo;
+
+
 	PIXEL_FORMAT			pixelFormat;
 	int						pixelSize;
 
@@ -562,6 +1076,66 @@ protected:
     int						arGetContour_wx[AR_CHAIN_MAX];
     int						arGetContour_wy[AR_CHAIN_MAX];
 
+	// arUtil.cpp: contour points of one edge for the batched undistortion in arGetLine2()
+	//
+	ARFloat					arGetLine_x[AR_CHAIN_MAX];
+	ARFloat					arGetLine_y[AR_CHAIN_MAX];
+
+	// temporary matrices of arGetLine2(), arMatrixPCA() and arUtilMatInv() are taken from this
+	// arena. it is reset at the start of arDetectMarker(), so once it has grown to the size a
+	// frame needs, tracking does not touch the heap anymore.
+	//
+	MemoryManagerArena		frameScratch;
+
+	// everything pose estimation writes besides the config or marker it works on. the tracker
+	// poses with its own state; the threads TrackerMultiMarkerImpl poses configs on get one
+	// each (see poseState()).
+	//
+	struct PoseState {
+		// arGetTransMatSub() and arModifyMatrix() take their temporaries from this arena, not from
+		// frameScratch: pose estimation may run on another thread while the next frame is detected
+		// (see TrackerPipeline). all users rewind it, so it is never reset.
+		MemoryManagerArena	scratch;
+
+		// arGetTransMat.cpp
+		ARFloat		pos2d[P_MAX][2];
+		ARFloat		pos3d[P_MAX][3];
+
+		// used for Hull Tracking (sized for four corners of every detectable marker)
+		MarkerPoint	hullInPoints[MAX_IMAGE_PATTERNS*4];
+		MarkerPoint	hullOutPoints[MAX_IMAGE_PATTERNS*4+1];
+		int			hullWork[MAX_IMAGE_PATTERNS*4];
+		FixedVector<int, MAX_IMAGE_PATTERNS>	hullTrackedMarkers;
+
+		CornerPoints	trackedCorners;
+
+		// corner correspondences collected for arStereoFitPose()
+		struct {
+			ARFloat pos2dL[MAX_IMAGE_PATTERNS*4][2];
+			ARFloat pos2dR[MAX_IMAGE_PATTERNS*4][2];
+			ARFloat pos3d[MAX_IMAGE_PATTERNS*4][3];
+			ARFloat posCam[MAX_IMAGE_PATTERNS*4][3];	// triangulated, left camera coordinates
+		} stereo;
+
+		FrameStats	*stats;			// counts numPoses and poseIterations, takes poseError
+	};
+
+	PoseState				pose;
+#ifdef AR_MULTI_POSE_USE_THREADS
+	pthread_key_t			poseKey;	// a pose thread's own PoseState
+#endif
+
+	// the PoseState of the calling thread
+	PoseState& poseState()
+	{
+#ifdef AR_MULTI_POSE_USE_THREADS
+		PoseState* state = (PoseState*)pthread_getspecific(poseKey);
+		if(state)
+			return *state;
+#endif
+		return pose;
+	}
+
 
 	// arGetCode.cpp
 	int    pattern_num;
@@ -580,23 +1154,43 @@ protected:
 	int    evec_dimBW;
 	int    evecBWf;
 
+	// arMultiConfigBundle.cpp: configs loaded from a bundle. only these own
+	// config->bundle, which is not initialized in configs built by the application.
+	std::vector<ARMultiMarkerInfoT*>	bundleConfigs;
+
+	// arMultiReadConfigFile.cpp: configs indexed by arMultiCreateConfigIndex(). the index
+	// fields of configs built by the application are not initialized, so they are never tested.
+	std::vector<ARMultiMarkerInfoT*>	indexedConfigs;
+
 	// arGetMarkerInfo.cpp
 	//
 	ARMarkerInfo    marker_infoL[MAX_IMAGE_PATTERNS];
 
-	// arGetTransMat.cpp
+	// arMultiThreshold.cpp: markers collected over all bit-planes
 	//
-	ARFloat  pos2d[P_MAX][2];
-	ARFloat  pos3d[P_MAX][3];
+	ARMarkerInfo    marker_infoMulti[MAX_IMAGE_PATTERNS];
 
 	// arLabeling.cpp
 	//
-	int16_t      *l_imageL; //[HARDCODED_BUFFER_WIDTH*HARDCODED_BUFFER_HEIGHT];		// dyna
-	int16_t      *l_imageR;
+	void         *l_imageL; //[screenWidth*screenHeight] of int16_t or int32_t		// dyna
+	void         *l_imageR; // like l_imageL, only allocated for stereo tracking			// dyna
 	int			 l_imageL_size;
+	int			 labelSize;			// sizeof(int16_t) or sizeof(int32_t), see checkImageBuffer()
+	int			 labelBudget;		// as set by setLabelBudget(), 0 for automatic
+	int			 labelLimit;		// budget in effect for the current image size
+	int			 labelCapacity;		// number of labels the work tables can hold right now
+	int			 labelCapacityR;	// ...the right image's tables (stereo tracking)
+	uint8_t		 labelMaskBit;		// bit arLabeling_MASK() treats as black, see arLabelingMask()
+
+	// if active, labeling only looks at this window (labeling resolution, x1/y1 exclusive).
+	// the label image keeps the values of the last frame outside of it.
+	struct {
+		bool active;
+		int x0, y0, x1, y1;
+	} labelRegion;
 
-	int          *workL;  //[WORK_SIZE];											// dyna
-	int          *work2L; //[WORK_SIZE*7];											// dyna
+	int          *workL;  //[labelCapacity];										// dyna
+	int          *work2L; //[labelCapacity*7];										// dyna
 
 	int          *workR;
 	int          *work2R;
@@ -606,9 +1200,9 @@ protected:
 
 	int          wlabel_numL;
 	int          wlabel_numR;
-	int          *wareaL;  //[WORK_SIZE];											// dyna
-	int          *wclipL;  //[WORK_SIZE*4];											// dyna
-	ARFloat       *wposL;  //[WORK_SIZE*2];											// dyna
+	int          *wareaL;  //[labelCapacity];										// dyna
+	int          *wclipL;  //[labelCapacity*4];										// dyna
+	ARFloat       *wposL;  //[labelCapacity*2];										// dyna
 
 	int        arFittingMode;
 	int        arImageProcMode;
@@ -622,19 +1216,27 @@ protected:
 
 	MARKER_MODE		markerMode;
 
-	unsigned char *RGB565_to_LUM8_LUT;		// lookup table for RGB565 to LUM8 conversion
 
 
 	// camera distortion addon by Daniel
 	//
 	UNDIST_MODE		undistMode;
 	unsigned int	*undistO2ITable;
+	volatile unsigned int	*undistO2ITileReady;	// per band of rows: built yet? (written with undistLock held)
+	int				undistO2INumTiles;
+#ifdef UNDIST_LUT_USE_THREADS
+	pthread_mutex_t	undistLock;					// held while a table (or a band of it) is built
+#endif
+	void			*undistO2IMap;				// mapped cache file if undistO2ITable points into it
+	size_t			undistO2IMapSize;
 
-	// used for Hull Tracking
-	MarkerPoint	hullInPoints[MAX_HULL_POINTS];
-	MarkerPoint	hullOutPoints[MAX_HULL_POINTS];
-
-	CornerPoints	trackedCorners;
+	// UNDIST_GRID: undistorted (x,y) of every undistGridStep-th pixel, undistGridW*undistGridH nodes
+	ARFloat			*undistGrid;
+	int				undistGridStep;
+	ARFloat			undistGridInvStep;
+	ARFloat			undistGridError;			// measured in the cell centres, -1 before the grid is built
+	int				undistGridW, undistGridH;
+	volatile unsigned int	undistGridReady;	// written with undistLock held
 
 	ARFloat			relBorderWidth;
 
@@ -645,6 +1247,8 @@ protected:
 	POSE_ESTIMATOR  poseEstimator;
 
     HULL_TRACKING_MODE hullTrackingMode;
+
+	MULTI_POSE_ESTIMATOR multiPoseEstimator;
 
 	ARToolKitPlus::Logger	*logger;
 
@@ -656,12 +1260,22 @@ protected:
 	ARFloat					gl_para[16];
 	ARFloat					gl_cpara[16];
 
-	char					*descriptionString;
+	char					descriptionString[512];		// filled by getDescription()
 
 	struct {
 		bool enabled;
 		int corners, leftright, bottomtop;
 	} vignetting;
+
+	struct {
+		bool enabled;
+		int windowSize, offsetPercent;
+	} adaptiveThreshold;
+
+	struct {
+		bool enabled;
+		int num, spacing;
+	} multiThreshold;
 
 #ifdef DEBUG_DIV_RANGE
 	struct DBG_INFO {
@@ -688,9 +1302,13 @@ protected:
 
 // this is templated code, so we need to include all this here...
 //
+#include <ARToolKitPlus_impl/core/arAdaptiveThreshold.cpp>
+#include <ARToolKitPlus_impl/core/arAutoThreshold.cpp>
 #include <ARToolKitPlus_impl/core/arBitFieldPattern.cpp>
+#include <ARToolKitPlus_impl/core/arCornerTracking.cpp>
 #include <ARToolKitPlus_impl/core/arDetectMarker.cpp>
 #include <ARToolKitPlus_impl/core/arDetectMarker2.cpp>
+#include <ARToolKitPlus_impl/core/arFrameStats.cpp>
 #include <ARToolKitPlus_impl/core/arGetCode.cpp>
 #include <ARToolKitPlus_impl/core/arGetMarkerInfo.cpp>
 #include <ARToolKitPlus_impl/core/arGetTransMat.cpp>
@@ -699,10 +1317,15 @@ protected:
 #include <ARToolKitPlus_impl/core/rppGetTransMat.cpp> // RPP integration -- [t.pintaric]
 #include <ARToolKitPlus_impl/core/arGetTransMatCont.cpp>
 #include <ARToolKitPlus_impl/core/arLabeling.cpp>
+#include <ARToolKitPlus_impl/core/arMotionGate.cpp>
 #include <ARToolKitPlus_impl/core/arMultiActivate.cpp>
 #include <ARToolKitPlus_impl/core/arMultiGetTransMat.cpp>
+#include <ARToolKitPlus_impl/core/arMultiGetTransMatRansac.cpp>
 #include <ARToolKitPlus_impl/core/rppMultiGetTransMat.cpp> 	// RPP integration -- [t.pintaric]
 #include <ARToolKitPlus_impl/core/arMultiReadConfigFile.cpp>
+#include <ARToolKitPlus_impl/core/arMultiThreshold.cpp>
+#include <ARToolKitPlus_impl/core/arMultiConfigBundle.cpp>
+#include <ARToolKitPlus_impl/core/arStereo.cpp>
 #include <ARToolKitPlus_impl/core/arUtil.cpp>
 #include <ARToolKitPlus_impl/core/matrix.cpp>
 #include <ARToolKitPlus_impl/core/mPCA.cpp>
@@ -77,6 +77,33 @@ public:
 	 */
 	virtual int calc(const unsigned char* nImage) = 0;
 
+	/// calculates the transformation matrix from a stereo image pair
+	/**
+	 *  Like calc(), but nImageRight is the image the right camera (see setStereoCamera())
+	 *  took at the same time as nImageLeft. A config whose markers are found in both images
+	 *  is posed from both images (ARMultiMarkerInfoT::transR is the pose relative to the
+	 *  right camera then), otherwise from the left image alone.
+	 *  Returns the number of markers detected in the left image.
+	 */
+	virtual int calcStereo(const unsigned char* nImageLeft, const unsigned char* nImageRight) = 0;
+
+	/// runs the detection half of calc()
+	/**
+	 *  Detects the markers in nImage and copies up to nMaxMarkers of them into nMarkers.
+	 *  Returns their number or -1 if detection failed. calcDetect() followed by calcPose()
+	 *  gives the same result as calc(); see TrackerSingleMarker::calcDetect() for how the
+	 *  two halves may run on different threads.
+	 */
+	virtual int calcDetect(const unsigned char* nImage, ARMarkerInfo* nMarkers, int nMaxMarkers,
+			 bool* nMarkersUnchanged=NULL) = 0;
+
+	/// runs the pose half of calc() on markers found by calcDetect()
+	/**
+	 *  Estimates the poses of all configs. nMarkers may be modified.
+	 *  Returns the number of markers with a valid id, or 0 if no config was tracked.
+	 */
+	virtual int calcPose(ARMarkerInfo* nMarkers, int nNumMarkers, bool nMarkersUnchanged=false) = 0;
+
 	/// Returns the number of detected markers used for multi-marker tracking
 	virtual int getNumDetectedMarkers() const = 0;
 
@@ -105,6 +132,35 @@ public:
 	virtual const ARMultiMarkerInfoT* getMultiMarkerConfig() const = 0;
 
 
+	/// Loads an additional multi-marker config file
+	/**
+	 *  All configs are tracked from the same set of detected markers, so marker
+	 *  detection only runs once per image no matter how many configs there are.
+	 *  On systems with more than one core the configs are posed on several threads.
+	 *  The config loaded by init() always has index 0, the returned index is
+	 *  used to query results for the new config. Returns -1 if loading failed.
+	 *  init() removes all additionally loaded configs.
+	 */
+	virtual int addMultiMarkerConfig(const char* nMultiFile) = 0;
+
+	/// Returns the number of loaded multi-marker configs
+	virtual int getNumMultiMarkerConfigs() const = 0;
+
+	/// Returns the nConfig'th multi-marker config or NULL if no such config exists
+	virtual const ARMultiMarkerInfoT* getMultiMarkerConfig(int nConfig) const = 0;
+
+	/// Returns true if a pose was found for the nConfig'th config in the last image
+	virtual bool isMultiMarkerConfigTracked(int nConfig) const = 0;
+
+	/// Returns the ARToolKit style transformation matrix of the nConfig'th config
+	virtual void getARMatrix(int nConfig, ARFloat nMatrix[3][4]) const = 0;
+
+	/// Returns the OpenGL style modelview matrix of the nConfig'th config
+	virtual const ARFloat* getModelViewMatrix(int nConfig) const = 0;
+
+	using Tracker::getModelViewMatrix;
+
+
 	/// Provides access to ARToolKit' internal version of the transformation matrix
 	/**
 	*  This method is primarily for compatibility issues with code previously using
@@ -88,6 +88,21 @@ public:
 	 */
 	virtual int calc(const unsigned char* nImage);
 
+	/// calculates the transformation matrix from a stereo image pair
+	/**
+	 *  see TrackerMultiMarker::calcStereo() for details.
+	 */
+	virtual int calcStereo(const unsigned char* nImageLeft, const unsigned char* nImageRight);
+
+	/// runs the detection half of calc()
+	/**
+	 *  see TrackerMultiMarker::calcDetect() for details.
+	 */
+	virtual int calcDetect(const unsigned char* nImage, ARMarkerInfo* nMarkers, int nMaxMarkers, bool* nMarkersUnchanged=NULL);
+
+	/// runs the pose half of calc() on markers found by calcDetect()
+	virtual int calcPose(ARMarkerInfo* nMarkers, int nNumMarkers, bool nMarkersUnchanged=false);
+
 	/// Returns the number of detected markers used for multi-marker tracking
 	virtual int getNumDetectedMarkers() const  {  return numDetected;  }
 
@@ -105,6 +120,18 @@ public:
 
 	virtual const ARMultiMarkerInfoT* getMultiMarkerConfig() const  {  return config;  }
 
+	virtual int addMultiMarkerConfig(const char* nMultiFile);
+
+	virtual int getNumMultiMarkerConfigs() const  {  return (int)configs.size();  }
+
+	virtual const ARMultiMarkerInfoT* getMultiMarkerConfig(int nConfig) const;
+
+	virtual bool isMultiMarkerConfigTracked(int nConfig) const;
+
+	virtual void getARMatrix(int nConfig, ARFloat nMatrix[3][4]) const;
+
+	virtual const ARFloat* getModelViewMatrix(int nConfig) const;
+
 	/// Provides access to ARToolKit' internal version of the transformation matrix
 	/**
 	*  This method is primarily for compatibility issues with code previously using
@@ -136,19 +163,40 @@ public:
 	int arFreePatt(int patno)  {  return AR_TEMPL_TRACKER::arFreePatt(patno);  }
 	int arMultiFreeConfig(ARMultiMarkerInfoT *config)  {  return AR_TEMPL_TRACKER::arMultiFreeConfig(config);  }
 	ARMultiMarkerInfoT *arMultiReadConfigFile(const char *filename)  {  return AR_TEMPL_TRACKER::arMultiReadConfigFile(filename);  }
+	int arMultiWriteConfigBundle(const char *nConfigFile, const char *nBundleFile)  {  return AR_TEMPL_TRACKER::arMultiWriteConfigBundle(nConfigFile, nBundleFile);  }
 	void activateBinaryMarker(int nThreshold)  {  AR_TEMPL_TRACKER::activateBinaryMarker(nThreshold);  }
 	void setMarkerMode(MARKER_MODE nMarkerMode)  {  AR_TEMPL_TRACKER::setMarkerMode(nMarkerMode);  }
 	void activateVignettingCompensation(bool nEnable, int nCorners=0, int nLeftRight=0, int nTopBottom=0)  {  AR_TEMPL_TRACKER::activateVignettingCompensation(nEnable, nCorners, nLeftRight, nTopBottom);  }
+	void activateAdaptiveThreshold(bool nEnable, int nWindowSize=0, int nOffsetPercent=15)  {  AR_TEMPL_TRACKER::activateAdaptiveThreshold(nEnable, nWindowSize, nOffsetPercent);  }
+	bool isAdaptiveThresholdActivated() const  {  return AR_TEMPL_TRACKER::isAdaptiveThresholdActivated();  }
+	void activateMultiThreshold(bool nEnable, int nNumThresholds=3, int nSpacing=32)  {  AR_TEMPL_TRACKER::activateMultiThreshold(nEnable, nNumThresholds, nSpacing);  }
+	bool isMultiThresholdActivated() const  {  return AR_TEMPL_TRACKER::isMultiThresholdActivated();  }
+	void activateMotionGate(bool nEnable, int nTolerance=8)  {  AR_TEMPL_TRACKER::activateMotionGate(nEnable, nTolerance);  }
+	bool isMotionGateActivated() const  {  return AR_TEMPL_TRACKER::isMotionGateActivated();  }
+	void activateCornerTracking(bool nEnable, int nMaxTrackedFrames=10)  {  AR_TEMPL_TRACKER::activateCornerTracking(nEnable, nMaxTrackedFrames);  }
+	bool isCornerTrackingActivated() const  {  return AR_TEMPL_TRACKER::isCornerTrackingActivated();  }
+	void activateDecodeCache(bool nEnable)  {  AR_TEMPL_TRACKER::activateDecodeCache(nEnable);  }
+	bool isDecodeCacheActivated() const  {  return AR_TEMPL_TRACKER::isDecodeCacheActivated();  }
+	void activateEarlyReject(bool nEnable, int nMinContrast=32)  {  AR_TEMPL_TRACKER::activateEarlyReject(nEnable, nMinContrast);  }
+	bool isEarlyRejectActivated() const  {  return AR_TEMPL_TRACKER::isEarlyRejectActivated();  }
+	int getNumEarlyRejects(EARLY_REJECT_REASON nReason) const  {  return AR_TEMPL_TRACKER::getNumEarlyRejects(nReason);  }
+	const FrameStats& getFrameStats() const  {  return AR_TEMPL_TRACKER::getFrameStats();  }
+	void getFrameStatsSummary(FrameStatsSummary& nSummary) const  {  AR_TEMPL_TRACKER::getFrameStatsSummary(nSummary);  }
+	void resetFrameStats()  {  AR_TEMPL_TRACKER::resetFrameStats();  }
 	void changeCameraSize(int nWidth, int nHeight)  {  AR_TEMPL_TRACKER::changeCameraSize(nWidth, nHeight);  }
 	void setUndistortionMode(UNDIST_MODE nMode)  {  AR_TEMPL_TRACKER::setUndistortionMode(nMode);  }
+	ARFloat getUndistGridError()  {  return AR_TEMPL_TRACKER::getUndistGridError();  }
 	bool setPoseEstimator(POSE_ESTIMATOR nMethod) {  return AR_TEMPL_TRACKER::setPoseEstimator(nMethod);  }
 	void setHullMode(HULL_TRACKING_MODE nMode)  {  AR_TEMPL_TRACKER::setHullMode(nMode);  }
+	void setMultiPoseEstimator(MULTI_POSE_ESTIMATOR nMethod)  {  AR_TEMPL_TRACKER::setMultiPoseEstimator(nMethod);  }
 	void setBorderWidth(ARFloat nFraction)  {  AR_TEMPL_TRACKER::setBorderWidth(nFraction);  }
 	void setThreshold(int nValue)  {  AR_TEMPL_TRACKER::setThreshold(nValue);  }
 	int getThreshold() const  {  return AR_TEMPL_TRACKER::getThreshold();  }
 	void activateAutoThreshold(bool nEnable)  {  AR_TEMPL_TRACKER::activateAutoThreshold(nEnable);  }
 	bool isAutoThresholdActivated() const  {  return AR_TEMPL_TRACKER::isAutoThresholdActivated();  }
 	void setNumAutoThresholdRetries(int nNumRetries)  {  AR_TEMPL_TRACKER::setNumAutoThresholdRetries(nNumRetries);  }
+	void setAutoThresholdMode(AUTO_THRESHOLD_MODE nMode)  {  AR_TEMPL_TRACKER::setAutoThresholdMode(nMode);  }
+	AUTO_THRESHOLD_MODE getAutoThresholdMode() const  {  return AR_TEMPL_TRACKER::getAutoThresholdMode();  }
 	const ARFloat* getModelViewMatrix() const  {  return AR_TEMPL_TRACKER::getModelViewMatrix();  }
 	const ARFloat* getProjectionMatrix() const  {  return AR_TEMPL_TRACKER::getProjectionMatrix();  }
 	const char* getDescription()  {  return AR_TEMPL_TRACKER::getDescription();  }
@@ -156,10 +204,14 @@ public:
 	int getBitsPerPixel() const  {  return static_cast<PIXEL_FORMAT>(AR_TEMPL_TRACKER::getBitsPerPixel());  }
 	int getNumLoadablePatterns() const  {  return AR_TEMPL_TRACKER::getNumLoadablePatterns();  }
 	void setImageProcessingMode(IMAGE_PROC_MODE nMode)  {  AR_TEMPL_TRACKER::setImageProcessingMode(nMode);  }
+	void setLabelBudget(int nMaxLabels)  {  AR_TEMPL_TRACKER::setLabelBudget(nMaxLabels);  }
+	int getLabelBudget() const  {  return AR_TEMPL_TRACKER::getLabelBudget();  }
 	Profiler& getProfiler()  {  return AR_TEMPL_TRACKER::getProfiler();  }
 	Camera* getCamera()  {  return AR_TEMPL_TRACKER::getCamera();  }
 	void setCamera(Camera* nCamera)  {  AR_TEMPL_TRACKER::setCamera(nCamera);  }
 	void setCamera(Camera* nCamera, ARFloat nNearClip, ARFloat nFarClip)  {  AR_TEMPL_TRACKER::setCamera(nCamera, nNearClip, nFarClip);  }
+	void setStereoCamera(Camera* nCamera, const ARFloat nRightFromLeft[3][4])  {  AR_TEMPL_TRACKER::setStereoCamera(nCamera, nRightFromLeft);  }
+	Camera* getStereoCamera()  {  return AR_TEMPL_TRACKER::getStereoCamera();  }
 	ARFloat calcOpenGLMatrixFromMarker(ARMarkerInfo* nMarkerInfo, ARFloat nPatternCenter[2], ARFloat nPatternSize, ARFloat *nOpenGLMatrix)  {  return AR_TEMPL_TRACKER::calcOpenGLMatrixFromMarker(nMarkerInfo, nPatternCenter, nPatternSize, nOpenGLMatrix);  }
 	ARFloat executeSingleMarkerPoseEstimator(ARMarkerInfo *marker_info, ARFloat center[2], ARFloat width, ARFloat conv[3][4])  {  return AR_TEMPL_TRACKER::executeSingleMarkerPoseEstimator(marker_info, center, width, conv);  }
 	ARFloat executeMultiMarkerPoseEstimator(ARMarkerInfo *marker_info, int marker_num, ARMultiMarkerInfoT *config)  {  return AR_TEMPL_TRACKER::executeMultiMarkerPoseEstimator(marker_info, marker_num, config);  }
@@ -171,14 +223,63 @@ public:
 
 	static size_t getMemoryRequirements();
 
+	// memory requirements for a nWidth x nHeight camera and a label budget (0 = automatic)
+	static size_t getMemoryRequirements(int nWidth, int nHeight, int nLabelBudget=0);
+
 protected:
 	int				numDetected;
 	bool			useDetectLite;
 
-	ARMultiMarkerInfoT  *config;
+	ARMultiMarkerInfoT  *config;					// same as configs[0].config
+
+	struct MultiConfig {
+		ARMultiMarkerInfoT	*config;
+		bool				tracked;
+		ARFloat				gl_para[16];
+	};
+
+	std::vector<MultiConfig>	configs;
+	size_t						numPosedConfigs;	// configs that were estimated on the last processed frame
+
+	void freeConfigs();
+
+	// poses configs[first..configs.size()), splitting them among up to numPoseThreads threads.
+	// nMarkersR is NULL for mono images, otherwise the configs get stereo poses where possible.
+	// returns true if any of the configs was found.
+	bool poseConfigs(size_t first, int nNumMarkers, ARMarkerInfo* nMarkersR, int nNumMarkersR);
+
+	// poses configs[first..last) from frameMarkers, nConfigMarkers is a copy the estimators may change
+	bool poseConfigRange(size_t first, size_t last, int nNumMarkers, ARMarkerInfo* nMarkersR, int nNumMarkersR,
+						 ARMarkerInfo* nConfigMarkers);
+
+	enum {
+		MAX_POSE_THREADS = 4		// including the calling thread
+	};
+
+	// a thread posing a range of configs with its own PoseState (see TrackerImpl::poseState())
+	struct PoseWorker {
+		typename AR_TEMPL_TRACKER::PoseState	state;
+		FrameStats		stats;
+		ARMarkerInfo	configMarkers[AR_TEMPL_TRACKER::MAX_IMAGE_PATTERNS];
+
+		TrackerMultiMarkerImpl	*tracker;
+		size_t			first, last;
+		int				numMarkers, numMarkersR;
+		ARMarkerInfo	*markersR;
+		bool			anyTracked;
+	};
+
+#ifdef AR_MULTI_POSE_USE_THREADS
+	static void* poseWorkerThread(void* nWorker);
+#endif
+
+	int				numPoseThreads;				// 1 if configs are posed on the calling thread only
+	PoseWorker		*poseWorkers;				// MAX_POSE_THREADS-1 of them, allocated on first use
 
 	int				detectedMarkerIDs[AR_TEMPL_TRACKER::MAX_IMAGE_PATTERNS];
 	ARMarkerInfo	detectedMarkers[AR_TEMPL_TRACKER::MAX_IMAGE_PATTERNS];
+	ARMarkerInfo	frameMarkers[AR_TEMPL_TRACKER::MAX_IMAGE_PATTERNS];		// markers of the frame being posed, left unchanged
+	ARMarkerInfo	configMarkers[AR_TEMPL_TRACKER::MAX_IMAGE_PATTERNS];	// per-config copy of the detected markers (calling thread)
 };
 
 
@@ -0,0 +1,210 @@
+/* ========================================================================
+* PROJECT: ARToolKitPlus
+* ========================================================================
+* This work is based on the original ARToolKit developed by
+*   Hirokazu Kato
+*   Mark Billinghurst
+*   HITLab, University of Washington, Seattle
+* http://www.hitl.washington.edu/artoolkit/
+*
+* Copyright of the derived and new portions of this work
+*     (C) 2006 Graz University of Technology
+*
+* This framework is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 2 of the License, or
+* (at your option) any later version.
+*
+* This framework is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this framework; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+* For further information please contact 
+*   Dieter Schmalstieg
+*   <schmalstieg@icg.tu-graz.ac.at>
+*   Graz University of Technology, 
+*   Institut for Computer Graphics and Vision,
+*   Inffeldgasse 16a, 8010 Graz, Austria.
+* ========================================================================
+** @author   Daniel Wagner
+*
+* $Id$
+* @file
+* ======================================================================== */
+
+#ifndef __ARTOOLKITPLUS_TRACKERPIPELINE_HEADERFILE__
+#define __ARTOOLKITPLUS_TRACKERPIPELINE_HEADERFILE__
+
+#include <ARToolKitPlus/TrackerSingleMarker.h>
+#include <ARToolKitPlus/TrackerMultiMarker.h>
+
+#if !defined(_MSC_VER) && !defined(_WIN32_WCE)
+#  include <pthread.h>
+#endif
+
+
+namespace ARToolKitPlus
+{
+
+
+/// Runs the detection and the pose estimation of a tracker on two threads
+/**
+ *  calc() blocks the caller until labeling, decoding and pose estimation are done.
+ *  TrackerPipeline splits it into calcDetect() and calcPose() (see TrackerSingleMarker)
+ *  and runs each half on its own thread, so the next image is already labeled while
+ *  the pose of the previous one is estimated:
+ *
+ *    submit() -> detection thread -> pose thread -> callback or poll()
+ *
+ *  Frames move through a ring of nQueueSize slots. Every stage owns one counter of the
+ *  ring and only waits for the counter of the stage before it, so each hand over is a
+ *  single producer / single consumer queue that needs no lock. Threads only sleep on a
+ *  condition variable while there is nothing to do. Markers and poses are written into
+ *  the slot of their frame and handed out from there without copies.
+ *
+ *  Results are the same as calling calc() for every image and arrive in the order the
+ *  images were submitted. submit() must always be called from the same thread, and so
+ *  must poll(). The tracker has to be fully set up (including all multi-marker configs)
+ *  before start() and must not be used directly until stop() returned. Images are not
+ *  copied: an image has to stay valid until its result has been delivered.
+ *
+ *  Without pthreads (Windows, Windows CE) submit() runs both stages immediately.
+ */
+class ARTOOLKITPLUS_API TrackerPipeline
+{
+public:
+	/// Result of one frame
+	struct Result {
+		unsigned int			frameId;		// as passed to submit()
+		double					timestamp;		// as passed to submit(), e.g. the capture time
+		const unsigned char*	image;			// the image passed to submit(), no longer used by the pipeline
+
+		int						result;			// what calc() returns for this image
+		ARFloat					confidence;		// confidence of the best marker (single marker tracker only)
+
+		int						numMarkers;		// markers found in the image, -1 if detection failed
+		ARMarkerInfo*			markers;
+
+		int						numPoses;		// 1 for a single marker tracker, the number of configs otherwise
+		bool*					tracked;		// whether a pose was found for a config in this image
+		ARFloat					(*trans)[3][4];	// see getARMatrix()
+		ARFloat					(*modelView)[16];	// see getModelViewMatrix()
+
+		double					submitTime,		// milliseconds (see getTime()) when the frame was submitted,
+								detectTime,		// when its detection started,
+								poseTime,		// when its pose estimation started
+								doneTime;		// and when the result was ready
+	};
+
+	/// Receives the results if set in start(); called on the pose thread
+	typedef void (*ResultCallback)(const Result& nResult, void* nUserData);
+
+
+	/// Creates a pipeline for a single marker tracker
+	/**
+	 *  nQueueSize is the number of frames that can be in the pipeline at once (including the
+	 *  result that was returned by poll() last). nMaxMarkers should be at least the tracker's
+	 *  __MAX_IMAGE_PATTERNS, otherwise markers can be missing compared to calc().
+	 */
+	TrackerPipeline(TrackerSingleMarker* nTracker, int nQueueSize=4, int nMaxMarkers=32);
+
+	/// Creates a pipeline for a multi marker tracker
+	TrackerPipeline(TrackerMultiMarker* nTracker, int nQueueSize=4, int nMaxMarkers=32);
+
+	/// Stops the pipeline
+	~TrackerPipeline();
+
+	/// Starts the detection and the pose thread
+	/**
+	 *  If nCallback is set every result is passed to it as soon as it is ready
+	 *  (and the slot is free again when the callback returns), otherwise results
+	 *  are queued for poll(). Returns false if the threads could not be created.
+	 */
+	bool start(ResultCallback nCallback=NULL, void* nUserData=NULL);
+
+	/// Waits until all submitted images are done and stops the threads
+	/**
+	 *  Results that were not polled yet can still be polled afterwards.
+	 */
+	void stop();
+
+	/// Returns true between start() and stop()
+	bool isRunning() const  {  return running;  }
+
+	/// Hands an image to the pipeline
+	/**
+	 *  Returns false if the pipeline is not running or all slots are in use. With nWait set
+	 *  submit() waits for a free slot instead; don't do this on the thread that calls poll().
+	 *  The image must stay valid until its result has been delivered.
+	 */
+	bool submit(const unsigned char* nImage, unsigned int nFrameId, double nTimestamp=0.0, bool nWait=false);
+
+	/// Returns the oldest result that has not been polled yet
+	/**
+	 *  Returns NULL if no result is ready. With nWait set poll() waits for the next result
+	 *  as long as frames are in the pipeline. The result stays valid until the next call
+	 *  of poll(), which gives its slot back to the pipeline. Always NULL if a callback is used.
+	 */
+	const Result* poll(bool nWait=false);
+
+	/// Returns the number of submitted frames whose results were not given back yet
+	int getNumPending() const;
+
+	/// Returns a time in milliseconds on the clock of Result::submitTime etc.
+	static double getTime();
+
+protected:
+	struct Slot {
+		Result	result;
+		bool	markersUnchanged;		// motion gate result of calcDetect()
+	};
+
+	void init(int nQueueSize, int nMaxMarkers);
+	void freeSlots();
+
+	void detect(Slot& nSlot);
+	void estimate(Slot& nSlot);
+
+	void advance(volatile unsigned int& nCounter);
+	void waitWhileEqual(volatile const unsigned int& nCounter, unsigned int nValue);
+
+	static void* detectThread(void* nPipeline);
+	static void* poseThread(void* nPipeline);
+
+	TrackerSingleMarker*	singleTracker;
+	TrackerMultiMarker*		multiTracker;
+
+	int						queueSize, maxMarkers, numPoses;
+	Slot*					slots;
+	ARMarkerInfo*			markerMemory;
+	bool*					trackedMemory;
+	ARFloat					(*transMemory)[3][4];
+	ARFloat					(*modelViewMemory)[16];
+
+	ResultCallback			callback;
+	void*					userData;
+
+	// frames submitted, detected, posed and given back so far; the slot of frame n is n%queueSize
+	volatile unsigned int	numSubmitted, numDetected, numPosed, numReleased;
+	bool					pollPending;	// the result returned by poll() last still holds its slot
+
+	volatile bool			running, quit;
+
+#if !defined(_MSC_VER) && !defined(_WIN32_WCE)
+	pthread_t				detector, estimator;
+	pthread_mutex_t			mutex;
+	pthread_cond_t			wakeup;
+	volatile unsigned int	numSleeping;
+#endif
+};
+
+
+}  // namespace ARToolKitPlus
+
+
+#endif //__ARTOOLKITPLUS_TRACKERPIPELINE_HEADERFILE__
@@ -88,6 +88,38 @@ public:
 	virtual int calc(const unsigned char* nImage, int nPattern=-1, bool nUpdateMatrix=true,
 			 ARMarkerInfo** nMarker_info=NULL, int* nNumMarkers=NULL) = 0;
 
+	/// calculates the transformation matrix from a stereo image pair
+	/**
+	 *  Like calc(), but nImageRight is the image the right camera (see setStereoCamera())
+	 *  took at the same time as nImageLeft. If the marker is also found in the right image
+	 *  its pose is estimated from both images, otherwise from the left image alone.
+	 *  nMarker_info and nNumMarkers return the markers of the left image.
+	 */
+	virtual int calcStereo(const unsigned char* nImageLeft, const unsigned char* nImageRight, int nPattern=-1,
+			 bool nUpdateMatrix=true, ARMarkerInfo** nMarker_info=NULL, int* nNumMarkers=NULL) = 0;
+
+	/// runs the detection half of calc()
+	/**
+	 *  Detects the markers in nImage and copies up to nMaxMarkers of them into nMarkers.
+	 *  nMarkersUnchanged receives whether the motion gate found the same markers as in the
+	 *  previous image. Returns the number of markers or -1 if detection failed.
+	 *
+	 *  calcDetect() followed by calcPose() gives the same result as calc(). The two halves
+	 *  share no state, so the detection of the next image may run on another thread while
+	 *  calcPose() works on the previous one (see TrackerPipeline). Each half must only be
+	 *  called from one thread at a time.
+	 */
+	virtual int calcDetect(const unsigned char* nImage, ARMarkerInfo* nMarkers, int nMaxMarkers,
+			 bool* nMarkersUnchanged=NULL) = 0;
+
+	/// runs the pose half of calc() on markers found by calcDetect()
+	/**
+	 *  Selects the best marker as calc() does and estimates its pose. nMarkers may be
+	 *  modified. Returns the id of the marker or -1 if none was accepted.
+	 */
+	virtual int calcPose(ARMarkerInfo* nMarkers, int nNumMarkers, bool nMarkersUnchanged=false,
+			 int nPattern=-1, bool nUpdateMatrix=true) = 0;
+
 	/// Sets the width and height of the patterns.
 	virtual void setPatternWidth(ARFloat nWidth) = 0;
 
@@ -63,6 +63,19 @@ typedef struct {
     int     visibleR;
 } ARMultiEachMarkerInfoT;
 
+typedef struct {
+    ARFloat   pos[4][2];
+    ARFloat   thresh;
+    ARFloat   err;
+    int      marker;
+    int      dir;
+} arMultiEachMarkerInternalInfoT;
+
+typedef struct {
+    ARFloat   cx;
+    int      marker;
+} arMultiSortedMarkerT;
+
 typedef struct {
     ARMultiEachMarkerInfoT  *marker;
     int                     marker_num;
@@ -70,9 +83,125 @@ typedef struct {
     int                     prevF;
 /*---*/
     ARFloat                  transR[3][4];
+
+/*--- added for large boards: built by arMultiCreateConfigIndex() when the config is read, or when a
+      config built by the application is first used. the tracker records the configs it indexed ---*/
+    int                     *idIndex;       // dense patt_id -> first config index (-1 if unused)
+    int                     *idNext;        // next config index with the same patt_id (-1 terminates)
+    int                     maxPattId;      // size of idIndex is maxPattId+1
+
+    ARFloat                 *pos2d;         // [marker_num*4*2] work buffer for arMultiGetTransMat()
+    ARFloat                 *pos3d;         // [marker_num*4*3] work buffer for arMultiGetTransMat()
+    arMultiEachMarkerInternalInfoT *winfo;  // [marker_num] work buffer for verify_markers()
+    int                     *matchIdx;      // [marker_num] work buffer: detected marker per config entry
+    arMultiSortedMarkerT    *sorted;        // [sortedSize] work buffer: detected markers sorted by x
+    int                     sortedSize;
+
+/*--- set if the config was loaded from a binary bundle (see ARMultiBundleHeaderT) ---*/
+    void                    *bundle;        // mapped (or read) bundle file; marker points into it
+    long                    bundleSize;
 } ARMultiMarkerInfoT;
 
 
+#define AR_MULTI_BUNDLE_MAGIC    "ARTKPMB"
+#define AR_MULTI_BUNDLE_VERSION  1
+#define AR_MULTI_BUNDLE_ENDIAN   0x01020304
+#define AR_MULTI_BUNDLE_MAX_PATTERN_SIZE  1024   // pattern width/height a bundle may declare
+
+
+/// Header of a binary multi-marker config bundle
+/**
+ *  A bundle is a precompiled multi-marker config which can be mapped into
+ *  memory and used directly instead of parsing a text config and its
+ *  pattern files. It is laid out as:
+ *
+ *    ARMultiBundleHeaderT
+ *    ARMultiEachMarkerInfoT[markerNum]     (itrans and pos3d precomputed)
+ *    int32_t patternRef[markerNum]         (-1: patt_id is a marker id, else bundle pattern index)
+ *    pattern records[patternNum]           (see arMultiBundlePatternSize())
+ *
+ *  Every section starts at an 8 byte aligned offset. The bundle is only valid
+ *  for the ARFloat type, byte order and pattern size it was written with;
+ *  those are stored in the header and checked when loading.
+ *  Bundles are written by TrackerImpl::arMultiWriteConfigBundle().
+ */
+typedef struct {
+    char        magic[8];
+    uint32_t    version;
+    uint32_t    endianTag;
+    uint32_t    floatSize;          // sizeof(ARFloat)
+    uint32_t    markerInfoSize;     // sizeof(ARMultiEachMarkerInfoT)
+    int32_t     patternWidth;
+    int32_t     patternHeight;
+    int32_t     binaryThreshold;    // binary marker threshold the patterns were converted with (-1: none)
+    int32_t     markerNum;
+    int32_t     patternNum;
+    uint32_t    markerOffset;
+    uint32_t    patternRefOffset;
+    uint32_t    patternOffset;
+    uint32_t    fileSize;
+    uint32_t    reserved;
+} ARMultiBundleHeaderT;
+
+
+/// Rounds a bundle section offset up to the next 8 byte boundary
+inline uint32_t
+arMultiBundleAlign(uint32_t nOffset)
+{
+    return (nOffset+7) & ~7u;
+}
+
+
+/// Size of one pattern record in a bundle
+/**
+ *  A record stores what arLoadPatt() computes for all 4 rotations:
+ *  int pat[4][w*h*3], int patBW[4][w*h], ARFloat patpow[4], ARFloat patpowBW[4]
+ *  nWidth and nHeight must not exceed AR_MULTI_BUNDLE_MAX_PATTERN_SIZE.
+ */
+inline uint32_t
+arMultiBundlePatternSize(int nWidth, int nHeight, int nFloatSize)
+{
+    return arMultiBundleAlign((uint32_t)(4*nWidth*nHeight*3*sizeof(int32_t) + 4*nWidth*nHeight*sizeof(int32_t) + 8*nFloatSize));
+}
+
+
+/// Returns the index of the first config entry using patt_id or -1 if the id is not part of the config
+/**
+ *  Configs with ids above the range of the index table have no table;
+ *  for those a linear search is done. Only called for indexed configs.
+ */
+inline int
+arMultiGetConfigIndex(const ARMultiMarkerInfoT *config, int patt_id)
+{
+    if( patt_id < 0 ) return -1;
+
+    if( config->idIndex == NULL ) {
+        for( int i = 0; i < config->marker_num; i++ ) {
+            if( config->marker[i].patt_id == patt_id ) return i;
+        }
+        return -1;
+    }
+
+    if( patt_id > config->maxPattId ) return -1;
+    return config->idIndex[patt_id];
+}
+
+
+/// Returns the next config entry sharing the patt_id of config entry nIdx or -1
+inline int
+arMultiGetNextConfigIndex(const ARMultiMarkerInfoT *config, int nIdx)
+{
+    if( config->idNext == NULL ) {
+        for( int i = nIdx+1; i < config->marker_num; i++ ) {
+            if( config->marker[i].patt_id == config->marker[nIdx].patt_id ) return i;
+        }
+        return -1;
+    }
+
+    return config->idNext[nIdx];
+}
+
+
 } // namespace ARToolKitPlus
 
 
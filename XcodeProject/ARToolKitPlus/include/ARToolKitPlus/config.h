@@ -55,8 +55,16 @@
 	typedef float ARFloat;
 #endif
 
-// disable the custom memory manager
+// the custom memory manager (setMemoryManager()) is compiled in everywhere
+// but on Windows, Apple/iOS included: it is how an application hands the
+// tracker tables to a MemoryManagerArena. nothing changes unless a manager
+// is set, memManager starts out NULL and artkp_Alloc()/artkp_Free() then
+// use plain malloc/free. on Windows the library is a DLL and memManager,
+// which the tracker templates use from the application's module, is not
+// exported, so it stays disabled there.
+#if defined(_MSC_VER) || defined(_WIN32_WCE)
 #define _ARTKP_NO_MEMORYMANAGER_
+#endif
 
 /**
  * Endianness:
@@ -182,9 +190,9 @@
 #define   EVEC_MAX     10
 #define	  P_MAX       500
 
-// this defines the maximum screen width that
-// can be processed by artoolkit...
-// memory consumption (if static) is: 2*width*height bytes
+// image size that is assumed by getMemoryRequirements() without
+// arguments. the labeling buffers are sized from the actual camera
+// image at runtime, so larger images can still be processed...
 #ifdef _WIN32_WCE
   #define MAX_BUFFER_WIDTH  320
   #define MAX_BUFFER_HEIGHT 240
@@ -196,13 +204,13 @@
 //#define WORK_SIZE   1024*32
 
 
-//#define SMALL_LUM8_TABLE
+// RGB565 to gray: (2*red + 5*green + blue)/8 of the 8-bit channel values.
+// since the channels are stored with their low bits cut off this is
+// 2*r5 + 2*g6 + g6/2 + b5, which splits into one static 256 entry table
+// per byte (RGB565_to_LUM8_hi/lo in TrackerImpl.h)
+#define RGB565_to_LUM8(pix)   ((unsigned char)(RGB565_to_LUM8_hi[(pix)>>8] + RGB565_to_LUM8_lo[(pix)&0xff]))
 
-#ifdef SMALL_LUM8_TABLE
-  #define getLUM8_from_RGB565(ptr)   RGB565_to_LUM8_LUT[ (*(unsigned short*)(ptr))>>6 ]
-#else
-  #define getLUM8_from_RGB565(ptr)   RGB565_to_LUM8_LUT[ (*(unsigned short*)(ptr))    ]
-#endif //SMALL_LUM8_TABLE
+#define getLUM8_from_RGB565(ptr)   RGB565_to_LUM8(*(const unsigned short*)(ptr))
 
 
 #if defined(_MSC_VER) || defined(_WIN32_WCE)
@@ -100,29 +100,27 @@ class BCH
 
 
 	protected:
-		BCH(int _m, int _length, int _t);
-		void initialize(int _m, int _length, int _t);
-		void generate_gf();
-		bool gen_poly(int _t);
 		void encode_bch(int *bb, const int *data); // int bb[length - k], data[k]
 		int decode_bch(int *recd);
 
 		int t;
 		int             m, n, length, k, d;
-		
-		std::vector<int> p;
-		std::vector<int> alpha_to;
-		std::vector<int> index_of;
-		std::vector<int> g;
-
-		std::vector<std::vector<int> > _elp;
-		std::vector<int> _d;
-		std::vector<int> _l;
-		std::vector<int> _u_lu;
-		std::vector<int> _s;
-		std::vector<int> _root;
-		std::vector<int> _loc;
-		std::vector<int> _reg;
+
+		// GF(2**m) lookup tables and generator polynomial of the
+		// default code, precomputed and shared by all instances
+		static const int alpha_to[BCH_MAX_LUT];
+		static const int index_of[BCH_MAX_LUT];
+		static const int g[BCH_MAX_LUT];
+
+		// decoder work space
+		int _elp[BCH_MAX_LUT][BCH_MAX_LUT];
+		int _d[BCH_MAX_LUT];
+		int _l[BCH_MAX_LUT];
+		int _u_lu[BCH_MAX_LUT];
+		int _s[BCH_MAX_LUT];
+		int _root[BCH_MAX_LUT];
+		int _loc[BCH_MAX_LUT];
+		int _reg[BCH_MAX_LUT];
 };
 
 
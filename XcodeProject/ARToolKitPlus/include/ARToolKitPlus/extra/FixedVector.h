@@ -0,0 +1,95 @@
+/* ========================================================================
+* PROJECT: ARToolKitPlus
+* ========================================================================
+* This work is based on the original ARToolKit developed by
+*   Hirokazu Kato
+*   Mark Billinghurst
+*   HITLab, University of Washington, Seattle
+* http://www.hitl.washington.edu/artoolkit/
+*
+* Copyright of the derived and new portions of this work
+*     (C) 2006 Graz University of Technology
+*
+* This framework is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 2 of the License, or
+* (at your option) any later version.
+*
+* This framework is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this framework; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+* For further information please contact 
+*   Dieter Schmalstieg
+*   <schmalstieg@icg.tu-graz.ac.at>
+*   Graz University of Technology, 
+*   Institut for Computer Graphics and Vision,
+*   Inffeldgasse 16a, 8010 Graz, Austria.
+* ========================================================================
+** @author   Daniel Wagner
+*
+* $Id$
+* @file
+* ======================================================================== */
+
+
+#ifndef __ARTOOLKITPLUS_FIXEDVECTOR_HEADERFILE__
+#define __ARTOOLKITPLUS_FIXEDVECTOR_HEADERFILE__
+
+
+#include <assert.h>
+
+
+namespace ARToolKitPlus {
+
+
+/// Vector with a capacity fixed at compile time
+/**
+ *  Used in places that run once per frame and would otherwise allocate
+ *  a std::vector each time. push_back() ignores elements beyond the
+ *  capacity and returns false for them.
+ */
+template <typename T, int CAPACITY>
+class FixedVector
+{
+public:
+	FixedVector() : num(0)
+	{}
+
+	bool push_back(const T& nValue)
+	{
+		if(num>=CAPACITY)
+			return false;
+		data[num++] = nValue;
+		return true;
+	}
+
+	void clear()  {  num = 0;  }
+
+	int size() const  {  return num;  }
+
+	int capacity() const  {  return CAPACITY;  }
+
+	bool empty() const  {  return num==0;  }
+
+	bool full() const  {  return num>=CAPACITY;  }
+
+	T& operator[](int nIdx)  {  assert(nIdx>=0 && nIdx<num);  return data[nIdx];  }
+
+	const T& operator[](int nIdx) const  {  assert(nIdx>=0 && nIdx<num);  return data[nIdx];  }
+
+protected:
+	T		data[CAPACITY];
+	int		num;
+};
+
+
+}  // namespace ARToolKitPlus
+
+
+#endif //__ARTOOLKITPLUS_FIXEDVECTOR_HEADERFILE__
@@ -46,7 +46,7 @@ namespace ARToolKitPlus {
 
 
 enum {
-	MAX_HULL_POINTS = 64		// support up to 16 visible markers
+	MAX_HULL_POSE_POINTS = 16	// max. number of hull corners passed to the pose estimator in HULL_FULL mode
 };
 
 struct MarkerPoint
@@ -67,6 +67,23 @@ inline int iabs(int nValue)
 
 int nearHull_2D(const MarkerPoint* P, int n, int k, MarkerPoint* H);
 
+/// Computes the exact convex hull in O(n log n) (Andrew's monotone chain)
+/**
+ *  P[] gets sorted in place. H[] must provide space for n+1 points. The
+ *  hull is returned in the same orientation as nearHull_2D() creates it,
+ *  but without repeating the first point at the end.
+ */
+int convexHull_2D(MarkerPoint* P, int n, MarkerPoint* H);
+
+/// Selects up to nMaxPoints points which are spread as far as possible
+/**
+ *  Does farthest point sampling starting at the longest diameter, which keeps
+ *  the selection well conditioned for pose estimation. nIndices receives the
+ *  selected indices in ascending order (hence in hull order if nPoints is a hull).
+ *  nWork must provide space for nNumPoints integers.
+ */
+int selectSpreadPoints(const MarkerPoint* nPoints, int nNumPoints, int nMaxPoints, int* nIndices, int* nWork);
+
 void findLongestDiameter(const MarkerPoint* nPoints, int nNumPoints, int &nIdx0, int &nIdx1);
 
 void findFurthestAway(const MarkerPoint* nPoints, int nNumPoints, int nIdx0, int nIdx1, int& nIdxFarthest);
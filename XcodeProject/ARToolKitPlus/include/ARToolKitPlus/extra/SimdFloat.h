@@ -0,0 +1,205 @@
+/* ========================================================================
+* PROJECT: ARToolKitPlus
+* ========================================================================
+* This work is based on the original ARToolKit developed by
+*   Hirokazu Kato
+*   Mark Billinghurst
+*   HITLab, University of Washington, Seattle
+* http://www.hitl.washington.edu/artoolkit/
+*
+* Copyright of the derived and new portions of this work
+*     (C) 2006 Graz University of Technology
+*
+* This framework is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 2 of the License, or
+* (at your option) any later version.
+*
+* This framework is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this framework; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+* For further information please contact 
+*   Dieter Schmalstieg
+*   <schmalstieg@icg.tu-graz.ac.at>
+*   Graz University of Technology, 
+*   Institut for Computer Graphics and Vision,
+*   Inffeldgasse 16a, 8010 Graz, Austria.
+* ========================================================================
+** @author   Daniel Wagner
+*
+* $Id$
+* @file
+* ======================================================================== */
+
+
+
+#ifndef __ARTOOLKITPLUS_SIMDFLOAT_HEADERFILE__
+#define __ARTOOLKITPLUS_SIMDFLOAT_HEADERFILE__
+
+
+#include <math.h>
+#include <ARToolKitPlus/config.h>
+
+#if !defined(_USE_DOUBLE_) && !defined(ARTOOLKITPLUS_NO_SIMD)
+#  if defined(__AVX2__)
+#    include <immintrin.h>
+#    define ARTOOLKITPLUS_SIMD_AVX2
+#  elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#    include <arm_neon.h>
+#    define ARTOOLKITPLUS_SIMD_NEON
+#  endif
+#endif
+
+
+namespace ARToolKitPlus {
+
+
+/// Single ARFloat with the interface of SimdFloat
+/**
+ *  Kernels are written once as templates over the value type and are
+ *  instantiated with SimdFloat for the bulk of an array and with
+ *  SimdScalar for the remaining elements.
+ */
+struct SimdScalar
+{
+	enum { WIDTH = 1 };
+
+	ARFloat v;
+
+	SimdScalar()  {}
+	SimdScalar(ARFloat nValue) : v(nValue)  {}
+
+	static SimdScalar load(const ARFloat* nPtr)  {  return SimdScalar(*nPtr);  }
+	void store(ARFloat* nPtr) const  {  *nPtr = v;  }
+
+	friend SimdScalar operator+(SimdScalar a, SimdScalar b)  {  return SimdScalar(a.v+b.v);  }
+	friend SimdScalar operator-(SimdScalar a, SimdScalar b)  {  return SimdScalar(a.v-b.v);  }
+	friend SimdScalar operator*(SimdScalar a, SimdScalar b)  {  return SimdScalar(a.v*b.v);  }
+	friend SimdScalar operator/(SimdScalar a, SimdScalar b)  {  return SimdScalar(a.v/b.v);  }
+
+	static SimdScalar sqrt(SimdScalar a)  {  return SimdScalar((ARFloat)::sqrt(a.v));  }
+	static SimdScalar abs(SimdScalar a)  {  return SimdScalar((ARFloat)::fabs(a.v));  }
+
+	/// a>b ? x : y, per element
+	static SimdScalar selectGreater(SimdScalar a, SimdScalar b, SimdScalar x, SimdScalar y)  {  return a.v>b.v ? x : y;  }
+
+	/// true if a>b for any element
+	static bool anyGreater(SimdScalar a, SimdScalar b)  {  return a.v>b.v;  }
+};
+
+
+#if defined(ARTOOLKITPLUS_SIMD_AVX2)
+
+/// 8 floats in an AVX register
+struct SimdFloat
+{
+	enum { WIDTH = 8 };
+
+	__m256 v;
+
+	SimdFloat()  {}
+	SimdFloat(__m256 nValue) : v(nValue)  {}
+	SimdFloat(float nValue) : v(_mm256_set1_ps(nValue))  {}
+
+	static SimdFloat load(const float* nPtr)  {  return SimdFloat(_mm256_loadu_ps(nPtr));  }
+	void store(float* nPtr) const  {  _mm256_storeu_ps(nPtr, v);  }
+
+	friend SimdFloat operator+(SimdFloat a, SimdFloat b)  {  return SimdFloat(_mm256_add_ps(a.v, b.v));  }
+	friend SimdFloat operator-(SimdFloat a, SimdFloat b)  {  return SimdFloat(_mm256_sub_ps(a.v, b.v));  }
+	friend SimdFloat operator*(SimdFloat a, SimdFloat b)  {  return SimdFloat(_mm256_mul_ps(a.v, b.v));  }
+	friend SimdFloat operator/(SimdFloat a, SimdFloat b)  {  return SimdFloat(_mm256_div_ps(a.v, b.v));  }
+
+	static SimdFloat sqrt(SimdFloat a)  {  return SimdFloat(_mm256_sqrt_ps(a.v));  }
+	static SimdFloat abs(SimdFloat a)  {  return SimdFloat(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v));  }
+
+	static SimdFloat selectGreater(SimdFloat a, SimdFloat b, SimdFloat x, SimdFloat y)
+	{
+		return SimdFloat(_mm256_blendv_ps(y.v, x.v, _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)));
+	}
+
+	static bool anyGreater(SimdFloat a, SimdFloat b)
+	{
+		return _mm256_movemask_ps(_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)) != 0;
+	}
+};
+
+#elif defined(ARTOOLKITPLUS_SIMD_NEON)
+
+/// 4 floats in a NEON register
+struct SimdFloat
+{
+	enum { WIDTH = 4 };
+
+	float32x4_t v;
+
+	SimdFloat()  {}
+	SimdFloat(float32x4_t nValue) : v(nValue)  {}
+	SimdFloat(float nValue) : v(vdupq_n_f32(nValue))  {}
+
+	static SimdFloat load(const float* nPtr)  {  return SimdFloat(vld1q_f32(nPtr));  }
+	void store(float* nPtr) const  {  vst1q_f32(nPtr, v);  }
+
+	friend SimdFloat operator+(SimdFloat a, SimdFloat b)  {  return SimdFloat(vaddq_f32(a.v, b.v));  }
+	friend SimdFloat operator-(SimdFloat a, SimdFloat b)  {  return SimdFloat(vsubq_f32(a.v, b.v));  }
+	friend SimdFloat operator*(SimdFloat a, SimdFloat b)  {  return SimdFloat(vmulq_f32(a.v, b.v));  }
+
+	friend SimdFloat operator/(SimdFloat a, SimdFloat b)
+	{
+#ifdef __aarch64__
+		return SimdFloat(vdivq_f32(a.v, b.v));
+#else
+		// ARMv7 has no divide: reciprocal estimate plus two Newton-Raphson steps
+		float32x4_t r = vrecpeq_f32(b.v);
+		r = vmulq_f32(vrecpsq_f32(b.v, r), r);
+		r = vmulq_f32(vrecpsq_f32(b.v, r), r);
+		return SimdFloat(vmulq_f32(a.v, r));
+#endif
+	}
+
+	static SimdFloat sqrt(SimdFloat a)
+	{
+#ifdef __aarch64__
+		return SimdFloat(vsqrtq_f32(a.v));
+#else
+		// sqrt(a) = a * 1/sqrt(a); zero has to be handled explicitly (0*inf)
+		float32x4_t r = vrsqrteq_f32(a.v);
+		r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a.v, r), r), r);
+		r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a.v, r), r), r);
+		uint32x4_t nonZero = vcgtq_f32(a.v, vdupq_n_f32(0.0f));
+		return SimdFloat(vbslq_f32(nonZero, vmulq_f32(a.v, r), vdupq_n_f32(0.0f)));
+#endif
+	}
+
+	static SimdFloat abs(SimdFloat a)  {  return SimdFloat(vabsq_f32(a.v));  }
+
+	static SimdFloat selectGreater(SimdFloat a, SimdFloat b, SimdFloat x, SimdFloat y)
+	{
+		return SimdFloat(vbslq_f32(vcgtq_f32(a.v, b.v), x.v, y.v));
+	}
+
+	static bool anyGreater(SimdFloat a, SimdFloat b)
+	{
+		uint32x4_t m = vcgtq_f32(a.v, b.v);
+		uint32x2_t m2 = vorr_u32(vget_low_u32(m), vget_high_u32(m));
+		return (vget_lane_u32(m2, 0) | vget_lane_u32(m2, 1)) != 0;
+	}
+};
+
+#else
+
+// no vector unit available (or ARFloat is double)
+typedef SimdScalar SimdFloat;
+
+#endif
+
+
+}  // namespace ARToolKitPlus
+
+
+#endif //__ARTOOLKITPLUS_SIMDFLOAT_HEADERFILE__
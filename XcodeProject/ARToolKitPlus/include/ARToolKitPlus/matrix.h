@@ -61,6 +61,9 @@
 namespace ARToolKitPlus {
 
 
+class MemoryManagerArena;
+
+
 struct ARMat {
 	ARFloat *m;
 	int row;
@@ -81,6 +84,12 @@ namespace Matrix {
 static ARMat  *alloc(int row, int clm);
 static int    free(ARMat *m);
 
+// allocate from an arena (heap if arena is NULL); free() on arena memory is a no-op,
+// it is released by rewinding the arena
+static ARMat  *alloc(MemoryManagerArena *arena, int row, int clm);
+static int    free(MemoryManagerArena *arena, ARMat *m);
+static ARMat  *allocDup(MemoryManagerArena *arena, ARMat *source);
+
 static int    dup(ARMat *dest, ARMat *source);
 static ARMat  *allocDup(ARMat *source);
 
@@ -49,6 +49,7 @@ namespace ARToolKitPlus {
 
 
 struct ARMat;
+class MemoryManagerArena;
 
 
 struct ARVec {
@@ -60,6 +61,8 @@ struct ARVec {
 namespace Vector {
 	static ARVec  *alloc( int clm );
 	static int    free( ARVec *v );
+	static ARVec  *alloc( MemoryManagerArena *arena, int clm );
+	static int    free( MemoryManagerArena *arena, ARVec *v );
         // static int    disp( ARVec *v );
 	static ARFloat household( ARVec *x );
 	static ARFloat innerproduct( ARVec *x, ARVec *y );
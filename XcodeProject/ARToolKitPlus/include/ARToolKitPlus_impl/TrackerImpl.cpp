@@ -38,6 +38,7 @@
  * ======================================================================== */
 
 
+#include <string.h>
 #include <ARToolKitPlus/Tracker.h>
 #include <ARToolKitPlus/TrackerImpl.h>
 
@@ -63,7 +64,6 @@ AR_TEMPL_TRACKER::TrackerImpl()
 #  ifdef WIN32
 #    pragma message(">>> using SinCos LUT")
 #  endif
-	Fixed28_Init();
 #  else
 #    ifdef WIN32
 #      pragma message(">>> not using SinCos LUT")
@@ -77,8 +77,17 @@ AR_TEMPL_TRACKER::TrackerImpl()
 
 	binaryMarkerThreshold = -1;
 
+	logger = NULL;
+
 	autoThreshold.enable = false;
-	autoThreshold.numRandomRetries = 2;
+	autoThreshold.numRetries = 2;
+	autoThreshold.mode = AUTO_THRESHOLD_RANDOM;
+	autoThreshold.numCandidates = 0;
+#ifdef AR_AUTO_THRESHOLD_USE_THREADS
+	autoThreshold.parallel = sysconf(_SC_NPROCESSORS_ONLN)>1;
+#else
+	autoThreshold.parallel = false;
+#endif //AR_AUTO_THRESHOLD_USE_THREADS
 
 	wmarker_num = 0;
 	prev_num = 0;
@@ -96,12 +105,27 @@ AR_TEMPL_TRACKER::TrackerImpl()
 	//
 	l_imageL = NULL;
 	l_imageL_size = 0;
+	labelSize = sizeof(int16_t);
+	labelBudget = 0;
+	labelLimit = LABEL_MAX_16BIT;
+	labelMaskBit = 1;
+	labelRegion.active = false;
 
-	workL = artkp_Alloc<int>(WORK_SIZE);
-	work2L = artkp_Alloc<int>(WORK_SIZE*7);
-	wareaL = artkp_Alloc<int>(WORK_SIZE);
-	wclipL = artkp_Alloc<int>(WORK_SIZE*4);
-	wposL = artkp_Alloc<ARFloat>(WORK_SIZE*2);
+	// the work tables grow on demand (see growLabelTables())
+	//
+	labelCapacity = LABEL_INITIAL_CAPACITY;
+	workL = artkp_Alloc<int>(labelCapacity);
+	work2L = artkp_Alloc<int>(labelCapacity*7);
+	wareaL = artkp_Alloc<int>(labelCapacity);
+	wclipL = artkp_Alloc<int>(labelCapacity*4);
+	wposL = artkp_Alloc<ARFloat>(labelCapacity*2);
+
+	frameScratch.init(FRAME_SCRATCH_SIZE, FRAME_SCRATCH_SIZE);
+	pose.scratch.init(POSE_SCRATCH_SIZE, POSE_SCRATCH_SIZE);
+	pose.stats = &frameStats.frame;
+#ifdef AR_MULTI_POSE_USE_THREADS
+	pthread_key_create(&poseKey, NULL);
+#endif
 
 	//workL = new int[WORK_SIZE];
 	//work2L = new int[WORK_SIZE*7];
@@ -111,12 +135,15 @@ AR_TEMPL_TRACKER::TrackerImpl()
 
 
 	// set all right side structures to NULL
+	// (they are allocated when stereo tracking is turned on, see checkImageBuffer())
 	l_imageR = NULL;
 	workR = NULL;
 	work2R = NULL;
 	wareaR = NULL;
 	wclipR = NULL;
 	wposR = NULL;
+	labelCapacityR = 0;
+	wlabel_numR = 0;
 
 	//arDebug                 = 0;
 	//arImage                 = NULL;
@@ -134,8 +161,6 @@ AR_TEMPL_TRACKER::TrackerImpl()
 
 	markerMode = MARKER_TEMPLATE;
 
-	RGB565_to_LUM8_LUT = NULL;
-
 	relBorderWidth = 0.25f;
 
 	// undistortion addon by Daniel
@@ -143,6 +168,19 @@ AR_TEMPL_TRACKER::TrackerImpl()
 	undistMode = UNDIST_STD;
 	undistO2ITable = NULL;
 	//undistI2OTable = NULL;
+	undistO2ITileReady = NULL;
+	undistO2INumTiles = 0;
+#ifdef UNDIST_LUT_USE_THREADS
+	pthread_mutex_init(&undistLock, NULL);
+#endif
+	undistO2IMap = NULL;
+	undistO2IMapSize = 0;
+	undistGrid = NULL;
+	undistGridStep = 0;
+	undistGridInvStep = 0;
+	undistGridError = -1;
+	undistGridW = undistGridH = 0;
+	undistGridReady = 0;
 	arParamObserv2Ideal_func = &AR_TEMPL_TRACKER::arParamObserv2Ideal_std;
 	//arParamIdeal2Observ_func = arParamIdeal2Observ_std;
 
@@ -151,14 +189,56 @@ AR_TEMPL_TRACKER::TrackerImpl()
 	vignetting.leftright = 
 	vignetting.bottomtop = 0;
 
+	adaptiveThreshold.enabled = false;
+	adaptiveThreshold.windowSize = 0;
+	adaptiveThreshold.offsetPercent = 15;
+
+	multiThreshold.enabled = false;
+	multiThreshold.num = 3;
+	multiThreshold.spacing = 32;
+
+	motionGate.enabled = false;
+	motionGate.tolerance = 8;
+	motionGate.state = MotionGate::FRAME_FULL;
+	motionGate.markersUnchanged = false;
+	motionGate.reference = NULL;
+	motionGate.blocks = NULL;
+	motionGate.blocksX = motionGate.blocksY = 0;
+	motionGate.valid = false;
+	motionGate.numDetected = motionGate.numOutput = 0;
+
+	cornerTracking.enabled = false;
+	cornerTracking.maxFrames = 10;
+	cornerTracking.numFrames = 0;
+	cornerTracking.tracked = cornerTracking.valid = false;
+	cornerTracking.memory = NULL;
+	cornerTracking.width[0] = cornerTracking.height[0] = 0;
+	cornerTracking.prev = 0;
+	cornerTracking.numMarkers = 0;
+
+	decodeCache.enabled = true;
+	decodeCache.numHistory = 0;
+	decodeCache.predictedId = -1;
+	decodeCache.predictedDir = 0;
+	decodeCache.predictedCf = 0.0f;
+
+	earlyReject.enabled = false;
+	earlyReject.minContrast = 32;
+	memset(earlyReject.numRejected, 0, sizeof(earlyReject.numRejected));
+
+	resetFrameStats();
+
+	stereo.camera = NULL;
+
 	bchProcessor = NULL;
 
 	// RPP integration -- [t.pintaric]
 	poseEstimator = POSE_ESTIMATOR_ORIGINAL;
 	
 	hullTrackingMode = HULL_OFF;
+	multiPoseEstimator = MULTI_POSE_ESTIMATOR_DEFAULT;
 
-	descriptionString = new char[512];
+	descriptionString[0] = 0;
 
 	profiler.reset();
 }
@@ -171,6 +251,10 @@ AR_TEMPL_TRACKER::~TrackerImpl()
 		delete arCamera;
 	arCamera = NULL;
 
+	if(stereo.camera)
+		delete stereo.camera;
+	stereo.camera = NULL;
+
 	if(bchProcessor)
 		delete bchProcessor;
 	bchProcessor = NULL;
@@ -199,17 +283,23 @@ AR_TEMPL_TRACKER::~TrackerImpl()
 		artkp_Free(wposL);
 	wposL = NULL;
 
-	if(RGB565_to_LUM8_LUT)
-		artkp_Free(RGB565_to_LUM8_LUT);
-	RGB565_to_LUM8_LUT = NULL;
+	freeStereoBuffers();
 
-	if(undistO2ITable)
-		artkp_Free(undistO2ITable);
-	undistO2ITable = NULL;
+	if(motionGate.reference)
+		artkp_Free(motionGate.reference);
+	motionGate.reference = NULL;
 
-	if(descriptionString)
-		delete [] descriptionString;
-	descriptionString = NULL;
+	if(cornerTracking.memory)
+		artkp_Free(cornerTracking.memory);
+	cornerTracking.memory = NULL;
+
+	freeUndistTables();
+#ifdef UNDIST_LUT_USE_THREADS
+	pthread_mutex_destroy(&undistLock);
+#endif
+#ifdef AR_MULTI_POSE_USE_THREADS
+	pthread_key_delete(poseKey);
+#endif
 }
 
 
@@ -255,17 +345,136 @@ AR_TEMPL_TRACKER::checkImageBuffer()
 
 	int newSize = screenWidth*screenHeight;
 
-	if(newSize==l_imageL_size)
-		return;
+	// labels have to be able to count up to the label budget:
+	// switch to 32-bit labels if it does not fit into int16_t
+	//
+	labelLimit = getLabelLimit(labelBudget, screenWidth, screenHeight);
+	int newLabelSize = labelLimit>LABEL_MAX_16BIT ? (int)sizeof(int32_t) : (int)sizeof(int16_t);
 
-	if(l_imageL)
-		//delete l_imageL;
-		artkp_Free(l_imageL);
+	if(newSize!=l_imageL_size || newLabelSize!=labelSize)
+	{
+		if(l_imageL)
+			//delete l_imageL;
+			artkp_Free(l_imageL);
 
-	l_imageL_size = newSize;
+		l_imageL_size = newSize;
+		labelSize = newLabelSize;
 
-	//l_imageL = new int16_t[newSize];
-	l_imageL = artkp_Alloc<int16_t>(newSize);
+		//l_imageL = new int16_t[newSize];
+		l_imageL = artkp_Alloc<uint8_t>(newSize*labelSize);
+
+		// the right label image always has the size of the left one
+		if(l_imageR)
+			artkp_Free(l_imageR);
+		l_imageR = NULL;
+	}
+
+	// stereo tracking labels the right image into its own buffers,
+	// histogram retries label a second threshold into them
+	//
+	if(needsRightLabelBuffers())
+	{
+		if(!l_imageR)
+			l_imageR = artkp_Alloc<uint8_t>(l_imageL_size*labelSize);
+
+		if(!workR)
+		{
+			labelCapacityR = LABEL_INITIAL_CAPACITY;
+			workR = artkp_Alloc<int>(labelCapacityR);
+			work2R = artkp_Alloc<int>(labelCapacityR*7);
+			wareaR = artkp_Alloc<int>(labelCapacityR);
+			wclipR = artkp_Alloc<int>(labelCapacityR*4);
+			wposR = artkp_Alloc<ARFloat>(labelCapacityR*2);
+		}
+	}
+}
+
+
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::freeStereoBuffers()
+{
+	artkp_Free(l_imageR);
+	artkp_Free(workR);
+	artkp_Free(work2R);
+	artkp_Free(wareaR);
+	artkp_Free(wclipR);
+	artkp_Free(wposR);
+
+	l_imageR = NULL;
+	workR = work2R = wareaR = wclipR = NULL;
+	wposR = NULL;
+	labelCapacityR = 0;
+}
+
+
+AR_TEMPL_FUNC int
+AR_TEMPL_TRACKER::getLabelLimit(int nLabelBudget, int nWidth, int nHeight)
+{
+	if(nLabelBudget>0)
+		return nLabelBudget;
+
+	int autoBudget = nWidth*nHeight/LABEL_AUTO_PIXELS;
+	return autoBudget>LABEL_MAX_16BIT ? autoBudget : LABEL_MAX_16BIT;
+}
+
+
+AR_TEMPL_FUNC bool
+AR_TEMPL_TRACKER::growLabelTables(int nNumLabels, int LorR)
+{
+	// the tables of the left or the right image (see arLabeling())
+	int*& work = LorR ? workL : workR;
+	int*& work2 = LorR ? work2L : work2R;
+	int*& warea = LorR ? wareaL : wareaR;
+	int*& wclip = LorR ? wclipL : wclipR;
+	ARFloat*& wpos = LorR ? wposL : wposR;
+	int& capacity = LorR ? labelCapacity : labelCapacityR;
+
+	if(nNumLabels>labelLimit)
+		return false;
+
+	int newCapacity = capacity;
+	while(newCapacity<nNumLabels)
+		newCapacity *= 2;
+	if(newCapacity>labelLimit)
+		newCapacity = labelLimit;
+
+	// work and work2 are in use while labeling and have to be copied,
+	// the other tables are only filled after the labeling pass.
+	// all tables are allocated before anything is freed, so on failure
+	// the old ones are still there and labeling stops at the old capacity
+	//
+	int* newWork = artkp_Alloc<int>(newCapacity);
+	int* newWork2 = artkp_Alloc<int>(newCapacity*7);
+	int* newArea = artkp_Alloc<int>(newCapacity);
+	int* newClip = artkp_Alloc<int>(newCapacity*4);
+	ARFloat* newPos = artkp_Alloc<ARFloat>(newCapacity*2);
+	if(!newWork || !newWork2 || !newArea || !newClip || !newPos)
+	{
+		artkp_Free(newWork);
+		artkp_Free(newWork2);
+		artkp_Free(newArea);
+		artkp_Free(newClip);
+		artkp_Free(newPos);
+		return false;
+	}
+
+	memcpy(newWork, work, capacity*sizeof(int));
+	memcpy(newWork2, work2, capacity*7*sizeof(int));
+
+	artkp_Free(work);
+	artkp_Free(work2);
+	artkp_Free(warea);
+	artkp_Free(wclip);
+	artkp_Free(wpos);
+
+	work = newWork;
+	work2 = newWork2;
+	warea = newArea;
+	wclip = newClip;
+	wpos = newPos;
+
+	capacity = newCapacity;
+	return true;
 }
 
 
@@ -333,7 +542,8 @@ AR_TEMPL_TRACKER::setCamera(Camera* nCamera)
 		// printf("%f %f %f;\n",arCamera->mat[1][0],arCamera->mat[1][1],arCamera->mat[1][2]);
 		// printf("%f %f %f ]\n",arCamera->mat[2][0],arCamera->mat[2][1],arCamera->mat[2][2]);
 
-		buildUndistO2ITable(arCamera);
+		// the undistortion table is built when UNDIST_LUT first needs it
+		// (see arParamObserv2Ideal_LUT)
 	}
 }
 
@@ -347,7 +557,29 @@ AR_TEMPL_TRACKER::setCamera(Camera* nCamera, ARFloat nNearClip, ARFloat nFarClip
 
 	for(int i = 0; i < 4; i++)
 		gCparam.mat[1][i] = (gCparam.ysize-1)*(gCparam.mat[2][i]) - gCparam.mat[1][i];
-	convertProjectionMatrixToOpenGLStyle(&gCparam, nNearClip,nFarClip, gl_cpara);
+	if(!convertProjectionMatrixToOpenGLStyle(&gCparam, nNearClip,nFarClip, gl_cpara) && logger)
+		logger->artLog("ARToolKitPlus: invalid camera matrix, no OpenGL projection matrix\n");
+}
+
+
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::setStereoCamera(Camera* nCamera, const ARFloat nRightFromLeft[3][4])
+{
+	stereo.camera = nCamera;
+
+	if(!stereo.camera)
+	{
+		freeStereoBuffers();
+		return;
+	}
+
+	// both images are processed with the same resolution
+	stereo.camera->changeFrameSize(screenWidth,screenHeight);
+	stereo.camera->logSettings(logger);
+
+	for(int i=0; i<3; i++)
+		for(int j=0; j<4; j++)
+			stereo.rightFromLeft[i][j] = nRightFromLeft[i][j];
 }
 
 
@@ -393,10 +625,8 @@ AR_TEMPL_TRACKER::convertProjectionMatrixToOpenGLStyle2( ARFloat cparam[3][4], i
     ARFloat   p[3][3], q[4][4];
     int      i, j;
 
-    if(arParamDecompMat(cparam, icpara, trans) < 0) {
-        printf("gConvGLcpara: Parameter error!!\n");
+    if(arParamDecompMat(cparam, icpara, trans) < 0)
         return false;
-    }
 
     for( i = 0; i < 3; i++ ) {
         for( j = 0; j < 3; j++ ) {
@@ -477,6 +707,9 @@ AR_TEMPL_TRACKER::changeCameraSize(int nWidth, int nHeight)
 	arCamera->changeFrameSize(nWidth,nHeight);
 	arInitCparam(arCamera);
 
+	if(stereo.camera)
+		stereo.camera->changeFrameSize(nWidth,nHeight);
+
 	if(logger)
 		logger->artLogEx("ARToolKitPlus: Changed CamSize %d, %d", arCamera->xsize, arCamera->ysize);
 }
@@ -502,6 +735,10 @@ AR_TEMPL_TRACKER::setUndistortionMode(UNDIST_MODE nMode)
 		arParamObserv2Ideal_func = &AR_TEMPL_TRACKER::arParamObserv2Ideal_LUT;
 		//arParamIdeal2Observ_func = arParamIdeal2Observ_LUT;
 		break;
+
+	case UNDIST_GRID:
+		arParamObserv2Ideal_func = &AR_TEMPL_TRACKER::arParamObserv2Ideal_grid;
+		break;
 	}
 }
 
@@ -544,53 +781,70 @@ AR_TEMPL_TRACKER::setPoseEstimator(POSE_ESTIMATOR nMode)
 AR_TEMPL_FUNC ARFloat
 AR_TEMPL_TRACKER::executeSingleMarkerPoseEstimator(ARMarkerInfo *marker_info, ARFloat center[2], ARFloat width, ARFloat conv[3][4])
 {
+	ARFloat err = -1.0f;
+
 	switch(poseEstimator)
 	{
 	case POSE_ESTIMATOR_ORIGINAL:
-		return arGetTransMat(marker_info, center, width, conv);
+		err = arGetTransMat(marker_info, center, width, conv);
+		break;
 
 	case POSE_ESTIMATOR_ORIGINAL_CONT:
-		return arGetTransMatCont2(marker_info, center, width, conv);
+		err = arGetTransMatCont2(marker_info, center, width, conv);
+		break;
 
 	case POSE_ESTIMATOR_RPP:
 		if(rppSupportAvailabe())
 		{
-			return rppGetTransMat(marker_info, center, width, conv);
+			err = rppGetTransMat(marker_info, center, width, conv);
+			break;
 		}
 		if(logger)
 			logger->artLog("ARToolKitPlus: Failed to set RPP pose estimator - RPP disabled during build\n");
 		return -1.0f;
 	}
 
-	return -1.0f;
+	PoseState& state = poseState();
+	state.stats->numPoses++;
+	state.stats->poseError = (float)err;
+	return err;
 }
 
 
 AR_TEMPL_FUNC ARFloat
 AR_TEMPL_TRACKER::executeMultiMarkerPoseEstimator(ARMarkerInfo *marker_info, int marker_num, ARMultiMarkerInfoT *config)
 {
-	if(hullTrackingMode!=HULL_OFF)
-		return arMultiGetTransMatHull(marker_info, marker_num, config);
+	ARFloat err = -1.0f;
 
-	switch(poseEstimator)
+	if(hullTrackingMode!=HULL_OFF)
+		err = arMultiGetTransMatHull(marker_info, marker_num, config);
+	else if(multiPoseEstimator==MULTI_POSE_ESTIMATOR_RANSAC)
+		err = arMultiGetTransMatRansac(marker_info, marker_num, config);
+	else
 	{
-	case POSE_ESTIMATOR_ORIGINAL:
-		return arMultiGetTransMat(marker_info, marker_num, config);
-
-	case POSE_ESTIMATOR_ORIGINAL_CONT:
-		return arMultiGetTransMat(marker_info, marker_num, config);
-
-	case POSE_ESTIMATOR_RPP:
-		if(rppSupportAvailabe())
+		switch(poseEstimator)
 		{
-			return rppMultiGetTransMat(marker_info, marker_num, config);
+		case POSE_ESTIMATOR_ORIGINAL:
+		case POSE_ESTIMATOR_ORIGINAL_CONT:
+			err = arMultiGetTransMat(marker_info, marker_num, config);
+			break;
+
+		case POSE_ESTIMATOR_RPP:
+			if(rppSupportAvailabe())
+			{
+				err = rppMultiGetTransMat(marker_info, marker_num, config);
+				break;
+			}
+			if(logger)
+				logger->artLog("ARToolKitPlus: Failed to set RPP pose estimator - RPP disabled during build\n");
+			return -1.0f;
 		}
-		if(logger)
-			logger->artLog("ARToolKitPlus: Failed to set RPP pose estimator - RPP disabled during build\n");
-		return -1.0f;
 	}
 
-	return -1.0f;
+	PoseState& state = poseState();
+	state.stats->numPoses++;
+	state.stats->poseError = (float)err;
+	return err;
 }
 
 
@@ -606,54 +860,69 @@ AR_TEMPL_TRACKER::activateVignettingCompensation(bool nEnable, int nCorners, int
 
 
 AR_TEMPL_FUNC void
-AR_TEMPL_TRACKER::setMarkerMode(MARKER_MODE nMarkerMode)
+AR_TEMPL_TRACKER::activateAdaptiveThreshold(bool nEnable, int nWindowSize, int nOffsetPercent)
 {
-	markerMode = nMarkerMode;
+	adaptiveThreshold.enabled = nEnable;
+	adaptiveThreshold.windowSize = nWindowSize>0 ? (nWindowSize|1) : 0;
+	adaptiveThreshold.offsetPercent = nOffsetPercent<0 ? 0 : (nOffsetPercent>99 ? 99 : nOffsetPercent);
+}
+
+
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::activateMultiThreshold(bool nEnable, int nNumThresholds, int nSpacing)
+{
+	multiThreshold.enabled = nEnable;
+	multiThreshold.num = nNumThresholds<2 ? 2 : (nNumThresholds>MULTI_THRESHOLD_MAX ? MULTI_THRESHOLD_MAX : nNumThresholds);
+	multiThreshold.spacing = nSpacing>=1 ? nSpacing : 1;
 }
 
 
-static void
-convertPixel16To24(unsigned short nPixel, unsigned char& nRed, unsigned char& nGreen, unsigned char& nBlue)
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::activateMotionGate(bool nEnable, int nTolerance)
 {
-	const unsigned short RED_MASK    = 0x1F << 11;
-	const unsigned short GREEN_MASK  = 0x3F << 5;
-	const unsigned short BLUE_MASK   = 0x1F;
+	motionGate.enabled = nEnable;
+	motionGate.tolerance = nTolerance>=0 ? nTolerance : 0;
 
-	nRed =   (unsigned char)((nPixel&RED_MASK) >> 8);
-	nGreen = (unsigned char)((nPixel&GREEN_MASK) >> 3);
-	nBlue =  (unsigned char)((nPixel&BLUE_MASK) << 3);
+	// the next frame is processed completely in any case
+	motionGate.valid = false;
+	motionGate.state = MotionGate::FRAME_FULL;
+	motionGate.markersUnchanged = false;
 }
 
 
 AR_TEMPL_FUNC void
-AR_TEMPL_TRACKER::checkRGB565LUT()
+AR_TEMPL_TRACKER::activateCornerTracking(bool nEnable, int nMaxTrackedFrames)
 {
-	int i;
+	cornerTracking.enabled = nEnable;
+	cornerTracking.maxFrames = nMaxTrackedFrames>=0 ? nMaxTrackedFrames : 0;
 
-	if(RGB565_to_LUM8_LUT)
-		return;
+	// start with a full detection
+	cornerTracking.valid = false;
+}
 
-	//RGB565_to_LUM8_LUT = new unsigned char[LUM_TABLE_SIZE];
-	RGB565_to_LUM8_LUT = artkp_Alloc<unsigned char>(LUM_TABLE_SIZE);
 
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::activateEarlyReject(bool nEnable, int nMinContrast)
+{
+	earlyReject.enabled = nEnable;
+	earlyReject.minContrast = nMinContrast>0 ? nMinContrast : 0;
+}
 
-#ifdef SMALL_LUM8_TABLE
-	for(i=0; i<(LUM_TABLE_SIZE >> 6); i++)
-	{
-		unsigned char red,green,blue;
 
-		convertPixel16To24(i<<6, red, green, blue);
-		RGB565_to_LUM8_LUT[i] =  (unsigned char)(((red<<1) + (green<<2) + green + blue)>>3);
-	}
-#else
-	for(i=0; i<LUM_TABLE_SIZE; i++)
-	{
-		unsigned char red,green,blue;
+AR_TEMPL_FUNC int
+AR_TEMPL_TRACKER::getNumEarlyRejects(EARLY_REJECT_REASON nReason) const
+{
+	if(nReason<0 || nReason>=EARLY_REJECT_NUM_REASONS)
+		return 0;
 
-		convertPixel16To24(i, red, green, blue);
-		RGB565_to_LUM8_LUT[i] =  (unsigned char)(((red<<1) + (green<<2) + green + blue)>>3);
-	}
-#endif //SMALL_LUM8_TABLE
+	return earlyReject.numRejected[nReason];
+}
+
+
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::setMarkerMode(MARKER_MODE nMarkerMode)
+{
+	markerMode = nMarkerMode;
 }
 
 
@@ -672,10 +941,10 @@ AR_TEMPL_TRACKER::cleanup()
 AR_TEMPL_FUNC const char*
 AR_TEMPL_TRACKER::getDescription()
 {
-	const char* pixelformats[] = { "NONE", "ABGR", "BGRA", "BGR", "RGBA", "RGB", "RGB565", "LUM"  };
+	static const char* const pixelformats[] = { "NONE", "ABGR", "BGRA", "BGR", "RGBA", "RGB", "RGB565", "LUM"  };
 	int f = getPixelFormat();
 
-	char *compilerstr = new char[256];
+	char compilerstr[256];
 
 #ifdef __INTEL_COMPILER
 	sprintf(compilerstr, "Intel C++ v%d.%d", __INTEL_COMPILER/100, __INTEL_COMPILER%100);
@@ -736,8 +1005,6 @@ AR_TEMPL_TRACKER::getDescription()
 			rppSupportAvailabe() ? "" : "not "
 			);
 
-	delete [] compilerstr;
-
 	assert(strlen(descriptionString)<512);
 	return descriptionString;
 }
@@ -779,17 +1046,29 @@ AR_TEMPL_TRACKER::operator delete(void *rawMemory)
 AR_TEMPL_FUNC size_t
 AR_TEMPL_TRACKER::getDynamicMemoryRequirements()
 {
-	// requirements for allocations in the constructor
+	return getDynamicMemoryRequirements(MAX_BUFFER_WIDTH, MAX_BUFFER_HEIGHT);
+}
+
+
+AR_TEMPL_FUNC size_t
+AR_TEMPL_TRACKER::getDynamicMemoryRequirements(int nWidth, int nHeight, int nLabelBudget)
+{
+	int labels = getLabelLimit(nLabelBudget, nWidth, nHeight);
+	size_t labelSize = labels>LABEL_MAX_16BIT ? sizeof(int32_t) : sizeof(int16_t);
+
+	// requirements for the labeling work tables. they grow by doubling from
+	// LABEL_INITIAL_CAPACITY up to the label budget; a memory manager that
+	// can not release memory needs to hold all generations (less than twice the last one)
 	//
-	size_t size = sizeof(unsigned int)*(WORK_SIZE +			// workL = new int[WORK_SIZE];
-										WORK_SIZE*7 +		// work2L = new int[WORK_SIZE*7];
-										WORK_SIZE +			// wareaL = new int[WORK_SIZE];
-										WORK_SIZE*4 +		// wclipL = new int[WORK_SIZE*4];
-										WORK_SIZE*2);		// wposL = new ARFloat[WORK_SIZE*2];
+	size_t size = 2*(sizeof(int)*(labels +					// workL
+								  labels*7 +				// work2L
+								  labels +					// wareaL
+								  labels*4) +				// wclipL
+					 sizeof(ARFloat)*labels*2);				// wposL
 
 	// requirements for the image buffer (arImageL)
 	//
-	size += sizeof(uint8_t)*MAX_BUFFER_WIDTH*MAX_BUFFER_HEIGHT;
+	size += sizeof(uint8_t)*nWidth*nHeight;
 
 
 	// requirements for allocation of marker_infoTWO
@@ -799,17 +1078,28 @@ AR_TEMPL_TRACKER::getDynamicMemoryRequirements()
 
 	// requirements for allocation of l_imageL
 	//
-	size += sizeof(int16_t)*MAX_BUFFER_WIDTH*MAX_BUFFER_HEIGHT;
+	size += labelSize*nWidth*nHeight;
 
 
 	// requirements for the lens undistortion table (undistO2ITable)
 	//
-	size += sizeof(unsigned int)*MAX_BUFFER_WIDTH*MAX_BUFFER_HEIGHT;
+	size += sizeof(unsigned int)*nWidth*nHeight;
+
+
+	// requirements for the undistortion grid (undistGrid) at its finest step
+	//
+	size += sizeof(ARFloat)*2*(nWidth/UNDIST_GRID_MIN_STEP+2)*(nHeight/UNDIST_GRID_MIN_STEP+2);
+
+
+	// requirements for the block means of the motion gate (motionGate.reference)
+	//
+	size += (nWidth/MotionGate::BLOCK_SIZE)*(nHeight/MotionGate::BLOCK_SIZE);
 
 
-	// requirements for the RGB565 to gray table RGB565_to_LUM8_LUT
+	// requirements for the two luminance pyramids of the corner tracking (cornerTracking.memory)
 	//
-	size += sizeof(unsigned char)*LUM_TABLE_SIZE;
+	for(int l=1; l<=CornerTracking::LEVELS; l++)
+		size += 2*(nWidth>>l)*(nHeight>>l);
 
 
 	return size;
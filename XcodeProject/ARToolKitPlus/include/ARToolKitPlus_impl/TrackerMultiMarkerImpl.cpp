@@ -59,6 +59,19 @@ ARMM_TEMPL_TRACKER::TrackerMultiMarkerImpl(int nWidth, int nHeight)
 	numDetected = 0;
 
 	config = 0;
+	numPosedConfigs = 0;
+
+	// like the histogram threshold retries: threads are only worth it with more than one core
+#ifdef AR_MULTI_POSE_USE_THREADS
+	numPoseThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	if(numPoseThreads>MAX_POSE_THREADS)
+		numPoseThreads = MAX_POSE_THREADS;
+	if(numPoseThreads<1)
+		numPoseThreads = 1;
+#else
+	numPoseThreads = 1;
+#endif //AR_MULTI_POSE_USE_THREADS
+	poseWorkers = NULL;
 
 	this->thresh = 150;
 }
@@ -68,8 +81,20 @@ ARMM_TEMPL_FUNC
 ARMM_TEMPL_TRACKER::~TrackerMultiMarkerImpl()
 {
 	cleanup();
-	if(config)
-		arMultiFreeConfig(config);
+	freeConfigs();
+	delete [] poseWorkers;
+}
+
+
+ARMM_TEMPL_FUNC void
+ARMM_TEMPL_TRACKER::freeConfigs()
+{
+	for(size_t i=0; i<configs.size(); i++)
+		arMultiFreeConfig(configs[i].config);
+
+	configs.clear();
+	config = NULL;
+	numPosedConfigs = 0;
 }
 
 
@@ -87,15 +112,11 @@ ARMM_TEMPL_TRACKER::init(const char* nCamParamFile, const char* nMultiFile, ARFl
 	if(!loadCameraFile(nCamParamFile, nNearClip, nFarClip))
 		return false;
 
-	if(config)
-		arMultiFreeConfig(config);
+	freeConfigs();
 
-    if((config = arMultiReadConfigFile(nMultiFile)) == NULL )
+    if(addMultiMarkerConfig(nMultiFile) < 0)
         return false;
 
-	if(this->logger)
-		this->logger->artLogEx("INFO: %d markers loaded from config file", config->marker_num);
-
     return true;
 }
 
@@ -107,6 +128,7 @@ ARMM_TEMPL_TRACKER::calc(const unsigned char* nImage)
 	int				tmpNumDetected;
     ARMarkerInfo    *tmp_markers;
 
+	this->frameStats.poseFollows = true;
 	if(useDetectLite)
 	{
 		if(arDetectMarkerLite(const_cast<unsigned char*>(nImage), this->thresh, &tmp_markers, &tmpNumDetected) < 0)
@@ -118,6 +140,45 @@ ARMM_TEMPL_TRACKER::calc(const unsigned char* nImage)
 			return 0;
 	}
 
+	return calcPose(tmp_markers, tmpNumDetected, this->motionGate.markersUnchanged);
+}
+
+
+ARMM_TEMPL_FUNC int
+ARMM_TEMPL_TRACKER::calcDetect(const unsigned char* nImage, ARMarkerInfo* nMarkers, int nMaxMarkers, bool* nMarkersUnchanged)
+{
+	int				tmpNumDetected;
+    ARMarkerInfo    *tmp_markers;
+
+	this->frameStats.poseFollows = true;
+	if(useDetectLite)
+	{
+		if(arDetectMarkerLite(const_cast<unsigned char*>(nImage), this->thresh, &tmp_markers, &tmpNumDetected) < 0)
+			return -1;
+	}
+	else
+	{
+		if(arDetectMarker(const_cast<unsigned char*>(nImage), this->thresh, &tmp_markers, &tmpNumDetected) < 0)
+			return -1;
+	}
+
+	if(tmpNumDetected > nMaxMarkers)
+		tmpNumDetected = nMaxMarkers;
+	memcpy(nMarkers, tmp_markers, tmpNumDetected*sizeof(ARMarkerInfo));
+
+	if(nMarkersUnchanged)
+		*nMarkersUnchanged = this->motionGate.markersUnchanged;
+
+	return tmpNumDetected;
+}
+
+
+ARMM_TEMPL_FUNC int
+ARMM_TEMPL_TRACKER::calcPose(ARMarkerInfo* tmp_markers, int tmpNumDetected, bool nMarkersUnchanged)
+{
+	numDetected = 0;
+	this->arStatsBeginPose();
+
 	for(int i=0; i<tmpNumDetected; i++)
 		if(tmp_markers[i].id!=-1)
 		{
@@ -127,14 +188,287 @@ ARMM_TEMPL_TRACKER::calc(const unsigned char* nImage)
 				break;
 		}
 
-	if(executeMultiMarkerPoseEstimator(tmp_markers, tmpNumDetected, config) < 0)
+	// all configs share the detected markers. since the pose estimators may
+	// change ids and directions (verify_markers) the markers are saved once
+	// and every config works on a fresh copy of them.
+	//
+	bool anyTracked = false;
+
+	// the markers did not change (motion gate), so did not the poses
+	// of the configs that were estimated before
+	size_t numReused = nMarkersUnchanged ? numPosedConfigs : 0;
+
+	// the hull corners of all configs posed in this frame (cleared here and not in
+	// arDetectMarker(), which may already run on the next frame)
+	if(!nMarkersUnchanged)
+		this->pose.trackedCorners.clear();
+
+	if(tmpNumDetected>__MAX_IMAGE_PATTERNS)
+		tmpNumDetected = __MAX_IMAGE_PATTERNS;
+	memcpy(frameMarkers, tmp_markers, tmpNumDetected*sizeof(ARMarkerInfo));
+
+	for(size_t c=0; c<numReused; c++)
+		anyTracked = anyTracked || configs[c].tracked;
+
+	if(poseConfigs(numReused, tmpNumDetected, NULL, 0))
+		anyTracked = true;
+	numPosedConfigs = configs.size();
+
+	this->arStatsEndPose();
+
+	if(configs.empty() || !anyTracked)
+		return 0;
+
+	// the first config is also available via the single config methods.
+	// if only other configs were found, do not leave an old pose there.
+	if(configs[0].tracked)
+		memcpy(this->gl_para, configs[0].gl_para, sizeof(this->gl_para));
+	else
+		memset(this->gl_para, 0, sizeof(this->gl_para));
+
+	return numDetected;
+}
+
+
+ARMM_TEMPL_FUNC int
+ARMM_TEMPL_TRACKER::calcStereo(const unsigned char* nImageLeft, const unsigned char* nImageRight)
+{
+	numDetected = 0;
+	int				tmpNumDetected, numDetectedR;
+    ARMarkerInfo    *tmp_markers, *markersR;
+
+	this->frameStats.poseFollows = true;
+	if(this->arDetectMarkerStereo(const_cast<unsigned char*>(nImageLeft), const_cast<unsigned char*>(nImageRight), this->thresh,
+								  &tmp_markers, &tmpNumDetected, &markersR, &numDetectedR) < 0)
+		return 0;
+
+	for(int i=0; i<tmpNumDetected; i++)
+		if(tmp_markers[i].id!=-1)
+		{
+			detectedMarkers[numDetected] = tmp_markers[i];
+			detectedMarkerIDs[numDetected++] = tmp_markers[i].id;
+			if(numDetected>=__MAX_IMAGE_PATTERNS)
+				break;
+		}
+
+	this->arStatsBeginPose();
+
+	if(tmpNumDetected>__MAX_IMAGE_PATTERNS)
+		tmpNumDetected = __MAX_IMAGE_PATTERNS;
+	memcpy(frameMarkers, tmp_markers, tmpNumDetected*sizeof(ARMarkerInfo));
+
+	bool anyTracked = poseConfigs(0, tmpNumDetected, markersR, numDetectedR);
+	numPosedConfigs = configs.size();
+
+	this->arStatsEndPose();
+
+	if(configs.empty() || !anyTracked)
 		return 0;
 
-	convertTransformationMatrixToOpenGLStyle(config->trans, this->gl_para);
+	// the first config is also available via the single config methods.
+	// if only other configs were found, do not leave an old pose there.
+	if(configs[0].tracked)
+		memcpy(this->gl_para, configs[0].gl_para, sizeof(this->gl_para));
+	else
+		memset(this->gl_para, 0, sizeof(this->gl_para));
+
 	return numDetected;
 }
 
 
+ARMM_TEMPL_FUNC bool
+ARMM_TEMPL_TRACKER::poseConfigs(size_t first, int nNumMarkers, ARMarkerInfo* nMarkersR, int nNumMarkersR)
+{
+	const size_t numConfigs = configs.size()-first;
+	int numThreads = 1;
+
+#ifdef AR_MULTI_POSE_USE_THREADS
+	pthread_t threads[MAX_POSE_THREADS-1];
+	bool started[MAX_POSE_THREADS-1];
+
+	if(numPoseThreads>1 && numConfigs>1)
+	{
+		numThreads = numConfigs<(size_t)numPoseThreads ? (int)numConfigs : numPoseThreads;
+
+		// the list of indexed configs is shared: the indexes are built before the threads start
+		for(size_t c=first; c<configs.size(); c++)
+			if(!this->arMultiHasConfigIndex(configs[c].config) && !this->arMultiCreateConfigIndex(configs[c].config))
+				numThreads = 1;
+	}
+
+	if(numThreads>1 && !poseWorkers)
+	{
+		poseWorkers = new PoseWorker[MAX_POSE_THREADS-1];
+		for(int t=0; t<MAX_POSE_THREADS-1; t++)
+		{
+			poseWorkers[t].state.scratch.init(AR_TEMPL_TRACKER::POSE_SCRATCH_SIZE, AR_TEMPL_TRACKER::POSE_SCRATCH_SIZE);
+			poseWorkers[t].state.stats = &poseWorkers[t].stats;
+			poseWorkers[t].tracker = this;
+		}
+	}
+
+	// the calling thread takes the first range of configs, so poses, corners and
+	// statistics of the others can be appended in config order after the join
+	for(int t=1; t<numThreads; t++)
+	{
+		PoseWorker& worker = poseWorkers[t-1];
+
+		worker.first = first + numConfigs*t/numThreads;
+		worker.last = first + numConfigs*(t+1)/numThreads;
+		worker.numMarkers = nNumMarkers;
+		worker.markersR = nMarkersR;
+		worker.numMarkersR = nNumMarkersR;
+		started[t-1] = pthread_create(&threads[t-1], NULL, poseWorkerThread, &worker)==0;
+	}
+#endif //AR_MULTI_POSE_USE_THREADS
+
+	bool anyTracked = poseConfigRange(first, first + numConfigs/numThreads, nNumMarkers, nMarkersR, nNumMarkersR, configMarkers);
+
+#ifdef AR_MULTI_POSE_USE_THREADS
+	FrameStats& stats = *this->pose.stats;
+
+	for(int t=1; t<numThreads; t++)
+	{
+		PoseWorker& worker = poseWorkers[t-1];
+
+		if(started[t-1])
+			pthread_join(threads[t-1], NULL);
+		else
+			poseWorkerThread(&worker);
+
+		stats.numPoses += worker.stats.numPoses;
+		stats.poseIterations += worker.stats.poseIterations;
+		if(worker.stats.numPoses>0)
+			stats.poseError = worker.stats.poseError;
+
+		this->pose.trackedCorners.insert(this->pose.trackedCorners.end(), worker.state.trackedCorners.begin(), worker.state.trackedCorners.end());
+		anyTracked = anyTracked || worker.anyTracked;
+	}
+#endif //AR_MULTI_POSE_USE_THREADS
+
+	return anyTracked;
+}
+
+
+ARMM_TEMPL_FUNC bool
+ARMM_TEMPL_TRACKER::poseConfigRange(size_t first, size_t last, int nNumMarkers, ARMarkerInfo* nMarkersR, int nNumMarkersR,
+									ARMarkerInfo* nConfigMarkers)
+{
+	bool anyTracked = false;
+
+	for(size_t c=first; c<last; c++)
+	{
+		configs[c].tracked = nMarkersR && this->arMultiGetTransMatStereo(frameMarkers, nNumMarkers, nMarkersR, nNumMarkersR, configs[c].config) >= 0;
+
+		// mono image, or none of the config's markers in both images: mono pose. the pose
+		// estimators may change the markers, so every config works on a fresh copy of them
+		if(!configs[c].tracked)
+		{
+			memcpy(nConfigMarkers, frameMarkers, nNumMarkers*sizeof(ARMarkerInfo));
+			configs[c].tracked = executeMultiMarkerPoseEstimator(nConfigMarkers, nNumMarkers, configs[c].config) >= 0;
+		}
+
+		if(!configs[c].tracked)
+			continue;
+
+		this->convertTransformationMatrixToOpenGLStyle(configs[c].config->trans, configs[c].gl_para);
+		anyTracked = true;
+	}
+
+	return anyTracked;
+}
+
+
+#ifdef AR_MULTI_POSE_USE_THREADS
+
+ARMM_TEMPL_FUNC void*
+ARMM_TEMPL_TRACKER::poseWorkerThread(void* nWorker)
+{
+	PoseWorker* worker = (PoseWorker*)nWorker;
+	TrackerMultiMarkerImpl* tracker = worker->tracker;
+
+	worker->stats.numPoses = 0;
+	worker->stats.poseIterations = 0;
+	worker->stats.poseError = -1.0f;
+	worker->state.trackedCorners.clear();
+
+	// also run on the calling thread if the thread could not be started: the key is reset afterwards
+	pthread_setspecific(tracker->poseKey, &worker->state);
+	worker->anyTracked = tracker->poseConfigRange(worker->first, worker->last, worker->numMarkers, worker->markersR, worker->numMarkersR,
+												  worker->configMarkers);
+	pthread_setspecific(tracker->poseKey, NULL);
+
+	return NULL;
+}
+
+#endif //AR_MULTI_POSE_USE_THREADS
+
+
+ARMM_TEMPL_FUNC int
+ARMM_TEMPL_TRACKER::addMultiMarkerConfig(const char* nMultiFile)
+{
+	MultiConfig newConfig;
+
+	if((newConfig.config = arMultiReadConfigFile(nMultiFile)) == NULL)
+	{
+		if(this->logger)
+			this->logger->artLogEx("ERROR: failed to load multi-marker config file '%s'", nMultiFile);
+		return -1;
+	}
+
+	newConfig.tracked = false;
+	this->convertTransformationMatrixToOpenGLStyle(newConfig.config->trans, newConfig.gl_para);
+
+	configs.push_back(newConfig);
+	config = configs[0].config;
+
+	if(this->logger)
+		this->logger->artLogEx("INFO: %d markers loaded from config file", newConfig.config->marker_num);
+
+	return (int)configs.size()-1;
+}
+
+
+ARMM_TEMPL_FUNC const ARMultiMarkerInfoT*
+ARMM_TEMPL_TRACKER::getMultiMarkerConfig(int nConfig) const
+{
+	if(nConfig<0 || nConfig>=(int)configs.size())
+		return NULL;
+
+	return configs[nConfig].config;
+}
+
+
+ARMM_TEMPL_FUNC bool
+ARMM_TEMPL_TRACKER::isMultiMarkerConfigTracked(int nConfig) const
+{
+	if(nConfig<0 || nConfig>=(int)configs.size())
+		return false;
+
+	return configs[nConfig].tracked;
+}
+
+
+ARMM_TEMPL_FUNC void
+ARMM_TEMPL_TRACKER::getARMatrix(int nConfig, ARFloat nMatrix[3][4]) const
+{
+	assert(nConfig>=0 && nConfig<(int)configs.size());
+
+	for(int i=0; i<3; i++)
+		for(int j=0; j<4; j++)
+			nMatrix[i][j] = configs[nConfig].config->trans[i][j];
+}
+
+
+ARMM_TEMPL_FUNC const ARFloat*
+ARMM_TEMPL_TRACKER::getModelViewMatrix(int nConfig) const
+{
+	assert(nConfig>=0 && nConfig<(int)configs.size());
+
+	return configs[nConfig].gl_para;
+}
+
+
 ARMM_TEMPL_FUNC void
 ARMM_TEMPL_TRACKER::getDetectedMarkers(int*& nMarkerIDs)
 {
@@ -190,4 +524,15 @@ ARMM_TEMPL_TRACKER::getMemoryRequirements()
 }
 
 
+ARMM_TEMPL_FUNC size_t
+ARMM_TEMPL_TRACKER::getMemoryRequirements(int nWidth, int nHeight, int nLabelBudget)
+{
+	size_t size = sizeof(ARMM_TEMPL_TRACKER);
+
+	size += AR_TEMPL_TRACKER::getDynamicMemoryRequirements(nWidth, nHeight, nLabelBudget);
+
+	return size;
+}
+
+
 }	// namespace ARToolKitPlus
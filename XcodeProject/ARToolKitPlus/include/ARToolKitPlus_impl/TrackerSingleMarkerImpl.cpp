@@ -66,6 +66,7 @@ ARSM_TEMPL_TRACKER::TrackerSingleMarkerImpl(int nWidth, int nHeight)
 
 	patt_width     = 80;
 	patt_center[0] = patt_center[1] = 0.0;
+	poseMarkerId = -1;
 }
 
 
@@ -120,12 +121,56 @@ ARSM_TEMPL_TRACKER::calc(const unsigned char* nImage, int nPattern, bool nUpdate
 
     // detect the markers in the video frame
 	//
+	this->frameStats.poseFollows = true;
     if(arDetectMarker(const_cast<unsigned char*>(nImage), this->thresh, &marker_info, &marker_num) < 0)
 	{
 		PROFILE_ENDSEC(profiler, SINGLEMARKER_OVERALL)
         return -1;
 	}
 
+	if(nMarker_info)
+		*nMarker_info = marker_info;
+	if(nNumMarkers)
+		*nNumMarkers = marker_num;
+
+	int id = calcPose(marker_info, marker_num, this->motionGate.markersUnchanged, nPattern, nUpdateMatrix);
+
+	PROFILE_ENDSEC(profiler, SINGLEMARKER_OVERALL)
+	return id;
+}
+
+
+ARSM_TEMPL_FUNC int
+ARSM_TEMPL_TRACKER::calcDetect(const unsigned char* nImage, ARMarkerInfo* nMarkers, int nMaxMarkers, bool* nMarkersUnchanged)
+{
+    ARMarkerInfo    *marker_info;
+    int             marker_num;
+
+	if(nImage == NULL)
+		return -1;
+
+	this->frameStats.poseFollows = true;
+    if(arDetectMarker(const_cast<unsigned char*>(nImage), this->thresh, &marker_info, &marker_num) < 0) {
+        return -1;
+    }
+
+	if(marker_num > nMaxMarkers)
+		marker_num = nMaxMarkers;
+	memcpy(nMarkers, marker_info, marker_num*sizeof(ARMarkerInfo));
+
+	if(nMarkersUnchanged)
+		*nMarkersUnchanged = this->motionGate.markersUnchanged;
+
+	return marker_num;
+}
+
+
+ARSM_TEMPL_FUNC int
+ARSM_TEMPL_TRACKER::calcPose(ARMarkerInfo* marker_info, int marker_num, bool nMarkersUnchanged, int nPattern, bool nUpdateMatrix)
+{
+	confidence = 0.0f;
+	this->arStatsBeginPose();
+
     // find best visible marker
     int best = -1;
     for(int j = 0; j < marker_num; j++)
@@ -138,16 +183,11 @@ ARSM_TEMPL_TRACKER::calc(const unsigned char* nImage, int nPattern, bool nUpdate
 				best = j;
         }
 
-	if(nMarker_info)
-		*nMarker_info = marker_info;
-	if(nNumMarkers)
-		*nNumMarkers = marker_num;
-
 	// nothing found ?
 	//
     if(best == -1)
 	{
-		PROFILE_ENDSEC(profiler, SINGLEMARKER_OVERALL)
+		this->arStatsEndPose();
         return -1;
 	}
 
@@ -186,13 +226,77 @@ ARSM_TEMPL_TRACKER::calc(const unsigned char* nImage, int nPattern, bool nUpdate
 
     // get the transformation between the marker and the real camera
 	//
-	if(nUpdateMatrix)
+	// the motion gate found the same markers as in the last frame: same pose
+	if(nUpdateMatrix && (!nMarkersUnchanged || poseMarkerId!=marker_info[best].id))
 	{
 		executeSingleMarkerPoseEstimator(&marker_info[best], patt_center, patt_width, patt_trans);
 		this->convertTransformationMatrixToOpenGLStyle(patt_trans, this->gl_para);
+		poseMarkerId = marker_info[best].id;
 	}
 
-	PROFILE_ENDSEC(profiler, SINGLEMARKER_OVERALL)
+	this->arStatsEndPose();
+	return marker_info[best].id;
+}
+
+
+ARSM_TEMPL_FUNC int
+ARSM_TEMPL_TRACKER::calcStereo(const unsigned char* nImageLeft, const unsigned char* nImageRight, int nPattern, bool nUpdateMatrix,
+								ARMarkerInfo** nMarker_info, int* nNumMarkers)
+{
+    ARMarkerInfo    *marker_info, *marker_infoR;
+    int             marker_num, marker_numR;
+
+	if(nImageLeft == NULL || nImageRight == NULL)
+		return -1;
+
+	confidence = 0.0f;
+
+	this->frameStats.poseFollows = true;
+	if(this->arDetectMarkerStereo(const_cast<unsigned char*>(nImageLeft), const_cast<unsigned char*>(nImageRight), this->thresh,
+								  &marker_info, &marker_num, &marker_infoR, &marker_numR) < 0)
+		return -1;
+
+    // find best visible marker in the left image
+    int best = -1;
+    for(int j = 0; j < marker_num; j++) {
+        if(marker_info[j].id != -1 && (nPattern==-1 || nPattern==marker_info[j].id)) {
+            if(best == -1 || marker_info[best].cf < marker_info[j].cf)
+                best = j;
+        }
+    }
+
+	if(nMarker_info)
+		*nMarker_info = marker_info;
+	if(nNumMarkers)
+		*nNumMarkers = marker_num;
+
+	// the pose stage of this frame, even if nothing is posed (see arFrameStats.cpp)
+	this->arStatsBeginPose();
+
+    if(best == -1) {
+		this->arStatsEndPose();
+        return -1;
+    }
+
+	confidence = marker_info[best].cf;
+
+	if(nUpdateMatrix)
+	{
+		// the same marker in the right image
+		int bestR = -1;
+		for(int j = 0; j < marker_numR; j++)
+			if(marker_infoR[j].id == marker_info[best].id && (bestR == -1 || marker_infoR[bestR].cf < marker_infoR[j].cf))
+				bestR = j;
+
+		// not in the right image or the corners did not agree: mono pose
+		if(bestR == -1 || this->arGetTransMatStereo(&marker_info[best], &marker_infoR[bestR], patt_center, patt_width, patt_trans) < 0)
+			executeSingleMarkerPoseEstimator(&marker_info[best], patt_center, patt_width, patt_trans);
+
+		this->convertTransformationMatrixToOpenGLStyle(patt_trans, this->gl_para);
+		poseMarkerId = marker_info[best].id;
+	}
+
+	this->arStatsEndPose();
 	return marker_info[best].id;
 }
 
@@ -259,4 +363,15 @@ ARSM_TEMPL_TRACKER::getMemoryRequirements()
 }
 
 
+ARSM_TEMPL_FUNC size_t
+ARSM_TEMPL_TRACKER::getMemoryRequirements(int nWidth, int nHeight, int nLabelBudget)
+{
+	size_t size = sizeof(ARSM_TEMPL_TRACKER);
+
+	size += AR_TEMPL_TRACKER::getDynamicMemoryRequirements(nWidth, nHeight, nLabelBudget);
+
+	return size;
+}
+
+
 }	// namespace ARToolKitPlus
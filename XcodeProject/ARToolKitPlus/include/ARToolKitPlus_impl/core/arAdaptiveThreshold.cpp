@@ -0,0 +1,213 @@
+/* ========================================================================
+ * PROJECT: ARToolKitPlus
+ * ========================================================================
+ * This work is based on the original ARToolKit developed by
+ *   Hirokazu Kato
+ *   Mark Billinghurst
+ *   HITLab, University of Washington, Seattle
+ * http://www.hitl.washington.edu/artoolkit/
+ *
+ * Copyright of the derived and new portions of this work
+ *     (C) 2006 Graz University of Technology
+ *
+ * This framework is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this framework; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * For further information please contact 
+ *   Dieter Schmalstieg
+ *   <schmalstieg@icg.tu-graz.ac.at>
+ *   Graz University of Technology, 
+ *   Institut for Computer Graphics and Vision,
+ *   Inffeldgasse 16a, 8010 Graz, Austria.
+ * ========================================================================
+ ** @author   Daniel Wagner
+ *
+ * $Id$
+ * @file
+ * ======================================================================== */
+
+
+#include <ARToolKitPlus/Tracker.h>
+
+
+namespace ARToolKitPlus {
+
+
+// box filter thresholding (Bradley & Roth): a pixel is black if it is at least
+// offsetPercent darker than the mean of the window around it.
+//
+// the means are computed on blocks of ADAPTIVE_BLOCK_SIZE x ADAPTIVE_BLOCK_SIZE
+// pixels: the block sums go into a small integral image, each block gets one
+// threshold from the window of blocks around it and all pixels of the block are
+// compared against that value. since the window is much larger than a block the
+// result is practically the same as a per-pixel box filter, but the per-pixel work
+// is reduced to one add and one compare. these loops work on bytes and integer sums,
+// SimdFloat (extra/SimdFloat.h) only has float lanes, so they are kept simple enough
+// for the compiler to vectorize them instead.
+//
+AR_TEMPL_FUNC uint8_t*
+AR_TEMPL_TRACKER::arBuildAdaptiveMask(uint8_t *image)
+{
+	const int bs = ADAPTIVE_BLOCK_SIZE;
+	int lxsize, lysize, step;
+	int x, y, bx, by;
+
+	if( arImageProcMode == AR_IMAGE_PROC_IN_HALF ) {
+		lxsize = arImXsize / 2;
+		lysize = arImYsize / 2;
+		step = 2;
+	}
+	else {
+		lxsize = arImXsize;
+		lysize = arImYsize;
+		step = 1;
+	}
+
+	int window = adaptiveThreshold.windowSize>0 ? adaptiveThreshold.windowSize : lxsize/8;
+	if(window>ADAPTIVE_MAX_WINDOW)
+		window = ADAPTIVE_MAX_WINDOW;
+
+	// window radius in blocks
+	int rb = (window/2 + bs/2) / bs;
+	if(rb<1)
+		rb = 1;
+
+	const int nbx = (lxsize+bs-1)/bs, nby = (lysize+bs-1)/bs;
+	const unsigned int darkFact = (unsigned int)(100-adaptiveThreshold.offsetPercent);
+
+	uint8_t			*mask = (uint8_t*)frameScratch.getMemory(lxsize*lysize);
+	unsigned int	*integral = (unsigned int*)frameScratch.getMemory((nbx+1)*(nby+1)*sizeof(unsigned int));
+	unsigned int	*blockRow = (unsigned int*)frameScratch.getMemory(nbx*sizeof(unsigned int));
+	uint8_t			*blockThresh = (uint8_t*)frameScratch.getMemory(nbx*nby);
+	uint8_t			*lum;
+	int				lumStride;
+
+	if(!mask || !integral || !blockRow || !blockThresh)
+		return NULL;
+
+	// the luminance plane at labeling resolution: full resolution LUM8
+	// images are used directly, everything else is converted once
+	//
+	if(pixelFormat==PIXEL_FORMAT_LUM && step==1)
+	{
+		lum = image;
+		lumStride = arImXsize;
+	}
+	else
+	{
+		lum = (uint8_t*)frameScratch.getMemory(lxsize*lysize);
+		lumStride = lxsize;
+		if(!lum)
+			return NULL;
+
+		int offs = (pixelFormat==PIXEL_FORMAT_ABGR) ? 1 : 0;
+
+		for(y=0; y<lysize; y++)
+		{
+			uint8_t *src = image + y*step*arImXsize*pixelSize, *dst = lum + y*lxsize;
+
+			switch(pixelFormat)
+			{
+			case PIXEL_FORMAT_LUM:
+				for(x=0; x<lxsize; x++, src+=step)
+					dst[x] = *src;
+				break;
+
+			case PIXEL_FORMAT_RGB565:
+				for(x=0; x<lxsize; x++, src+=step*2)
+					dst[x] = getLUM8_from_RGB565(src);
+				break;
+
+			default:
+				// same (r+g+b)/3 the global threshold is compared against
+				for(x=0; x<lxsize; x++, src+=step*pixelSize)
+					dst[x] = (uint8_t)((src[offs]+src[offs+1]+src[offs+2])/3);
+				break;
+			}
+		}
+	}
+
+	// integral image of the block sums: integral[(by+1)*(nbx+1)+bx+1]
+	// holds the sum of all pixels in blocks [0..bx] x [0..by]
+	//
+	for(bx=0; bx<=nbx; bx++)
+		integral[bx] = 0;
+
+	for(by=0; by<nby; by++)
+	{
+		for(bx=0; bx<nbx; bx++)
+			blockRow[bx] = 0;
+
+		int y1 = (by+1)*bs<lysize ? (by+1)*bs : lysize;
+		for(y=by*bs; y<y1; y++)
+		{
+			const uint8_t *row = lum + y*lumStride;
+			for(bx=0, x=0; x+bs<=lxsize; bx++, x+=bs)
+				blockRow[bx] += row[x] + row[x+1] + row[x+2] + row[x+3];
+			for(; x<lxsize; x++)
+				blockRow[bx] += row[x];
+		}
+
+		unsigned int *prev = integral + by*(nbx+1), *cur = prev + (nbx+1), rowSum = 0;
+		cur[0] = 0;
+		for(bx=0; bx<nbx; bx++)
+		{
+			rowSum += blockRow[bx];
+			cur[bx+1] = prev[bx+1] + rowSum;
+		}
+	}
+
+	// one threshold per block from the window of blocks around it
+	// (ADAPTIVE_MAX_WINDOW keeps sum*darkFact below 2^32)
+	//
+	for(by=0; by<nby; by++)
+	{
+		int by0 = by-rb>0 ? by-rb : 0, by1 = by+rb<nby-1 ? by+rb : nby-1;
+		int py0 = by0*bs, py1 = (by1+1)*bs<lysize ? (by1+1)*bs : lysize;
+
+		for(bx=0; bx<nbx; bx++)
+		{
+			int bx0 = bx-rb>0 ? bx-rb : 0, bx1 = bx+rb<nbx-1 ? bx+rb : nbx-1;
+			int px0 = bx0*bs, px1 = (bx1+1)*bs<lxsize ? (bx1+1)*bs : lxsize;
+
+			unsigned int sum = integral[(by1+1)*(nbx+1)+bx1+1] - integral[by0*(nbx+1)+bx1+1]
+							 - integral[(by1+1)*(nbx+1)+bx0] + integral[by0*(nbx+1)+bx0];
+			unsigned int count = (unsigned int)((px1-px0)*(py1-py0));
+
+			blockThresh[by*nbx+bx] = (uint8_t)(sum*darkFact/(count*100));
+		}
+	}
+
+	for(y=0; y<lysize; y++)
+	{
+		const uint8_t *row = lum + y*lumStride, *thresh = blockThresh + (y/bs)*nbx;
+		uint8_t *dst = mask + y*lxsize;
+
+		for(bx=0, x=0; x+bs<=lxsize; bx++, x+=bs)
+		{
+			const uint8_t t = thresh[bx];
+			dst[x+0] = (uint8_t)(row[x+0]<=t);
+			dst[x+1] = (uint8_t)(row[x+1]<=t);
+			dst[x+2] = (uint8_t)(row[x+2]<=t);
+			dst[x+3] = (uint8_t)(row[x+3]<=t);
+		}
+		for(; x<lxsize; x++)
+			dst[x] = (uint8_t)(row[x]<=thresh[bx]);
+	}
+
+	return mask;
+}
+
+
+}	// namespace ARToolKitPlus
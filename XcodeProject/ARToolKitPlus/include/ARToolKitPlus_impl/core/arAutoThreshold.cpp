@@ -0,0 +1,367 @@
+/* ========================================================================
+ * PROJECT: ARToolKitPlus
+ * ========================================================================
+ * This work is based on the original ARToolKit developed by
+ *   Hirokazu Kato
+ *   Mark Billinghurst
+ *   HITLab, University of Washington, Seattle
+ * http://www.hitl.washington.edu/artoolkit/
+ *
+ * Copyright of the derived and new portions of this work
+ *     (C) 2006 Graz University of Technology
+ *
+ * This framework is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this framework; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * For further information please contact 
+ *   Dieter Schmalstieg
+ *   <schmalstieg@icg.tu-graz.ac.at>
+ *   Graz University of Technology, 
+ *   Institut for Computer Graphics and Vision,
+ *   Inffeldgasse 16a, 8010 Graz, Austria.
+ * ========================================================================
+ ** @author   Daniel Wagner
+ *
+ * $Id$
+ * @file
+ * ======================================================================== */
+
+
+#include <string.h>
+#include <stdlib.h>
+#include <ARToolKitPlus/Tracker.h>
+
+
+namespace ARToolKitPlus {
+
+
+// labeling of the next histogram candidate, see arDetectMarkerRetries()
+//
+struct RetryLabelJob
+{
+	void*		tracker;
+	uint8_t*	image;
+	int			thresh;
+
+	void*		limage;
+	int			label_num;
+	int			*area, *clip, *label_ref;
+	ARFloat		*pos;
+};
+
+
+// sum of w*mu^2 over one class [nFirst..nLast] of the histogram, using the
+// prefix sums nP (pixel count) and nS (intensity sum), both indexed with +1
+// so that nP[0]==nS[0]==0. maximizing the sum over all classes is the same
+// as maximizing the between-class variance (Otsu).
+//
+static inline double
+otsuClassTerm(const double* nP, const double* nS, int nFirst, int nLast)
+{
+	double w = nP[nLast+1]-nP[nFirst], s = nS[nLast+1]-nS[nFirst];
+	return w>0.0 ? s*s/w : 0.0;
+}
+
+
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::arBuildThresholdHistogram(uint8_t *image)
+{
+	const int		step = AutoThreshold::SAMPLE_STEP;
+	unsigned int	*hist = autoThreshold.histogram;
+	int				x, y;
+
+	memset(hist, 0, sizeof(autoThreshold.histogram));
+
+	// the labeling compares r+g+b against 3*thresh for the color formats,
+	// so the histogram is built from the same (r+g+b)/3 value
+	int offs = (pixelFormat==PIXEL_FORMAT_ABGR) ? 1 : 0;
+
+	for(y=step/2; y<arImYsize; y+=step)
+	{
+		uint8_t *pnt = image + (y*arImXsize + step/2)*pixelSize;
+
+		switch(pixelFormat)
+		{
+		case PIXEL_FORMAT_LUM:
+			for(x=step/2; x<arImXsize; x+=step, pnt+=step)
+				hist[*pnt]++;
+			break;
+
+		case PIXEL_FORMAT_RGB565:
+			for(x=step/2; x<arImXsize; x+=step, pnt+=step*2)
+				hist[getLUM8_from_RGB565(pnt)]++;
+			break;
+
+		default:
+			for(x=step/2; x<arImXsize; x+=step, pnt+=step*pixelSize)
+				hist[(pnt[offs]+pnt[offs+1]+pnt[offs+2])/3]++;
+			break;
+		}
+	}
+}
+
+
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::arBuildThresholdCandidates(uint8_t *image, int nFirstThresh)
+{
+	const int	minDist = AutoThreshold::MIN_DISTANCE;
+	double		P[257], S[257];
+	int			i, j, lo, hi, best, best1, best2;
+	double		v, bestV;
+
+	autoThreshold.numCandidates = 0;
+
+	arBuildThresholdHistogram(image);
+
+	P[0] = S[0] = 0.0;
+	for(i=0; i<256; i++)
+	{
+		P[i+1] = P[i] + autoThreshold.histogram[i];
+		S[i+1] = S[i] + (double)i*autoThreshold.histogram[i];
+	}
+
+	if(P[256]<=0.0)
+		return;
+
+	// 1% and 99% quantiles: outliers (specular highlights, dead pixels)
+	// should not stretch the range that is searched
+	for(lo=0; lo<255 && P[lo+1]<0.01*P[256]; lo++)
+		;
+	for(hi=255; hi>lo && P[hi]>0.99*P[256]; hi--)
+		;
+
+	if(hi-lo<2)
+		return;
+
+	int maxCandidates = autoThreshold.numRetries+1;
+	if(maxCandidates>AutoThreshold::MAX_CANDIDATES)
+		maxCandidates = AutoThreshold::MAX_CANDIDATES;
+
+	// two classes: the classic Otsu threshold
+	best = lo;
+	bestV = -1.0;
+	for(i=lo; i<hi; i++)
+	{
+		v = otsuClassTerm(P, S, 0, i) + otsuClassTerm(P, S, i+1, 255);
+		if(v>bestV)
+		{
+			bestV = v;
+			best = i;
+		}
+	}
+	addThresholdCandidate(best, nFirstThresh, maxCandidates);
+
+	// three classes: markers in shadow or on a dark background often fall into
+	// the lower or upper split of a two-level Otsu search
+	best1 = lo;
+	best2 = lo+1;
+	bestV = -1.0;
+	for(i=lo; i<hi-1; i++)
+	{
+		double v0 = otsuClassTerm(P, S, 0, i);
+		for(j=i+1; j<hi; j++)
+		{
+			v = v0 + otsuClassTerm(P, S, i+1, j) + otsuClassTerm(P, S, j+1, 255);
+			if(v>bestV)
+			{
+				bestV = v;
+				best1 = i;
+				best2 = j;
+			}
+		}
+	}
+	addThresholdCandidate(best1, nFirstThresh, maxCandidates);
+	addThresholdCandidate(best2, nFirstThresh, maxCandidates);
+
+	// remaining retries bisect the widest gap between thresholds that are already
+	// queued (or were tried first) until the gaps get too narrow to be worth it
+	while(autoThreshold.numCandidates<maxCandidates)
+	{
+		int gapStart = lo, gapEnd = hi, widest = -1;
+		int prev = lo;
+
+		for(;;)
+		{
+			// next queued threshold above prev (or hi)
+			int next = hi;
+			for(i=0; i<autoThreshold.numCandidates; i++)
+				if(autoThreshold.candidates[i]>prev && autoThreshold.candidates[i]<next)
+					next = autoThreshold.candidates[i];
+			if(nFirstThresh>prev && nFirstThresh<next)
+				next = nFirstThresh;
+
+			if(next-prev>widest)
+			{
+				widest = next-prev;
+				gapStart = prev;
+				gapEnd = next;
+			}
+
+			if(next>=hi)
+				break;
+			prev = next;
+		}
+
+		if(widest<2*minDist)
+			break;
+
+		int count = autoThreshold.numCandidates;
+		addThresholdCandidate((gapStart+gapEnd)/2, nFirstThresh, maxCandidates);
+		if(autoThreshold.numCandidates==count)
+			break;
+	}
+}
+
+
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::addThresholdCandidate(int nThresh, int nFirstThresh, int nMaxCandidates)
+{
+	const int minDist = AutoThreshold::MIN_DISTANCE;
+
+	if(autoThreshold.numCandidates>=nMaxCandidates || abs(nThresh-nFirstThresh)<minDist)
+		return;
+
+	for(int i=0; i<autoThreshold.numCandidates; i++)
+		if(abs(nThresh-autoThreshold.candidates[i])<minDist)
+			return;
+
+	autoThreshold.candidates[autoThreshold.numCandidates++] = nThresh;
+}
+
+
+AR_TEMPL_FUNC int
+AR_TEMPL_TRACKER::arGetRetryThreshold(uint8_t *image, int nRetry, int nFirstThresh)
+{
+	if(autoThreshold.mode==AUTO_THRESHOLD_RANDOM)
+		return (rand() % 230) + 10;
+
+	// the histogram is only needed once the first attempt of a frame failed
+	if(nRetry==0)
+		arBuildThresholdCandidates(image, nFirstThresh);
+
+	return nRetry<autoThreshold.numCandidates ? autoThreshold.candidates[nRetry] : -1;
+}
+
+
+AR_TEMPL_FUNC bool
+AR_TEMPL_TRACKER::needsRightLabelBuffers() const
+{
+	return stereo.camera || (autoThreshold.parallel && autoThreshold.enable && autoThreshold.mode==AUTO_THRESHOLD_HISTOGRAM);
+}
+
+
+AR_TEMPL_FUNC void*
+AR_TEMPL_TRACKER::arRetryLabelThread(void *nJob)
+{
+	RetryLabelJob* job = (RetryLabelJob*)nJob;
+	AR_TEMPL_TRACKER* tracker = (AR_TEMPL_TRACKER*)job->tracker;
+
+	job->limage = tracker->arLabeling(job->image, job->thresh, &job->label_num, &job->area, &job->pos, &job->clip, &job->label_ref, 0);
+	return NULL;
+}
+
+
+AR_TEMPL_FUNC int
+AR_TEMPL_TRACKER::arDetectMarkerLabels(uint8_t *dataPtr, int nThresh, void *limage, int label_num, int *area, ARFloat *pos, int *clip, int *label_ref)
+{
+	if(!limage)
+		return -1;
+
+	marker_info2 = arDetectMarker2(limage, label_num, label_ref, area, pos, clip, AR_AREA_MAX, AR_AREA_MIN, 1.0, &wmarker_num);
+	assert(wmarker_num <= MAX_IMAGE_PATTERNS);
+	if(!marker_info2)
+		return -1;
+
+	wmarker_info = arGetMarkerInfo(dataPtr, marker_info2, &wmarker_num, nThresh);
+	assert(wmarker_num <= MAX_IMAGE_PATTERNS);
+	if(!wmarker_info)
+		return -1;
+
+	return wmarker_num;
+}
+
+
+// the histogram candidates are known as soon as the first retry starts, so they are tried two at a
+// time: one is labeled into the left buffers by this thread, the next one into the right buffers
+// (see arStereoLabelThread) by another. contour extraction and decoding keep their results in shared
+// members, they check the second label image only if the first one had no marker.
+// random thresholds are drawn and tried one after the other, as before. so are the
+// histogram candidates on a single core, where the second labeling would only add work.
+//
+AR_TEMPL_FUNC int
+AR_TEMPL_TRACKER::arDetectMarkerRetries(uint8_t *dataPtr, int nFirstThresh, int &nThresh)
+{
+	void			*limage;
+	int				label_num;
+	int				*area, *clip, *label_ref;
+	ARFloat			*pos;
+	RetryLabelJob	job;
+	int				found = 0, numTries = 0;
+	int				retryThresh = arGetRetryThreshold(dataPtr, 0, nFirstThresh);
+
+	const bool pairs = autoThreshold.parallel && autoThreshold.mode==AUTO_THRESHOLD_HISTOGRAM && l_imageR!=NULL;
+
+	job.tracker = this;
+	job.image = dataPtr;
+
+	while(found<=0 && retryThresh>=0 && numTries<autoThreshold.numRetries)
+	{
+		bool threaded = false;
+
+		nThresh = retryThresh;
+		retryThresh = arGetRetryThreshold(dataPtr, ++numTries, nFirstThresh);
+
+#ifdef AR_AUTO_THRESHOLD_USE_THREADS
+		pthread_t thread;
+		if(pairs && retryThresh>=0 && numTries<autoThreshold.numRetries)
+		{
+			job.thresh = retryThresh;
+			job.limage = NULL;
+			threaded = pthread_create(&thread, NULL, arRetryLabelThread, &job)==0;
+		}
+#endif //AR_AUTO_THRESHOLD_USE_THREADS
+
+		frameStats.frame.numRetries = numTries;
+		frameStats.frame.threshold = nThresh;
+
+		limage = arLabeling(dataPtr, nThresh, &label_num, &area, &pos, &clip, &label_ref);
+		found = arDetectMarkerLabels(dataPtr, nThresh, limage, label_num, area, pos, clip, label_ref);
+
+#ifdef AR_AUTO_THRESHOLD_USE_THREADS
+		if(threaded)
+			pthread_join(thread, NULL);
+#endif //AR_AUTO_THRESHOLD_USE_THREADS
+
+		if(found>0 || !threaded)
+			continue;
+
+		// no marker with the left candidate, the right one is labeled already
+		nThresh = retryThresh;
+		retryThresh = arGetRetryThreshold(dataPtr, ++numTries, nFirstThresh);
+
+		frameStats.frame.numRetries = numTries;
+		frameStats.frame.threshold = nThresh;
+		if(job.limage)
+			frameStats.frame.numLabels += job.label_num;
+
+		found = arDetectMarkerLabels(dataPtr, nThresh, job.limage, job.label_num, job.area, job.pos, job.clip, job.label_ref);
+	}
+
+	// without a marker the next frame starts with the next untried threshold
+	thresh = (found<=0 && retryThresh>=0) ? retryThresh : nThresh;
+	return found;
+}
+
+
+}	// namespace ARToolKitPlus
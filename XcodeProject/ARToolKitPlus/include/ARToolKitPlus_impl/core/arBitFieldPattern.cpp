@@ -180,6 +180,29 @@ checkPatternSimple(IDPATTERN nPattern, int& nID, float& nProp)
 }
 
 
+static float
+getPropBCH(int nErrors)
+{
+	switch(nErrors)
+	{
+	case 0:
+		return 1.00f;
+
+	case 1:
+		return 0.75f;
+
+	case 2:
+		return 0.50f;
+
+	case 3:
+		return 0.25f;
+
+	default:
+		return 0.0f;
+	}
+}
+
+
 static void
 checkPatternBCH(IDPATTERN nPattern, int& nID, float& nProp, BCH* nProcessor)
 {
@@ -196,28 +219,21 @@ checkPatternBCH(IDPATTERN nPattern, int& nID, float& nProp, BCH* nProcessor)
 
 	nID = (int)(decodedPattern & andMask);
 
-	switch(err)
-	{
-	case 0:
-		nProp = 1.00f;
-		break;
+	nProp = getPropBCH(err);
+}
 
-	case 1:
-		nProp = 0.75f;
-		break;
 
-	case 2:
-		nProp = 0.50f;
-		break;
+static int
+countBitErrors(IDPATTERN nPattern0, IDPATTERN nPattern1)
+{
+	IDPATTERN diff = nPattern0 ^ nPattern1;
+	int num = 0;
 
-	case 3:
-		nProp = 0.25f;
-		break;
+	for(int i=0; i<pattBits; i++)
+		if(isBitSet(diff, i))
+			num++;
 
-	default:
-		nProp = 0.0f;
-		break;
-	}
+	return num;
 }
 
 
@@ -533,5 +549,66 @@ AR_TEMPL_TRACKER::bitfield_check_BCH( uint8_t *data, int *code, int *dir, ARFloa
 }
 
 
+// checks a single code and rotation instead of decoding all four rotations.
+// for BCH markers the result is the same as bitfield_check_BCH() gives for
+// this rotation: the code word is at least 9 bits away from any other, so with
+// up to 3 bit errors the decoder would correct to the very same id.
+//
+AR_TEMPL_FUNC bool
+AR_TEMPL_TRACKER::bitfield_verify( uint8_t *data, int code, int dir, ARFloat *cf, int thresh)
+{
+	unsigned char patimg[idPattWidth*idPattHeight];
+	int i;
+
+	if(downsamplePattern(data, patimg)==-1)
+		return false;
+
+	IDPATTERN pat=0, one=1;
+
+	for(i=0; i<pattBits; i++)
+		if(patimg[pattBits-1-i]>thresh)
+			pat |= one<<i;
+
+	// same orientation as in bitfield_check_*(): direction n is the
+	// pattern rotated n times by 90 degrees clockwise
+	for(i=0; i<dir; i++)
+		rotate90CW(pat);
+
+	if(markerMode==MARKER_ID_SIMPLE)
+	{
+		int id = -1;
+		float prop = 0.0f;
+
+		checkPatternSimple(pat, id, prop);
+		if(id!=code || prop<=0.0f)
+			return false;
+
+		*cf = prop;
+		return true;
+	}
+	else
+	{
+		if(code<0 || code>(int)idMaxBCH)
+			return false;
+
+		if(bchProcessor==NULL)
+			bchProcessor = new BCH;
+
+		_64bits encoded;
+		bchProcessor->encode(encoded, code);
+
+		IDPATTERN expected = encoded;
+		applyMaskBCH(expected);
+
+		int err = countBitErrors(pat, expected);
+		if(err>3)
+			return false;
+
+		*cf = getPropBCH(err);
+		return true;
+	}
+}
+
+
 
 }  // namespace ARToolKitPlus
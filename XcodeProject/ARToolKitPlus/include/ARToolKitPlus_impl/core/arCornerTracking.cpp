@@ -0,0 +1,524 @@
+/* ========================================================================
+ * PROJECT: ARToolKitPlus
+ * ========================================================================
+ * This work is based on the original ARToolKit developed by
+ *   Hirokazu Kato
+ *   Mark Billinghurst
+ *   HITLab, University of Washington, Seattle
+ * http://www.hitl.washington.edu/artoolkit/
+ *
+ * Copyright of the derived and new portions of this work
+ *     (C) 2006 Graz University of Technology
+ *
+ * This framework is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this framework; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * For further information please contact 
+ *   Dieter Schmalstieg
+ *   <schmalstieg@icg.tu-graz.ac.at>
+ *   Graz University of Technology, 
+ *   Institut for Computer Graphics and Vision,
+ *   Inffeldgasse 16a, 8010 Graz, Austria.
+ * ========================================================================
+ ** @author   Daniel Wagner
+ *
+ * $Id$
+ * @file
+ * ======================================================================== */
+
+
+#include <math.h>
+#include <string.h>
+#include <ARToolKitPlus/Tracker.h>
+
+
+namespace ARToolKitPlus {
+
+
+// corner tracking between full detections (keyframes). the image is reduced to a
+// luminance pyramid (1/2, 1/4 and 1/8 of the camera resolution, 2x2 box filtered) and
+// every vertex of the identified markers of the last frame is followed with a pyramidal
+// Lucas-Kanade tracker. a tracked frame is accepted only if every marker passes:
+//  - each window converged with a well conditioned gradient matrix and a small residual
+//  - the tracked square is still convex and its area did not jump
+//  - points on the middle of the black border are darker than the points just outside
+// otherwise the frame gets a full detection, which also starts the next tracking run.
+//
+// coordinates: cornerTracking.corners are observed (distorted) camera pixels. pixel i
+// of a pyramid level covers pixels 2i and 2i+1 of the level below, so x(l+1) = (x(l)-0.5)/2.
+// the pyramids are only built around the markers (see arBuildTrackingPyramid()), windows
+// outside of that region count as lost.
+//
+AR_TEMPL_FUNC bool
+AR_TEMPL_TRACKER::arTrackMarkerCorners(uint8_t *dataPtr)
+{
+	const int levels = CornerTracking::LEVELS;
+	ARFloat corners[MAX_IMAGE_PATTERNS][4][2], areaRatio[MAX_IMAGE_PATTERNS];
+	int i, k, l;
+
+	cornerTracking.tracked = false;
+
+	if(!cornerTracking.enabled)
+		return false;
+
+	// (re)allocate both pyramids if the image size changed
+	//
+	if(cornerTracking.width[0]!=arImXsize/2 || cornerTracking.height[0]!=arImYsize/2)
+	{
+		size_t size = 0;
+
+		if(cornerTracking.memory)
+			artkp_Free(cornerTracking.memory);
+		cornerTracking.memory = NULL;
+		cornerTracking.valid = false;
+
+		for(l=0; l<levels; l++)
+		{
+			cornerTracking.width[l] = arImXsize>>(l+1);
+			cornerTracking.height[l] = arImYsize>>(l+1);
+			size += cornerTracking.width[l]*cornerTracking.height[l];
+		}
+
+		if(cornerTracking.width[levels-1]<2*CornerTracking::WINDOW_RADIUS+4 ||
+		   cornerTracking.height[levels-1]<2*CornerTracking::WINDOW_RADIUS+4 ||
+		   (cornerTracking.memory = artkp_Alloc<uint8_t>(2*size))==NULL)
+		{
+			cornerTracking.width[0] = cornerTracking.height[0] = 0;
+			return false;
+		}
+
+		uint8_t *mem = cornerTracking.memory;
+		for(i=0; i<2; i++)
+			for(l=0; l<levels; l++)
+			{
+				cornerTracking.pyramid[i][l] = mem;
+				mem += cornerTracking.width[l]*cornerTracking.height[l];
+			}
+	}
+
+	if(!cornerTracking.valid || cornerTracking.numMarkers<1 || cornerTracking.numFrames>=cornerTracking.maxFrames)
+	{
+		cornerTracking.valid = false;
+		return false;
+	}
+
+	// from here on a failure means a full detection, which restarts the tracking
+	cornerTracking.valid = false;
+
+	arBuildTrackingPyramid(dataPtr, cornerTracking.corners, cornerTracking.numMarkers);
+
+	for(i=0; i<cornerTracking.numMarkers; i++)
+	{
+		ARFloat quad[4][2], oldArea = 0, newArea = 0;
+
+		for(k=0; k<4; k++)
+		{
+			ARFloat x = (cornerTracking.corners[i][k][0]-(ARFloat)0.5)/2,
+					y = (cornerTracking.corners[i][k][1]-(ARFloat)0.5)/2;
+
+			if(!arTrackCorner(x, y, &quad[k][0], &quad[k][1]))
+				return false;
+
+			corners[i][k][0] = quad[k][0]*2+(ARFloat)0.5;
+			corners[i][k][1] = quad[k][1]*2+(ARFloat)0.5;
+		}
+
+		// the square must keep its orientation and convexity, and not jump in size
+		//
+		for(k=0; k<4; k++)
+		{
+			const ARFloat *a = cornerTracking.corners[i][k], *b = cornerTracking.corners[i][(k+1)%4], *c = cornerTracking.corners[i][(k+2)%4];
+			const ARFloat *na = corners[i][k], *nb = corners[i][(k+1)%4], *nc = corners[i][(k+2)%4];
+			ARFloat oldCross = (b[0]-a[0])*(c[1]-b[1]) - (b[1]-a[1])*(c[0]-b[0]);
+			ARFloat newCross = (nb[0]-na[0])*(nc[1]-nb[1]) - (nb[1]-na[1])*(nc[0]-nb[0]);
+
+			if(oldCross*newCross<=0)
+				return false;
+
+			oldArea += a[0]*b[1] - b[0]*a[1];
+			newArea += na[0]*nb[1] - nb[0]*na[1];
+		}
+
+		areaRatio[i] = newArea/oldArea;
+		if(areaRatio[i]<(ARFloat)0.7 || areaRatio[i]>(ARFloat)1.43)
+			return false;
+
+		if(!arCheckTrackedBorder(quad))
+			return false;
+	}
+
+	// all markers were followed: build the marker infos as arGetMarkerInfo() would
+	//
+	for(i=0; i<cornerTracking.numMarkers; i++)
+	{
+		ARMarkerInfo &m = cornerTracking.markers[i];
+
+		m.area = (int)(m.area*areaRatio[i] + (ARFloat)0.5);
+		m.pos[0] = m.pos[1] = 0;
+
+		for(k=0; k<4; k++)
+		{
+			m.pos[0] += corners[i][k][0]/4;
+			m.pos[1] += corners[i][k][1]/4;
+
+			// the undistortion table only takes whole pixels
+			if(undistMode==UNDIST_LUT)
+				arCamera->observ2Ideal(corners[i][k][0], corners[i][k][1], &m.vertex[k][0], &m.vertex[k][1]);
+			else
+				(this->*arParamObserv2Ideal_func)(arCamera, corners[i][k][0], corners[i][k][1], &m.vertex[k][0], &m.vertex[k][1]);
+		}
+
+		// line k runs from vertex k to vertex k+1 (see arGetLine2())
+		for(k=0; k<4; k++)
+		{
+			const ARFloat *a = m.vertex[k], *b = m.vertex[(k+1)%4];
+			ARFloat dx = b[0]-a[0], dy = b[1]-a[1], len = (ARFloat)sqrt(dx*dx+dy*dy);
+
+			m.line[k][0] = dy/len;
+			m.line[k][1] = -dx/len;
+			m.line[k][2] = -(m.line[k][0]*a[0] + m.line[k][1]*a[1]);
+		}
+
+		marker_infoL[i] = m;
+	}
+
+	memcpy(cornerTracking.corners, corners, cornerTracking.numMarkers*sizeof(corners[0]));
+
+	wmarker_info = marker_infoL;
+	wmarker_num = cornerTracking.numMarkers;
+
+	cornerTracking.prev = 1-cornerTracking.prev;
+	cornerTracking.numFrames++;
+	cornerTracking.tracked = true;
+	cornerTracking.valid = true;
+
+	// for the motion gate this counts as a completely processed frame
+	labelRegion.active = false;
+	motionGate.state = MotionGate::FRAME_FULL;
+
+	return true;
+}
+
+
+// called after a full detection, once the ids of wmarker_info are final (but before
+// markers of the tracking history are added): the identified markers are followed next
+//
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::arUpdateCornerTracking(uint8_t *dataPtr)
+{
+	const int border = (CornerTracking::WINDOW_RADIUS+2)*2;
+	int i, k, n;
+
+	if(!cornerTracking.enabled || cornerTracking.tracked || !cornerTracking.memory)
+		return;
+
+	for(i=n=0; i<wmarker_num && n<MAX_IMAGE_PATTERNS; i++)
+	{
+		if(wmarker_info[i].id<0)
+			continue;
+
+		for(k=0; k<4; k++)
+		{
+			ARFloat *c = cornerTracking.corners[n][k];
+
+			if(undistMode==UNDIST_NONE)
+			{
+				c[0] = wmarker_info[i].vertex[k][0];
+				c[1] = wmarker_info[i].vertex[k][1];
+			}
+			else
+				arParamIdeal2Observ(arCamera, wmarker_info[i].vertex[k][0], wmarker_info[i].vertex[k][1], &c[0], &c[1]);
+
+			// corners that close to the image border are lost by the next frame anyway
+			if(c[0]<border || c[1]<border || c[0]>=arImXsize-border || c[1]>=arImYsize-border)
+				break;
+		}
+
+		if(k==4)
+			cornerTracking.markers[n++] = wmarker_info[i];
+	}
+
+	if(n>0)
+		arBuildTrackingPyramid(dataPtr, cornerTracking.corners, n);
+
+	cornerTracking.numMarkers = n;
+	cornerTracking.numFrames = 0;
+	cornerTracking.prev = 1-cornerTracking.prev;
+	cornerTracking.valid = n>0;
+}
+
+
+// luminance pyramid of the current frame into pyramid[1-prev]. only the bounding box of
+// nCorners plus CornerTracking::MARGIN pixels is built, aligned to the coarsest level.
+// the first level is the 2x2 mean of the camera image, (r+g+b)/3 for the color formats.
+//
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::arBuildTrackingPyramid(uint8_t *dataPtr, const ARFloat nCorners[][4][2], int nNum)
+{
+	const int	levels = CornerTracking::LEVELS, align = 1<<levels;
+	const int	rowSize = arImXsize*pixelSize;
+	const int	offs = (pixelFormat==PIXEL_FORMAT_ABGR) ? 1 : 0;
+	const int	cur = 1-cornerTracking.prev;
+	uint8_t		**dst = cornerTracking.pyramid[cur];
+	ARFloat		minX = (ARFloat)arImXsize, minY = (ARFloat)arImYsize, maxX = 0, maxY = 0;
+	int			x, y, l;
+
+	for(int i=0; i<nNum; i++)
+		for(int k=0; k<4; k++)
+		{
+			if(nCorners[i][k][0]<minX) minX = nCorners[i][k][0];
+			if(nCorners[i][k][0]>maxX) maxX = nCorners[i][k][0];
+			if(nCorners[i][k][1]<minY) minY = nCorners[i][k][1];
+			if(nCorners[i][k][1]>maxY) maxY = nCorners[i][k][1];
+		}
+
+	// region in camera pixels, x1/y1 exclusive
+	int x0 = ((int)minX - CornerTracking::MARGIN) & ~(align-1), y0 = ((int)minY - CornerTracking::MARGIN) & ~(align-1);
+	int x1 = ((int)maxX + CornerTracking::MARGIN + align) & ~(align-1), y1 = ((int)maxY + CornerTracking::MARGIN + align) & ~(align-1);
+
+	if(x0<0) x0 = 0;
+	if(y0<0) y0 = 0;
+	if(x1>(arImXsize & ~(align-1))) x1 = arImXsize & ~(align-1);
+	if(y1>(arImYsize & ~(align-1))) y1 = arImYsize & ~(align-1);
+
+	for(l=0; l<levels; l++)
+	{
+		int *reg = cornerTracking.region[cur][l];
+		reg[0] = x0>>(l+1);  reg[1] = y0>>(l+1);
+		reg[2] = x1>>(l+1);  reg[3] = y1>>(l+1);
+	}
+
+	const int w = cornerTracking.width[0], rx0 = x0/2, rx1 = x1/2;
+
+	for(y=y0/2; y<y1/2; y++)
+	{
+		const uint8_t *p0 = dataPtr + 2*y*rowSize + 2*rx0*pixelSize, *p1 = p0 + rowSize;
+		uint8_t *d = dst[0] + y*w;
+
+		switch(pixelFormat)
+		{
+		case PIXEL_FORMAT_LUM:
+			for(x=rx0; x<rx1; x++, p0+=2, p1+=2)
+				d[x] = (uint8_t)((p0[0] + p0[1] + p1[0] + p1[1] + 2) >> 2);
+			break;
+
+		case PIXEL_FORMAT_RGB565:
+			for(x=rx0; x<rx1; x++, p0+=4, p1+=4)
+				d[x] = (uint8_t)((getLUM8_from_RGB565(p0) + getLUM8_from_RGB565(p0+2) +
+								  getLUM8_from_RGB565(p1) + getLUM8_from_RGB565(p1+2) + 2) >> 2);
+			break;
+
+		case PIXEL_FORMAT_RGB:
+		case PIXEL_FORMAT_BGR:
+			for(x=rx0; x<rx1; x++, p0+=6, p1+=6)
+				d[x] = (uint8_t)((p0[0] + p0[1] + p0[2] + p0[3] + p0[4] + p0[5] +
+								  p1[0] + p1[1] + p1[2] + p1[3] + p1[4] + p1[5] + 6) / 12);
+			break;
+
+		default:
+			p0 += offs;  p1 += offs;
+			for(x=rx0; x<rx1; x++, p0+=8, p1+=8)
+				d[x] = (uint8_t)((p0[0] + p0[1] + p0[2] + p0[4] + p0[5] + p0[6] +
+								  p1[0] + p1[1] + p1[2] + p1[4] + p1[5] + p1[6] + 6) / 12);
+			break;
+		}
+	}
+
+	for(l=1; l<levels; l++)
+	{
+		const int *reg = cornerTracking.region[cur][l];
+		const int sw = cornerTracking.width[l-1], dw = cornerTracking.width[l];
+
+		for(y=reg[1]; y<reg[3]; y++)
+		{
+			const uint8_t *s0 = dst[l-1] + 2*y*sw + 2*reg[0], *s1 = s0 + sw;
+			uint8_t *d = dst[l] + y*dw;
+
+			for(x=reg[0]; x<reg[2]; x++, s0+=2, s1+=2)
+				d[x] = (uint8_t)((s0[0] + s0[1] + s1[0] + s1[1] + 2) >> 2);
+		}
+	}
+}
+
+
+// bilinearly interpolated (2*nRadius+1)^2 window around (nX,nY), false if it does not
+// fit into nRegion (x0,y0,x1,y1 with x1,y1 exclusive)
+//
+AR_TEMPL_FUNC bool
+AR_TEMPL_TRACKER::arSampleTrackingWindow(const uint8_t *nImage, int nWidth, const int nRegion[4], ARFloat nX, ARFloat nY,
+										 int nRadius, ARFloat *nWindow)
+{
+	if(nX<nRegion[0]+nRadius || nY<nRegion[1]+nRadius || nX>=nRegion[2]-nRadius-1 || nY>=nRegion[3]-nRadius-1)
+		return false;
+
+	const int		ix = (int)nX, iy = (int)nY, n = 2*nRadius+1;
+	const ARFloat	fx = nX-ix, fy = nY-iy;
+	const ARFloat	w00 = (1-fx)*(1-fy), w01 = fx*(1-fy), w10 = (1-fx)*fy, w11 = fx*fy;
+
+	for(int y=0; y<n; y++)
+	{
+		const uint8_t *p0 = nImage + (iy-nRadius+y)*nWidth + ix-nRadius, *p1 = p0 + nWidth;
+
+		for(int x=0; x<n; x++)
+			*nWindow++ = w00*p0[x] + w01*p0[x+1] + w10*p1[x] + w11*p1[x+1];
+	}
+
+	return true;
+}
+
+
+// pyramidal Lucas-Kanade: follows (nX,nY) of the first level of the last frame's pyramid
+// into the current one. coarse levels where the window does not fit or has too little
+// structure are skipped, the first level has to succeed.
+//
+AR_TEMPL_FUNC bool
+AR_TEMPL_TRACKER::arTrackCorner(ARFloat nX, ARFloat nY, ARFloat *nNewX, ARFloat *nNewY)
+{
+	const int	levels = CornerTracking::LEVELS, r = CornerTracking::WINDOW_RADIUS;
+	const int	n = 2*r+1, np = n+2;
+	ARFloat		prevWin[(2*CornerTracking::WINDOW_RADIUS+3)*(2*CornerTracking::WINDOW_RADIUS+3)];
+	ARFloat		gradX[(2*CornerTracking::WINDOW_RADIUS+1)*(2*CornerTracking::WINDOW_RADIUS+1)];
+	ARFloat		gradY[(2*CornerTracking::WINDOW_RADIUS+1)*(2*CornerTracking::WINDOW_RADIUS+1)];
+	ARFloat		curWin[(2*CornerTracking::WINDOW_RADIUS+1)*(2*CornerTracking::WINDOW_RADIUS+1)];
+	ARFloat		px[CornerTracking::LEVELS], py[CornerTracking::LEVELS];
+	ARFloat		dx = 0, dy = 0, residual = 0;
+	int			l, x, y, i;
+
+	px[0] = nX;
+	py[0] = nY;
+	for(l=1; l<levels; l++)
+	{
+		px[l] = (px[l-1]-(ARFloat)0.5)/2;
+		py[l] = (py[l-1]-(ARFloat)0.5)/2;
+	}
+
+	for(l=levels-1; l>=0; l--)
+	{
+		const int		prev = cornerTracking.prev, cur = 1-prev, w = cornerTracking.width[l];
+		const uint8_t	*prevImg = cornerTracking.pyramid[prev][l], *curImg = cornerTracking.pyramid[cur][l];
+
+		if(l<levels-1)
+		{
+			dx *= 2;
+			dy *= 2;
+		}
+
+		if(!arSampleTrackingWindow(prevImg, w, cornerTracking.region[prev][l], px[l], py[l], r+1, prevWin))
+		{
+			if(l==0)
+				return false;
+			continue;
+		}
+
+		// gradient matrix of the window of the last frame
+		//
+		ARFloat gxx = 0, gxy = 0, gyy = 0;
+
+		for(y=0, i=0; y<n; y++)
+			for(x=0; x<n; x++, i++)
+			{
+				const ARFloat *p = prevWin + (y+1)*np + x+1;
+
+				gradX[i] = (p[1]-p[-1]) / 2;
+				gradY[i] = (p[np]-p[-np]) / 2;
+				gxx += gradX[i]*gradX[i];
+				gxy += gradX[i]*gradY[i];
+				gyy += gradY[i]*gradY[i];
+			}
+
+		const ARFloat det = gxx*gyy - gxy*gxy;
+		const ARFloat minEigen = (gxx + gyy - (ARFloat)sqrt((gxx-gyy)*(gxx-gyy) + 4*gxy*gxy)) / 2;
+
+		if(det<=0 || minEigen<(ARFloat)CornerTracking::MIN_EIGEN*n*n)
+		{
+			if(l==0)
+				return false;
+			continue;
+		}
+
+		for(int iter=0; iter<CornerTracking::MAX_ITERATIONS; iter++)
+		{
+			ARFloat bx = 0, by = 0;
+
+			if(!arSampleTrackingWindow(curImg, w, cornerTracking.region[cur][l], px[l]+dx, py[l]+dy, r, curWin))
+				return false;
+
+			residual = 0;
+			for(y=0, i=0; y<n; y++)
+				for(x=0; x<n; x++, i++)
+				{
+					ARFloat diff = prevWin[(y+1)*np + x+1] - curWin[i];
+
+					bx += diff*gradX[i];
+					by += diff*gradY[i];
+					residual += diff>0 ? diff : -diff;
+				}
+
+			const ARFloat ddx = (gyy*bx - gxy*by) / det;
+			const ARFloat ddy = (gxx*by - gxy*bx) / det;
+
+			dx += ddx;
+			dy += ddy;
+
+			if(ddx*ddx + ddy*ddy < (ARFloat)0.03*0.03*(1<<(2*l)))
+				break;
+		}
+	}
+
+	if(residual > (ARFloat)CornerTracking::MAX_RESIDUAL*n*n)
+		return false;
+
+	*nNewX = px[0]+dx;
+	*nNewY = py[0]+dy;
+	return true;
+}
+
+
+// the black border of a marker (corners on the first pyramid level) has to be darker
+// than its surroundings: three points along each edge are sampled in the middle of the
+// border and the same distance outside of it. one of the twelve may fail.
+//
+AR_TEMPL_FUNC bool
+AR_TEMPL_TRACKER::arCheckTrackedBorder(const ARFloat nCorners[4][2])
+{
+	const uint8_t	*img = cornerTracking.pyramid[1-cornerTracking.prev][0];
+	const int		w = cornerTracking.width[0], *reg = cornerTracking.region[1-cornerTracking.prev][0];
+	const ARFloat	b = relBorderWidth/2;
+	int				numFailed = 0;
+
+	for(int k=0; k<4; k++)
+	{
+		const ARFloat *a = nCorners[k], *c = nCorners[(k+1)%4], *oa = nCorners[(k+3)%4], *oc = nCorners[(k+2)%4];
+
+		for(int s=1; s<4; s++)
+		{
+			const ARFloat t = s*(ARFloat)0.25;
+			const ARFloat ex = a[0] + t*(c[0]-a[0]), ey = a[1] + t*(c[1]-a[1]);
+			const ARFloat fx = oa[0] + t*(oc[0]-oa[0]), fy = oa[1] + t*(oc[1]-oa[1]);
+			const int ix = (int)(ex + b*(fx-ex) + (ARFloat)0.5), iy = (int)(ey + b*(fy-ey) + (ARFloat)0.5);
+			const int ox = (int)(ex - b*(fx-ex) + (ARFloat)0.5), oy = (int)(ey - b*(fy-ey) + (ARFloat)0.5);
+
+			if(ox<reg[0] || oy<reg[1] || ox>=reg[2] || oy>=reg[3] || ix<reg[0] || iy<reg[1] || ix>=reg[2] || iy>=reg[3])
+				return false;
+
+			if((int)img[oy*w+ox] - (int)img[iy*w+ix] < CornerTracking::MIN_BORDER_CONTRAST)
+				numFailed++;
+		}
+	}
+
+	return numFailed<=1;
+}
+
+
+}	// namespace ARToolKitPlus
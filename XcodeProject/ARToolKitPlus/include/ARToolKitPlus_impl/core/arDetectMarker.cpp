@@ -40,6 +40,7 @@
 
 #include <ARToolKitPlus/Tracker.h>
 #include <stdio.h>
+#include <string.h>
 
 
 namespace ARToolKitPlus {
@@ -50,7 +51,7 @@ namespace ARToolKitPlus {
 AR_TEMPL_FUNC int
 AR_TEMPL_TRACKER::arDetectMarker(uint8_t *dataPtr, int _thresh, ARMarkerInfo **marker_info, int *marker_num)
 {
-    int16_t                *limage=NULL;
+    void                   *limage=NULL;
     int                    label_num;
     int                    *area, *clip, *label_ref;
     ARFloat                 *pos;
@@ -58,10 +59,22 @@ AR_TEMPL_TRACKER::arDetectMarker(uint8_t *dataPtr, int _thresh, ARMarkerInfo **m
     ARFloat                 diff, diffmin;
     int                    cid, cdir;
     int                    i, j, k;
-    
-    trackedCorners.clear();
-	autoThreshold.reset();
+    
 	checkImageBuffer();
+	frameScratch.reset();
+	memset(earlyReject.numRejected, 0, sizeof(earlyReject.numRejected));
+	arStatsBeginDetect(_thresh);
+
+	// motion gate: nothing changed since the last processed frame
+	if(arCheckMotionGate(dataPtr, _thresh)==MotionGate::FRAME_UNCHANGED)
+	{
+		*marker_info = arGetMotionGateResult(marker_num);
+		frameStats.frame.unchanged = true;
+		arStatsEndDetect(*marker_info, *marker_num);
+		return 0;
+	}
+
+	autoThreshold.reset();
 
 //	FILE* fp = fopen("imgdump.raw", "wb");
 //	fwrite(dataPtr, 1, 320*240*2, fp);
@@ -69,35 +82,43 @@ AR_TEMPL_TRACKER::arDetectMarker(uint8_t *dataPtr, int _thresh, ARMarkerInfo **m
 
     *marker_num = 0;
 
-	for(int numTries = 0;;)
+	// candidates at the position of a marker of the last frame are only verified
+	decodeCache.numHistory = decodeCache.enabled ? prev_num : 0;
+
+	if(arTrackMarkerCorners(dataPtr))
 	{
-		limage = arLabeling(dataPtr, _thresh, &label_num, &area, &pos, &clip, &label_ref);
-		if(limage)
+		// corner tracking followed every marker of the last frame, nothing to label
+		frameStats.frame.tracked = true;
+	}
+	else if(multiThreshold.enabled && !adaptiveThreshold.enabled)
+	{
+		// one pass over the image, markers from all thresholds
+		wmarker_info = arDetectMarkerMultiThreshold(dataPtr, _thresh, &wmarker_num);
+		if(!wmarker_info)
 		{
-			marker_info2 = arDetectMarker2(limage, label_num, label_ref, area, pos, clip, AR_AREA_MAX, AR_AREA_MIN, 1.0, &wmarker_num);
-			assert(wmarker_num <= MAX_IMAGE_PATTERNS);
-			if(marker_info2)
-			{
-				wmarker_info = arGetMarkerInfo(dataPtr, marker_info2, &wmarker_num, _thresh);
-				assert(wmarker_num <= MAX_IMAGE_PATTERNS);
-				if(wmarker_info && wmarker_num>0)
-					break;
-			}
+			arStatsEndDetect(NULL, -1);
+			return -1;
 		}
+	}
+	else
+	{
+		limage = arLabeling(dataPtr, _thresh, &label_num, &area, &pos, &clip, &label_ref);
+		int found = arDetectMarkerLabels(dataPtr, _thresh, limage, label_num, area, pos, clip, label_ref);
 
-		if(!autoThreshold.enable)
-			break;
-		else
+		// adaptive thresholding does not depend on thresh, a retry would give the same result.
+		// a partial frame (motion gate) often has no marker in the changed region at all.
+		if(found<=0 && autoThreshold.enable && !adaptiveThreshold.enabled && !labelRegion.active)
+			found = arDetectMarkerRetries(dataPtr, _thresh, _thresh);
+
+		if(found<0)
 		{
-			_thresh = thresh = (rand() % 230) + 10;
-			if(++numTries>autoThreshold.numRandomRetries)
-				break;
+			arStatsEndDetect(NULL, -1);
+			return -1;
 		}
-
 	}
 
-	if(!limage || !marker_info2 || !wmarker_info)
-		return -1;
+	decodeCache.numHistory = 0;
+	arUpdateMotionGate();
 
     for( i = 0; i < prev_num; i++ ) {
         rlenmin = 10.0;
@@ -137,9 +158,14 @@ AR_TEMPL_TRACKER::arDetectMarker(uint8_t *dataPtr, int _thresh, ARMarkerInfo **m
     }
 
     for( i = 0; i < wmarker_num; i++ ) {
-        if( wmarker_info[i].cf < 0.5 ) wmarker_info[i].id = -1;
+        if( wmarker_info[i].cf < 0.5 ) {
+            wmarker_info[i].id = -1;
+            frameStats.frame.numRejected[CANDIDATE_REJECT_CF]++;
+        }
    }
 
+	arUpdateCornerTracking(dataPtr);
+
 
 /*------------------------------------------------------------*/
 
@@ -192,9 +218,14 @@ AR_TEMPL_TRACKER::arDetectMarker(uint8_t *dataPtr, int _thresh, ARMarkerInfo **m
 
 	assert(*marker_num <= MAX_IMAGE_PATTERNS);
 
-	if(autoThreshold.enable)
+	// the markers of a partial frame (motion gate) are no fair sample for the threshold,
+	// a tracked frame (corner tracking) has not looked at the markers' pixels at all
+	if(autoThreshold.enable && !labelRegion.active && !cornerTracking.tracked)
 		thresh = autoThreshold.calc();
 
+	arStoreMotionGateResult(_thresh);
+	arStatsEndDetect(*marker_info, *marker_num);
+
     return 0;
 }
 
@@ -204,68 +235,85 @@ AR_TEMPL_TRACKER::arDetectMarker(uint8_t *dataPtr, int _thresh, ARMarkerInfo **m
 AR_TEMPL_FUNC int
 AR_TEMPL_TRACKER::arDetectMarkerLite(uint8_t *dataPtr, int _thresh, ARMarkerInfo **marker_info, int *marker_num)
 {
-    int16_t                *limage = NULL;
+    void                   *limage = NULL;
     int                    label_num;
     int                    *area, *clip, *label_ref;
     ARFloat                 *pos;
     int                    i;
-
-    trackedCorners.clear();
 
-	autoThreshold.reset();
 	checkImageBuffer();
+	frameScratch.reset();
+	memset(earlyReject.numRejected, 0, sizeof(earlyReject.numRejected));
+	arStatsBeginDetect(_thresh);
+
+	if(arCheckMotionGate(dataPtr, _thresh)==MotionGate::FRAME_UNCHANGED)
+	{
+		*marker_info = arGetMotionGateResult(marker_num);
+		frameStats.frame.unchanged = true;
+		arStatsEndDetect(*marker_info, *marker_num);
+		return 0;
+	}
+
+	autoThreshold.reset();
 
     *marker_num = 0;
+	decodeCache.numHistory = 0;		// no tracking history to predict codes from
 
-	for(int numTries = 0;;)
+	if(arTrackMarkerCorners(dataPtr))
 	{
-		limage = arLabeling(dataPtr, _thresh, &label_num, &area, &pos, &clip, &label_ref);
-		if(limage)
+		// corner tracking followed every marker of the last frame, nothing to label
+		frameStats.frame.tracked = true;
+	}
+	else if(multiThreshold.enabled && !adaptiveThreshold.enabled)
+	{
+		// one pass over the image, markers from all thresholds
+		wmarker_info = arDetectMarkerMultiThreshold(dataPtr, _thresh, &wmarker_num);
+		if(!wmarker_info)
 		{
-			marker_info2 = arDetectMarker2(limage, label_num, label_ref, area, pos, clip, AR_AREA_MAX, AR_AREA_MIN, 1.0, &wmarker_num);
-			if(marker_info2)
-			{
-				wmarker_info = arGetMarkerInfo(dataPtr, marker_info2, &wmarker_num, _thresh);
-				if(wmarker_info && wmarker_num>0)
-					break;
-			}
+			arStatsEndDetect(NULL, -1);
+			return -1;
 		}
+	}
+	else
+	{
+		limage = arLabeling(dataPtr, _thresh, &label_num, &area, &pos, &clip, &label_ref);
+		int found = arDetectMarkerLabels(dataPtr, _thresh, limage, label_num, area, pos, clip, label_ref);
 
-		if(!autoThreshold.enable)
-			break;
-		else
+		// adaptive thresholding does not depend on thresh, a retry would give the same result.
+		// a partial frame (motion gate) often has no marker in the changed region at all.
+		if(found<=0 && autoThreshold.enable && !adaptiveThreshold.enabled && !labelRegion.active)
+			found = arDetectMarkerRetries(dataPtr, _thresh, _thresh);
+
+		if(found<0)
 		{
-			_thresh = thresh = (rand() % 230) + 10;
-			if(++numTries>autoThreshold.numRandomRetries)
-				break;
+			arStatsEndDetect(NULL, -1);
+			return -1;
 		}
-
 	}
 
-	if(!limage || !marker_info2 || !wmarker_info)
-		return -1;
-
-
-    limage = arLabeling(dataPtr, _thresh, &label_num, &area, &pos, &clip, &label_ref);
-    if( limage == 0 )    return -1;
+	arUpdateMotionGate();
 
-    marker_info2 = arDetectMarker2(limage, label_num, label_ref, area, pos, clip, AR_AREA_MAX, AR_AREA_MIN, 1.0, &wmarker_num);
-    if( marker_info2 == 0 ) return -1;
-
-    wmarker_info = arGetMarkerInfo(dataPtr, marker_info2, &wmarker_num, _thresh);
-    if( wmarker_info == 0 ) return -1;
+    for( i = 0; i < wmarker_num; i++ ) {
+        if( wmarker_info[i].cf < 0.5 ) {
+            wmarker_info[i].id = -1;
+            frameStats.frame.numRejected[CANDIDATE_REJECT_CF]++;
+        }
+    }
 
-    for( i = 0; i < wmarker_num; i++ )
-        if( wmarker_info[i].cf < 0.5 )
-			wmarker_info[i].id = -1;
+	arUpdateCornerTracking(dataPtr);
 
 
     *marker_num  = wmarker_num;
     *marker_info = wmarker_info;
 
-	if(autoThreshold.enable)
+	// the markers of a partial frame (motion gate) are no fair sample for the threshold,
+	// a tracked frame (corner tracking) has not looked at the markers' pixels at all
+	if(autoThreshold.enable && !labelRegion.active && !cornerTracking.tracked)
 		thresh = autoThreshold.calc();
 
+	arStoreMotionGateResult(_thresh);
+	arStatsEndDetect(*marker_info, *marker_num);
+
     return 0;
 }
 
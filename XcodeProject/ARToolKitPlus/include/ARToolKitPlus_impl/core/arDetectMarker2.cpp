@@ -48,15 +48,30 @@ static int get_vertex( int x_coord[], int y_coord[], int st,  int ed,
 
 
 AR_TEMPL_FUNC ARMarkerInfo2*
-AR_TEMPL_TRACKER::arDetectMarker2(int16_t *limage, int label_num, int *label_ref,
+AR_TEMPL_TRACKER::arDetectMarker2(void *limage, int label_num, int *label_ref,
+                    int *warea, ARFloat *wpos, int *wclip,
+                    int area_max, int area_min, ARFloat factor, int *marker_num)
+{
+	if(labelSize==sizeof(int32_t))
+		return arDetectMarker2((int32_t*)limage, label_num, label_ref, warea, wpos, wclip, area_max, area_min, factor, marker_num);
+	else
+		return arDetectMarker2((int16_t*)limage, label_num, label_ref, warea, wpos, wclip, area_max, area_min, factor, marker_num);
+}
+
+
+AR_TEMPL_FUNC template<class LABEL_T> ARMarkerInfo2*
+AR_TEMPL_TRACKER::arDetectMarker2(LABEL_T *limage, int label_num, int *label_ref,
                     int *warea, ARFloat *wpos, int *wclip,
                     int area_max, int area_min, ARFloat factor, int *marker_num)
 {
     ARMarkerInfo2     *pm;
     int               xsize, ysize;
+    int               xmin, ymin, xmax, ymax;
     int               marker_num2;
     int               i, j, ret;
     ARFloat            d;
+	int               *rejected = frameStats.frame.numRejected;
+	uint64_t           begin = arStatsClock();
 
 	PROFILE_BEGINSEC(profiler, DETECTMARKER2)
 
@@ -70,18 +85,41 @@ AR_TEMPL_TRACKER::arDetectMarker2(int16_t *limage, int label_num, int *label_ref
         xsize = arImXsize;
         ysize = arImYsize;
     }
+
+    // squares touching the border of the labeled window might be cut off
+    if( labelRegion.active ) {
+        xmin = labelRegion.x0+1;  xmax = labelRegion.x1-2;
+        ymin = labelRegion.y0+1;  ymax = labelRegion.y1-2;
+    }
+    else {
+        xmin = ymin = 1;
+        xmax = xsize-2;  ymax = ysize-2;
+    }
+
     marker_num2 = 0;
     for(i=0; i<label_num; i++ ) {
-        if( warea[i] < area_min || warea[i] > area_max ) continue;
-        if( wclip[i*4+0] == 1 || wclip[i*4+1] == xsize-2 ) continue;
-        if( wclip[i*4+2] == 1 || wclip[i*4+3] == ysize-2 ) continue;
+        if( warea[i] < area_min || warea[i] > area_max ) {
+            rejected[CANDIDATE_REJECT_AREA]++;
+            continue;
+        }
+        if( wclip[i*4+0] == xmin || wclip[i*4+1] == xmax ||
+            wclip[i*4+2] == ymin || wclip[i*4+3] == ymax ) {
+            rejected[CANDIDATE_REJECT_CLIP]++;
+            continue;
+        }
 
         ret = arGetContour( limage, label_ref, i+1,
                             &(wclip[i*4]), &(marker_infoTWO[marker_num2]));
-        if( ret < 0 ) continue;
+        if( ret < 0 ) {
+            rejected[CANDIDATE_REJECT_CONTOUR]++;
+            continue;
+        }
 
         ret = check_square( warea[i], &(marker_infoTWO[marker_num2]), factor );
-        if( ret < 0 ) continue;
+        if( ret < 0 ) {
+            rejected[CANDIDATE_REJECT_SQUARE]++;
+            continue;
+        }
 
         marker_infoTWO[marker_num2].area   = warea[i];
         marker_infoTWO[marker_num2].pos[0] = wpos[i*2+0];
@@ -115,6 +153,7 @@ AR_TEMPL_TRACKER::arDetectMarker2(int16_t *limage, int label_num, int *label_ref
                 marker_infoTWO[j-1] = marker_infoTWO[j];
             }
             marker_num2--;
+            rejected[CANDIDATE_REJECT_OVERLAP]++;
         }
     }
 
@@ -134,19 +173,21 @@ AR_TEMPL_TRACKER::arDetectMarker2(int16_t *limage, int label_num, int *label_ref
 
 	PROFILE_ENDSEC(profiler, DETECTMARKER2)
 
+	frameStats.frame.nanoseconds[FRAME_STAGE_CONTOUR] += (unsigned int)(arStatsClock()-begin);
+
     *marker_num = marker_num2;
     return( &(marker_infoTWO[0]) );
 }
 
 
-AR_TEMPL_FUNC int
-AR_TEMPL_TRACKER::arGetContour(int16_t *limage, int *label_ref, int label, int clip[4], ARMarkerInfo2 *marker_infoTWO)
+AR_TEMPL_FUNC template<class LABEL_T> int
+AR_TEMPL_TRACKER::arGetContour(LABEL_T *limage, int *label_ref, int label, int clip[4], ARMarkerInfo2 *marker_infoTWO)
 {
     static const int      xdir[8] = { 0, 1, 1, 1, 0,-1,-1,-1};
     static const int      ydir[8] = {-1,-1, 0, 1, 1, 1, 0,-1};
     //static int      wx[AR_CHAIN_MAX];
     //static int      wy[AR_CHAIN_MAX];
-    int16_t         *p1;
+    LABEL_T         *p1;
     int             xsize, ysize;
     int             sx, sy, dir;
     int             dmax, d, v1 = 0;
@@ -168,7 +209,9 @@ AR_TEMPL_TRACKER::arGetContour(int16_t *limage, int *label_ref, int label, int c
         }
     }
     if( i > clip[1] ) {
-        printf("??? 1\n"); return(-1);
+        if(logger)
+            logger->artLogEx("ARToolKitPlus: arGetContour: no pixel of label %d in its clip rectangle\n", label);
+        return(-1);
     }
 
     marker_infoTWO->coord_num = 1;
@@ -184,7 +227,9 @@ AR_TEMPL_TRACKER::arGetContour(int16_t *limage, int *label_ref, int label, int c
             dir = (dir+1)%8;
         }
         if( i == 8 ) {
-            printf("??? 2\n"); return(-1);
+            if(logger)
+                logger->artLogEx("ARToolKitPlus: arGetContour: label %d is a single pixel\n", label);
+            return(-1);
         }
         marker_infoTWO->x_coord[marker_infoTWO->coord_num]
             = marker_infoTWO->x_coord[marker_infoTWO->coord_num-1] + xdir[dir];
@@ -194,7 +239,9 @@ AR_TEMPL_TRACKER::arGetContour(int16_t *limage, int *label_ref, int label, int c
          && marker_infoTWO->y_coord[marker_infoTWO->coord_num] == sy ) break;
         marker_infoTWO->coord_num++;
         if( marker_infoTWO->coord_num == AR_CHAIN_MAX-1 ) {
-            printf("??? 3\n"); return(-1);
+            if(logger)
+                logger->artLogEx("ARToolKitPlus: arGetContour: contour of label %d is longer than %d pixels\n", label, AR_CHAIN_MAX);
+            return(-1);
         }
     }
 
@@ -0,0 +1,303 @@
+/* ========================================================================
+ * PROJECT: ARToolKitPlus
+ * ========================================================================
+ * This work is based on the original ARToolKit developed by
+ *   Hirokazu Kato
+ *   Mark Billinghurst
+ *   HITLab, University of Washington, Seattle
+ * http://www.hitl.washington.edu/artoolkit/
+ *
+ * Copyright of the derived and new portions of this work
+ *     (C) 2006 Graz University of Technology
+ *
+ * This framework is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this framework; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * For further information please contact 
+ *   Dieter Schmalstieg
+ *   <schmalstieg@icg.tu-graz.ac.at>
+ *   Graz University of Technology, 
+ *   Institut for Computer Graphics and Vision,
+ *   Inffeldgasse 16a, 8010 Graz, Austria.
+ * ========================================================================
+ ** @author   Daniel Wagner
+ *
+ * $Id$
+ * @file
+ * ======================================================================== */
+
+
+#include <string.h>
+#include <time.h>
+#include <ARToolKitPlus/Tracker.h>
+
+#if !defined(WIN32) && !defined(_WIN32_WCE)
+#  include <sys/time.h>
+#endif
+
+
+namespace ARToolKitPlus {
+
+
+// the statistics cost a few clock reads and counter increments per frame, so they
+// are always on. arDetectMarker() and friends count into the detection fields of
+// frameStats.frame while the frame is processed, arStatsEndDetect() copies them into
+// the history. the pose fields are handled the same way by the pose thread, so
+// detection and pose estimation never write to the same fields.
+//
+// every frame has one history entry. the pose stage may run behind the detection
+// (TrackerPipeline), so arStatsEndDetect() queues the number of every frame that
+// will be posed and arStatsBeginPose() takes the next one: the pose values end up
+// in the entry of the frame whose markers were posed.
+
+
+AR_TEMPL_FUNC uint64_t
+AR_TEMPL_TRACKER::arStatsClock()
+{
+#if defined(WIN32) || defined(_WIN32_WCE)
+	static LARGE_INTEGER freq = { 0 };
+	LARGE_INTEGER now;
+	if(freq.QuadPart==0)
+		QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+	return (uint64_t)((double)now.QuadPart*1.0e9/(double)freq.QuadPart);
+#elif defined(CLOCK_MONOTONIC)
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec*1000000000u + (uint64_t)ts.tv_nsec;
+#else
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (uint64_t)tv.tv_sec*1000000000u + (uint64_t)tv.tv_usec*1000u;
+#endif
+}
+
+
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::arStatsBeginDetect(int nThresh)
+{
+	FrameStats& f = frameStats.frame;
+
+	f.numLabels = 0;
+	f.numCandidates = 0;
+	f.numMarkers = 0;
+	memset(f.numRejected, 0, sizeof(f.numRejected));
+	f.threshold = nThresh;
+	f.numRetries = 0;
+	f.unchanged = false;
+	f.tracked = false;
+	for(int i=0; i<FRAME_STAGE_POSE; i++)
+		f.nanoseconds[i] = 0;
+
+	frameStats.detectBegin = arStatsClock();
+}
+
+
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::arStatsEndDetect(const ARMarkerInfo *nMarkers, int nNum)
+{
+	const unsigned int window = FrameStatsSummary::WINDOW;
+	FrameStats& f = frameStats.frame;
+	FrameStats& h = frameStats.history[frameStats.numDetected % window];
+	int i;
+
+	f.nanoseconds[FRAME_STAGE_DETECT] = (unsigned int)(arStatsClock()-frameStats.detectBegin);
+
+	f.numMarkers = 0;
+	for(i=0; i<nNum; i++)
+		if(nMarkers[i].id>=0)
+			f.numMarkers++;
+
+	for(i=0; i<EARLY_REJECT_NUM_REASONS; i++)
+		f.numRejected[CANDIDATE_REJECT_EARLY] += earlyReject.numRejected[i];
+
+	h.numLabels = f.numLabels;
+	h.numCandidates = f.numCandidates;
+	h.numMarkers = f.numMarkers;
+	memcpy(h.numRejected, f.numRejected, sizeof(h.numRejected));
+	h.threshold = f.threshold;
+	h.numRetries = f.numRetries;
+	h.unchanged = f.unchanged;
+	h.tracked = f.tracked;
+	for(i=0; i<FRAME_STAGE_POSE; i++)
+		h.nanoseconds[i] = f.nanoseconds[i];
+
+	// filled in by arStatsEndPose() if the frame gets a pose
+	h.numPoses = 0;
+	h.poseIterations = 0;
+	h.poseError = -1.0f;
+	h.nanoseconds[FRAME_STAGE_POSE] = 0;
+
+	// calc() and TrackerPipeline only run the pose stage if detection succeeded. plain
+	// arDetectMarker() calls are not queued, nothing would ever take them off again
+	if(nNum>=0 && frameStats.poseFollows)
+		frameStats.poseFrames[frameStats.numQueued++ % window] = frameStats.numDetected;
+	frameStats.poseFollows = false;
+
+	frameStats.numDetected++;
+}
+
+
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::arStatsBeginPose()
+{
+	FrameStats& f = frameStats.frame;
+
+	f.numPoses = 0;
+	f.poseIterations = 0;
+	f.poseError = -1.0f;
+	f.nanoseconds[FRAME_STAGE_POSE] = 0;
+
+	frameStats.poseFrame = frameStats.poseFrames[frameStats.numPosed++ % FrameStatsSummary::WINDOW];
+	frameStats.poseBegin = arStatsClock();
+}
+
+
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::arStatsEndPose()
+{
+	FrameStats& f = frameStats.frame;
+
+	// nothing was posed (no marker, or unchanged markers kept their pose)
+	if(f.numPoses==0)
+		return;
+
+	f.nanoseconds[FRAME_STAGE_POSE] = (unsigned int)(arStatsClock()-frameStats.poseBegin);
+
+	FrameStats& h = frameStats.history[frameStats.poseFrame % FrameStatsSummary::WINDOW];
+
+	h.numPoses = f.numPoses;
+	h.poseIterations = f.poseIterations;
+	h.poseError = f.poseError;
+	h.nanoseconds[FRAME_STAGE_POSE] = f.nanoseconds[FRAME_STAGE_POSE];
+}
+
+
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::getFrameStatsSummary(FrameStatsSummary& nSummary) const
+{
+	const unsigned int window = FrameStatsSummary::WINDOW;
+	int i, k, numLabeled = 0, numErrors = 0;
+
+	memset(&nSummary, 0, sizeof(nSummary));
+
+	nSummary.numFrames = (int)(frameStats.numDetected<window ? frameStats.numDetected : window);
+
+	for(i=0; i<nSummary.numFrames; i++)
+	{
+		const FrameStats& h = frameStats.history[i];
+
+		nSummary.meanLabels += h.numLabels;
+		nSummary.meanCandidates += h.numCandidates;
+		nSummary.meanMarkers += h.numMarkers;
+		for(k=0; k<CANDIDATE_REJECT_NUM_REASONS; k++)
+			nSummary.meanRejected[k] += h.numRejected[k];
+
+		// unchanged and tracked frames did not label with a threshold
+		if(!h.unchanged && !h.tracked)
+		{
+			nSummary.meanThreshold += h.threshold;
+			nSummary.meanRetries += h.numRetries;
+			numLabeled++;
+		}
+
+		nSummary.unchangedRate += h.unchanged ? 1.0f : 0.0f;
+		nSummary.trackedRate += h.tracked ? 1.0f : 0.0f;
+		nSummary.detectionRate += h.numMarkers>0 ? 1.0f : 0.0f;
+
+		for(k=0; k<FRAME_STAGE_POSE; k++)
+		{
+			float us = h.nanoseconds[k]*0.001f;
+			nSummary.meanMicroseconds[k] += us;
+			if(us>nSummary.maxMicroseconds[k])
+				nSummary.maxMicroseconds[k] = us;
+		}
+	}
+
+	for(i=0; i<nSummary.numFrames; i++)
+	{
+		const FrameStats& h = frameStats.history[i];
+		float us = h.nanoseconds[FRAME_STAGE_POSE]*0.001f;
+
+		if(h.numPoses==0)
+			continue;
+
+		nSummary.numPoseFrames++;
+		nSummary.meanPoseIterations += h.poseIterations;
+
+		// -1: the last pose estimation of the frame failed
+		if(h.poseError>=0.0f)
+		{
+			nSummary.meanPoseError += h.poseError;
+			if(h.poseError>nSummary.maxPoseError)
+				nSummary.maxPoseError = h.poseError;
+			numErrors++;
+		}
+
+		nSummary.meanMicroseconds[FRAME_STAGE_POSE] += us;
+		if(us>nSummary.maxMicroseconds[FRAME_STAGE_POSE])
+			nSummary.maxMicroseconds[FRAME_STAGE_POSE] = us;
+	}
+
+	if(nSummary.numFrames>0)
+	{
+		float s = 1.0f/nSummary.numFrames;
+
+		nSummary.meanLabels *= s;
+		nSummary.meanCandidates *= s;
+		nSummary.meanMarkers *= s;
+		for(k=0; k<CANDIDATE_REJECT_NUM_REASONS; k++)
+			nSummary.meanRejected[k] *= s;
+		nSummary.unchangedRate *= s;
+		nSummary.trackedRate *= s;
+		nSummary.detectionRate *= s;
+		for(k=0; k<FRAME_STAGE_POSE; k++)
+			nSummary.meanMicroseconds[k] *= s;
+	}
+
+	if(numLabeled>0)
+	{
+		nSummary.meanThreshold /= numLabeled;
+		nSummary.meanRetries /= numLabeled;
+	}
+
+	if(nSummary.numPoseFrames>0)
+	{
+		float s = 1.0f/nSummary.numPoseFrames;
+
+		nSummary.meanPoseIterations *= s;
+		nSummary.meanMicroseconds[FRAME_STAGE_POSE] *= s;
+	}
+
+	if(numErrors>0)
+		nSummary.meanPoseError /= numErrors;
+}
+
+
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::resetFrameStats()
+{
+	memset(&frameStats.frame, 0, sizeof(frameStats.frame));
+	frameStats.frame.poseError = -1.0f;
+	frameStats.numDetected = 0;
+	frameStats.poseFollows = false;
+	frameStats.numQueued = 0;
+	frameStats.numPosed = 0;
+	frameStats.poseFrame = 0;
+	frameStats.detectBegin = 0;
+	frameStats.poseBegin = 0;
+}
+
+
+}	// namespace ARToolKitPlus
@@ -73,7 +73,8 @@ AR_TEMPL_TRACKER::arLoadPatt(char *filename)
     patno = i;
 
     if( (fp=fopen(filename, "r")) == NULL ) {
-        printf("\"%s\" not found!!\n", filename);
+        if(logger)
+            logger->artLogEx("ARToolKitPlus: pattern file '%s' not found\n", filename);
         return(-1);
     }
 
@@ -83,7 +84,9 @@ AR_TEMPL_TRACKER::arLoadPatt(char *filename)
             for( i2 = 0; i2 < PATTERN_HEIGHT; i2++ ) {
                 for( i1 = 0; i1 < PATTERN_WIDTH; i1++ ) {
                     if( fscanf(fp, "%d", &j) != 1 ) {
-                        printf("Pattern Data read error!!\n");
+                        if(logger)
+                            logger->artLogEx("ARToolKitPlus: pattern file '%s' is incomplete\n", filename);
+                        fclose(fp);
                         return -1;
                     }
 					if(binaryMarkerThreshold!=-1)
@@ -179,12 +182,48 @@ AR_TEMPL_TRACKER::arGetCode(uint8_t *image, int *x_coord, int *y_coord, int *ver
 				autoThreshold.addValue(ext_pat[y][x][0], ext_pat[y][x][1], ext_pat[y][x][2], pixelFormat);
 	}
 
+	// with adaptive thresholding the global threshold may not fit the lighting of
+	// this marker: take the middle between its darkest and brightest sample instead
+	// (same luminance as downsamplePattern() uses)
+	if(adaptiveThreshold.enabled && markerMode!=MARKER_TEMPLATE)
+	{
+		int x,y, minLum=255, maxLum=0;
+
+		for(y=0; y<PATTERN_HEIGHT; y++)
+			for(x=0; x<PATTERN_WIDTH; x++)
+			{
+				int lum = (ext_pat[y][x][0]+(ext_pat[y][x][1]<<1)+ext_pat[y][x][2])>>2;
+				if(lum<minLum)
+					minLum = lum;
+				if(lum>maxLum)
+					maxLum = lum;
+			}
+
+		if(maxLum-minLum>=ADAPTIVE_MIN_CONTRAST)
+			thresh = (minLum+maxLum)/2;
+	}
+
 
 //#pragma message (">>> WARNING: compiling with marker content dumping. performance will be very low !!!")
 //	FILE* fp = fopen("dump.raw", "wb");
 //	fwrite(ext_pat, PATTERN_HEIGHT*PATTERN_WIDTH*3, 1, fp);
 //	fclose(fp);
 
+	// decode cache: the marker found here in the last frame is checked first,
+	// in its expected direction only
+	if(decodeCache.predictedId>=0)
+	{
+		bool verified = (markerMode==MARKER_TEMPLATE) ?
+							pattern_verify((uint8_t *)ext_pat, decodeCache.predictedId, decodeCache.predictedDir, cf) :
+							bitfield_verify((uint8_t *)ext_pat, decodeCache.predictedId, decodeCache.predictedDir, cf, thresh);
+		if(verified)
+		{
+			*code = decodeCache.predictedId;
+			*dir = decodeCache.predictedDir;
+			return(0);
+		}
+	}
+
 	switch(markerMode)
 	{
 	case MARKER_TEMPLATE:
@@ -490,6 +529,128 @@ printf("%3d(%f), %3d(%f)\n", xdiv2, sqrt(lx1), ydiv2, sqrt(ly1));
 
     return(0);
 }
+
+
+// early reject: the marker square is mapped to [100,110]x[100,110] as in arGetPatt().
+// border samples lie in the middle of the black border, inside samples at the centers
+// of a 6x6 grid. the local threshold is halfway between the border and the brightest
+// inside sample, so the test works under any lighting (and adaptive thresholding).
+//
+AR_TEMPL_FUNC int
+AR_TEMPL_TRACKER::arEarlyReject(uint8_t *image, int *x_coord, int *y_coord, int *vertex)
+{
+	const int	numBorder = EarlyReject::BORDER_SAMPLES, numInside = EarlyReject::INTERIOR_SAMPLES;
+	ARFloat		world[4][2], local[4][2], para[3][3];
+	ARFloat		border = relBorderWidth * 10.0f, mid = border * 0.5f, s;
+	int			borderLum[4*numBorder], borderSum = 0, insideMin = 255, insideMax = 0;
+	int			i, j, lum;
+
+	world[0][0] = 100.0f;			world[0][1] = 100.0f;
+	world[1][0] = 100.0f + 10.0f;	world[1][1] = 100.0f;
+	world[2][0] = 100.0f + 10.0f;	world[2][1] = 100.0f + 10.0f;
+	world[3][0] = 100.0f;			world[3][1] = 100.0f + 10.0f;
+	for(i=0; i<4; i++)
+	{
+		local[i][0] = (ARFloat)x_coord[vertex[i]];
+		local[i][1] = (ARFloat)y_coord[vertex[i]];
+	}
+	get_cpara(world, local, para);
+
+	for(i=0; i<numBorder; i++)
+	{
+		s = 100.0f + border + (10.0f - 2.0f*border) * (i+0.5f) / numBorder;
+
+		borderLum[i*4+0] = arSampleMarkerLum(image, para, s, 100.0f + mid);
+		borderLum[i*4+1] = arSampleMarkerLum(image, para, 110.0f - mid, s);
+		borderLum[i*4+2] = arSampleMarkerLum(image, para, s, 110.0f - mid);
+		borderLum[i*4+3] = arSampleMarkerLum(image, para, 100.0f + mid, s);
+	}
+
+	for(i=0; i<4*numBorder; i++)
+	{
+		if(borderLum[i]<0)			// off the image: let the full test decide
+			return -1;
+		borderSum += borderLum[i];
+	}
+
+	for(j=0; j<numInside; j++)
+		for(i=0; i<numInside; i++)
+		{
+			lum = arSampleMarkerLum(image, para, 100.0f + border + (10.0f - 2.0f*border) * (i+0.5f) / numInside,
+												 100.0f + border + (10.0f - 2.0f*border) * (j+0.5f) / numInside);
+			if(lum<0)
+				return -1;
+			if(lum<insideMin)
+				insideMin = lum;
+			if(lum>insideMax)
+				insideMax = lum;
+		}
+
+	const int borderMean = borderSum / (4*numBorder);
+
+	if(insideMax-borderMean < earlyReject.minContrast)
+		return EARLY_REJECT_CONTRAST;
+
+	const int localThresh = (borderMean + insideMax) / 2;
+	int numBright = 0;
+
+	for(i=0; i<4*numBorder; i++)
+		if(borderLum[i]>localThresh)
+			numBright++;
+
+	// the raw vertices can be off by a pixel or two (half resolution contours),
+	// so the border test needs a border that is a few pixels wide
+	ARFloat dx, dy, side2, minSide2 = (ARFloat)(arImXsize*arImXsize + arImYsize*arImYsize);
+
+	for(i=0; i<4; i++)
+	{
+		dx = local[(i+1)%4][0] - local[i][0];
+		dy = local[(i+1)%4][1] - local[i][1];
+		side2 = dx*dx + dy*dy;
+		if(side2<minSide2)
+			minSide2 = side2;
+	}
+
+	if(numBright>EarlyReject::MAX_BRIGHT_BORDER &&
+	   minSide2*relBorderWidth*relBorderWidth >= (ARFloat)(EarlyReject::MIN_BORDER_PIXELS*EarlyReject::MIN_BORDER_PIXELS))
+		return EARLY_REJECT_BORDER;
+
+	if(insideMin>localThresh)
+		return EARLY_REJECT_EMPTY;
+
+	return -1;
+}
+
+
+AR_TEMPL_FUNC int
+AR_TEMPL_TRACKER::arSampleMarkerLum(uint8_t *image, const ARFloat para[3][3], ARFloat xw, ARFloat yw)
+{
+	ARFloat d = para[2][0]*xw + para[2][1]*yw + para[2][2];
+	if(d==0)
+		return -1;
+
+	int xc = (int)((para[0][0]*xw + para[0][1]*yw + para[0][2])/d);
+	int yc = (int)((para[1][0]*xw + para[1][1]*yw + para[1][2])/d);
+	if(xc<0 || xc>=arImXsize || yc<0 || yc>=arImYsize)
+		return -1;
+
+	const uint8_t *pix = image + (yc*arImXsize+xc)*pixelSize;
+
+	switch(pixelFormat)
+	{
+	case PIXEL_FORMAT_LUM:
+		return pix[0];
+
+	case PIXEL_FORMAT_RGB565:
+		return getLUM8_from_RGB565(pix);
+
+	case PIXEL_FORMAT_ABGR:
+		return (pix[1]+pix[2]+pix[3])/3;
+
+	default:
+		return (pix[0]+pix[1]+pix[2])/3;
+	}
+}
 //#else
 /*
 int arGetPatt( uint8_t *image, int *x_coord, int *y_coord, int *vertex,
@@ -737,6 +898,51 @@ AR_TEMPL_TRACKER::pattern_match( uint8_t *data, int *code, int *dir, ARFloat *cf
 }
 
 
+// correlates the pattern with a single template (pattern code, rotation dir)
+// instead of all of them. accepted if the confidence is about the one of the
+// last frame: a much lower value might mean that another template fits better.
+//
+AR_TEMPL_FUNC bool
+AR_TEMPL_TRACKER::pattern_verify( uint8_t *data, int code, int dir, ARFloat *cf)
+{
+    int    input[PATTERN_HEIGHT*PATTERN_WIDTH*3];
+    int    i, ave, sum, size;
+    ARFloat datapow;
+
+    if( code >= MAX_LOAD_PATTERNS || patf[code] != 1 ) return false;
+
+    size = (arTemplateMatchingMode == AR_TEMPLATE_MATCHING_COLOR) ? PATTERN_HEIGHT*PATTERN_WIDTH*3 : PATTERN_HEIGHT*PATTERN_WIDTH;
+
+    ave = 0;
+    for(i=0;i<PATTERN_HEIGHT*PATTERN_WIDTH*3;i++) ave += (255-data[i]);
+    ave /= (PATTERN_HEIGHT*PATTERN_WIDTH*3);
+
+    sum = 0;
+    for(i=0;i<size;i++) {
+        if( arTemplateMatchingMode == AR_TEMPLATE_MATCHING_COLOR )
+            input[i] = (255-data[i]) - ave;
+        else
+            input[i] = ((255-data[i*3+0]) + (255-data[i*3+1]) + (255-data[i*3+2]))/3 - ave;
+        sum += input[i]*input[i];
+    }
+
+    datapow = (ARFloat)sqrt( (ARFloat)sum );
+    if( datapow == 0.0 ) return false;
+
+    sum = 0;
+    if( arTemplateMatchingMode == AR_TEMPLATE_MATCHING_COLOR ) {
+        for(i=0;i<size;i++) sum += input[i]*pat[code][dir][i];
+        *cf = sum / patpow[code][dir] / datapow;
+    }
+    else {
+        for(i=0;i<size;i++) sum += input[i]*patBW[code][dir][i];
+        *cf = sum / patpowBW[code][dir] / datapow;
+    }
+
+    return *cf >= 0.5f && *cf >= decodeCache.predictedCf*0.9f;
+}
+
+
 AR_TEMPL_FUNC void
 AR_TEMPL_TRACKER::gen_evec(void)
 {
@@ -835,12 +1041,11 @@ AR_TEMPL_TRACKER::gen_evec(void)
 static void
 get_cpara( ARFloat world[4][2], ARFloat vertex[4][2], ARFloat para[3][3] )
 {
-    ARMat   *a, *b, *c;
+    ARFloat am[8*8], bm[8], cm[8];
+    ARMat   as = { am, 8, 8 }, bs = { bm, 8, 1 }, cs = { cm, 8, 1 };
+    ARMat   *a = &as, *b = &bs, *c = &cs;
     int     i;
 
-    a = Matrix::alloc( 8, 8 );
-    b = Matrix::alloc( 8, 1 );
-    c = Matrix::alloc( 8, 1 );
     for( i = 0; i < 4; i++ ) {
         a->m[i*16+0]  = world[i][0];
         a->m[i*16+1]  = world[i][1];
@@ -871,9 +1076,6 @@ get_cpara( ARFloat world[4][2], ARFloat vertex[4][2], ARFloat para[3][3] )
     para[2][0] = c->m[2*3+0];
     para[2][1] = c->m[2*3+1];
     para[2][2] = 1.0;
-    Matrix::free( a );
-    Matrix::free( b );
-    Matrix::free( c );
 }
 
 
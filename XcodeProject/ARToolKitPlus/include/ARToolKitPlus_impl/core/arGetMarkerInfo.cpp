@@ -50,22 +50,49 @@ AR_TEMPL_TRACKER::arGetMarkerInfo(uint8_t *image, ARMarkerInfo2 *marker_info2, i
     int            id, dir;
     ARFloat         cf;
     int            i, j;
+	uint64_t       begin = arStatsClock();
 
 	PROFILE_BEGINSEC(profiler, GETMARKERINFO)
 
+	frameStats.frame.numCandidates += *marker_num;
+
     for( i = j = 0; i < *marker_num; i++ ) {
         marker_infoL[j].area   = marker_info2[i].area;
         marker_infoL[j].pos[0] = marker_info2[i].pos[0];
         marker_infoL[j].pos[1] = marker_info2[i].pos[1];
 
+		// a few samples of the border and the inside before the expensive steps
+		if(earlyReject.enabled)
+		{
+			int reason = arEarlyReject(image, marker_info2[i].x_coord, marker_info2[i].y_coord, marker_info2[i].vertex);
+			if(reason>=0)
+			{
+				earlyReject.numRejected[reason]++;
+				continue;
+			}
+		}
+
         if( arGetLine(marker_info2[i].x_coord, marker_info2[i].y_coord,
                       marker_info2[i].coord_num, marker_info2[i].vertex,
-                      marker_infoL[j].line, marker_infoL[j].vertex) < 0 ) continue;
+                      marker_infoL[j].line, marker_infoL[j].vertex) < 0 ) {
+			frameStats.frame.numRejected[CANDIDATE_REJECT_LINE]++;
+			continue;
+		}
+
+		// a marker of the last frame at this position only has to be verified
+		int prev = arPredictCode(marker_infoL[j], &decodeCache.predictedDir);
+		if(prev>=0)
+		{
+			decodeCache.predictedId = prev_info[prev].marker.id;
+			decodeCache.predictedCf = prev_info[prev].marker.cf;
+		}
 
         arGetCode( image,
                    marker_info2[i].x_coord, marker_info2[i].y_coord,
                    marker_info2[i].vertex, &id, &dir, &cf, thresh);
 
+		decodeCache.predictedId = -1;
+
         marker_infoL[j].id  = id;
         marker_infoL[j].dir = dir;
         marker_infoL[j].cf  = cf;
@@ -76,8 +103,66 @@ AR_TEMPL_TRACKER::arGetMarkerInfo(uint8_t *image, ARMarkerInfo2 *marker_info2, i
 
 	PROFILE_ENDSEC(profiler, GETMARKERINFO)
 
+	frameStats.frame.nanoseconds[FRAME_STAGE_DECODE] += (unsigned int)(arStatsClock()-begin);
+
     return( marker_infoL );
 }
 
 
+AR_TEMPL_FUNC int
+AR_TEMPL_TRACKER::arPredictCode(const ARMarkerInfo& nCandidate, int *nDir)
+{
+	ARFloat rarea, rlen, diff, diffmin;
+	int i, j, k, match = -1;
+
+	// same position test as the tracking history in arDetectMarker(). only markers
+	// identified in the last frame count: older entries are too far behind
+	for(i=0; i<decodeCache.numHistory; i++)
+	{
+		const ARMarkerInfo& prev = prev_info[i].marker;
+
+		if(prev_info[i].count!=1)
+			continue;
+
+		rarea = (ARFloat)prev.area / (ARFloat)nCandidate.area;
+		if(rarea<0.7f || rarea>1.43f)
+			continue;
+
+		rlen = ( (nCandidate.pos[0]-prev.pos[0])*(nCandidate.pos[0]-prev.pos[0]) +
+				 (nCandidate.pos[1]-prev.pos[1])*(nCandidate.pos[1]-prev.pos[1]) ) / nCandidate.area;
+		if(rlen>=0.5f)
+			continue;
+
+		// two markers of the last frame fit: the candidate has to be decoded
+		if(match>=0)
+			return -1;
+		match = i;
+	}
+
+	if(match<0)
+		return -1;
+
+	// the contour may start at another vertex than in the last frame:
+	// find the rotation of the vertex order that fits best
+	const ARMarkerInfo& prev = prev_info[match].marker;
+
+	diffmin = 10000.0f * 10000.0f;
+	*nDir = prev.dir;
+	for(j=0; j<4; j++)
+	{
+		diff = 0.0f;
+		for(k=0; k<4; k++)
+			diff += (prev.vertex[k][0]-nCandidate.vertex[(j+k)%4][0]) * (prev.vertex[k][0]-nCandidate.vertex[(j+k)%4][0]) +
+					(prev.vertex[k][1]-nCandidate.vertex[(j+k)%4][1]) * (prev.vertex[k][1]-nCandidate.vertex[(j+k)%4][1]);
+		if(diff<diffmin)
+		{
+			diffmin = diff;
+			*nDir = (prev.dir-j+4) % 4;
+		}
+	}
+
+	return match;
+}
+
+
 }  // namespace ARToolKitPlus
@@ -109,6 +109,7 @@ AR_TEMPL_TRACKER::arGetTransMat3(ARFloat rot[3][3], ARFloat ppos2d[][2],
     ARFloat  off[3], pmax[3], pmin[3];
     ARFloat  ret;
     int     i;
+	PoseState& state = poseState();
 
 	PROFILE_BEGINSEC(profiler, GETTRANSMAT3)
 
@@ -128,15 +129,15 @@ AR_TEMPL_TRACKER::arGetTransMat3(ARFloat rot[3][3], ARFloat ppos2d[][2],
     off[1] = -(pmax[1] + pmin[1])  * (ARFloat)0.5;
     off[2] = -(pmax[2] + pmin[2])  * (ARFloat)0.5;
     for( i = 0; i < num; i++ ) {
-        pos3d[i][0] = ppos3d[i][0] + off[0];
-        pos3d[i][1] = ppos3d[i][1] + off[1];
+        state.pos3d[i][0] = ppos3d[i][0] + off[0];
+        state.pos3d[i][1] = ppos3d[i][1] + off[1];
 /*
         pos3d[i][2] = ppos3d[i][2] + off[2];
 */
-        pos3d[i][2] = 0.0;
+        state.pos3d[i][2] = 0.0;
     }
 
-    ret = arGetTransMatSub( rot, ppos2d, pos3d, num, conv, pCam);
+    ret = arGetTransMatSub( rot, ppos2d, state.pos3d, num, conv, pCam);
                             //dist_factor, cpara );
 
     conv[0][3] = conv[0][0]*off[0] + conv[0][1]*off[1] + conv[0][2]*off[2] + conv[0][3];
@@ -164,6 +165,7 @@ AR_TEMPL_TRACKER::arGetTransMat5(ARFloat rot[3][3], ARFloat ppos2d[][2],
     ARFloat  off[3], pmax[3], pmin[3];
     ARFloat  ret;
     int     i;
+	PoseState& state = poseState();
 
     pmax[0]=pmax[1]=pmax[2] = -10000000000.0;
     pmin[0]=pmin[1]=pmin[2] =  10000000000.0;
@@ -179,12 +181,12 @@ AR_TEMPL_TRACKER::arGetTransMat5(ARFloat rot[3][3], ARFloat ppos2d[][2],
     off[1] = -(pmax[1] + pmin[1])  * (ARFloat)0.5;
     off[2] = -(pmax[2] + pmin[2])  * (ARFloat)0.5;
     for( i = 0; i < num; i++ ) {
-        pos3d[i][0] = ppos3d[i][0] + off[0];
-        pos3d[i][1] = ppos3d[i][1] + off[1];
-        pos3d[i][2] = ppos3d[i][2] + off[2];
+        state.pos3d[i][0] = ppos3d[i][0] + off[0];
+        state.pos3d[i][1] = ppos3d[i][1] + off[1];
+        state.pos3d[i][2] = ppos3d[i][2] + off[2];
     }
 
-    ret = arGetTransMatSub( rot, ppos2d, pos3d, num, conv, pCam);
+    ret = arGetTransMatSub( rot, ppos2d, state.pos3d, num, conv, pCam);
                             //dist_factor, cpara );
 
     conv[0][3] = conv[0][0]*off[0] + conv[0][1]*off[1] + conv[0][2]*off[2] + conv[0][3];
@@ -208,22 +210,29 @@ AR_TEMPL_TRACKER::arGetTransMatSub(ARFloat rot[3][3], ARFloat ppos2d[][2],
 
 	PROFILE_BEGINSEC(profiler, GETTRANSMATSUB)
 
-    mat_a = Matrix::alloc( num*2, 3 );
-    mat_b = Matrix::alloc( 3, num*2 );
-    mat_c = Matrix::alloc( num*2, 1 );
-    mat_d = Matrix::alloc( 3, 3 );
-    mat_e = Matrix::alloc( 3, 1 );
-    mat_f = Matrix::alloc( 3, 1 );
+	PoseState& state = poseState();
+
+	// one refinement pass of the ARToolKit estimators (single, multi, hull, RANSAC)
+	state.stats->poseIterations++;
+
+    MemoryManagerArena::Scope scratch( state.scratch );
+
+    mat_a = Matrix::alloc( &state.scratch, num*2, 3 );
+    mat_b = Matrix::alloc( &state.scratch, 3, num*2 );
+    mat_c = Matrix::alloc( &state.scratch, num*2, 1 );
+    mat_d = Matrix::alloc( &state.scratch, 3, 3 );
+    mat_e = Matrix::alloc( &state.scratch, 3, 1 );
+    mat_f = Matrix::alloc( &state.scratch, 3, 1 );
 
     if( arFittingMode == AR_FITTING_TO_INPUT ) {
         for( i = 0; i < num; i++ ) {
-            arParamIdeal2Observ_std(pCam, ppos2d[i][0], ppos2d[i][1], &pos2d[i][0], &pos2d[i][1]);
+            arParamIdeal2Observ_std(pCam, ppos2d[i][0], ppos2d[i][1], &state.pos2d[i][0], &state.pos2d[i][1]);
         }
     }
     else {
         for( i = 0; i < num; i++ ) {
-            pos2d[i][0] = ppos2d[i][0];
-            pos2d[i][1] = ppos2d[i][1];
+            state.pos2d[i][0] = ppos2d[i][0];
+            state.pos2d[i][1] = ppos2d[i][1];
         }
     }
 
@@ -239,13 +248,13 @@ AR_TEMPL_TRACKER::arGetTransMatSub(ARFloat rot[3][3], ARFloat ppos2d[][2],
            + rot[2][2] * pos3d[j][2];
         mat_a->m[j*6+0] = mat_b->m[num*0+j*2] = pCam->mat[0][0];
         mat_a->m[j*6+1] = mat_b->m[num*2+j*2] = pCam->mat[0][1];
-        mat_a->m[j*6+2] = mat_b->m[num*4+j*2] = pCam->mat[0][2] - pos2d[j][0];
-        mat_c->m[j*2+0] = wz * pos2d[j][0]
+        mat_a->m[j*6+2] = mat_b->m[num*4+j*2] = pCam->mat[0][2] - state.pos2d[j][0];
+        mat_c->m[j*2+0] = wz * state.pos2d[j][0]
                - pCam->mat[0][0]*wx - pCam->mat[0][1]*wy - pCam->mat[0][2]*wz;
         mat_a->m[j*6+3] = mat_b->m[num*0+j*2+1] = 0.0;
         mat_a->m[j*6+4] = mat_b->m[num*2+j*2+1] = pCam->mat[1][1];
-        mat_a->m[j*6+5] = mat_b->m[num*4+j*2+1] = pCam->mat[1][2] - pos2d[j][1];
-        mat_c->m[j*2+1] = wz * pos2d[j][1]
+        mat_a->m[j*6+5] = mat_b->m[num*4+j*2+1] = pCam->mat[1][2] - state.pos2d[j][1];
+        mat_c->m[j*2+1] = wz * state.pos2d[j][1]
                - pCam->mat[1][1]*wy - pCam->mat[1][2]*wz;
     }
     Matrix::mul( mat_d, mat_b, mat_a );
@@ -269,7 +278,7 @@ AR_TEMPL_TRACKER::arGetTransMatSub(ARFloat rot[3][3], ARFloat ppos2d[][2],
 		//trans[2] = 303.0f;
 		//arGetRot( -90.5f*3.1415f/180.0f, 120.3f*3.1415f/180.0f, 31.2f*3.1415f/180.0f, rot );
 
-		ret = arModifyMatrix( rot, trans, pCam->mat, pos3d, pos2d, num );
+		ret = arModifyMatrix( rot, trans, pCam->mat, pos3d, state.pos2d, num );
 
 		arGetAngle( rot, &a, &b, &c );
 		a=a;
@@ -310,12 +319,12 @@ AR_TEMPL_TRACKER::arGetTransMatSub(ARFloat rot[3][3], ARFloat ppos2d[][2],
 	//
 	// double end
 
-    Matrix::free( mat_a );
-    Matrix::free( mat_b );
-    Matrix::free( mat_c );
-    Matrix::free( mat_d );
-    Matrix::free( mat_e );
-    Matrix::free( mat_f );
+    Matrix::free( &state.scratch, mat_a );
+    Matrix::free( &state.scratch, mat_b );
+    Matrix::free( &state.scratch, mat_c );
+    Matrix::free( &state.scratch, mat_d );
+    Matrix::free( &state.scratch, mat_e );
+    Matrix::free( &state.scratch, mat_f );
 
     for( j = 0; j < 3; j++ ) {
         for( i = 0; i < 3; i++ ) conv[j][i] = rot[j][i];
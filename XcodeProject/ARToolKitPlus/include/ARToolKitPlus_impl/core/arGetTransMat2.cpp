@@ -272,8 +272,11 @@ AR_TEMPL_TRACKER::arModifyMatrix(ARFloat rot[3][3], ARFloat trans[3], ARFloat cp
 
 //	PROFILE_BEGINSEC(profiler, MODIFYMATRIX)
 
-	FIXED_VEC3D	*_vertex = (FIXED_VEC3D*)malloc(num*sizeof(FIXED_VEC3D)),
-				*_pos2d = (FIXED_VEC3D*)malloc(num*sizeof(FIXED_VEC3D)),
+	PoseState& state = poseState();
+	MemoryManagerArena::Scope scratch(state.scratch);
+
+	FIXED_VEC3D	*_vertex = (FIXED_VEC3D*)state.scratch.getMemory(num*sizeof(FIXED_VEC3D)),
+				*_pos2d = (FIXED_VEC3D*)state.scratch.getMemory(num*sizeof(FIXED_VEC3D)),
 				_combo[3], _vec1, _vec2, _trans;
 	I32			_combo3[3];
 
@@ -456,9 +459,6 @@ AR_TEMPL_TRACKER::arModifyMatrix(ARFloat rot[3][3], ARFloat trans[3], ARFloat cp
 
 //	PROFILE_ENDSEC(profiler, MODIFYMATRIX_LOOP)
 
-	free(_vertex);
-	free(_pos2d);
-
 	ma = FIXED_Fixed_n_To_Float(_ma, 12);
 	mb = FIXED_Fixed_n_To_Float(_mb, 12);
 	mc = FIXED_Fixed_n_To_Float(_mc, 12);
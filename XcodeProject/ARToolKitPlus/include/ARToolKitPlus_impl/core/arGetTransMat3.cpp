@@ -698,14 +698,14 @@ static int
 check_dir( ARFloat dir[3], ARFloat st[2], ARFloat ed[2],
                       ARFloat cpara[3][4] )
 {
-    ARMat     *mat_a;
+    ARFloat    mat_am[3*3];
+    ARMat      mat_as = { mat_am, 3, 3 }, *mat_a = &mat_as;
     ARFloat    world[2][3];
     ARFloat    camera[2][2];
     ARFloat    v[2][2];
     ARFloat    h;
     int       i, j;
 
-    mat_a = Matrix::alloc( 3, 3 );
     for(j=0;j<3;j++) for(i=0;i<3;i++) mat_a->m[j*3+i] = cpara[j][i];
     Matrix::selfInv( mat_a );
     world[0][0] = mat_a->m[0]*st[0]*(ARFloat)10.0
@@ -717,7 +717,6 @@ check_dir( ARFloat dir[3], ARFloat st[2], ARFloat ed[2],
     world[0][2] = mat_a->m[6]*st[0]*(ARFloat)10.0
                 + mat_a->m[7]*st[1]*(ARFloat)10.0
                 + mat_a->m[8]*(ARFloat)10.0;
-    Matrix::free( mat_a );
     world[1][0] = world[0][0] + dir[0];
     world[1][1] = world[0][1] + dir[1];
     world[1][2] = world[0][2] + dir[2];
@@ -82,48 +82,106 @@ put_zero( uint8_t *p, int size )
 #include "arLabelingImpl.h"
 #undef _DEF_PIXEL_FORMAT_LUM
 
+// not a camera format: labels the output of arBuildAdaptiveMask()
+#define _DEF_PIXEL_FORMAT_MASK
+#define LABEL_FUNC_NAME arLabeling_MASK
+#include "arLabelingImpl.h"
+#undef _DEF_PIXEL_FORMAT_MASK
 
-AR_TEMPL_FUNC int16_t*
+
+AR_TEMPL_FUNC void*
 AR_TEMPL_TRACKER::arLabeling(uint8_t *image, int thresh, int *label_num, int **area,
-					ARFloat **pos, int **clip, int **label_ref )
+					ARFloat **pos, int **clip, int **label_ref, int LorR )
 {
-	int16_t* ret = NULL;
+	void* ret = NULL;
+	bool wide = labelSize==sizeof(int32_t);
+
+	// the right image of a stereo pair (LorR==0) is labeled on another thread, it is not counted
+	uint64_t begin = LorR ? arStatsClock() : 0;
 
 	PROFILE_BEGINSEC(profiler, LABELING)
 	//ret = labeling2(image, thresh, label_num, area, pos, clip, label_ref, 1);
 
-	switch(pixelFormat)
+	if(adaptiveThreshold.enabled)
 	{
-	case PIXEL_FORMAT_ABGR:
-		ret = arLabeling_ABGR(image, thresh, label_num, area, pos, clip, label_ref);
-		break;
-
-	case PIXEL_FORMAT_BGRA:
-	case PIXEL_FORMAT_BGR:
-		ret = arLabeling_BGR(image, thresh, label_num, area, pos, clip, label_ref);
-		break;
-
-	case PIXEL_FORMAT_RGBA:
-	case PIXEL_FORMAT_RGB:
-		ret = arLabeling_RGB(image, thresh, label_num, area, pos, clip, label_ref);
-		break;
-
-	case PIXEL_FORMAT_RGB565:
-		ret = arLabeling_RGB565(image, thresh, label_num, area, pos, clip, label_ref);
-		break;
-
-	case PIXEL_FORMAT_LUM:
-		ret = arLabeling_LUM(image, thresh, label_num, area, pos, clip, label_ref);
-		break;
+		// the mask is only needed until the label image is done
+		MemoryManagerArena::Scope scratch(frameScratch);
+		uint8_t *mask = arBuildAdaptiveMask(image);
+
+		if(mask)
+			ret = arLabelingMask(mask, 0, label_num, area, pos, clip, label_ref, LorR);
+	}
+	else
+	{
+		switch(pixelFormat)
+		{
+		case PIXEL_FORMAT_ABGR:
+			if(wide)
+				ret = arLabeling_ABGR<int32_t>(image, thresh, label_num, area, pos, clip, label_ref, LorR);
+			else
+				ret = arLabeling_ABGR<int16_t>(image, thresh, label_num, area, pos, clip, label_ref, LorR);
+			break;
+
+		case PIXEL_FORMAT_BGRA:
+		case PIXEL_FORMAT_BGR:
+			if(wide)
+				ret = arLabeling_BGR<int32_t>(image, thresh, label_num, area, pos, clip, label_ref, LorR);
+			else
+				ret = arLabeling_BGR<int16_t>(image, thresh, label_num, area, pos, clip, label_ref, LorR);
+			break;
+
+		case PIXEL_FORMAT_RGBA:
+		case PIXEL_FORMAT_RGB:
+			if(wide)
+				ret = arLabeling_RGB<int32_t>(image, thresh, label_num, area, pos, clip, label_ref, LorR);
+			else
+				ret = arLabeling_RGB<int16_t>(image, thresh, label_num, area, pos, clip, label_ref, LorR);
+			break;
+
+		case PIXEL_FORMAT_RGB565:
+			if(wide)
+				ret = arLabeling_RGB565<int32_t>(image, thresh, label_num, area, pos, clip, label_ref, LorR);
+			else
+				ret = arLabeling_RGB565<int16_t>(image, thresh, label_num, area, pos, clip, label_ref, LorR);
+			break;
+
+		case PIXEL_FORMAT_LUM:
+			if(wide)
+				ret = arLabeling_LUM<int32_t>(image, thresh, label_num, area, pos, clip, label_ref, LorR);
+			else
+				ret = arLabeling_LUM<int16_t>(image, thresh, label_num, area, pos, clip, label_ref, LorR);
+			break;
+		}
 	}
 
     PROFILE_ENDSEC(profiler, LABELING)
 
+	if(LorR)
+	{
+		frameStats.frame.nanoseconds[FRAME_STAGE_LABELING] += (unsigned int)(arStatsClock()-begin);
+		if(ret)
+			frameStats.frame.numLabels += *label_num;
+	}
+
 	return ret;
 }
 
 
 
+AR_TEMPL_FUNC void*
+AR_TEMPL_TRACKER::arLabelingMask(uint8_t *mask, int nBit, int *label_num, int **area,
+					ARFloat **pos, int **clip, int **label_ref, int LorR )
+{
+	labelMaskBit = (uint8_t)(1<<nBit);
+
+	if(labelSize==sizeof(int32_t))
+		return arLabeling_MASK<int32_t>(mask, 0, label_num, area, pos, clip, label_ref, LorR);
+	else
+		return arLabeling_MASK<int16_t>(mask, 0, label_num, area, pos, clip, label_ref, LorR);
+}
+
+
+
 #if 0
 AR_TEMPL_FUNC int16_t*
 AR_TEMPL_TRACKER::labeling2(uint8_t *image, int thresh, int *label_num, int **area,
@@ -38,19 +38,20 @@
  * ======================================================================== */
 
 
-AR_TEMPL_FUNC int16_t*
+AR_TEMPL_FUNC template<class LABEL_T> LABEL_T*
 AR_TEMPL_TRACKER::LABEL_FUNC_NAME(uint8_t *image, int thresh, int *label_num, int **area,
-								  ARFloat **pos, int **clip, int **label_ref)
+								  ARFloat **pos, int **clip, int **label_ref, int LorR)
 {
     uint8_t   *pnt;                     /*  image pointer       */
-    int16_t   *pnt1, *pnt2;             /*  image pointer       */
+    LABEL_T   *pnt1, *pnt2;             /*  image pointer       */
     int       *wk;                      /*  pointer for work    */
     int       wk_max;                   /*  work                */
     int       m,n;                      /*  work                */
     int       i,j,k;                    /*  for loop            */
     int       lxsize, lysize;
-    int       poff;
-    int16_t   *l_image;
+    int       x0, y0, x1, y1;
+    int       poff, rowSkip;
+    LABEL_T   *l_image;
     int       *work, *work2;
     int       *wlabel_num;
     int       *warea;
@@ -62,19 +63,27 @@ AR_TEMPL_TRACKER::LABEL_FUNC_NAME(uint8_t *image, int thresh, int *label_num, in
 	#pragma message(">> Performance Warning: arlabeling() optimizations disabled.")
 #endif //_!DISABLE_TP_OPTIMIZATIONS_
 
-	if(pixelFormat==PIXEL_FORMAT_RGB565)
-		checkRGB565LUT();
 
+	assert((LorR ? l_imageL : l_imageR) && "checkImageBuffer() must be called before labeling2(). this should happen automatically in arDetectMarker() & arDetectMarkerLite()");
 
-	assert(l_imageL && "checkImageBuffer() must be called before labeling2(). this should happen automatically in arDetectMarker() & arDetectMarkerLite()");
-
-    l_image = &l_imageL[0];
-    work    = &workL[0];
-    work2   = &work2L[0];
-    wlabel_num = &wlabel_numL;
-    warea   = &wareaL[0];
-    wclip   = &wclipL[0];
-    wpos    = &wposL[0];
+    if( LorR ) {
+        l_image = (LABEL_T*)l_imageL;
+        work    = &workL[0];
+        work2   = &work2L[0];
+        wlabel_num = &wlabel_numL;
+        warea   = &wareaL[0];
+        wclip   = &wclipL[0];
+        wpos    = &wposL[0];
+    }
+    else {
+        l_image = (LABEL_T*)l_imageR;
+        work    = &workR[0];
+        work2   = &work2R[0];
+        wlabel_num = &wlabel_numR;
+        warea   = &wareaR[0];
+        wclip   = &wclipR[0];
+        wpos    = &wposR[0];
+    }
 
 
 	if(pixelFormat!=PIXEL_FORMAT_RGB565 && pixelFormat!=PIXEL_FORMAT_LUM)
@@ -89,36 +98,57 @@ AR_TEMPL_TRACKER::LABEL_FUNC_NAME(uint8_t *image, int thresh, int *label_num, in
         lysize = arImYsize;
     }
 
-    pnt1 = &l_image[0];
-    pnt2 = &l_image[(lysize-1)*lxsize];
-    for(i = 0; i < lxsize; i++) {
+    // the window that is labeled (see labelRegion), the whole image by default.
+    // its outermost rows and columns are the zero border of the label image
+    //
+    if( labelRegion.active && LorR ) {
+        x0 = labelRegion.x0;  y0 = labelRegion.y0;
+        x1 = labelRegion.x1;  y1 = labelRegion.y1;
+    }
+    else {
+        x0 = y0 = 0;
+        x1 = lxsize;  y1 = lysize;
+    }
+
+    pnt1 = &l_image[y0*lxsize+x0];
+    pnt2 = &l_image[(y1-1)*lxsize+x0];
+    for(i = x0; i < x1; i++) {
         *(pnt1++) = *(pnt2++) = 0;
     }
 
-    pnt1 = &l_image[0];
-    pnt2 = &l_image[lxsize-1];
-    for(i = 0; i < lysize; i++) {
+    pnt1 = &l_image[y0*lxsize+x0];
+    pnt2 = &l_image[y0*lxsize+x1-1];
+    for(i = y0; i < y1; i++) {
         *pnt1 = *pnt2 = 0;
         pnt1 += lxsize;
         pnt2 += lxsize;
     }
 
     wk_max = 0;
-    pnt2 = &(l_image[lxsize+1]);
+    rowSkip = lxsize - (x1-x0) + 2;
+    pnt2 = &(l_image[(y0+1)*lxsize+x0+1]);
+#ifdef _DEF_PIXEL_FORMAT_MASK
+    // the mask already has the labeling resolution
+    pnt = &(image[(y0+1)*lxsize+x0+1]);
+    poff = 1;
+#else
     if( arImageProcMode == AR_IMAGE_PROC_IN_HALF ) {
-        pnt = &(image[(arImXsize*2+2)*pixelSize]);
+        pnt = &(image[((y0+1)*arImXsize*2+(x0+1)*2)*pixelSize]);
         poff = pixelSize*2;
     }
     else {
-        pnt = &(image[(arImXsize+1)*pixelSize]);
+        pnt = &(image[((y0+1)*arImXsize+x0+1)*pixelSize]);
         poff = pixelSize;
     }
+#endif
 
 
 //	int diffCorners = -60,
 //		diffLeftRight = -40,
 //		difftopBottom = -20;
 
+#ifndef _DEF_PIXEL_FORMAT_MASK
+	// the mask is already thresholded, vignetting compensation only applies to the image formats
 	const int shiftBits = 10;
 	int iHalf=lxsize/2, jHalf=lysize/2;
 
@@ -130,10 +160,12 @@ AR_TEMPL_TRACKER::LABEL_FUNC_NAME(uint8_t *image, int thresh, int *label_num, in
 		dCorrCenterY = -corrCenterY/jHalf,
 		corrX = 0, dCorrX = 0,
 		corrThresh;
+#endif //!_DEF_PIXEL_FORMAT_MASK
 
 
-	for(j = 1; j < lysize-1; j++, pnt+=poff*2, pnt2+=2)
+	for(j = y0+1; j < y1-1; j++, pnt+=poff*rowSkip, pnt2+=rowSkip)
 	{
+#ifndef _DEF_PIXEL_FORMAT_MASK
 		if(vignetting.enabled)
 		{
 			corrX = corrLeftY;
@@ -149,9 +181,11 @@ AR_TEMPL_TRACKER::LABEL_FUNC_NAME(uint8_t *image, int thresh, int *label_num, in
 			corrLeftY += dCorrLeftY;
 			corrCenterY += dCorrCenterY;
 		}
+#endif //!_DEF_PIXEL_FORMAT_MASK
 
-		for(i = 1; i < lxsize-1; i++, pnt+=poff, pnt2++)
+		for(i = x0+1; i < x1-1; i++, pnt+=poff, pnt2++)
 		{
+#ifndef _DEF_PIXEL_FORMAT_MASK
 			if(vignetting.enabled)
 			{
 				if(i==iHalf)
@@ -162,6 +196,7 @@ AR_TEMPL_TRACKER::LABEL_FUNC_NAME(uint8_t *image, int thresh, int *label_num, in
 			}
 			else
 				corrThresh = thresh;
+#endif //!_DEF_PIXEL_FORMAT_MASK
 
 			bool isBlack = false;
 
@@ -181,6 +216,9 @@ AR_TEMPL_TRACKER::LABEL_FUNC_NAME(uint8_t *image, int thresh, int *label_num, in
 #ifdef _DEF_PIXEL_FORMAT_LUM
 				isBlack = ( *pnt <= corrThresh );
 #endif
+#ifdef _DEF_PIXEL_FORMAT_MASK
+				isBlack = ( (*pnt & labelMaskBit) != 0 );
+#endif
 
 			if(isBlack) {
 				pnt1 = &(pnt2[-lxsize]);
@@ -343,8 +381,13 @@ AR_TEMPL_TRACKER::LABEL_FUNC_NAME(uint8_t *image, int thresh, int *label_num, in
                 }
                 else {
                     wk_max++;
-                    if( wk_max > WORK_SIZE ) {
-                        return(0);
+                    if( wk_max > (LorR ? labelCapacity : labelCapacityR) ) {
+                        if( !growLabelTables(wk_max, LorR) ) return(0);
+                        work  = LorR ? workL  : workR;
+                        work2 = LorR ? work2L : work2R;
+                        warea = LorR ? wareaL : wareaR;
+                        wclip = LorR ? wclipL : wclipR;
+                        wpos  = LorR ? wposL  : wposR;
                     }
                     work[wk_max-1] = *pnt2 = wk_max;
 #ifdef _DISABLE_TP_OPTIMIZATIONS_
@@ -373,7 +416,9 @@ AR_TEMPL_TRACKER::LABEL_FUNC_NAME(uint8_t *image, int thresh, int *label_num, in
 
 		}	// end for x
 		
+#ifndef _DEF_PIXEL_FORMAT_MASK
 		if( arImageProcMode == AR_IMAGE_PROC_IN_HALF ) pnt += arImXsize*pixelSize;
+#endif
 
 	}	// end for y
 
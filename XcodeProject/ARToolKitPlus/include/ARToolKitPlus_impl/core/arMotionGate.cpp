@@ -0,0 +1,362 @@
+/* ========================================================================
+ * PROJECT: ARToolKitPlus
+ * ========================================================================
+ * This work is based on the original ARToolKit developed by
+ *   Hirokazu Kato
+ *   Mark Billinghurst
+ *   HITLab, University of Washington, Seattle
+ * http://www.hitl.washington.edu/artoolkit/
+ *
+ * Copyright of the derived and new portions of this work
+ *     (C) 2006 Graz University of Technology
+ *
+ * This framework is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this framework; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * For further information please contact 
+ *   Dieter Schmalstieg
+ *   <schmalstieg@icg.tu-graz.ac.at>
+ *   Graz University of Technology, 
+ *   Institut for Computer Graphics and Vision,
+ *   Inffeldgasse 16a, 8010 Graz, Austria.
+ * ========================================================================
+ ** @author   Daniel Wagner
+ *
+ * $Id$
+ * @file
+ * ======================================================================== */
+
+
+#include <string.h>
+#include <ARToolKitPlus/Tracker.h>
+
+
+namespace ARToolKitPlus {
+
+
+// the frame signature: the mean luminance of every BLOCK_SIZE x BLOCK_SIZE pixels,
+// (r+g+b)/3 for the color formats, sampled at every SAMPLE_STEP-th pixel and row.
+// that is plenty to notice a marker move and keeps the signature clearly cheaper
+// than a labeling pass. a few rightmost columns and bottom rows that do not fill a
+// whole block are not looked at. sums and differences are taken on integers, which
+// the float lanes of extra/SimdFloat.h do not help with.
+//
+// the frame is compared against the block means of the last processed frame. a tile
+// (TILE_BLOCKS x TILE_BLOCKS blocks) has changed if any of its blocks is off by more
+// than the tolerance. nothing changed: the caller returns the cached results. otherwise
+// the rectangle around all changed tiles plus one tile of margin is grown until it
+// either contains or misses every marker of the last frame completely and becomes
+// labelRegion. markers that are cut by the border of the labeled window are dropped by
+// arDetectMarker2(), so a marker can not show up twice after arUpdateMotionGate().
+//
+AR_TEMPL_FUNC int
+AR_TEMPL_TRACKER::arCheckMotionGate(uint8_t *dataPtr, int nThresh)
+{
+	const int bs = MotionGate::BLOCK_SIZE, tb = MotionGate::TILE_BLOCKS;
+	int x, y, bx, by, i;
+
+	labelRegion.active = false;
+	motionGate.state = MotionGate::FRAME_FULL;
+	motionGate.markersUnchanged = false;
+	motionGate.blocks = NULL;
+
+	if(!motionGate.enabled)
+		return motionGate.state;
+
+	const int nbx = arImXsize/bs, nby = arImYsize/bs;
+
+	if(nbx<1 || nby<1)
+		return motionGate.state;
+
+	if(nbx!=motionGate.blocksX || nby!=motionGate.blocksY)
+	{
+		if(motionGate.reference)
+			artkp_Free(motionGate.reference);
+		motionGate.reference = artkp_Alloc<uint8_t>(nbx*nby);
+		motionGate.blocksX = nbx;
+		motionGate.blocksY = nby;
+		motionGate.valid = false;
+
+		if(!motionGate.reference)
+		{
+			motionGate.blocksX = motionGate.blocksY = 0;
+			return motionGate.state;
+		}
+	}
+
+	const int		step = MotionGate::SAMPLE_STEP;
+	const int		offs = (pixelFormat==PIXEL_FORMAT_ABGR) ? 1 : 0;
+	const int		num = (bs/step)*(bs/step);
+	uint8_t			*blocks = (uint8_t*)frameScratch.getMemory(nbx*nby);
+	unsigned int	*sums = (unsigned int*)frameScratch.getMemory(nbx*sizeof(unsigned int));
+
+	if(!blocks || !sums)
+		return motionGate.state;
+
+	for(by=0; by<nby; by++)
+	{
+		memset(sums, 0, nbx*sizeof(unsigned int));
+
+		for(y=0; y<bs; y+=step)
+		{
+			uint8_t *pnt = dataPtr + (by*bs+y)*arImXsize*pixelSize;
+
+			switch(pixelFormat)
+			{
+			case PIXEL_FORMAT_LUM:
+				for(bx=0; bx<nbx; bx++, pnt+=bs)
+					for(x=0; x<bs; x+=step)
+						sums[bx] += pnt[x];
+				break;
+
+			case PIXEL_FORMAT_RGB565:
+				for(bx=0; bx<nbx; bx++, pnt+=bs*2)
+					for(x=0; x<bs; x+=step)
+						sums[bx] += getLUM8_from_RGB565(pnt+x*2);
+				break;
+
+			case PIXEL_FORMAT_RGB:
+			case PIXEL_FORMAT_BGR:
+				for(bx=0; bx<nbx; bx++, pnt+=bs*3)
+					for(x=0; x<bs*3; x+=step*3)
+						sums[bx] += (pnt[x] + pnt[x+1] + pnt[x+2]) / 3;
+				break;
+
+			default:
+				for(bx=0; bx<nbx; bx++, pnt+=bs*4)
+					for(x=offs; x<bs*4; x+=step*4)
+						sums[bx] += (pnt[x] + pnt[x+1] + pnt[x+2]) / 3;
+				break;
+			}
+		}
+
+		uint8_t *dst = blocks + by*nbx;
+
+		for(bx=0; bx<nbx; bx++)
+			dst[bx] = (uint8_t)(sums[bx]/num);
+	}
+
+	motionGate.blocks = blocks;
+
+	// the last frame is of no use if the labeling would have looked different.
+	// the auto threshold jitters a little even on a static image, small moves are ignored
+	//
+	int threshDiff = nThresh>motionGate.thresh ? nThresh-motionGate.thresh : motionGate.thresh-nThresh;
+
+	if(!motionGate.valid || motionGate.imageProcMode!=arImageProcMode || motionGate.pixelFormat!=pixelFormat ||
+	   threshDiff>(autoThreshold.enable ? motionGate.tolerance : 0))
+		return motionGate.state;
+
+	// bounding box of the changed tiles
+	//
+	const uint8_t *ref = motionGate.reference;
+	const int tol = motionGate.tolerance;
+	int tx0 = nbx, ty0 = nby, tx1 = -1, ty1 = -1;
+
+	for(by=0; by<nby; by++)
+	{
+		const uint8_t *cur = blocks + by*nbx, *old = ref + by*nbx;
+
+		for(bx=0; bx<nbx; bx++)
+		{
+			int d = (int)cur[bx] - (int)old[bx];
+			if(d>tol || d<-tol)
+			{
+				int tx = bx/tb, ty = by/tb;
+				if(tx<tx0) tx0 = tx;
+				if(tx>tx1) tx1 = tx;
+				if(ty<ty0) ty0 = ty;
+				if(ty>ty1) ty1 = ty;
+
+				// the rest of this tile can not change the box anymore
+				bx = (tx+1)*tb-1;
+			}
+		}
+	}
+
+	if(tx1<0)
+	{
+		motionGate.markersUnchanged = true;
+		return motionGate.state = MotionGate::FRAME_UNCHANGED;
+	}
+
+	// tile box plus one tile margin, in pixels
+	//
+	const int tileSize = tb*bs;
+	int x0 = (tx0-1)*tileSize, y0 = (ty0-1)*tileSize,
+		x1 = (tx1+2)*tileSize, y1 = (ty1+2)*tileSize;
+
+	// markers that reach into the box are searched again, so the box has to contain them
+	//
+	const int margin = tileSize/2;
+	bool grown = true;
+
+	while(grown)
+	{
+		grown = false;
+
+		for(i=0; i<motionGate.numDetected; i++)
+		{
+			const ARMarkerInfo &m = motionGate.detected[i];
+			int mx0 = arImXsize, my0 = arImYsize, mx1 = 0, my1 = 0;
+
+			for(int k=0; k<4; k++)
+			{
+				int vx = (int)m.vertex[k][0], vy = (int)m.vertex[k][1];
+				if(vx<mx0) mx0 = vx;
+				if(vx>mx1) mx1 = vx;
+				if(vy<my0) my0 = vy;
+				if(vy>my1) my1 = vy;
+			}
+			mx0 -= margin;  my0 -= margin;
+			mx1 += margin;  my1 += margin;
+
+			if(mx1<x0 || mx0>=x1 || my1<y0 || my0>=y1)
+				continue;
+
+			if(mx0<x0) { x0 = mx0;  grown = true; }
+			if(my0<y0) { y0 = my0;  grown = true; }
+			if(mx1>=x1) { x1 = mx1+1;  grown = true; }
+			if(my1>=y1) { y1 = my1+1;  grown = true; }
+		}
+	}
+
+	if(x0<0) x0 = 0;
+	if(y0<0) y0 = 0;
+	if(x1>arImXsize) x1 = arImXsize;
+	if(y1>arImYsize) y1 = arImYsize;
+
+	// the vignetting compensation is interpolated over the whole image row by row
+	//
+	if(vignetting.enabled || (x1-x0)*(y1-y0)*100 > arImXsize*arImYsize*MotionGate::MAX_PARTIAL_AREA)
+		return motionGate.state;
+
+	motionGate.regionX0 = x0;
+	motionGate.regionY0 = y0;
+	motionGate.regionX1 = x1;
+	motionGate.regionY1 = y1;
+
+	labelRegion.active = true;
+	if( arImageProcMode == AR_IMAGE_PROC_IN_HALF ) {
+		labelRegion.x0 = x0/2;  labelRegion.x1 = (x1+1)/2;
+		labelRegion.y0 = y0/2;  labelRegion.y1 = (y1+1)/2;
+		if(labelRegion.x1>arImXsize/2) labelRegion.x1 = arImXsize/2;
+		if(labelRegion.y1>arImYsize/2) labelRegion.y1 = arImYsize/2;
+	}
+	else {
+		labelRegion.x0 = x0;  labelRegion.x1 = x1;
+		labelRegion.y0 = y0;  labelRegion.y1 = y1;
+	}
+
+	return motionGate.state = MotionGate::FRAME_PARTIAL;
+}
+
+
+// called once wmarker_info holds the detections of this frame (before the tracking
+// history is applied): takes over the markers outside of the labeled region and makes
+// the block means of the processed part of the image the new reference.
+//
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::arUpdateMotionGate()
+{
+	const int bs = MotionGate::BLOCK_SIZE;
+	int i, n, by;
+
+	if(!motionGate.enabled || !motionGate.blocks)
+		return;
+
+	const int nbx = motionGate.blocksX, nby = motionGate.blocksY;
+
+	if(motionGate.state==MotionGate::FRAME_PARTIAL)
+	{
+		const int x0 = motionGate.regionX0, y0 = motionGate.regionY0,
+				  x1 = motionGate.regionX1, y1 = motionGate.regionY1;
+
+		// if the change did neither touch an old marker nor show a new one
+		// (squares that are not identified do not count), the markers are
+		// the same as in the last frame
+		bool unchanged = true;
+
+		for(i=0; i<wmarker_num; i++)
+			if(wmarker_info[i].cf>=0.5)
+				unchanged = false;
+
+		// the region was grown to hold every old marker it touches
+		// completely, those have been searched again
+		for(i=0; i<motionGate.numDetected && wmarker_num<MAX_IMAGE_PATTERNS; i++)
+		{
+			const ARMarkerInfo &m = motionGate.detected[i];
+			bool inside = false;
+
+			for(int k=0; k<4; k++)
+				if(m.vertex[k][0]>=x0 && m.vertex[k][0]<x1 && m.vertex[k][1]>=y0 && m.vertex[k][1]<y1)
+					inside = true;
+
+			if(!inside)
+				wmarker_info[wmarker_num++] = m;
+			else if(m.cf>=0.5)
+				unchanged = false;
+		}
+
+		motionGate.markersUnchanged = unchanged;
+
+		const int bx0 = x0/bs, by0 = y0/bs;
+		const int bx1 = (x1+bs-1)/bs < nbx ? (x1+bs-1)/bs : nbx,
+				  by1 = (y1+bs-1)/bs < nby ? (y1+bs-1)/bs : nby;
+
+		for(by=by0; by<by1; by++)
+			memcpy(motionGate.reference+by*nbx+bx0, motionGate.blocks+by*nbx+bx0, bx1-bx0);
+	}
+	else
+	{
+		memcpy(motionGate.reference, motionGate.blocks, nbx*nby);
+		motionGate.imageProcMode = arImageProcMode;
+		motionGate.pixelFormat = pixelFormat;
+		motionGate.valid = true;
+	}
+
+	n = wmarker_num<MAX_IMAGE_PATTERNS ? wmarker_num : MAX_IMAGE_PATTERNS;
+	memcpy(motionGate.detected, wmarker_info, n*sizeof(ARMarkerInfo));
+	motionGate.numDetected = n;
+}
+
+
+// keeps what arDetectMarker() hands out, to be returned again for unchanged
+// frames, and the threshold the image was labeled with
+//
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::arStoreMotionGateResult(int nThresh)
+{
+	if(!motionGate.enabled)
+		return;
+
+	memcpy(motionGate.output, wmarker_info, wmarker_num*sizeof(ARMarkerInfo));
+	motionGate.numOutput = wmarker_num;
+	motionGate.thresh = nThresh;
+}
+
+
+// unchanged frames: the results of the last processed frame
+//
+AR_TEMPL_FUNC ARMarkerInfo*
+AR_TEMPL_TRACKER::arGetMotionGateResult(int *marker_num)
+{
+	memcpy(marker_infoL, motionGate.output, motionGate.numOutput*sizeof(ARMarkerInfo));
+	wmarker_info = marker_infoL;
+	wmarker_num = *marker_num = motionGate.numOutput;
+	return wmarker_info;
+}
+
+
+}	// namespace ARToolKitPlus
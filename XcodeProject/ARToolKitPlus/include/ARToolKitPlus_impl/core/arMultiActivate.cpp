@@ -85,7 +85,9 @@ AR_TEMPL_TRACKER::arMultiFreeConfig( ARMultiMarkerInfoT *config )
     for( i = 0; i < config->marker_num; i++ ) {
         arFreePatt( config->marker[i].patt_id );
     }
-    free( config->marker );
+    arMultiFreeConfigIndex( config );
+    if( arMultiIsConfigBundle(config) ) arMultiFreeConfigBundle( config );
+    else                                free( config->marker );
     free( config );
     config = NULL;
 
@@ -0,0 +1,374 @@
+/* ========================================================================
+ * PROJECT: ARToolKitPlus
+ * ========================================================================
+ * This work is based on the original ARToolKit developed by
+ *   Hirokazu Kato
+ *   Mark Billinghurst
+ *   HITLab, University of Washington, Seattle
+ * http://www.hitl.washington.edu/artoolkit/
+ *
+ * Copyright of the derived and new portions of this work
+ *     (C) 2006 Graz University of Technology
+ *
+ * This framework is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this framework; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * For further information please contact 
+ *   Dieter Schmalstieg
+ *   <schmalstieg@icg.tu-graz.ac.at>
+ *   Graz University of Technology, 
+ *   Institut for Computer Graphics and Vision,
+ *   Inffeldgasse 16a, 8010 Graz, Austria.
+ * ========================================================================
+ ** @author   Daniel Wagner
+ *
+ * $Id$
+ * @file
+ * ======================================================================== */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ARToolKitPlus/Tracker.h>
+
+#if !defined(_MSC_VER) && !defined(_WIN32_WCE)
+#  define AR_MULTI_BUNDLE_USE_MMAP
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#endif
+
+
+namespace ARToolKitPlus {
+
+
+static bool
+isValidMultiBundle(const ARMultiBundleHeaderT *header, long nSize)
+{
+    long    markerSize, patternSize;
+
+    if( nSize < (long)sizeof(ARMultiBundleHeaderT) ) return false;
+    if( memcmp(header->magic, AR_MULTI_BUNDLE_MAGIC, sizeof(header->magic)) != 0 ) return false;
+    if( header->version != AR_MULTI_BUNDLE_VERSION ) return false;
+    if( header->endianTag != AR_MULTI_BUNDLE_ENDIAN ) return false;
+    if( header->floatSize != sizeof(ARFloat) ) return false;
+    if( header->markerInfoSize != sizeof(ARMultiEachMarkerInfoT) ) return false;
+    if( header->fileSize != (uint32_t)nSize ) return false;
+    if( header->markerNum < 0 || header->patternNum < 0 ) return false;
+    if( header->patternWidth <= 0 || header->patternHeight <= 0 ) return false;
+
+    // bounded before arMultiBundlePatternSize() multiplies them; whether they match
+    // this build's pattern size is checked by the caller
+    if( header->patternWidth > AR_MULTI_BUNDLE_MAX_PATTERN_SIZE ||
+        header->patternHeight > AR_MULTI_BUNDLE_MAX_PATTERN_SIZE ) return false;
+
+    // every count is checked against the file size before it is multiplied
+    //
+    if( header->markerNum > nSize/(long)sizeof(ARMultiEachMarkerInfoT) ) return false;
+    patternSize = arMultiBundlePatternSize(header->patternWidth, header->patternHeight, sizeof(ARFloat));
+    if( header->patternNum > nSize/patternSize ) return false;
+    markerSize = header->markerNum*(long)sizeof(ARMultiEachMarkerInfoT);
+
+    if( (header->markerOffset & 7) || (header->patternRefOffset & 7) || (header->patternOffset & 7) ) return false;
+    if( header->markerOffset < sizeof(ARMultiBundleHeaderT) ) return false;
+    if( (long)header->markerOffset + markerSize > (long)header->patternRefOffset ) return false;
+    if( (long)header->patternRefOffset + header->markerNum*(long)sizeof(int32_t) > (long)header->patternOffset ) return false;
+    if( (long)header->patternOffset + header->patternNum*patternSize > nSize ) return false;
+
+    return true;
+}
+
+
+AR_TEMPL_FUNC ARMultiMarkerInfoT*
+AR_TEMPL_TRACKER::arMultiReadConfigBundle(const char *filename)
+{
+    const ARMultiBundleHeaderT  *header;
+    const int32_t               *patternRef;
+    const uint8_t               *record;
+    ARMultiMarkerInfoT          *marker_info;
+    uint8_t                     *data;
+    long                        size;
+    int                         *slots;
+    int                         i, h, n, recordSize;
+
+#ifdef AR_MULTI_BUNDLE_USE_MMAP
+    // the mapping is private and writable: the marker table is used in place
+    // and visible/patt_id get written to copy-on-write pages, never to the file
+    //
+    struct stat st;
+    void        *map;
+    int         fd;
+
+    if( (fd=open(filename, O_RDONLY)) < 0 ) return NULL;
+    if( fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(ARMultiBundleHeaderT) ) {close(fd); return NULL;}
+    size = (long)st.st_size;
+    map = mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if( map == MAP_FAILED ) return NULL;
+    data = (uint8_t*)map;
+#else
+    FILE        *fp;
+
+    if( (fp=fopen(filename, "rb")) == NULL ) return NULL;
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if( size < (long)sizeof(ARMultiBundleHeaderT) ) {fclose(fp); return NULL;}
+    arMalloc(data, uint8_t, size);
+    if( fread(data, 1, size, fp) != (size_t)size ) {fclose(fp); free(data); return NULL;}
+    fclose(fp);
+#endif
+
+    marker_info = (ARMultiMarkerInfoT *)malloc( sizeof(ARMultiMarkerInfoT) );
+    if( marker_info == NULL ) {
+#ifdef AR_MULTI_BUNDLE_USE_MMAP
+        munmap(data, size);
+#else
+        free(data);
+#endif
+        return NULL;
+    }
+    marker_info->bundle     = data;
+    marker_info->bundleSize = size;
+
+    header = (const ARMultiBundleHeaderT*)data;
+    if( !isValidMultiBundle(header, size) ) {
+        if(logger)
+            logger->artLogEx("ARToolKitPlus: '%s' is not a valid multi-marker bundle for this build\n", filename);
+        arMultiFreeConfigBundle(marker_info);
+        free(marker_info);
+        return NULL;
+    }
+
+    if( header->patternNum > 0 &&
+        (header->patternWidth != PATTERN_WIDTH || header->patternHeight != PATTERN_HEIGHT || header->binaryThreshold != binaryMarkerThreshold) ) {
+        if(logger)
+            logger->artLogEx("ARToolKitPlus: bundle '%s' was created for %dx%d patterns with binary threshold %d\n",
+                             filename, header->patternWidth, header->patternHeight, header->binaryThreshold);
+        arMultiFreeConfigBundle(marker_info);
+        free(marker_info);
+        return NULL;
+    }
+
+    marker_info->marker     = (ARMultiEachMarkerInfoT*)(data + header->markerOffset);
+    marker_info->marker_num = header->markerNum;
+    marker_info->prevF      = 0;
+    patternRef              = (const int32_t*)(data + header->patternRefOffset);
+
+    for( i = 0; i < header->markerNum; i++ ) {
+        if( patternRef[i] < -1 || patternRef[i] >= header->patternNum ) {
+            arMultiFreeConfigBundle(marker_info);
+            free(marker_info);
+            return NULL;
+        }
+    }
+
+    // copy the precomputed patterns into free slots (same slot search as arLoadPatt())
+    //
+    if(pattern_num == -1 ) {
+        for( i = 0; i < MAX_LOAD_PATTERNS; i++ ) patf[i] = 0;
+        pattern_num = 0;
+    }
+
+    arMalloc(slots, int, header->patternNum>0 ? header->patternNum : 1);
+    for( n = 0, i = 0; n < header->patternNum && i < MAX_LOAD_PATTERNS; i++ ) {
+        if( patf[i] == 0 ) slots[n++] = i;
+    }
+    if( n < header->patternNum ) {
+        if(logger)
+            logger->artLogEx("ARToolKitPlus: bundle '%s' needs %d free pattern slots\n", filename, header->patternNum);
+        free(slots);
+        arMultiFreeConfigBundle(marker_info);
+        free(marker_info);
+        return NULL;
+    }
+
+    recordSize = arMultiBundlePatternSize(PATTERN_WIDTH, PATTERN_HEIGHT, sizeof(ARFloat));
+    for( n = 0; n < header->patternNum; n++ ) {
+        const int32_t   *recPat, *recPatBW;
+        const ARFloat   *recPow;
+
+        record   = data + header->patternOffset + n*recordSize;
+        recPat   = (const int32_t*)record;
+        recPatBW = recPat + 4*PATTERN_HEIGHT*PATTERN_WIDTH*3;
+        recPow   = (const ARFloat*)(recPatBW + 4*PATTERN_HEIGHT*PATTERN_WIDTH);
+
+        for( h = 0; h < 4; h++ ) {
+            memcpy(pat[slots[n]][h], recPat + h*PATTERN_HEIGHT*PATTERN_WIDTH*3, PATTERN_HEIGHT*PATTERN_WIDTH*3*sizeof(int));
+            memcpy(patBW[slots[n]][h], recPatBW + h*PATTERN_HEIGHT*PATTERN_WIDTH, PATTERN_HEIGHT*PATTERN_WIDTH*sizeof(int));
+            patpow[slots[n]][h]   = recPow[h];
+            patpowBW[slots[n]][h] = recPow[4+h];
+        }
+        patf[slots[n]] = 1;
+        pattern_num++;
+    }
+
+    for( i = 0; i < header->markerNum; i++ ) {
+        if( patternRef[i] >= 0 ) marker_info->marker[i].patt_id = slots[patternRef[i]];
+    }
+
+    if( !arMultiCreateConfigIndex(marker_info) ) {
+        for( n = 0; n < header->patternNum; n++ ) arFreePatt(slots[n]);
+        free(slots);
+        arMultiFreeConfigBundle(marker_info);
+        free(marker_info);
+        return NULL;
+    }
+    free(slots);
+
+    bundleConfigs.push_back(marker_info);
+
+    return marker_info;
+}
+
+
+AR_TEMPL_FUNC bool
+AR_TEMPL_TRACKER::arMultiIsConfigBundle(const ARMultiMarkerInfoT *config) const
+{
+    for( size_t i = 0; i < bundleConfigs.size(); i++ ) {
+        if( bundleConfigs[i] == config ) return true;
+    }
+
+    return false;
+}
+
+
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::arMultiFreeConfigBundle(ARMultiMarkerInfoT *config)
+{
+    for( size_t i = 0; i < bundleConfigs.size(); i++ ) {
+        if( bundleConfigs[i] == config ) {bundleConfigs.erase(bundleConfigs.begin()+i); break;}
+    }
+    if( config->bundle == NULL ) return;
+
+#ifdef AR_MULTI_BUNDLE_USE_MMAP
+    munmap(config->bundle, config->bundleSize);
+#else
+    free(config->bundle);
+#endif
+    config->bundle     = NULL;
+    config->bundleSize = 0;
+    config->marker     = NULL;
+}
+
+
+AR_TEMPL_FUNC int
+AR_TEMPL_TRACKER::arMultiWriteConfigBundle(const char *nConfigFile, const char *nBundleFile)
+{
+    ARMultiMarkerInfoT      *config;
+    ARMultiBundleHeaderT    header;
+    FILE                    *fp;
+    char                    buf[256], buf1[256];
+    int                     slotToPattern[MAX_LOAD_PATTERNS];
+    int32_t                 *patternRef;
+    uint8_t                 *data;
+    int                     i, h, num, patternNum, recordSize;
+    bool                    ok;
+
+    if( (config=arMultiReadConfigFile(nConfigFile)) == NULL ) return -1;
+    if( arMultiIsConfigBundle(config) ) {
+        if(logger)
+            logger->artLogEx("ARToolKitPlus: '%s' already is a multi-marker bundle\n", nConfigFile);
+        arMultiFreeConfig(config);
+        return -1;
+    }
+
+    // the parsed config does not tell template patterns from marker ids,
+    // so walk the marker names of the text file once more
+    //
+    if( (fp=fopen(nConfigFile, "r")) == NULL ) {arMultiFreeConfig(config); return -1;}
+    get_buff(buf, 256, fp);
+    if( sscanf(buf, "%d", &num) != 1 || num != config->marker_num ) {fclose(fp); arMultiFreeConfig(config); return -1;}
+
+    for( i = 0; i < MAX_LOAD_PATTERNS; i++ ) slotToPattern[i] = -1;
+    arMalloc(patternRef, int32_t, num>0 ? num : 1);
+    patternNum = 0;
+
+    for( i = 0; i < num; i++ ) {
+        get_buff(buf, 256, fp);
+        sscanf(buf, "%s", buf1);
+        if( isNumber(buf1) ) {
+            patternRef[i] = -1;
+        }
+        else {
+            if( slotToPattern[config->marker[i].patt_id] == -1 ) slotToPattern[config->marker[i].patt_id] = patternNum++;
+            patternRef[i] = slotToPattern[config->marker[i].patt_id];
+        }
+        for( h = 0; h < 5; h++ ) get_buff(buf, 256, fp);     // width, center, 3 rows of trans
+    }
+    fclose(fp);
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, AR_MULTI_BUNDLE_MAGIC, sizeof(header.magic));
+    header.version          = AR_MULTI_BUNDLE_VERSION;
+    header.endianTag        = AR_MULTI_BUNDLE_ENDIAN;
+    header.floatSize        = sizeof(ARFloat);
+    header.markerInfoSize   = sizeof(ARMultiEachMarkerInfoT);
+    header.patternWidth     = PATTERN_WIDTH;
+    header.patternHeight    = PATTERN_HEIGHT;
+    header.binaryThreshold  = binaryMarkerThreshold;
+    header.markerNum        = num;
+    header.patternNum       = patternNum;
+    header.markerOffset     = arMultiBundleAlign(sizeof(ARMultiBundleHeaderT));
+    header.patternRefOffset = arMultiBundleAlign(header.markerOffset + num*sizeof(ARMultiEachMarkerInfoT));
+    header.patternOffset    = arMultiBundleAlign(header.patternRefOffset + num*sizeof(int32_t));
+    recordSize              = arMultiBundlePatternSize(PATTERN_WIDTH, PATTERN_HEIGHT, sizeof(ARFloat));
+    header.fileSize         = header.patternOffset + patternNum*recordSize;
+
+    data = (uint8_t*)calloc(header.fileSize, 1);
+    if( data == NULL ) {free(patternRef); arMultiFreeConfig(config); return -1;}
+
+    memcpy(data, &header, sizeof(header));
+    memcpy(data + header.markerOffset, config->marker, num*sizeof(ARMultiEachMarkerInfoT));
+    memcpy(data + header.patternRefOffset, patternRef, num*sizeof(int32_t));
+
+    for( i = 0; i < MAX_LOAD_PATTERNS; i++ ) {
+        int32_t *recPat, *recPatBW;
+        ARFloat *recPow;
+
+        if( slotToPattern[i] == -1 ) continue;
+
+        recPat   = (int32_t*)(data + header.patternOffset + slotToPattern[i]*recordSize);
+        recPatBW = recPat + 4*PATTERN_HEIGHT*PATTERN_WIDTH*3;
+        recPow   = (ARFloat*)(recPatBW + 4*PATTERN_HEIGHT*PATTERN_WIDTH);
+
+        for( h = 0; h < 4; h++ ) {
+            memcpy(recPat + h*PATTERN_HEIGHT*PATTERN_WIDTH*3, pat[i][h], PATTERN_HEIGHT*PATTERN_WIDTH*3*sizeof(int));
+            memcpy(recPatBW + h*PATTERN_HEIGHT*PATTERN_WIDTH, patBW[i][h], PATTERN_HEIGHT*PATTERN_WIDTH*sizeof(int));
+            recPow[h]   = patpow[i][h];
+            recPow[4+h] = patpowBW[i][h];
+        }
+    }
+
+    ok = false;
+    if( (fp=fopen(nBundleFile, "wb")) != NULL ) {
+        ok = fwrite(data, 1, header.fileSize, fp) == header.fileSize;
+        ok = (fclose(fp) == 0) && ok;
+    }
+
+    if( !ok && logger )
+        logger->artLogEx("ARToolKitPlus: failed to write multi-marker bundle '%s'\n", nBundleFile);
+
+    free(data);
+    free(patternRef);
+    arMultiFreeConfig(config);
+
+    return ok ? 0 : -1;
+}
+
+
+}  // namespace ARToolKitPlus
@@ -56,14 +56,6 @@ namespace ARToolKitPlus {
 #define  AR_MULTI_GET_TRANS_MAT_MAX_LOOP_COUNT   2
 #define  AR_MULTI_GET_TRANS_MAT_MAX_FIT_ERROR    10.0
 
-typedef struct {
-    ARFloat   pos[4][2];
-    ARFloat   thresh;
-    ARFloat   err;
-    int      marker;
-    int      dir;
-} arMultiEachMarkerInternalInfoT;
-
 
 AR_TEMPL_FUNC ARFloat
 AR_TEMPL_TRACKER::arMultiGetTransMat(ARMarkerInfo *marker_info, int marker_num, ARMultiMarkerInfoT *config)
@@ -75,22 +67,31 @@ AR_TEMPL_TRACKER::arMultiGetTransMat(ARMarkerInfo *marker_info, int marker_num,
     int                   dir;
     int                   i, j, k;
 
+    // configs built by the application get their buffers now
+    if( !arMultiHasConfigIndex(config) && !arMultiCreateConfigIndex(config) ) return -1;
+
     if( config->prevF ) {
         verify_markers( marker_info, marker_num, config );
     }
 
+    // find the detected marker with the highest confidence for each config entry:
+    // a single pass over the detected markers using the patt_id lookup table
+    //
+    for( i = 0; i < config->marker_num; i++ ) config->marker[i].visible = -1;
+    for( j = 0; j < marker_num; j++ ) {
+        if( marker_info[j].cf < 0.70 ) continue;
+        if( (i = arMultiGetConfigIndex(config, marker_info[j].id)) < 0 ) continue;
+
+        k = config->marker[i].visible;
+        if( k == -1 || marker_info[k].cf < marker_info[j].cf ) {
+            for( ; i != -1; i = arMultiGetNextConfigIndex(config, i) ) config->marker[i].visible = j;
+        }
+    }
+
     max = -1;
     vnum = 0;
     for( i = 0; i < config->marker_num; i++ ) {
-        k = -1;
-        for( j = 0; j < marker_num; j++ ) {
-            if( marker_info[j].id != config->marker[i].patt_id ) continue;
-            if( marker_info[j].cf < 0.70 ) continue;
-
-            if( k == -1 ) k = j;
-            else if( marker_info[k].cf < marker_info[j].cf ) k = j;
-        }
-        if( (config->marker[i].visible=k) == -1) continue;
+        if( (k=config->marker[i].visible) == -1) continue;
 
 		// Changed by Daniel: use the selected pose estimator for this now. i'm though not sure if
 		//                    it is wise to use arGetTransMatCont for multi-marker tracking...
@@ -126,8 +127,8 @@ AR_TEMPL_TRACKER::arMultiGetTransMat(ARMarkerInfo *marker_info, int marker_num,
         return -1;
     }
 
-    arMalloc(pos2d, ARFloat, vnum*4*2);
-    arMalloc(pos3d, ARFloat, vnum*4*3);
+    pos2d = config->pos2d;
+    pos3d = config->pos3d;
 
     j = 0;
     for( i = 0; i < config->marker_num; i++ ) {
@@ -172,8 +173,6 @@ AR_TEMPL_TRACKER::arMultiGetTransMat(ARMarkerInfo *marker_info, int marker_num,
 
         if( err < THRESH_2 ) {
             config->prevF = 1;
-            free(pos3d);
-            free(pos2d);
             return err;
         }
     }
@@ -207,26 +206,54 @@ AR_TEMPL_TRACKER::arMultiGetTransMat(ARMarkerInfo *marker_info, int marker_num,
         config->prevF = 0;
     }
 
-    free(pos3d);
-    free(pos2d);
     return err;
 }
 
 
+static int
+compareSortedMarkers( const void *a, const void *b )
+{
+    ARFloat d = ((const arMultiSortedMarkerT*)a)->cx - ((const arMultiSortedMarkerT*)b)->cx;
+
+    return d<0 ? -1 : (d>0 ? 1 : 0);
+}
+
+
 AR_TEMPL_FUNC int
 AR_TEMPL_TRACKER::verify_markers(ARMarkerInfo *marker_info, int marker_num, ARMultiMarkerInfoT *config)
 {
     arMultiEachMarkerInternalInfoT *winfo;
+    arMultiSortedMarkerT           *sorted;
     ARFloat                         wtrans[3][4];
     ARFloat                         pos3d[4][2];
     ARFloat                         wx, wy, wz, hx, hy, h;
     int                            dir1, dir2 = 0, marker2;
     ARFloat                         err, err1 = 0, err2;
     ARFloat                         x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+    ARFloat                         cx, r;
     int                            w1, w2;
-    int                            i, j, k;
-
-    arMalloc(winfo,arMultiEachMarkerInternalInfoT,config->marker_num);
+    int                            i, j, k, s, lo, hi;
+
+    if( !arMultiHasConfigIndex(config) && !arMultiCreateConfigIndex(config) ) return -1;
+    winfo = config->winfo;
+
+    // sort the detected markers by the x-coordinate of their corner centroid.
+    // the squared distance of two centroids is at most a quarter of the summed
+    // squared corner distances, so only markers within sqrt(thresh)/2 of a
+    // projected marker can pass the threshold test below.
+    //
+    if( config->sortedSize < marker_num ) {
+        free(config->sorted);
+        arMalloc(config->sorted, arMultiSortedMarkerT, marker_num);
+        config->sortedSize = marker_num;
+    }
+    sorted = config->sorted;
+    for( j = 0; j < marker_num; j++ ) {
+        sorted[j].cx = (marker_info[j].vertex[0][0] + marker_info[j].vertex[1][0]
+                      + marker_info[j].vertex[2][0] + marker_info[j].vertex[3][0]) * 0.25f;
+        sorted[j].marker = j;
+    }
+    if( marker_num > 1 ) qsort( sorted, marker_num, sizeof(arMultiSortedMarkerT), compareSortedMarkers );
 
     for( i = 0; i < config->marker_num; i++ ) {
 		arUtilMatMul(config->trans, config->marker[i].trans, wtrans);
@@ -298,7 +325,19 @@ printf("\n");
     for( i = 0; i < config->marker_num; i++ ) {
         marker2 = -1;
         err2 = winfo[i].thresh;
-        for( j = 0; j < marker_num; j++ ) {
+
+        cx = (winfo[i].pos[0][0] + winfo[i].pos[1][0] + winfo[i].pos[2][0] + winfo[i].pos[3][0]) * 0.25f;
+        r  = (ARFloat)sqrt(winfo[i].thresh > 0 ? winfo[i].thresh : 0) * 0.5f + 1.0f;
+
+        lo = 0;  hi = marker_num;
+        while( lo < hi ) {
+            k = (lo + hi) / 2;
+            if( sorted[k].cx < cx - r ) lo = k + 1;
+            else                        hi = k;
+        }
+
+        for( s = lo; s < marker_num && sorted[s].cx <= cx + r; s++ ) {
+            j = sorted[s].marker;
             if( marker_info[j].id != -1
              && marker_info[j].id != config->marker[i].patt_id
              && marker_info[j].cf > 0.7 ) continue;
@@ -329,7 +368,8 @@ printf("\n");
 #ifdef ARTK_DEBUG
 	printf("%f\n", err1);
 #endif
-            if( err1 < err2 ) {
+            // same winner as a scan in detection order: lowest index on ties
+            if( err1 < err2 || (err1 == err2 && marker2 != -1 && j < marker2) ) {
                 err2 = err1;
                 dir2 = dir1;
                 marker2 = j;
@@ -355,23 +395,24 @@ printf("\n");
 	printf("w1,w2 = %d,%d\n", w1, w2);
 #endif
     if( w2 >= w1 ) {
-        free(winfo);
         return -1;
     }
 
+    // drop all ids belonging to this config, then hand out the verified ones.
+    // if several config entries share an id only the last one keeps it
+    // (the others got their id cleared again by the later entry before).
+    //
+    for( j = 0; j < marker_num; j++ ) {
+        if( arMultiGetConfigIndex(config, marker_info[j].id) >= 0 ) marker_info[j].id = -1;
+    }
     for( i = 0; i < config->marker_num; i++ ) {
-        for( j = 0; j < marker_num; j++ ) {
-                if( marker_info[j].id == config->marker[i].patt_id ) marker_info[j].id = -1;
-        }
         if( winfo[i].marker != -1 ) {
-            marker_info[winfo[i].marker].id  = config->marker[i].patt_id;
+            marker_info[winfo[i].marker].id  = arMultiGetNextConfigIndex(config, i) == -1 ? config->marker[i].patt_id : -1;
             marker_info[winfo[i].marker].dir = (4-winfo[i].dir)%4;
             marker_info[winfo[i].marker].cf  = 1.0;
         }
     }
 
-    free(winfo);
-
     return 0;
 }
 
@@ -50,79 +50,78 @@ AR_TEMPL_TRACKER::arMultiGetTransMatHull(ARMarkerInfo *marker_info, int marker_n
 {
 	//return arMultiGetTransMat(marker_info, marker_num, config);
 
+	PoseState& state = poseState();
 	int numInPoints=0;
-	std::vector<int> trackedMarkers;
-	int trackedCenterX=-1,trackedCenterY=-1;
+	int trackedCenterX=0,trackedCenterY=0;
 
 	//const int indices[4] = {idx0,idx1,idx2,idx3};
 	//rpp_vec ppos2d[4];
 	//rpp_vec ppos3d[4];
 
-	const int maxHullPoints = 16;
+	const int maxHullPoints = MAX_HULL_POSE_POINTS;
 	int indices[maxHullPoints];
 	rpp_vec ppos2d[maxHullPoints];
 	rpp_vec ppos3d[maxHullPoints];
 
 
+	// configs built by the application get their index now
+	if(!arMultiHasConfigIndex(config) && !arMultiCreateConfigIndex(config))
+		return -1;
+
 	// create an array of 2D points and keep references
 	// to the source points
 	//
+	state.hullTrackedMarkers.clear();
+
 	for(int i=0; i<marker_num; i++)
 	{
-		int mId = marker_info[i].id;
-		int configIdx = -1;
-
-		for(int j=0; j<config->marker_num; j++)
-			if(config->marker[j].patt_id==mId)
-			{
-				configIdx = j;
-				break;
-			}
+		int configIdx = arMultiGetConfigIndex(config, marker_info[i].id);
 
 		if(configIdx==-1)
 			continue;
 
-		trackedMarkers.push_back(i);
+		if(!state.hullTrackedMarkers.push_back(i))
+			break;
 
 		for(int c=0; c<4; c++)
 		{
 			int dir = marker_info[i].dir;
 			int cornerIdx = (c+4-dir)%4;
-			hullInPoints[numInPoints].x = (MarkerPoint::coord_type)marker_info[i].vertex[cornerIdx][0];
-			hullInPoints[numInPoints].y = (MarkerPoint::coord_type)marker_info[i].vertex[cornerIdx][1];
-			hullInPoints[numInPoints].cornerIdx = c;
-			hullInPoints[numInPoints].markerIdx = configIdx;
+			state.hullInPoints[numInPoints].x = (MarkerPoint::coord_type)marker_info[i].vertex[cornerIdx][0];
+			state.hullInPoints[numInPoints].y = (MarkerPoint::coord_type)marker_info[i].vertex[cornerIdx][1];
+			state.hullInPoints[numInPoints].cornerIdx = c;
+			state.hullInPoints[numInPoints].markerIdx = configIdx;
 			numInPoints++;
 		}
-
-		if(numInPoints>=MAX_HULL_POINTS)
-			break;
 	}
 
 
-	// next get the convex hull of all points
-	// (decrease amount by one to ignore last point, which is identical to first point)
+	// next get the convex hull of all points (O(n log n), so this
+	// also works for hundreds of visible markers)
 	//
-	int numHullPoints = nearHull_2D(hullInPoints, numInPoints, numInPoints, hullOutPoints)-1;
+	int numHullPoints = convexHull_2D(state.hullInPoints, numInPoints, state.hullOutPoints);
 	int idx0,idx1,idx2,idx3;
 
+	if(numHullPoints<4)
+		return -1;
+
 
 	if(hullTrackingMode==HULL_FOUR)
 	{
 		// find those points with furthest distance and that lie on
 		// opposite parts of the hull. this fixes the first two points of our quad.
 		//
-		findLongestDiameter(hullOutPoints, numHullPoints, idx0,idx1);
+		findLongestDiameter(state.hullOutPoints, numHullPoints, idx0,idx1);
 		assert(iabs(idx0-idx1)>0);
 
 		// find the point that is furthest away of the line
 		// of our first two points. this fixes the third point of the quad
-		findFurthestAway(hullOutPoints, numHullPoints, idx0,idx1, idx2);
+		findFurthestAway(state.hullOutPoints, numHullPoints, idx0,idx1, idx2);
 		sortIntegers(idx0,idx1, idx2);
 
 		// of all other points find the one that results in
 		// a quad with the largest area.
-		maximizeArea(hullOutPoints, numHullPoints, idx0,idx1,idx2,idx3);
+		maximizeArea(state.hullOutPoints, numHullPoints, idx0,idx1,idx2,idx3);
 
 		// now that we have all four points we must sort them...
 		//
@@ -136,11 +135,10 @@ AR_TEMPL_TRACKER::arMultiGetTransMatHull(ARMarkerInfo *marker_info, int marker_n
 	}
 	else
 	{
-		if(numHullPoints>maxHullPoints)
-			numHullPoints = maxHullPoints;
-
-		for(int i=0; i<numHullPoints; i++)
-			indices[i] = i;
+		// don't just cut off the hull (that would only keep the corners of one
+		// side of the board), but select corners that are spread over all of it
+		//
+		numHullPoints = selectSpreadPoints(state.hullOutPoints, numHullPoints, maxHullPoints, indices, state.hullWork);
 	}
 
 	assert(numHullPoints<=maxHullPoints);
@@ -155,9 +153,9 @@ AR_TEMPL_TRACKER::arMultiGetTransMatHull(ARMarkerInfo *marker_info, int marker_n
 	{
 		//int idx = indices[(i+1)%4];
 		int idx = indices[i];
-		const MarkerPoint& pt = hullOutPoints[idx];
+		const MarkerPoint& pt = state.hullOutPoints[idx];
 
-		trackedCorners.push_back(CornerPoint(pt.x,pt.y));
+		state.trackedCorners.push_back(CornerPoint(pt.x,pt.y));
 
 		trackedCenterX += pt.x;
 		trackedCenterY += pt.y;
@@ -175,8 +173,8 @@ AR_TEMPL_TRACKER::arMultiGetTransMatHull(ARMarkerInfo *marker_info, int marker_n
 		ppos3d[i][2] = 0;
 	}
 
-	trackedCenterX /= 4;
-	trackedCenterY /= 4;
+	trackedCenterX /= numHullPoints;
+	trackedCenterY /= numHullPoints;
 
 
 	// prepare structures and data we need for input and output
@@ -205,10 +203,10 @@ AR_TEMPL_TRACKER::arMultiGetTransMatHull(ARMarkerInfo *marker_info, int marker_n
 		ARFloat rot[3][3];
 
 		int minIdx=-1, minDist=0x7fffffff;
-		for(size_t i=0; i<trackedMarkers.size(); i++)
+		for(int i=0; i<state.hullTrackedMarkers.size(); i++)
 		{
-			assert(trackedMarkers[i]>=0 && trackedMarkers[i]<marker_num);
-			int idx = trackedMarkers[i];
+			assert(state.hullTrackedMarkers[i]>=0 && state.hullTrackedMarkers[i]<marker_num);
+			int idx = state.hullTrackedMarkers[i];
 			const ARMarkerInfo& mInfo = marker_info[idx];
 			int dx = trackedCenterX-(int)mInfo.pos[0], dy = trackedCenterY-(int)mInfo.pos[1];
 			int d = dx*dx + dy*dy;
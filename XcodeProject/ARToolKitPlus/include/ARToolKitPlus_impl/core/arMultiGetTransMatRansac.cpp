@@ -0,0 +1,251 @@
+/* ========================================================================
+ * PROJECT: ARToolKitPlus
+ * ========================================================================
+ * This work is based on the original ARToolKit developed by
+ *   Hirokazu Kato
+ *   Mark Billinghurst
+ *   HITLab, University of Washington, Seattle
+ * http://www.hitl.washington.edu/artoolkit/
+ *
+ * Copyright of the derived and new portions of this work
+ *     (C) 2006 Graz University of Technology
+ *
+ * This framework is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this framework; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * For further information please contact 
+ *   Dieter Schmalstieg
+ *   <schmalstieg@icg.tu-graz.ac.at>
+ *   Graz University of Technology, 
+ *   Institut for Computer Graphics and Vision,
+ *   Inffeldgasse 16a, 8010 Graz, Austria.
+ * ========================================================================
+ ** @author   Daniel Wagner
+ *
+ * $Id$
+ * @file
+ * ======================================================================== */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <ARToolKitPlus/Tracker.h>
+#include <ARToolKitPlus/matrix.h>
+
+
+namespace ARToolKitPlus {
+
+
+#define  AR_MULTI_RANSAC_MAX_HYPOTHESES     16     // max. number of single-marker hypotheses per frame
+#define  AR_MULTI_RANSAC_CONFIDENCE         0.99   // probability of having seen an all-inlier hypothesis
+#define  AR_MULTI_RANSAC_MAX_SEED_ERROR     3.0    // same as THRESH_1 in arMultiGetTransMat()
+#define  AR_MULTI_RANSAC_INLIER_RATIO       0.3    // max. rms corner distance relative to the marker size
+#define  AR_MULTI_RANSAC_MIN_INLIER_ERROR   4.0    // but never less than 2 pixels rms
+#define  AR_MULTI_RANSAC_MAX_LOOP_COUNT     2
+#define  AR_MULTI_RANSAC_MAX_FIT_ERROR      10.0
+
+
+// Reprojects the corners of all candidate markers with 'combo' (camera matrix
+// times board pose) and counts the markers whose detected corners are close enough.
+// Scoring stops as soon as nMinInliers can't be reached anymore.
+// If nMark is true config->marker[].visible is reset for all outliers.
+//
+static int
+scoreMultiMarkerHypothesis(ARMarkerInfo *marker_info, ARMultiMarkerInfoT *config, const arMultiSortedMarkerT *cand, int n,
+                           ARFloat combo[3][4], int nMinInliers, ARFloat *nScore, bool nMark)
+{
+    ARFloat  hx, hy, h, dx, dy, err, thresh;
+    int      inliers = 0;
+    int      c, s, i, k, dir;
+
+    *nScore = 0;
+
+    for( s = 0; s < n; s++ ) {
+        if( !nMark && inliers + (n - s) < nMinInliers ) break;
+
+        i = cand[s].marker;
+        k = config->marker[i].visible;
+        dir = marker_info[k].dir;
+
+        thresh = (ARFloat)(AR_MULTI_RANSAC_INLIER_RATIO*AR_MULTI_RANSAC_INLIER_RATIO) * marker_info[k].area;
+        if( thresh < AR_MULTI_RANSAC_MIN_INLIER_ERROR ) thresh = (ARFloat)AR_MULTI_RANSAC_MIN_INLIER_ERROR;
+
+        err = 0;
+        for( c = 0; c < 4; c++ ) {
+            const ARFloat *p = config->marker[i].pos3d[c];
+            hx = combo[0][0] * p[0] + combo[0][1] * p[1] + combo[0][2] * p[2] + combo[0][3];
+            hy = combo[1][0] * p[0] + combo[1][1] * p[1] + combo[1][2] * p[2] + combo[1][3];
+            h  = combo[2][0] * p[0] + combo[2][1] * p[1] + combo[2][2] * p[2] + combo[2][3];
+            if( h <= 0 ) { err = thresh * 4; break; }
+
+            dx = hx / h - marker_info[k].vertex[(4+c-dir)%4][0];
+            dy = hy / h - marker_info[k].vertex[(4+c-dir)%4][1];
+            err += dx*dx + dy*dy;
+        }
+        err *= (ARFloat)0.25;
+
+        if( err < thresh ) {
+            inliers++;
+            *nScore += err / thresh;
+        }
+        else {
+            *nScore += 1;
+            if( nMark ) config->marker[i].visible = -1;
+        }
+    }
+
+    return inliers;
+}
+
+
+AR_TEMPL_FUNC ARFloat
+AR_TEMPL_TRACKER::arMultiGetTransMatRansac(ARMarkerInfo *marker_info, int marker_num, ARMultiMarkerInfoT *config)
+{
+    arMultiSortedMarkerT  *cand;
+    ARFloat               *pos2d, *pos3d;
+    ARFloat               hyp[3][4], best[3][4], trans1[3][4], combo[3][4], rot[3][3];
+    ARFloat               err, score, bestScore = 0, w;
+    int                   n, vnum, needed, maxHyp, inliers, bestInliers = 0;
+    int                   i, j, k, s, dir, step;
+
+    if( !arMultiHasConfigIndex(config) && !arMultiCreateConfigIndex(config) ) return -1;
+
+    // find the detected marker with the highest confidence for each config entry
+    // (same rules as in arMultiGetTransMat())
+    //
+    for( i = 0; i < config->marker_num; i++ ) config->marker[i].visible = -1;
+    for( j = 0; j < marker_num; j++ ) {
+        if( marker_info[j].cf < 0.70 ) continue;
+        if( (i = arMultiGetConfigIndex(config, marker_info[j].id)) < 0 ) continue;
+
+        k = config->marker[i].visible;
+        if( k == -1 || marker_info[k].cf < marker_info[j].cf ) {
+            for( ; i != -1; i = arMultiGetNextConfigIndex(config, i) ) config->marker[i].visible = j;
+        }
+    }
+
+    // collect the candidates, biggest markers first: these give the most
+    // reliable hypotheses and are therefore tried first
+    //
+    if( config->sortedSize < config->marker_num ) {
+        free(config->sorted);
+        arMalloc(config->sorted, arMultiSortedMarkerT, config->marker_num);
+        config->sortedSize = config->marker_num;
+    }
+    cand = config->sorted;
+
+    n = 0;
+    for( i = 0; i < config->marker_num; i++ ) {
+        if( (k=config->marker[i].visible) < 0 ) continue;
+        cand[n].cx = -(ARFloat)marker_info[k].area;
+        cand[n].marker = i;
+        n++;
+    }
+    if( n == 0 ) {
+        config->prevF = 0;
+        return -1;
+    }
+    if( n > 1 ) qsort( cand, n, sizeof(arMultiSortedMarkerT), compareSortedMarkers );
+
+    // the pose of the previous frame is the first hypothesis
+    //
+    if( config->prevF ) {
+        arUtilMatMul( arCamera->mat, config->trans, combo );
+        bestInliers = scoreMultiMarkerHypothesis(marker_info, config, cand, n, combo, 1, &bestScore, false);
+        for( j = 0; j < 3; j++ ) for( k = 0; k < 4; k++ ) best[j][k] = config->trans[j][k];
+    }
+
+    // each single marker gives a full hypothesis for the board pose. stop as soon as
+    // we can be sure enough to have tried a hypothesis from an inlier marker.
+    //
+    maxHyp = n < AR_MULTI_RANSAC_MAX_HYPOTHESES ? n : AR_MULTI_RANSAC_MAX_HYPOTHESES;
+    needed = maxHyp;
+    if( bestInliers == n ) needed = 0;
+
+    for( s = 0; s < needed; s++ ) {
+        i = cand[s].marker;
+        k = config->marker[i].visible;
+
+        err = arGetTransMat(&marker_info[k], config->marker[i].center, config->marker[i].width, trans1);
+        if( err < 0 || err > AR_MULTI_RANSAC_MAX_SEED_ERROR ) continue;
+
+        arUtilMatMul( trans1, config->marker[i].itrans, hyp );
+
+        arUtilMatMul( arCamera->mat, hyp, combo );
+        inliers = scoreMultiMarkerHypothesis(marker_info, config, cand, n, combo, bestInliers, &score, false);
+        if( inliers > bestInliers || (inliers == bestInliers && inliers > 0 && score < bestScore) ) {
+            bestInliers = inliers;
+            bestScore   = score;
+            for( j = 0; j < 3; j++ ) for( k = 0; k < 4; k++ ) best[j][k] = hyp[j][k];
+
+            w = (ARFloat)bestInliers / n;
+            if( w >= 1 ) needed = s+1;
+            else {
+                j = (int)ceil( log(1.0-AR_MULTI_RANSAC_CONFIDENCE) / log(1.0-w) );
+                if( j < needed ) needed = j;
+            }
+        }
+    }
+
+    if( bestInliers == 0 ) {
+        config->prevF = 0;
+        return -1;
+    }
+
+    // refine with the corners of all inlier markers. the pose estimator can
+    // take at most P_MAX points, use every n-th marker on larger boards.
+    //
+    arUtilMatMul( arCamera->mat, best, combo );
+    scoreMultiMarkerHypothesis(marker_info, config, cand, n, combo, 0, &score, true);
+
+    pos2d = config->pos2d;
+    pos3d = config->pos3d;
+    step = (bestInliers*4 + P_MAX-1) / P_MAX;
+    if( step < 1 ) step = 1;
+
+    vnum = 0;
+    for( s = 0, j = 0; s < n; s++ ) {
+        i = cand[s].marker;
+        if( (k=config->marker[i].visible) < 0 ) continue;
+        if( (j++ % step) != 0 ) continue;
+
+        dir = marker_info[k].dir;
+        for( int c = 0; c < 4; c++ ) {
+            pos2d[vnum*8+c*2+0] = marker_info[k].vertex[(4+c-dir)%4][0];
+            pos2d[vnum*8+c*2+1] = marker_info[k].vertex[(4+c-dir)%4][1];
+            pos3d[vnum*12+c*3+0] = config->marker[i].pos3d[c][0];
+            pos3d[vnum*12+c*3+1] = config->marker[i].pos3d[c][1];
+            pos3d[vnum*12+c*3+2] = config->marker[i].pos3d[c][2];
+        }
+        vnum++;
+    }
+
+    for( j = 0; j < 3; j++ ) {
+        for( i = 0; i < 3; i++ ) {
+            rot[j][i] = best[j][i];
+        }
+    }
+    for( i = 0; i < AR_MULTI_RANSAC_MAX_LOOP_COUNT; i++ ) {
+        err = arGetTransMat4( rot, (ARFloat (*)[2])pos2d, (ARFloat (*)[3])pos3d, vnum*4, config->trans );
+        if( err < AR_MULTI_RANSAC_MAX_FIT_ERROR ) break;
+    }
+
+    config->prevF = err < AR_MULTI_RANSAC_MAX_FIT_ERROR ? 1 : 0;
+
+    return err;
+}
+
+
+}  // namespace ARToolKitPlus
@@ -89,6 +89,16 @@ AR_TEMPL_TRACKER::arMultiReadConfigFile(const char *filename)
     int                    num;
     int                    i, j;
 
+    // binary bundles are mapped instead of parsed
+    //
+    if( (fp=fopen(filename,"rb")) == NULL ) return NULL;
+    if( fread(buf, 1, sizeof(AR_MULTI_BUNDLE_MAGIC), fp) == sizeof(AR_MULTI_BUNDLE_MAGIC) &&
+        memcmp(buf, AR_MULTI_BUNDLE_MAGIC, sizeof(AR_MULTI_BUNDLE_MAGIC)) == 0 ) {
+        fclose(fp);
+        return arMultiReadConfigBundle(filename);
+    }
+    fclose(fp);
+
     setlocale(LC_NUMERIC, "C");
     
     if( (fp=fopen(filename,"r")) == NULL ) return NULL;
@@ -175,9 +185,121 @@ AR_TEMPL_TRACKER::arMultiReadConfigFile(const char *filename)
     marker_info->marker     = marker;
     marker_info->marker_num = num;
     marker_info->prevF      = 0;
+    marker_info->bundle     = NULL;
+    marker_info->bundleSize = 0;
+
+    if( !arMultiCreateConfigIndex(marker_info) ) {
+        free(marker); free(marker_info); return NULL;
+    }
 
     return marker_info;
 }
 
 
+// ids larger than this are not put into the dense lookup table
+// (arMultiGetConfigIndex() falls back to a linear search then)
+#define AR_MULTI_MAX_INDEXED_PATT_ID  65535
+
+
+AR_TEMPL_FUNC bool
+AR_TEMPL_TRACKER::arMultiCreateConfigIndex(ARMultiMarkerInfoT *config)
+{
+    int   i, id, num = config->marker_num;
+
+    config->idIndex    = NULL;
+    config->idNext     = NULL;
+    config->pos2d      = NULL;
+    config->pos3d      = NULL;
+    config->winfo      = NULL;
+    config->matchIdx   = NULL;
+    config->sorted     = NULL;
+    config->sortedSize = 0;
+    config->maxPattId  = -1;
+
+    // from now on the fields are initialized and owned by the tracker
+    // (arMultiFreeConfigIndex() only releases configs recorded here)
+    if( !arMultiHasConfigIndex(config) ) indexedConfigs.push_back(config);
+
+    for( i = 0; i < num; i++ ) {
+        if( config->marker[i].patt_id > config->maxPattId ) config->maxPattId = config->marker[i].patt_id;
+    }
+
+    // build the dense patt_id -> config index table. entries sharing an id
+    // are chained in ascending order, so idIndex always yields the first one.
+    //
+    if( config->maxPattId >= 0 && config->maxPattId <= AR_MULTI_MAX_INDEXED_PATT_ID ) {
+        config->idIndex = (int *)malloc( sizeof(int) * (config->maxPattId+1) );
+        config->idNext  = (int *)malloc( sizeof(int) * (num>0 ? num : 1) );
+        if( config->idIndex == NULL || config->idNext == NULL ) {
+            arMultiFreeConfigIndex(config);
+            return false;
+        }
+
+        for( i = 0; i <= config->maxPattId; i++ ) config->idIndex[i] = -1;
+        for( i = num-1; i >= 0; i-- ) {
+            id = config->marker[i].patt_id;
+            config->idNext[i] = id>=0 ? config->idIndex[id] : -1;
+            if( id >= 0 ) config->idIndex[id] = i;
+        }
+    }
+
+    // work buffers which were allocated for every frame before
+    //
+    config->pos2d    = (ARFloat *)malloc( sizeof(ARFloat) * (num>0 ? num : 1)*4*2 );
+    config->pos3d    = (ARFloat *)malloc( sizeof(ARFloat) * (num>0 ? num : 1)*4*3 );
+    config->winfo    = (arMultiEachMarkerInternalInfoT *)malloc( sizeof(arMultiEachMarkerInternalInfoT) * (num>0 ? num : 1) );
+    config->matchIdx = (int *)malloc( sizeof(int) * (num>0 ? num : 1) );
+
+    // large enough for verify_markers() (at most MAX_IMAGE_PATTERNS detections)
+    // and the RANSAC candidates (at most num), so it is not reallocated while tracking
+    //
+    config->sortedSize = (num > MAX_IMAGE_PATTERNS) ? num : MAX_IMAGE_PATTERNS;
+    config->sorted   = (arMultiSortedMarkerT *)malloc( sizeof(arMultiSortedMarkerT) * config->sortedSize );
+
+    // the pose estimators rely on all buffers, a partly built index must not be left behind
+    if( config->pos2d == NULL || config->pos3d == NULL || config->winfo == NULL ||
+        config->matchIdx == NULL || config->sorted == NULL ) {
+        arMultiFreeConfigIndex(config);
+        return false;
+    }
+
+    return true;
+}
+
+
+AR_TEMPL_FUNC bool
+AR_TEMPL_TRACKER::arMultiHasConfigIndex(const ARMultiMarkerInfoT *config) const
+{
+    for( size_t i = 0; i < indexedConfigs.size(); i++ ) {
+        if( indexedConfigs[i] == config ) return true;
+    }
+
+    return false;
+}
+
+
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::arMultiFreeConfigIndex(ARMultiMarkerInfoT *config)
+{
+    size_t i;
+
+    // the fields of configs that were never indexed are not initialized
+    for( i = 0; i < indexedConfigs.size(); i++ ) {
+        if( indexedConfigs[i] == config ) break;
+    }
+    if( i == indexedConfigs.size() ) return;
+    indexedConfigs.erase(indexedConfigs.begin()+i);
+
+    free(config->idIndex);   config->idIndex  = NULL;
+    free(config->idNext);    config->idNext   = NULL;
+    free(config->pos2d);     config->pos2d    = NULL;
+    free(config->pos3d);     config->pos3d    = NULL;
+    free(config->winfo);     config->winfo    = NULL;
+    free(config->matchIdx);  config->matchIdx = NULL;
+    free(config->sorted);    config->sorted   = NULL;
+    config->sortedSize = 0;
+    config->maxPattId = -1;
+}
+
+
 }  // namespace ARToolKitPlus
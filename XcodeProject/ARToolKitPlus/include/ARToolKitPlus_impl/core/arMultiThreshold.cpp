@@ -0,0 +1,210 @@
+/* ========================================================================
+ * PROJECT: ARToolKitPlus
+ * ========================================================================
+ * This work is based on the original ARToolKit developed by
+ *   Hirokazu Kato
+ *   Mark Billinghurst
+ *   HITLab, University of Washington, Seattle
+ * http://www.hitl.washington.edu/artoolkit/
+ *
+ * Copyright of the derived and new portions of this work
+ *     (C) 2006 Graz University of Technology
+ *
+ * This framework is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this framework; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * For further information please contact 
+ *   Dieter Schmalstieg
+ *   <schmalstieg@icg.tu-graz.ac.at>
+ *   Graz University of Technology, 
+ *   Institut for Computer Graphics and Vision,
+ *   Inffeldgasse 16a, 8010 Graz, Austria.
+ * ========================================================================
+ ** @author   Daniel Wagner
+ *
+ * $Id$
+ * @file
+ * ======================================================================== */
+
+
+#include <ARToolKitPlus/Tracker.h>
+
+
+namespace ARToolKitPlus {
+
+
+// binarizes the image at up to 8 thresholds in a single pass: bit k of each
+// byte of the result is set if the pixel is black at nThresholds[k]. the test
+// is exactly the one of arLabeling() (r+g+b <= 3*thresh for the color formats),
+// looked up from a table that holds the bits of all thresholds at once.
+//
+AR_TEMPL_FUNC uint8_t*
+AR_TEMPL_TRACKER::arBuildThresholdPlanes(uint8_t *image, const int *nThresholds, int nNum)
+{
+	uint8_t		bits[3*255+1];
+	int			lxsize, lysize, step;
+	int			x, y, k;
+
+	if( arImageProcMode == AR_IMAGE_PROC_IN_HALF ) {
+		lxsize = arImXsize / 2;
+		lysize = arImYsize / 2;
+		step = 2;
+	}
+	else {
+		lxsize = arImXsize;
+		lysize = arImYsize;
+		step = 1;
+	}
+
+	uint8_t *planes = (uint8_t*)frameScratch.getMemory(lxsize*lysize);
+	if(!planes)
+		return NULL;
+
+	const int threshFact = (pixelFormat!=PIXEL_FORMAT_RGB565 && pixelFormat!=PIXEL_FORMAT_LUM) ? 3 : 1;
+
+	for(int v=0; v<=255*threshFact; v++)
+	{
+		bits[v] = 0;
+		for(k=0; k<nNum; k++)
+			if(v<=nThresholds[k]*threshFact)
+				bits[v] |= (uint8_t)(1<<k);
+	}
+
+	const int offs = (pixelFormat==PIXEL_FORMAT_ABGR) ? 1 : 0;
+
+	for(y=0; y<lysize; y++)
+	{
+		const uint8_t *src = image + y*step*arImXsize*pixelSize;
+		uint8_t *dst = planes + y*lxsize;
+
+		switch(pixelFormat)
+		{
+		case PIXEL_FORMAT_LUM:
+			for(x=0; x<lxsize; x++, src+=step)
+				dst[x] = bits[*src];
+			break;
+
+		case PIXEL_FORMAT_RGB565:
+			for(x=0; x<lxsize; x++, src+=step*2)
+				dst[x] = bits[getLUM8_from_RGB565(src)];
+			break;
+
+		default:
+			for(x=0; x<lxsize; x++, src+=step*pixelSize)
+				dst[x] = bits[src[offs]+src[offs+1]+src[offs+2]];
+			break;
+		}
+	}
+
+	return planes;
+}
+
+
+// detects markers at multiThreshold.num thresholds around nThresh. the image is
+// read once (arBuildThresholdPlanes()), then each bit-plane is labeled and run
+// through arDetectMarker2() and arGetMarkerInfo(). a square that shows up at
+// several thresholds is reported once: the detection with the best confidence wins.
+//
+AR_TEMPL_FUNC ARMarkerInfo*
+AR_TEMPL_TRACKER::arDetectMarkerMultiThreshold(uint8_t *dataPtr, int nThresh, int *marker_num)
+{
+	int				thresholds[MULTI_THRESHOLD_MAX];
+	int				label_num, *area, *clip, *label_ref;
+	ARFloat			*pos;
+	int				num = multiThreshold.num, numMerged = 0, numPlanesLabeled = 0;
+	int				i, j, k;
+
+	// the current threshold first, then alternating below and above it,
+	// so that earlier planes win ties when merging
+	for(k=0; k<num; k++)
+	{
+		int offset = ((k+1)/2) * multiThreshold.spacing;
+		int t = (k&1) ? nThresh-offset : nThresh+offset;
+		thresholds[k] = t<1 ? 1 : (t>254 ? 254 : t);
+	}
+
+	MemoryManagerArena::Scope scratch(frameScratch);
+
+	uint64_t begin = arStatsClock();
+
+	PROFILE_BEGINSEC(profiler, LABELING)
+	uint8_t *planes = arBuildThresholdPlanes(dataPtr, thresholds, num);
+	PROFILE_ENDSEC(profiler, LABELING)
+
+	frameStats.frame.nanoseconds[FRAME_STAGE_LABELING] += (unsigned int)(arStatsClock()-begin);
+
+	*marker_num = 0;
+	if(!planes)
+		return NULL;
+
+	for(k=0; k<num; k++)
+	{
+		begin = arStatsClock();
+
+		PROFILE_BEGINSEC(profiler, LABELING)
+		void *limage = arLabelingMask(planes, k, &label_num, &area, &pos, &clip, &label_ref);
+		PROFILE_ENDSEC(profiler, LABELING)
+
+		frameStats.frame.nanoseconds[FRAME_STAGE_LABELING] += (unsigned int)(arStatsClock()-begin);
+
+		if(!limage)
+			continue;
+		numPlanesLabeled++;
+		frameStats.frame.numLabels += label_num;
+
+		int num2;
+		ARMarkerInfo2 *info2 = arDetectMarker2(limage, label_num, label_ref, area, pos, clip, AR_AREA_MAX, AR_AREA_MIN, 1.0, &num2);
+		if(!info2 || num2==0)
+			continue;
+
+		ARMarkerInfo *info = arGetMarkerInfo(dataPtr, info2, &num2, thresholds[k]);
+		if(!info)
+			continue;
+
+		// same duplicate test as in arDetectMarker2(): centers closer
+		// than half the side length of the larger square
+		for(i=0; i<num2; i++)
+		{
+			for(j=0; j<numMerged; j++)
+			{
+				ARFloat dx = info[i].pos[0]-marker_infoMulti[j].pos[0],
+						dy = info[i].pos[1]-marker_infoMulti[j].pos[1];
+				int maxArea = info[i].area>marker_infoMulti[j].area ? info[i].area : marker_infoMulti[j].area;
+
+				if(dx*dx+dy*dy < maxArea/4)
+					break;
+			}
+
+			if(j<numMerged)
+			{
+				if(info[i].cf>marker_infoMulti[j].cf)
+					marker_infoMulti[j] = info[i];
+			}
+			else if(numMerged<MAX_IMAGE_PATTERNS)
+				marker_infoMulti[numMerged++] = info[i];
+		}
+	}
+
+	if(numPlanesLabeled==0)
+		return NULL;
+
+	for(i=0; i<numMerged; i++)
+		marker_infoL[i] = marker_infoMulti[i];
+
+	*marker_num = numMerged;
+	return marker_infoL;
+}
+
+
+}	// namespace ARToolKitPlus
@@ -0,0 +1,718 @@
+/* ========================================================================
+ * PROJECT: ARToolKitPlus
+ * ========================================================================
+ * This work is based on the original ARToolKit developed by
+ *   Hirokazu Kato
+ *   Mark Billinghurst
+ *   HITLab, University of Washington, Seattle
+ * http://www.hitl.washington.edu/artoolkit/
+ *
+ * Copyright of the derived and new portions of this work
+ *     (C) 2006 Graz University of Technology
+ *
+ * This framework is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this framework; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * For further information please contact 
+ *   Dieter Schmalstieg
+ *   <schmalstieg@icg.tu-graz.ac.at>
+ *   Graz University of Technology, 
+ *   Institut for Computer Graphics and Vision,
+ *   Inffeldgasse 16a, 8010 Graz, Austria.
+ * ========================================================================
+ ** @author   Daniel Wagner
+ *
+ * $Id$
+ * @file
+ * ======================================================================== */
+
+
+#include <string.h>
+#include <math.h>
+#include <ARToolKitPlus/Tracker.h>
+#include <ARToolKitPlus/Camera.h>
+
+#if !defined(_MSC_VER) && !defined(_WIN32_WCE)
+#  define AR_STEREO_USE_THREADS
+#  include <pthread.h>
+#endif
+
+
+namespace ARToolKitPlus {
+
+
+// labeling of the right image, see arDetectMarkerStereo()
+//
+struct StereoLabelJob
+{
+	void*		tracker;
+	uint8_t*	image;
+	int			thresh;
+
+	void*		limage;
+	int			label_num;
+	int			*area, *clip, *label_ref;
+	ARFloat		*pos;
+};
+
+
+// projects the point X (left camera coordinates) with the camera matrix P.
+// returns false if the point is not in front of the camera.
+//
+static bool
+arStereoProject(const ARFloat P[3][4], const double X[3], double uv[2])
+{
+	double w = P[2][0]*X[0] + P[2][1]*X[1] + P[2][2]*X[2] + P[2][3];
+	if(w<=0.0)
+		return false;
+
+	uv[0] = (P[0][0]*X[0] + P[0][1]*X[1] + P[0][2]*X[2] + P[0][3]) / w;
+	uv[1] = (P[1][0]*X[0] + P[1][1]*X[1] + P[1][2]*X[2] + P[1][3]) / w;
+	return true;
+}
+
+
+// linear triangulation: the point whose projections with PL and PR come closest to pL and pR
+// (two equations per image, solved in the least squares sense)
+//
+static bool
+arStereoTriangulate(const ARFloat PL[3][4], const ARFloat PR[3][4], const ARFloat pL[2], const ARFloat pR[2], double X[3])
+{
+	double A[4][4], N[3][3], b[3];
+	int i, j, r;
+
+	for(j=0; j<4; j++)
+	{
+		A[0][j] = pL[0]*PL[2][j] - PL[0][j];
+		A[1][j] = pL[1]*PL[2][j] - PL[1][j];
+		A[2][j] = pR[0]*PR[2][j] - PR[0][j];
+		A[3][j] = pR[1]*PR[2][j] - PR[1][j];
+	}
+
+	for(i=0; i<3; i++)
+	{
+		b[i] = 0.0;
+		for(r=0; r<4; r++)
+			b[i] -= A[r][i]*A[r][3];
+		for(j=0; j<3; j++)
+		{
+			N[i][j] = 0.0;
+			for(r=0; r<4; r++)
+				N[i][j] += A[r][i]*A[r][j];
+		}
+	}
+
+	double c0 = N[1][1]*N[2][2] - N[1][2]*N[2][1];
+	double c1 = N[1][2]*N[2][0] - N[1][0]*N[2][2];
+	double c2 = N[1][0]*N[2][1] - N[1][1]*N[2][0];
+	double det = N[0][0]*c0 + N[0][1]*c1 + N[0][2]*c2;
+
+	// parallel rays
+	if(fabs(det) <= 1e-12*fabs(N[0][0]*N[1][1]*N[2][2]))
+		return false;
+
+	X[0] = (b[0]*c0 + N[0][1]*(N[1][2]*b[2] - b[1]*N[2][2]) + N[0][2]*(b[1]*N[2][1] - N[1][1]*b[2])) / det;
+	X[1] = (N[0][0]*(b[1]*N[2][2] - N[1][2]*b[2]) + b[0]*c1 + N[0][2]*(N[1][0]*b[2] - b[1]*N[2][0])) / det;
+	X[2] = (N[0][0]*(N[1][1]*b[2] - b[1]*N[2][1]) + N[0][1]*(b[1]*N[2][0] - N[1][0]*b[2]) + b[0]*c2) / det;
+	return true;
+}
+
+
+// eigenvalues d and eigenvectors (columns of v) of the symmetric matrix a (cyclic Jacobi, a is destroyed)
+//
+static void
+arStereoEigen4(double a[4][4], double v[4][4], double d[4])
+{
+	int p, q, k;
+
+	for(p=0; p<4; p++)
+		for(q=0; q<4; q++)
+			v[p][q] = p==q ? 1.0 : 0.0;
+
+	for(int sweep=0; sweep<50; sweep++)
+	{
+		double off = 0.0, diag = 0.0;
+		for(p=0; p<4; p++)
+		{
+			diag += a[p][p]*a[p][p];
+			for(q=p+1; q<4; q++)
+				off += a[p][q]*a[p][q];
+		}
+		if(off <= 1e-24*diag)
+			break;
+
+		for(p=0; p<3; p++)
+			for(q=p+1; q<4; q++)
+			{
+				if(a[p][q]==0.0)
+					continue;
+
+				double theta = (a[q][q]-a[p][p]) / (2.0*a[p][q]);
+				double t = (theta>=0.0 ? 1.0 : -1.0) / (fabs(theta) + sqrt(theta*theta+1.0));
+				double c = 1.0/sqrt(t*t+1.0), s = t*c;
+
+				for(k=0; k<4; k++)
+				{
+					double akp = a[k][p], akq = a[k][q];
+					a[k][p] = c*akp - s*akq;
+					a[k][q] = s*akp + c*akq;
+				}
+				for(k=0; k<4; k++)
+				{
+					double apk = a[p][k], aqk = a[q][k];
+					a[p][k] = c*apk - s*aqk;
+					a[q][k] = s*apk + c*aqk;
+				}
+				for(k=0; k<4; k++)
+				{
+					double vkp = v[k][p], vkq = v[k][q];
+					v[k][p] = c*vkp - s*vkq;
+					v[k][q] = s*vkp + c*vkq;
+				}
+			}
+	}
+
+	for(p=0; p<4; p++)
+		d[p] = a[p][p];
+}
+
+
+// rigid transformation (rot, trans) that moves the model points closest to the measured points
+// (Horn's closed form solution with unit quaternions)
+//
+static void
+arStereoAbsoluteOrientation(const ARFloat model[][3], const ARFloat meas[][3], int num, double rot[3][3], double trans[3])
+{
+	double cm[3] = {0,0,0}, cp[3] = {0,0,0}, S[3][3], N[4][4], V[4][4], d[4];
+	int i, j, k;
+
+	for(i=0; i<num; i++)
+		for(j=0; j<3; j++)
+		{
+			cm[j] += model[i][j];
+			cp[j] += meas[i][j];
+		}
+	for(j=0; j<3; j++)
+	{
+		cm[j] /= num;
+		cp[j] /= num;
+	}
+
+	for(j=0; j<3; j++)
+		for(k=0; k<3; k++)
+		{
+			S[j][k] = 0.0;
+			for(i=0; i<num; i++)
+				S[j][k] += (model[i][j]-cm[j]) * (meas[i][k]-cp[k]);
+		}
+
+	N[0][0] = S[0][0]+S[1][1]+S[2][2];
+	N[1][1] = S[0][0]-S[1][1]-S[2][2];
+	N[2][2] = -S[0][0]+S[1][1]-S[2][2];
+	N[3][3] = -S[0][0]-S[1][1]+S[2][2];
+	N[0][1] = N[1][0] = S[1][2]-S[2][1];
+	N[0][2] = N[2][0] = S[2][0]-S[0][2];
+	N[0][3] = N[3][0] = S[0][1]-S[1][0];
+	N[1][2] = N[2][1] = S[0][1]+S[1][0];
+	N[1][3] = N[3][1] = S[2][0]+S[0][2];
+	N[2][3] = N[3][2] = S[1][2]+S[2][1];
+
+	arStereoEigen4(N, V, d);
+
+	int best = 0;
+	for(i=1; i<4; i++)
+		if(d[i]>d[best])
+			best = i;
+
+	double q0 = V[0][best], qx = V[1][best], qy = V[2][best], qz = V[3][best];
+
+	rot[0][0] = q0*q0+qx*qx-qy*qy-qz*qz;
+	rot[0][1] = 2.0*(qx*qy-q0*qz);
+	rot[0][2] = 2.0*(qx*qz+q0*qy);
+	rot[1][0] = 2.0*(qy*qx+q0*qz);
+	rot[1][1] = q0*q0-qx*qx+qy*qy-qz*qz;
+	rot[1][2] = 2.0*(qy*qz-q0*qx);
+	rot[2][0] = 2.0*(qz*qx-q0*qy);
+	rot[2][1] = 2.0*(qz*qy+q0*qx);
+	rot[2][2] = q0*q0-qx*qx-qy*qy+qz*qz;
+
+	for(j=0; j<3; j++)
+		trans[j] = cp[j] - (rot[j][0]*cm[0] + rot[j][1]*cm[1] + rot[j][2]*cm[2]);
+}
+
+
+// solves the 6x6 system H x = g (Gaussian elimination with partial pivoting), false if singular
+//
+static bool
+arStereoSolve6(double H[6][6], double g[6], double x[6])
+{
+	int i, j, k;
+
+	for(i=0; i<6; i++)
+	{
+		int piv = i;
+		for(k=i+1; k<6; k++)
+			if(fabs(H[k][i])>fabs(H[piv][i]))
+				piv = k;
+		if(fabs(H[piv][i])<1e-12)
+			return false;
+
+		if(piv!=i)
+		{
+			for(j=0; j<6; j++)
+			{
+				double tmp = H[i][j];  H[i][j] = H[piv][j];  H[piv][j] = tmp;
+			}
+			double tmp = g[i];  g[i] = g[piv];  g[piv] = tmp;
+		}
+
+		for(k=i+1; k<6; k++)
+		{
+			double f = H[k][i]/H[i][i];
+			for(j=i; j<6; j++)
+				H[k][j] -= f*H[i][j];
+			g[k] -= f*g[i];
+		}
+	}
+
+	for(i=5; i>=0; i--)
+	{
+		x[i] = g[i];
+		for(j=i+1; j<6; j++)
+			x[i] -= H[i][j]*x[j];
+		x[i] /= H[i][i];
+	}
+	return true;
+}
+
+
+// mean squared reprojection error (pixels) of the model points in both images,
+// optionally accumulates the Gauss-Newton normal equations for a pose update
+//
+static double
+arStereoReprojection(const ARFloat PL[3][4], const ARFloat PR[3][4], const ARFloat model[][3],
+					 const ARFloat pos2dL[][2], const ARFloat pos2dR[][2], int num,
+					 const double rot[3][3], const double trans[3], double H[6][6], double g[6])
+{
+	double err = 0.0;
+	int i, j, k, view;
+
+	if(H)
+	{
+		memset(H, 0, sizeof(double)*36);
+		memset(g, 0, sizeof(double)*6);
+	}
+
+	for(i=0; i<num; i++)
+	{
+		double v[3], X[3];
+		for(j=0; j<3; j++)
+		{
+			v[j] = rot[j][0]*model[i][0] + rot[j][1]*model[i][1] + rot[j][2]*model[i][2];
+			X[j] = v[j] + trans[j];
+		}
+
+		for(view=0; view<2; view++)
+		{
+			const ARFloat (*P)[4] = view==0 ? PL : PR;
+			const ARFloat *meas = view==0 ? pos2dL[i] : pos2dR[i];
+			double uv[2];
+
+			if(!arStereoProject(P, X, uv))
+				return -1.0;
+
+			double r[2] = { meas[0]-uv[0], meas[1]-uv[1] };
+			err += r[0]*r[0] + r[1]*r[1];
+
+			if(!H)
+				continue;
+
+			// d(uv)/dX, with X = exp(w) rot model + trans: dX/dw = -[v]x, dX/dtrans = I
+			double w = P[2][0]*X[0] + P[2][1]*X[1] + P[2][2]*X[2] + P[2][3];
+			for(k=0; k<2; k++)
+			{
+				double du[3], J[6];
+				for(j=0; j<3; j++)
+					du[j] = (P[k][j] - uv[k]*P[2][j]) / w;
+
+				J[0] = du[2]*v[1] - du[1]*v[2];
+				J[1] = du[0]*v[2] - du[2]*v[0];
+				J[2] = du[1]*v[0] - du[0]*v[1];
+				J[3] = du[0];
+				J[4] = du[1];
+				J[5] = du[2];
+
+				for(j=0; j<6; j++)
+				{
+					g[j] += J[j]*r[k];
+					for(int l=0; l<6; l++)
+						H[j][l] += J[j]*J[l];
+				}
+			}
+		}
+	}
+
+	return err/(2*num);
+}
+
+
+AR_TEMPL_FUNC void*
+AR_TEMPL_TRACKER::arStereoLabelThread(void *nJob)
+{
+	StereoLabelJob* job = (StereoLabelJob*)nJob;
+	AR_TEMPL_TRACKER* tracker = (AR_TEMPL_TRACKER*)job->tracker;
+
+	job->limage = tracker->arLabeling(job->image, job->thresh, &job->label_num, &job->area, &job->pos, &job->clip, &job->label_ref, 0);
+	return NULL;
+}
+
+
+// labeling is the only stage that does not keep its results in shared members (it writes
+// either the left or the right buffers), so only the labeling of both images runs concurrently.
+// contour extraction and marker decoding follow for one image after the other.
+//
+AR_TEMPL_FUNC int
+AR_TEMPL_TRACKER::arDetectMarkerStereo(uint8_t *dataL, uint8_t *dataR, int _thresh,
+									   ARMarkerInfo **marker_infoL, int *marker_numL, ARMarkerInfo **marker_infoR, int *marker_numR)
+{
+	void            *limage;
+	int             label_num;
+	int             *area, *clip, *label_ref;
+	ARFloat         *pos;
+	StereoLabelJob  job;
+	bool            threaded = false;
+	int             i;
+
+	*marker_numL = *marker_numR = 0;
+	*marker_infoL = stereo.markerL;
+	*marker_infoR = stereo.markerR;
+
+	if(!stereo.camera)
+		return -1;
+
+	checkImageBuffer();
+	frameScratch.reset();
+	memset(earlyReject.numRejected, 0, sizeof(earlyReject.numRejected));
+	arStatsBeginDetect(_thresh);
+
+	// stereo pairs are always processed completely. the motion gate and corner tracking
+	// start over with the next mono frame, as its predecessor was not seen by them.
+	labelRegion.active = false;
+	motionGate.valid = false;
+	motionGate.markersUnchanged = false;
+	cornerTracking.valid = false;
+	cornerTracking.tracked = false;
+	decodeCache.numHistory = 0;
+	pose.trackedCorners.clear();
+	autoThreshold.reset();
+
+	job.tracker = this;
+	job.image = dataR;
+	job.thresh = _thresh;
+	job.limage = NULL;
+
+	// adaptive thresholding builds its mask in frameScratch, which can not be shared:
+	// both images are labeled by this thread then
+	//
+#ifdef AR_STEREO_USE_THREADS
+	pthread_t thread;
+	if(!adaptiveThreshold.enabled)
+		threaded = pthread_create(&thread, NULL, arStereoLabelThread, &job)==0;
+#endif //AR_STEREO_USE_THREADS
+
+	limage = arLabeling(dataL, _thresh, &label_num, &area, &pos, &clip, &label_ref, 1);
+
+#ifdef AR_STEREO_USE_THREADS
+	if(threaded)
+		pthread_join(thread, NULL);
+#endif //AR_STEREO_USE_THREADS
+
+	if(!threaded)
+		arStereoLabelThread(&job);
+
+	const bool labeledL = limage!=NULL;
+
+	for(int LorR=1; LorR>=0; LorR--)
+	{
+		ARMarkerInfo *markers = LorR ? stereo.markerL : stereo.markerR;
+		int *num = LorR ? marker_numL : marker_numR;
+
+		if(!LorR)
+		{
+			limage = job.limage;
+			label_num = job.label_num;
+			area = job.area;
+			pos = job.pos;
+			clip = job.clip;
+			label_ref = job.label_ref;
+		}
+
+		if(!limage)
+			continue;
+
+		marker_info2 = arDetectMarker2(limage, label_num, label_ref, area, pos, clip, AR_AREA_MAX, AR_AREA_MIN, 1.0, &wmarker_num);
+		if(!marker_info2)
+			continue;
+
+		// the right image's lines are undistorted with the right camera. the undistortion
+		// tables of UNDIST_LUT and UNDIST_GRID belong to the left camera, so its model is used directly.
+		//
+		Camera *leftCamera = arCamera;
+		ARPARAM_UNDIST_FUNC leftUndist = arParamObserv2Ideal_func;
+
+		if(!LorR)
+		{
+			arCamera = stereo.camera;
+			if(undistMode!=UNDIST_NONE)
+				arParamObserv2Ideal_func = &AR_TEMPL_TRACKER::arParamObserv2Ideal_std;
+		}
+
+		wmarker_info = arGetMarkerInfo(LorR ? dataL : dataR, marker_info2, &wmarker_num, _thresh);
+
+		arCamera = leftCamera;
+		arParamObserv2Ideal_func = leftUndist;
+
+		if(!wmarker_info)
+			continue;
+
+		for(i=0; i<wmarker_num; i++)
+		{
+			markers[i] = wmarker_info[i];
+			if(markers[i].cf < 0.5)
+			{
+				markers[i].id = -1;
+				frameStats.frame.numRejected[CANDIDATE_REJECT_CF]++;
+			}
+		}
+		*num = wmarker_num;
+	}
+
+	if(autoThreshold.enable)
+		thresh = autoThreshold.calc();
+
+	arStatsEndDetect(stereo.markerL, labeledL ? *marker_numL : -1);
+
+	return labeledL ? 0 : -1;
+}
+
+
+AR_TEMPL_FUNC ARFloat
+AR_TEMPL_TRACKER::arGetTransMatStereo(ARMarkerInfo *marker_infoL, ARMarkerInfo *marker_infoR, ARFloat center[2], ARFloat width, ARFloat conv[3][4])
+{
+	static const ARFloat corner[4][2] = { {-0.5f,0.5f}, {0.5f,0.5f}, {0.5f,-0.5f}, {-0.5f,-0.5f} };
+	PoseState& state = poseState();
+
+	for(int j=0; j<4; j++)
+	{
+		const int vL = (4-marker_infoL->dir+j)%4, vR = (4-marker_infoR->dir+j)%4;
+
+		state.stereo.pos2dL[j][0] = marker_infoL->vertex[vL][0];
+		state.stereo.pos2dL[j][1] = marker_infoL->vertex[vL][1];
+		state.stereo.pos2dR[j][0] = marker_infoR->vertex[vR][0];
+		state.stereo.pos2dR[j][1] = marker_infoR->vertex[vR][1];
+		state.stereo.pos3d[j][0] = center[0] + width*corner[j][0];
+		state.stereo.pos3d[j][1] = center[1] + width*corner[j][1];
+		state.stereo.pos3d[j][2] = 0.0f;
+	}
+
+	return arStereoFitPose(4, conv);
+}
+
+
+AR_TEMPL_FUNC ARFloat
+AR_TEMPL_TRACKER::arMultiGetTransMatStereo(ARMarkerInfo *marker_infoL, int marker_numL, ARMarkerInfo *marker_infoR, int marker_numR,
+										   ARMultiMarkerInfoT *config)
+{
+	PoseState& state = poseState();
+	int i, j, k, num = 0;
+
+	if( !arMultiHasConfigIndex(config) && !arMultiCreateConfigIndex(config) )
+		return -1;
+
+	// the detected marker with the highest confidence for each config entry,
+	// in the left (visible) and in the right image (visibleR)
+	//
+	for( i = 0; i < config->marker_num; i++ ) config->marker[i].visible = config->marker[i].visibleR = -1;
+
+	for( j = 0; j < marker_numL; j++ ) {
+		if( marker_infoL[j].cf < 0.70 ) continue;
+		if( (i = arMultiGetConfigIndex(config, marker_infoL[j].id)) < 0 ) continue;
+
+		k = config->marker[i].visible;
+		if( k == -1 || marker_infoL[k].cf < marker_infoL[j].cf ) {
+			for( ; i != -1; i = arMultiGetNextConfigIndex(config, i) ) config->marker[i].visible = j;
+		}
+	}
+	for( j = 0; j < marker_numR; j++ ) {
+		if( marker_infoR[j].cf < 0.70 ) continue;
+		if( (i = arMultiGetConfigIndex(config, marker_infoR[j].id)) < 0 ) continue;
+
+		k = config->marker[i].visibleR;
+		if( k == -1 || marker_infoR[k].cf < marker_infoR[j].cf ) {
+			for( ; i != -1; i = arMultiGetNextConfigIndex(config, i) ) config->marker[i].visibleR = j;
+		}
+	}
+
+	for( i = 0; i < config->marker_num && num+4 <= MAX_IMAGE_PATTERNS*4; i++ ) {
+		if( config->marker[i].visible < 0 || config->marker[i].visibleR < 0 ) continue;
+
+		ARMarkerInfo *mL = &marker_infoL[config->marker[i].visible];
+		ARMarkerInfo *mR = &marker_infoR[config->marker[i].visibleR];
+
+		for( j = 0; j < 4; j++, num++ ) {
+			const int vL = (4-mL->dir+j)%4, vR = (4-mR->dir+j)%4;
+
+			state.stereo.pos2dL[num][0] = mL->vertex[vL][0];
+			state.stereo.pos2dL[num][1] = mL->vertex[vL][1];
+			state.stereo.pos2dR[num][0] = mR->vertex[vR][0];
+			state.stereo.pos2dR[num][1] = mR->vertex[vR][1];
+			state.stereo.pos3d[num][0] = config->marker[i].pos3d[j][0];
+			state.stereo.pos3d[num][1] = config->marker[i].pos3d[j][1];
+			state.stereo.pos3d[num][2] = config->marker[i].pos3d[j][2];
+		}
+	}
+
+	ARFloat err = num>0 ? arStereoFitPose(num, config->trans) : -1;
+	if( err < 0 ) {
+		config->prevF = 0;
+		return -1;
+	}
+	config->prevF = 1;
+
+	// the pose relative to the right camera
+	for( j = 0; j < 3; j++ ) {
+		for( k = 0; k < 4; k++ ) {
+			config->transR[j][k] = stereo.rightFromLeft[j][0] * config->trans[0][k]
+								 + stereo.rightFromLeft[j][1] * config->trans[1][k]
+								 + stereo.rightFromLeft[j][2] * config->trans[2][k];
+		}
+		config->transR[j][3] += stereo.rightFromLeft[j][3];
+	}
+
+	return err;
+}
+
+
+// the corners are triangulated first: corners whose triangulated point does not project back
+// onto both of its image points (wrong match, bad corner) are left out. the model is aligned
+// to the triangulated points, and that pose is refined on the reprojection error in both images.
+//
+AR_TEMPL_FUNC ARFloat
+AR_TEMPL_TRACKER::arStereoFitPose(int num, ARFloat conv[3][4])
+{
+	PoseState& state = poseState();
+	ARFloat (*PL)[4] = arCamera->mat;
+	ARFloat PR[3][4];
+	double  X[3], uvL[2], uvR[2], rot[3][3], trans[3];
+	double  H[6][6], g[6], delta[6];
+	int     i, j, k, numValid = 0;
+
+	// the right camera matrix in left camera coordinates
+	for(j=0; j<3; j++)
+		for(k=0; k<4; k++)
+			PR[j][k] = stereo.camera->mat[j][0]*stereo.rightFromLeft[0][k]
+					 + stereo.camera->mat[j][1]*stereo.rightFromLeft[1][k]
+					 + stereo.camera->mat[j][2]*stereo.rightFromLeft[2][k]
+					 + (k==3 ? stereo.camera->mat[j][3] : 0.0f);
+
+	for(i=0; i<num; i++)
+	{
+		if(!arStereoTriangulate(PL, PR, state.stereo.pos2dL[i], state.stereo.pos2dR[i], X))
+			continue;
+		if(!arStereoProject(PL, X, uvL) || !arStereoProject(PR, X, uvR))
+			continue;
+		if((uvL[0]-state.stereo.pos2dL[i][0])*(uvL[0]-state.stereo.pos2dL[i][0]) + (uvL[1]-state.stereo.pos2dL[i][1])*(uvL[1]-state.stereo.pos2dL[i][1]) > Stereo::MAX_CORNER_ERROR ||
+		   (uvR[0]-state.stereo.pos2dR[i][0])*(uvR[0]-state.stereo.pos2dR[i][0]) + (uvR[1]-state.stereo.pos2dR[i][1])*(uvR[1]-state.stereo.pos2dR[i][1]) > Stereo::MAX_CORNER_ERROR)
+			continue;
+
+		if(numValid!=i)
+		{
+			memcpy(state.stereo.pos2dL[numValid], state.stereo.pos2dL[i], sizeof(state.stereo.pos2dL[i]));
+			memcpy(state.stereo.pos2dR[numValid], state.stereo.pos2dR[i], sizeof(state.stereo.pos2dR[i]));
+			memcpy(state.stereo.pos3d[numValid], state.stereo.pos3d[i], sizeof(state.stereo.pos3d[i]));
+		}
+		for(j=0; j<3; j++)
+			state.stereo.posCam[numValid][j] = (ARFloat)X[j];
+		numValid++;
+	}
+
+	if(numValid<Stereo::MIN_CORNERS)
+		return -1;
+
+	arStereoAbsoluteOrientation(state.stereo.pos3d, state.stereo.posCam, numValid, rot, trans);
+
+	double err = arStereoReprojection(PL, PR, state.stereo.pos3d, state.stereo.pos2dL, state.stereo.pos2dR, numValid, rot, trans, H, g);
+
+	for(int iter=0; iter<Stereo::MAX_ITERATIONS && err>=0.0; iter++)
+	{
+		state.stats->poseIterations++;
+
+		if(!arStereoSolve6(H, g, delta))
+			break;
+
+		// rot = exp(delta[0..2]) rot
+		double angle = sqrt(delta[0]*delta[0] + delta[1]*delta[1] + delta[2]*delta[2]);
+		double newRot[3][3], newTrans[3], dR[3][3];
+
+		if(angle>1e-12)
+		{
+			double ax = delta[0]/angle, ay = delta[1]/angle, az = delta[2]/angle;
+			double s = sin(angle), c = 1.0-cos(angle);
+
+			dR[0][0] = 1.0 - c*(ay*ay+az*az);  dR[0][1] = -s*az + c*ax*ay;       dR[0][2] = s*ay + c*ax*az;
+			dR[1][0] = s*az + c*ax*ay;         dR[1][1] = 1.0 - c*(ax*ax+az*az);  dR[1][2] = -s*ax + c*ay*az;
+			dR[2][0] = -s*ay + c*ax*az;        dR[2][1] = s*ax + c*ay*az;         dR[2][2] = 1.0 - c*(ax*ax+ay*ay);
+		}
+		else
+			for(j=0; j<3; j++)
+				for(k=0; k<3; k++)
+					dR[j][k] = j==k ? 1.0 : 0.0;
+
+		for(j=0; j<3; j++)
+		{
+			for(k=0; k<3; k++)
+				newRot[j][k] = dR[j][0]*rot[0][k] + dR[j][1]*rot[1][k] + dR[j][2]*rot[2][k];
+			newTrans[j] = trans[j] + delta[3+j];
+		}
+
+		double newErr = arStereoReprojection(PL, PR, state.stereo.pos3d, state.stereo.pos2dL, state.stereo.pos2dR, numValid, newRot, newTrans, H, g);
+		if(newErr<0.0 || newErr>=err)
+			break;
+
+		memcpy(rot, newRot, sizeof(rot));
+		memcpy(trans, newTrans, sizeof(trans));
+		bool converged = err-newErr < 1e-6*err;
+		err = newErr;
+		if(converged)
+			break;
+	}
+
+	if(err<0.0)
+		return -1;
+
+	state.stats->numPoses++;
+	state.stats->poseError = (float)err;
+
+	for(j=0; j<3; j++)
+	{
+		for(k=0; k<3; k++)
+			conv[j][k] = (ARFloat)rot[j][k];
+		conv[j][3] = (ARFloat)trans[j];
+	}
+
+	return (ARFloat)err;
+}
+
+
+}	// namespace ARToolKitPlus
@@ -64,17 +64,16 @@ AR_TEMPL_FUNC int
 AR_TEMPL_TRACKER::arInitCparam(Camera *pCam)
 {
 	// if the camera parameters change, the undistortion LUT has to be rebuilt.
-	// (this is done automatically in arParamObserv2Ideal_LUT or arParamIdeal2Observ_LUT)
+	// (this is done lazily in arParamObserv2Ideal_LUT or arParamObserv2Ideal_grid,
+	// a cache file is only reused if it was made for this camera)
 	//
-	if(undistO2ITable && (arImXsize!=pCam->xsize || arImYsize!=pCam->ysize))
-	{
-		artkp_Free(undistO2ITable);
-		undistO2ITable = NULL;
-	}
+	freeUndistTables();
 
 	arImXsize = pCam->xsize;
 	arImYsize = pCam->ysize;
 
+	initUndistTables();
+
     return(0);
 }
 
@@ -97,36 +96,52 @@ AR_TEMPL_TRACKER::arGetLine2(int x_coord[], int y_coord[], int coord_num,
     int      st, ed, n;
     int      i, j;
 
-    ev     = Vector::alloc( 2 );
-    mean   = Vector::alloc( 2 );
-    evec   = Matrix::alloc( 2, 2 );
+    MemoryManagerArena::Scope scratch( frameScratch );
+
+    ev     = Vector::alloc( &frameScratch, 2 );
+    mean   = Vector::alloc( &frameScratch, 2 );
+    evec   = Matrix::alloc( &frameScratch, 2, 2 );
     for( i = 0; i < 4; i++ ) {
         w1 = (ARFloat)(vertex[i+1]-vertex[i]+1) * (ARFloat)0.05 + (ARFloat)0.5;
         st = (int)(vertex[i]   + w1);
         ed = (int)(vertex[i+1] - w1);
         n = ed - st + 1;
-        input  = Matrix::alloc( n, 2 );
-        for( j = 0; j < n; j++ ) {
-			ARFloat x,y;
-			(this->*arParamObserv2Ideal_func)( pCam, (ARFloat)x_coord[st+j], (ARFloat)y_coord[st+j], &x,&y);
-			input->m[j*2+0] = x;
-			input->m[j*2+1] = y;
-        }
-        if( arMatrixPCA(input, evec, ev, mean) < 0 ) {
-            Matrix::free( input );
-            Matrix::free( evec );
-            Vector::free( mean );
-            Vector::free( ev );
+        input  = Matrix::alloc( &frameScratch, n, 2 );
+		if( arParamObserv2Ideal_func == &AR_TEMPL_TRACKER::arParamObserv2Ideal_std ) {
+			// undistort the whole edge with one (vectorized) call instead of one virtual call per pixel
+			for( j = 0; j < n; j++ ) {
+				arGetLine_x[j] = (ARFloat)x_coord[st+j];
+				arGetLine_y[j] = (ARFloat)y_coord[st+j];
+			}
+			pCam->observ2IdealBatch( arGetLine_x, arGetLine_y, arGetLine_x, arGetLine_y, n );
+			for( j = 0; j < n; j++ ) {
+				input->m[j*2+0] = arGetLine_x[j];
+				input->m[j*2+1] = arGetLine_y[j];
+			}
+		}
+		else {
+			for( j = 0; j < n; j++ ) {
+				ARFloat x,y;
+				(this->*arParamObserv2Ideal_func)( pCam, (ARFloat)x_coord[st+j], (ARFloat)y_coord[st+j], &x,&y);
+				input->m[j*2+0] = x;
+				input->m[j*2+1] = y;
+			}
+		}
+        if( arMatrixPCA(input, evec, ev, mean, &frameScratch) < 0 ) {
+            Matrix::free( &frameScratch, input );
+            Matrix::free( &frameScratch, evec );
+            Vector::free( &frameScratch, mean );
+            Vector::free( &frameScratch, ev );
             return(-1);
         }
         line[i][0] =  evec->m[1];
         line[i][1] = -evec->m[0];
         line[i][2] = -(line[i][0]*mean->v[0] + line[i][1]*mean->v[1]);
-        Matrix::free( input );
+        Matrix::free( &frameScratch, input );
     }
-    Matrix::free( evec );
-    Vector::free( mean );
-    Vector::free( ev );
+    Matrix::free( &frameScratch, evec );
+    Vector::free( &frameScratch, mean );
+    Vector::free( &frameScratch, ev );
 
     for( i = 0; i < 4; i++ ) {
         w1 = line[(i+3)%4][0] * line[i][1] - line[i][0] * line[(i+3)%4][1];
@@ -160,10 +175,10 @@ AR_TEMPL_TRACKER::arUtilMatMul( ARFloat s1[3][4], ARFloat s2[3][4], ARFloat d[3]
 AR_TEMPL_FUNC int
 AR_TEMPL_TRACKER::arUtilMatInv(ARFloat s[3][4], ARFloat d[3][4])
 {
-    ARMat       *mat;
+    ARFloat     matm[4*4];
+    ARMat       mats = { matm, 4, 4 }, *mat = &mats;
     int         i, j;
 
-    mat = Matrix::alloc( 4, 4 );
     for( j = 0; j < 3; j++ ) {
         for( i = 0; i < 4; i++ ) {
             mat->m[j*4+i] = s[j][i];
@@ -177,7 +192,6 @@ AR_TEMPL_TRACKER::arUtilMatInv(ARFloat s[3][4], ARFloat d[3][4])
             d[j][i] = mat->m[j*4+i];
         }
     }
-    Matrix::free( mat );
 
     return 0;
 }
@@ -54,11 +54,11 @@ namespace ARToolKitPlus {
 
 static int EX( ARMat *input, ARVec *mean );
 static int CENTER( ARMat *inout, ARVec *mean );
-static int PCA( ARMat *input, ARMat *output, ARVec *ev );
+static int PCA( ARMat *input, ARMat *output, ARVec *ev, MemoryManagerArena *arena );
 static int x_by_xt( ARMat *input, ARMat *output );
 static int xt_by_x( ARMat *input, ARMat *output );
 static int EV_create( ARMat *input, ARMat *u, ARMat *output, ARVec *ev );
-static int QRM( ARMat *u, ARVec *ev );
+static int QRM( ARMat *u, ARVec *ev, MemoryManagerArena *arena );
 
 
 /* === matrix definition ===
@@ -91,7 +91,7 @@ Mean:
 
 
 AR_TEMPL_FUNC int
-AR_TEMPL_TRACKER::arMatrixPCA(ARMat *input, ARMat *evec, ARVec *ev, ARVec *mean)
+AR_TEMPL_TRACKER::arMatrixPCA(ARMat *input, ARMat *evec, ARVec *ev, ARVec *mean, MemoryManagerArena *arena)
 {
     ARMat     *work;
     ARFloat  srow, sum;
@@ -107,22 +107,22 @@ AR_TEMPL_TRACKER::arMatrixPCA(ARMat *input, ARMat *evec, ARVec *ev, ARVec *mean)
     if( ev->clm   != check )      return(-1);
     if( mean->clm != input->clm ) return(-1);
 
-    work = Matrix::allocDup( input );
+    work = Matrix::allocDup( arena, input );
     if( work == NULL ) return -1;
 
     srow = (ARFloat)sqrt((ARFloat)row);
     if( EX( work, mean ) < 0 ) {
-        Matrix::free( work );
+        Matrix::free( arena, work );
         return(-1);
     }
     if( CENTER( work, mean ) < 0 ) {
-        Matrix::free( work );
+        Matrix::free( arena, work );
         return(-1);
     }
     for(i=0; i<row*clm; i++) work->m[i] /= srow;
 
-    rval = PCA( work, evec, ev );
-    Matrix::free( work );
+    rval = PCA( work, evec, ev, arena );
+    Matrix::free( arena, work );
 
     sum = 0.0;
     for( i = 0; i < ev->clm; i++ ) sum += ev->v[i];
@@ -156,7 +156,7 @@ AR_TEMPL_TRACKER::arMatrixPCA2( ARMat *input, ARMat *evec, ARVec *ev )
     for(i=0; i<row*clm; i++) work->m[i] /= srow;
 */
 
-    rval = PCA( work, evec, ev );
+    rval = PCA( work, evec, ev, NULL );
     Matrix::free( work );
 
     sum = 0.0;
@@ -167,7 +167,7 @@ AR_TEMPL_TRACKER::arMatrixPCA2( ARMat *input, ARMat *evec, ARVec *ev )
 }
 
 static int
-PCA( ARMat *input, ARMat *output, ARVec *ev )
+PCA( ARMat *input, ARMat *output, ARVec *ev, MemoryManagerArena *arena )
 {
     ARMat     *u;
     ARFloat  *m1, *m2;
@@ -182,20 +182,20 @@ PCA( ARMat *input, ARMat *output, ARVec *ev )
     if( output->row != min )        return(-1);
     if( ev->clm != min )            return(-1);
 
-    u = Matrix::alloc( min, min );
+    u = Matrix::alloc( arena, min, min );
     if( u->row != min || u->clm != min ) return(-1);
     if( row < clm ) {
-        if( x_by_xt( input, u ) < 0 ) { Matrix::free(u); return(-1); }
+        if( x_by_xt( input, u ) < 0 ) { Matrix::free(arena, u); return(-1); }
     }
     else {
-        if( xt_by_x( input, u ) < 0 ) { Matrix::free(u); return(-1); }
+        if( xt_by_x( input, u ) < 0 ) { Matrix::free(arena, u); return(-1); }
     }
 
-    if( QRM( u, ev ) < 0 ) { Matrix::free(u); return(-1); }
+    if( QRM( u, ev, arena ) < 0 ) { Matrix::free(arena, u); return(-1); }
 
     if( row < clm ) {
         if( EV_create( input, u, output, ev ) < 0 ) {
-            Matrix::free(u);
+            Matrix::free(arena, u);
             return(-1);
         }
     }
@@ -212,7 +212,7 @@ PCA( ARMat *input, ARMat *output, ARVec *ev )
         }
     }
 
-    Matrix::free(u);
+    Matrix::free(arena, u);
 
     return( 0 );
 }
@@ -368,7 +368,7 @@ EV_create( ARMat *input, ARMat *u, ARMat *output, ARVec *ev )
 }
 
 static int
-QRM( ARMat *a, ARVec *dv )
+QRM( ARMat *a, ARVec *dv, MemoryManagerArena *arena )
 {
     ARVec     *ev, ev1;
     ARFloat  w, t, s, x, y, c;
@@ -380,13 +380,13 @@ QRM( ARMat *a, ARVec *dv )
     if( dim != a->clm || dim < 2 ) return(-1);
     if( dv->clm != dim ) return(-1);
 
-    ev = Vector::alloc( dim );
+    ev = Vector::alloc( arena, dim );
     if( ev == NULL ) return(-1);
 
     ev1.clm = dim-1;
     ev1.v = &(ev->v[1]);
     if( Vector::tridiagonalize( a, dv, &ev1 ) < 0 ) {
-        Vector::free( ev );
+        Vector::free( arena, ev );
         return(-1);
     }
 
@@ -468,7 +468,7 @@ QRM( ARMat *a, ARVec *dv )
         }
     }
 
-    Vector::free( ev );
+    Vector::free( arena, ev );
     return(0);
 }
 
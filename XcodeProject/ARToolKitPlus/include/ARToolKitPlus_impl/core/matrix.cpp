@@ -46,6 +46,7 @@
 #include <stdlib.h>
 #endif
 #include <ARToolKitPlus/matrix.h>
+#include <ARToolKitPlus/MemoryManagerArena.h>
 
 
 namespace ARToolKitPlus {
@@ -114,6 +115,51 @@ allocDup(ARMat *source)
 }
 
 
+// arena versions: header and elements are taken from one chunk of the arena
+static ARMat*
+alloc(MemoryManagerArena *arena, int row, int clm)
+{
+	ARMat *m;
+
+	if( arena == NULL ) return alloc(row, clm);
+
+	m = (ARMat *)arena->getMemory(((sizeof(ARMat)+15)&~15) + sizeof(ARFloat) * row * clm);
+	if( m == NULL ) return NULL;
+
+	m->m = (ARFloat *)((unsigned char *)m + ((sizeof(ARMat)+15)&~15));
+	m->row = row;
+	m->clm = clm;
+
+	return m;
+}
+
+
+static int
+free(MemoryManagerArena *arena, ARMat *m)
+{
+	if( arena == NULL ) return free(m);
+
+	return 0;
+}
+
+
+static ARMat*
+allocDup(MemoryManagerArena *arena, ARMat *source)
+{
+	ARMat *dest;
+
+	dest = alloc(arena, source->row, source->clm);
+	if( dest == NULL ) return NULL;
+
+	if( dup(dest, source) < 0 ) {
+		free(arena, dest);
+		return NULL;
+	}
+
+	return dest;
+}
+
+
 // from mAllocInv.c
 /*
 static ARMat*
@@ -39,11 +39,19 @@
 
 
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 #include <ARToolKitPlus/Tracker.h>
 #include <ARToolKitPlus/Camera.h>
 #include <ARToolKitPlus/param.h>
 
+#if !defined(_MSC_VER) && !defined(_WIN32_WCE)
+#  define UNDIST_LUT_USE_MMAP
+#  include <pthread.h>
+#  include <unistd.h>
+#  include <sys/mman.h>
+#endif
+
 
 namespace ARToolKitPlus {
 
@@ -103,27 +111,301 @@ void fixedToFloat(unsigned int nFixed, ARFloat& nX, ARFloat& nY)
 }
 
 
+// file header of the cached undistortion table (<camera file>.LUT)
+//
+#define UNDIST_LUT_MAGIC    "ARTKPLUT"
+#define UNDIST_LUT_VERSION  2
+
+struct UndistLUTHeader
+{
+	char			magic[8];
+	uint32_t		version;
+	uint32_t		entrySize;		// sizeof(unsigned int)
+	int32_t			width, height;
+	uint32_t		cameraHash;		// see hashUndistCamera()
+	uint32_t		reserved;
+};
+
+
+// the undistortion table is built in bands of this many rows
+#define UNDIST_LUT_TILE_ROWS  16
+
+// upper limit for the number of threads building a complete table
+#define UNDIST_LUT_MAX_THREADS  8
+
+
+// Fingerprint of the camera model for the LUT cache: the frame size plus the
+// undistorted positions of some probe points, so any change of the camera
+// file, camera class or resolution invalidates the cache.
+//
+static uint32_t
+hashUndistCamera(Camera* pCam)
+{
+	ARFloat px[25], py[25];
+	uint32_t hash = 2166136261u;		// FNV-1a
+	int i;
+
+	for(i=0; i<25; i++)
+	{
+		px[i] = (ARFloat)(pCam->xsize*(i%5))/4;
+		py[i] = (ARFloat)(pCam->ysize*(i/5))/4;
+	}
+	pCam->observ2IdealBatch(px, py, px, py, 25);
+
+	const int32_t size[2] = { pCam->xsize, pCam->ysize };
+	const unsigned char* bytes[3] = { (const unsigned char*)size, (const unsigned char*)px, (const unsigned char*)py };
+	const int numBytes[3] = { sizeof(size), sizeof(px), sizeof(py) };
+
+	for(int b=0; b<3; b++)
+		for(i=0; i<numBytes[b]; i++)
+		{
+			hash ^= bytes[b][i];
+			hash *= 16777619u;
+		}
+
+	return hash;
+}
+
+
+// fills rows [nY0,nY1) of an undistortion table (row-major, nWidth entries per row)
+//
+static void
+buildUndistO2IRows(Camera* pCam, unsigned int* nTable, int nWidth, int nY0, int nY1)
+{
+	ARFloat *rowX = new ARFloat[nWidth], *rowY = new ARFloat[nWidth];
+	unsigned int* entry = nTable + nY0*nWidth;
+
+	for(int y=nY0; y<nY1; y++)
+	{
+		for(int x=0; x<nWidth; x++)
+		{
+			rowX[x] = (ARFloat)x;
+			rowY[x] = (ARFloat)y;
+		}
+		pCam->observ2IdealBatch(rowX, rowY, rowX, rowY, nWidth);
+		for(int x=0; x<nWidth; x++)
+			floatToFixed(rowX[x], rowY[x], *entry++);
+	}
+
+	delete [] rowX;
+	delete [] rowY;
+}
+
+
+#ifdef UNDIST_LUT_USE_THREADS
+
+struct UndistLUTJob
+{
+	Camera*			cam;
+	unsigned int*	table;
+	int				width, height;
+	int				firstTile, tileStep;
+};
+
+static void*
+buildUndistO2ITilesThread(void* nJob)
+{
+	UndistLUTJob* job = (UndistLUTJob*)nJob;
+
+	// tiles are interleaved between the threads, which evens out the
+	// slower iterative undistortion towards the image border
+	for(int y=job->firstTile*UNDIST_LUT_TILE_ROWS; y<job->height; y+=job->tileStep*UNDIST_LUT_TILE_ROWS)
+		buildUndistO2IRows(job->cam, job->table, job->width, y, y+UNDIST_LUT_TILE_ROWS<job->height ? y+UNDIST_LUT_TILE_ROWS : job->height);
+
+	return NULL;
+}
+
+#endif //UNDIST_LUT_USE_THREADS
+
+
+// fills a complete undistortion table using all cores
+//
+static void
+buildUndistO2ITableParallel(Camera* pCam, unsigned int* nTable, int nWidth, int nHeight)
+{
+#ifdef UNDIST_LUT_USE_THREADS
+	int numThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	int numStarted = 0, i;
+
+	if(numThreads>UNDIST_LUT_MAX_THREADS)
+		numThreads = UNDIST_LUT_MAX_THREADS;
+
+	if(numThreads>1)
+	{
+		pthread_t threads[UNDIST_LUT_MAX_THREADS];
+		UndistLUTJob jobs[UNDIST_LUT_MAX_THREADS];
+
+		for(i=0; i<numThreads; i++)
+		{
+			jobs[i].cam = pCam;
+			jobs[i].table = nTable;
+			jobs[i].width = nWidth;
+			jobs[i].height = nHeight;
+			jobs[i].firstTile = i;
+			jobs[i].tileStep = numThreads;
+		}
+
+		// the calling thread takes the first share itself
+		for(i=1; i<numThreads; i++)
+		{
+			if(pthread_create(&threads[i], NULL, buildUndistO2ITilesThread, &jobs[i])!=0)
+				break;
+			numStarted++;
+		}
+
+		// shares whose thread could not be started are done here as well
+		for(int j=numStarted+1; j<numThreads; j++)
+			buildUndistO2ITilesThread(&jobs[j]);
+		buildUndistO2ITilesThread(&jobs[0]);
+
+		for(i=1; i<=numStarted; i++)
+			pthread_join(threads[i], NULL);
+		return;
+	}
+#endif //UNDIST_LUT_USE_THREADS
+
+	buildUndistO2IRows(pCam, nTable, nWidth, 0, nHeight);
+}
+
+
+// the "built" flags of the table bands and the grid are read without the lock
+// for every contour point. a flag is set only after the data it guards was
+// written, so a thread that sees it set also sees the data.
+//
+static inline bool
+isUndistReady(volatile const unsigned int& nFlag)
+{
+#if !defined(UNDIST_LUT_USE_THREADS)
+	return nFlag!=0;
+#elif defined(__ATOMIC_ACQUIRE)
+	return __atomic_load_n(&nFlag, __ATOMIC_ACQUIRE)!=0;
+#else
+	return __sync_fetch_and_add(const_cast<volatile unsigned int*>(&nFlag), 0)!=0;
+#endif
+}
+
+
+static inline void
+setUndistReady(volatile unsigned int& nFlag)
+{
+#if !defined(UNDIST_LUT_USE_THREADS)
+	nFlag = 1;
+#elif defined(__ATOMIC_RELEASE)
+	__atomic_store_n(&nFlag, 1u, __ATOMIC_RELEASE);
+#else
+	__sync_synchronize();
+	nFlag = 1;
+#endif
+}
+
+
 AR_TEMPL_FUNC int
 AR_TEMPL_TRACKER::arParamObserv2Ideal_LUT(Camera* pCam, ARFloat ox, ARFloat oy, ARFloat *ix, ARFloat *iy)
 {
-	if(!undistO2ITable)
-		buildUndistO2ITable(pCam);
-
 	int x=(int)ox, y=(int)oy;
+	const int tile = y/UNDIST_LUT_TILE_ROWS;
+
+	assert(undistO2ITileReady && y>=0 && tile<undistO2INumTiles);
+
+	// without a cache file the table is filled band by band as contours need it
+	if(!isUndistReady(undistO2ITileReady[tile]))
+		buildUndistO2ITile(pCam, tile);
 
 	fixedToFloat(undistO2ITable[x+y*arImXsize], *ix,*iy);
 	return 0;
 }
 
 
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::buildUndistO2ITile(Camera* pCam, int nTile)
+{
+#ifdef UNDIST_LUT_USE_THREADS
+	pthread_mutex_lock(&undistLock);
+#endif
+
+	// another thread may have built the table or this band in the meantime
+	if(!undistO2ITable)
+		buildUndistO2ITable(pCam);
+
+	if(!undistO2ITileReady[nTile])
+	{
+		const int y0 = nTile*UNDIST_LUT_TILE_ROWS;
+		buildUndistO2IRows(pCam, undistO2ITable, arImXsize, y0, y0+UNDIST_LUT_TILE_ROWS<arImYsize ? y0+UNDIST_LUT_TILE_ROWS : arImYsize);
+		setUndistReady(undistO2ITileReady[nTile]);
+	}
+
+#ifdef UNDIST_LUT_USE_THREADS
+	pthread_mutex_unlock(&undistLock);
+#endif
+}
+
+
+AR_TEMPL_FUNC bool
+AR_TEMPL_TRACKER::loadUndistO2ICache(const char* nFileName, uint32_t nCameraHash)
+{
+	const size_t tableSize = (size_t)arImXsize*arImYsize*sizeof(unsigned int);
+	UndistLUTHeader header;
+
+	FILE* fp = fopen(nFileName, "rb");
+	if(!fp)
+		return false;
+
+	bool valid = fread(&header, sizeof(header), 1, fp)==1 &&
+				 memcmp(header.magic, UNDIST_LUT_MAGIC, sizeof(header.magic))==0 &&
+				 header.version==UNDIST_LUT_VERSION &&
+				 header.entrySize==sizeof(unsigned int) &&
+				 header.width==arImXsize && header.height==arImYsize &&
+				 header.cameraHash==nCameraHash;
+
+	if(valid)
+	{
+		fseek(fp, 0, SEEK_END);
+		valid = (size_t)ftell(fp) == sizeof(header)+tableSize;
+	}
+
+	if(!valid)
+	{
+		fclose(fp);
+		return false;
+	}
+
+#ifdef UNDIST_LUT_USE_MMAP
+	void* map = mmap(NULL, sizeof(header)+tableSize, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+	fclose(fp);
+	if(map==MAP_FAILED)
+		return false;
+
+	undistO2IMap = map;
+	undistO2IMapSize = sizeof(header)+tableSize;
+	undistO2ITable = (unsigned int*)((char*)map + sizeof(header));
+	return true;
+#else
+	undistO2ITable = artkp_Alloc<unsigned int>(arImXsize*arImYsize);
+	fseek(fp, sizeof(header), SEEK_SET);
+	valid = fread(undistO2ITable, 1, tableSize, fp) == tableSize;
+	fclose(fp);
+	if(!valid)
+	{
+		artkp_Free(undistO2ITable);
+		undistO2ITable = NULL;
+	}
+	return valid;
+#endif
+}
+
+
 AR_TEMPL_FUNC void
 AR_TEMPL_TRACKER::buildUndistO2ITable(Camera* pCam)
 {
-	int x,y;
-	ARFloat cx,cy, ox,oy;
-	unsigned int fixed;
 	char* cachename = NULL;
-	bool loaded = false;
+	uint32_t cameraHash = 0;
+	int i;
+
+	// we have to take care here when using a memory manager that can not free memory
+	// (usually this lookup table should only be built once - unless we change camera resolution)
+	//
+	if(undistO2ITable)
+		return;
 
 	if(loadCachedUndist)
 	{
@@ -131,52 +413,238 @@ AR_TEMPL_TRACKER::buildUndistO2ITable(Camera* pCam)
 		cachename = new char[strlen(pCam->getFileName())+5];
 		strcpy(cachename, pCam->getFileName());
 		strcat(cachename, ".LUT");
-	}
 
-	// we have to take care here when using a memory manager that can not free memory
-	// (usually this lookup table should only be built once - unless we change camera resolution)
-	//
-	if(undistO2ITable)
-		//delete undistO2ITable;
-		artkp_Free(undistO2ITable);
+		cameraHash = hashUndistCamera(pCam);
+		if(loadUndistO2ICache(cachename, cameraHash))
+		{
+			for(i=0; i<undistO2INumTiles; i++)
+				setUndistReady(undistO2ITileReady[i]);
+			delete [] cachename;
+			return;
+		}
+	}
 
 	//undistO2ITable = new unsigned int [arImXsize*arImYsize];
 	undistO2ITable = artkp_Alloc<unsigned int>(arImXsize*arImYsize);
 
 	if(loadCachedUndist)
 	{
-		if(FILE* fp = fopen(cachename, "rb"))
-		{
-			size_t numBytes = fread(undistO2ITable, 1, arImXsize*arImYsize*sizeof(unsigned int), fp);
-			fclose(fp);
+		// the complete table goes into the cache, so build all of it right away
+		//
+		buildUndistO2ITableParallel(pCam, undistO2ITable, arImXsize, arImYsize);
+		for(i=0; i<undistO2INumTiles; i++)
+			setUndistReady(undistO2ITileReady[i]);
 
-			if(numBytes == arImXsize*arImYsize*sizeof(unsigned int))
-				loaded = true;
+		if(FILE* fp = fopen(cachename, "wb"))
+		{
+			UndistLUTHeader header;
+
+			memset(&header, 0, sizeof(header));
+			memcpy(header.magic, UNDIST_LUT_MAGIC, sizeof(header.magic));
+			header.version = UNDIST_LUT_VERSION;
+			header.entrySize = sizeof(unsigned int);
+			header.width = arImXsize;
+			header.height = arImYsize;
+			header.cameraHash = cameraHash;
+
+			const size_t tableSize = (size_t)arImXsize*arImYsize*sizeof(unsigned int);
+			bool written = fwrite(&header, sizeof(header), 1, fp)==1 &&
+						   fwrite(undistO2ITable, 1, tableSize, fp)==tableSize;
+			written = fclose(fp)==0 && written;
+
+			// a truncated cache would fail its size check when loading,
+			// but there is no point in leaving it on disk
+			if(!written)
+			{
+				remove(cachename);
+				if(logger)
+					logger->artLogEx("ARToolKitPlus: could not write undistortion cache '%s'\n", cachename);
+			}
 		}
 	}
 
-	if(!loaded)
+	// otherwise bands are built on first access only (see arParamObserv2Ideal_LUT)
+
+	delete [] cachename;
+}
+
+
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::initUndistTables()
+{
+	// the band flags exist before any frame is processed, only the table
+	// itself is allocated (or mapped from the cache file) on first use
+	//
+	undistO2INumTiles = (arImYsize+UNDIST_LUT_TILE_ROWS-1)/UNDIST_LUT_TILE_ROWS;
+	undistO2ITileReady = new unsigned int[undistO2INumTiles];
+	for(int i=0; i<undistO2INumTiles; i++)
+		undistO2ITileReady[i] = 0;
+}
+
+
+// maximum deviation (pixels) of the interpolated grid from the exact camera model
+#define UNDIST_GRID_MAX_ERROR  0.01
+
+
+AR_TEMPL_FUNC int
+AR_TEMPL_TRACKER::arParamObserv2Ideal_grid(Camera* pCam, ARFloat ox, ARFloat oy, ARFloat *ix, ARFloat *iy)
+{
+	// the grid is built on first use, see buildUndistO2ITile() for the locking
+	if(!isUndistReady(undistGridReady))
+		buildUndistGrid(pCam);
+
+	lookupUndistGrid(ox, oy, ix, iy);
+	return 0;
+}
+
+
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::lookupUndistGrid(ARFloat ox, ARFloat oy, ARFloat *ix, ARFloat *iy) const
+{
+	ARFloat fx = ox*undistGridInvStep, fy = oy*undistGridInvStep;
+	int gx = (int)fx, gy = (int)fy;
+
+	// points outside of the image are extrapolated from the border cells
+	if(gx<0) gx = 0;  else if(gx>undistGridW-2) gx = undistGridW-2;
+	if(gy<0) gy = 0;  else if(gy>undistGridH-2) gy = undistGridH-2;
+
+	const ARFloat tx = fx-gx, ty = fy-gy;
+	const ARFloat* n0 = undistGrid + 2*(gy*undistGridW+gx);
+	const ARFloat* n1 = n0 + 2*undistGridW;
+
+	const ARFloat x0 = n0[0] + tx*(n0[2]-n0[0]), y0 = n0[1] + tx*(n0[3]-n0[1]);
+	const ARFloat x1 = n1[0] + tx*(n1[2]-n1[0]), y1 = n1[1] + tx*(n1[3]-n1[1]);
+
+	*ix = x0 + ty*(x1-x0);
+	*iy = y0 + ty*(y1-y0);
+}
+
+
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::buildUndistGrid(Camera* pCam)
+{
+#ifdef UNDIST_LUT_USE_THREADS
+	pthread_mutex_lock(&undistLock);
+#endif
+
+	// another thread may have built the grid in the meantime
+	if(undistGridReady)
+	{
+#ifdef UNDIST_LUT_USE_THREADS
+		pthread_mutex_unlock(&undistLock);
+#endif
+		return;
+	}
+
+	const int maxW = arImXsize/UNDIST_GRID_MIN_STEP+2;
+	ARFloat *rowX = new ARFloat[maxW], *rowY = new ARFloat[maxW];
+	int x,y, step;
+
+	// start with a coarse grid and refine it until bilinear interpolation
+	// is accurate enough in the centre of every cell (where its error peaks)
+	//
+	for(step=UNDIST_GRID_MAX_STEP; ; step/=2)
 	{
-		for(x=0; x<arImXsize; x++)
+		if(undistGrid)
+			artkp_Free(undistGrid);
+
+		undistGridStep = step;
+		undistGridInvStep = (ARFloat)1.0/step;
+		undistGridW = (arImXsize+step-1)/step + 1;
+		undistGridH = (arImYsize+step-1)/step + 1;
+		undistGrid = artkp_Alloc<ARFloat>(2*undistGridW*undistGridH);
+
+		for(y=0; y<undistGridH; y++)
 		{
-			for(y=0; y<arImYsize; y++)
+			ARFloat* node = undistGrid + 2*y*undistGridW;
+
+			for(x=0; x<undistGridW; x++)
+			{
+				rowX[x] = (ARFloat)(x*step);
+				rowY[x] = (ARFloat)(y*step);
+			}
+			pCam->observ2IdealBatch(rowX, rowY, rowX, rowY, undistGridW);
+			for(x=0; x<undistGridW; x++)
 			{
-				arParamObserv2Ideal_std(pCam, (ARFloat)x, (ARFloat)y, &cx, &cy);
-				floatToFixed(cx,cy, fixed);
-				fixedToFloat(fixed, ox,oy);
-				undistO2ITable[x+y*arImXsize] = fixed;
+				node[2*x+0] = rowX[x];
+				node[2*x+1] = rowY[x];
 			}
 		}
 
-		if(loadCachedUndist)
-			if(FILE* fp = fopen(cachename, "wb"))
+		ARFloat maxErr = 0;
+		for(y=0; y<undistGridH-1; y++)
+		{
+			for(x=0; x<undistGridW-1; x++)
+			{
+				rowX[x] = (ARFloat)((x+0.5f)*step);
+				rowY[x] = (ARFloat)((y+0.5f)*step);
+			}
+			pCam->observ2IdealBatch(rowX, rowY, rowX, rowY, undistGridW-1);
+			for(x=0; x<undistGridW-1; x++)
 			{
-				fwrite(undistO2ITable, 1, arImXsize*arImYsize*sizeof(unsigned int), fp);
-				fclose(fp);
+				ARFloat gx, gy;
+				lookupUndistGrid((ARFloat)((x+0.5f)*step), (ARFloat)((y+0.5f)*step), &gx, &gy);
+				if((ARFloat)fabs(gx-rowX[x]) > maxErr) maxErr = (ARFloat)fabs(gx-rowX[x]);
+				if((ARFloat)fabs(gy-rowY[x]) > maxErr) maxErr = (ARFloat)fabs(gy-rowY[x]);
 			}
+		}
+
+		// the finest step is kept even if it misses the bound, getUndistGridError() tells
+		undistGridError = maxErr;
+		if(maxErr <= UNDIST_GRID_MAX_ERROR || step/2 < UNDIST_GRID_MIN_STEP)
+			break;
 	}
 
-	delete cachename;
+	delete [] rowX;
+	delete [] rowY;
+
+	if(undistGridError > UNDIST_GRID_MAX_ERROR && logger)
+		logger->artLogEx("ARToolKitPlus: UNDIST_GRID is off by up to %.3f pixels at a node distance of %d", undistGridError, undistGridStep);
+
+	setUndistReady(undistGridReady);
+
+#ifdef UNDIST_LUT_USE_THREADS
+	pthread_mutex_unlock(&undistLock);
+#endif
+}
+
+
+AR_TEMPL_FUNC void
+AR_TEMPL_TRACKER::freeUndistTables()
+{
+	if(undistO2IMap)
+	{
+#ifdef UNDIST_LUT_USE_MMAP
+		munmap(undistO2IMap, undistO2IMapSize);
+#endif
+		undistO2IMap = NULL;
+		undistO2IMapSize = 0;
+	}
+	else if(undistO2ITable)
+		artkp_Free(undistO2ITable);
+	undistO2ITable = NULL;
+
+	delete [] undistO2ITileReady;
+	undistO2ITileReady = NULL;
+	undistO2INumTiles = 0;
+
+	if(undistGrid)
+		artkp_Free(undistGrid);
+	undistGrid = NULL;
+	undistGridError = -1;
+	undistGridReady = 0;
+}
+
+
+AR_TEMPL_FUNC ARFloat
+AR_TEMPL_TRACKER::getUndistGridError()
+{
+	if(undistMode!=UNDIST_GRID || !arCamera)
+		return -1;
+
+	if(!isUndistReady(undistGridReady))
+		buildUndistGrid(arCamera);
+	return undistGridError;
 }
 
 
@@ -41,8 +41,6 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
-#include <map>
-#include <deque>
 #include <ARToolKitPlus/Tracker.h>
 #include <ARToolKitPlus/matrix.h>
 #include <ARToolKitPlus/extra/rpp.h>
@@ -57,61 +55,36 @@ AR_TEMPL_TRACKER::rppMultiGetTransMat(ARMarkerInfo *marker_info, int marker_num,
 	rpp_mat R, R_init;
 	rpp_vec t;
 
-	std::map<int, int> marker_id_freq;
-	for(int i=0; i<marker_num; i++)
-	{
-		const int m_patt_id = marker_info[i].id;
-		if(m_patt_id >= 0)
-		{
-			std::map<int, int>::iterator iter = marker_id_freq.find(m_patt_id);
-			
-			if(iter == marker_id_freq.end()) {
-			    marker_id_freq.insert(std::make_pair<int,int>(
-			    #ifdef __GXX_EXPERIMENTAL_CXX0X__
-			    (int&&)
-			    #endif
-			    m_patt_id, 1));
-			} else {
-			    ((*iter).second)++;
-			}
-		}
-	}
+	if(!arMultiHasConfigIndex(config) && !arMultiCreateConfigIndex(config))
+		return -1;
 
-	std::deque<std::pair<int,int> > config_patt_id;
-	for(int j=0; j<config->marker_num; j++)
-		config_patt_id.push_back(std::make_pair<int,int>(j, config->marker[j].patt_id));
+	// assign each detected marker to the first config entry with its id.
+	// ids which were detected more than once are ambiguous and ignored.
+	//
+	int *matchIdx = config->matchIdx;
+	for(int c=0; c<config->marker_num; c++)
+		matchIdx[c] = -1;
 
-	std::map<int, int> m2c_idx;
+	unsigned int n_markers = 0;
 	for(int m=0; m<marker_num; m++)
 	{
-		const int m_patt_id = marker_info[m].id;
-		bool ignore_marker = (m_patt_id < 0);
-		std::map<int, int>::iterator m_iter = marker_id_freq.find(m_patt_id);
-		if(m_iter != marker_id_freq.end()) ignore_marker |= ((*m_iter).second > 1);
-		if(!ignore_marker)
+		const int c = arMultiGetConfigIndex(config, marker_info[m].id);
+		if(c < 0)
+			continue;
+
+		if(matchIdx[c] == -1)
 		{
-			std::deque<std::pair<int,int> >::iterator c_iter = config_patt_id.begin();
-			if(c_iter != config_patt_id.end()) do
-			{
-				const int patt_id = (*c_iter).second;
-				if(marker_info[m].id == patt_id)
-				{
-					m2c_idx.insert(std::make_pair<int,int>(m,(*c_iter).first));
-					config_patt_id.erase(c_iter);
-					c_iter = config_patt_id.end();
-					continue;
-				}
-				else
-				{
-					c_iter++;
-				}
-			}
-			while(c_iter != config_patt_id.end());
+			matchIdx[c] = m;
+			n_markers++;
+		}
+		else if(matchIdx[c] >= 0)
+		{
+			matchIdx[c] = -2;
+			n_markers--;
 		}
 	}
 
 	// ----------------------------------------------------------------------
-	const unsigned int n_markers = (unsigned int) m2c_idx.size();
 	const unsigned int n_pts = 4*n_markers;
 
 	if(n_markers == 0) return(-1);
@@ -124,12 +97,13 @@ AR_TEMPL_TRACKER::rppMultiGetTransMat(ARMarkerInfo *marker_info, int marker_num,
 
 	const rpp_float iprts_z =  1;
 
+	// walk the detected markers in ascending order, as before
 	int p=0;
-	for(std::map<int, int>::iterator iter = m2c_idx.begin();
-		iter != m2c_idx.end(); iter++)
+	for(int m=0; m<marker_num; m++)
 	{
-		const int m = (*iter).first;
-		const int c = (*iter).second;
+		const int c = arMultiGetConfigIndex(config, marker_info[m].id);
+		if(c < 0 || matchIdx[c] != m)
+			continue;
 
 		const int dir = marker_info[m].dir;
 		const int v_idx[4] = {(4-dir)%4, (5-dir)%4, (6-dir)%4, (7-dir)%4};
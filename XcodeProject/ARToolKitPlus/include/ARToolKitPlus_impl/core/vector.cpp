@@ -50,6 +50,7 @@
 #include <ARToolKitPlus/Tracker.h>
 #include <ARToolKitPlus/matrix.h>
 #include <ARToolKitPlus/vector.h>
+#include <ARToolKitPlus/MemoryManagerArena.h>
 
 
 namespace ARToolKitPlus {
@@ -111,6 +112,33 @@ free( ARVec *v )
 }
 
 
+// arena versions: header and elements are taken from one chunk of the arena
+static ARVec*
+alloc( MemoryManagerArena *arena, int clm )
+{
+    ARVec     *v;
+
+    if( arena == NULL ) return alloc( clm );
+
+    v = (ARVec *)arena->getMemory( ((sizeof(ARVec)+15)&~15) + sizeof(ARFloat) * clm );
+    if( v == NULL ) return NULL;
+
+    v->v = (ARFloat *)((unsigned char *)v + ((sizeof(ARVec)+15)&~15));
+    v->clm = clm;
+
+    return v;
+}
+
+
+static int
+free( MemoryManagerArena *arena, ARVec *v )
+{
+    if( arena == NULL ) return free( v );
+
+    return 0;
+}
+
+
 // from vHouse.c
 static ARFloat
 household( ARVec *x )
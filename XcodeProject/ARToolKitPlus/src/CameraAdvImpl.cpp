@@ -44,6 +44,7 @@
 #include <math.h>
 
 #include <ARToolKitPlus/CameraAdvImpl.h>
+#include <ARToolKitPlus/extra/SimdFloat.h>
 
 
 namespace ARToolKitPlus {
@@ -166,6 +167,107 @@ ideal2Observ(ARFloat ix, ARFloat iy, ARFloat *ox, ARFloat *oy)
 	*oy = (xu[1] * cdist) + (kc[2]*a3 + kc[3]*a1);
 }
 
+// observ2Ideal() for V::WIDTH points. Iterates until the update of every
+// point is below nTolerance (in normalized coordinates) or nIterations is reached.
+//
+template <typename V>
+static inline void
+observ2IdealKernel(const ARFloat cc[2], const ARFloat fc[2], const ARFloat kc[6], int nIterations, ARFloat nTolerance,
+				   const ARFloat *ox, const ARFloat *oy, ARFloat *ix, ARFloat *iy)
+{
+	const V cx(cc[0]), cy(cc[1]), fx(fc[0]), fy(fc[1]);
+	const V k1(kc[0]), k2(kc[1]), k3(kc[4]), p1(kc[2]), p2(kc[3]);
+	const V one((ARFloat)1.0), two((ARFloat)2.0), tol2(nTolerance*nTolerance);
+
+	const V xd0 = (V::load(ox) - cx) / fx;
+	const V xd1 = (V::load(oy) - cy) / fy;
+
+	V x0 = xd0, x1 = xd1;
+	for(int kk=0; kk<nIterations; kk++)
+	{
+		const V x0_sq = x0*x0;
+		const V x1_sq = x1*x1;
+		const V x0_x1 = x0*x1;
+		const V r_2 = x0_sq + x1_sq;
+		const V r_2_sq = r_2*r_2;
+		const V inv_k_radial = one / (one + k1*r_2 + k2*r_2_sq + k3*(r_2*r_2_sq));
+		const V delta_x0 = two*p1*x0_x1 + p2*(r_2 + two*x0_sq);
+		const V delta_x1 = p1*(r_2 + two*x1_sq) + two*p2*x0_x1;
+		const V n0 = (xd0 - delta_x0) * inv_k_radial;
+		const V n1 = (xd1 - delta_x1) * inv_k_radial;
+		const V e0 = n0 - x0, e1 = n1 - x1;
+
+		x0 = n0;
+		x1 = n1;
+
+		if(!V::anyGreater(e0*e0 + e1*e1, tol2))
+			break;
+	}
+
+	(x0*fx + cx).store(ix);
+	(x1*fy + cy).store(iy);
+}
+
+
+// ideal2Observ() for V::WIDTH points
+//
+template <typename V>
+static inline void
+ideal2ObservKernel(const ARFloat cc[2], const ARFloat fc[2], const ARFloat kc[6],
+				   const ARFloat *ix, const ARFloat *iy, ARFloat *ox, ARFloat *oy)
+{
+	const V one((ARFloat)1.0), two((ARFloat)2.0);
+	const V xu0 = (V::load(ix) - V(cc[0])) / V(fc[0]);
+	const V xu1 = (V::load(iy) - V(cc[1])) / V(fc[1]);
+
+	const V r2 = xu0*xu0 + xu1*xu1;
+	const V r4 = r2*r2;
+	const V r6 = r4*r2;
+	const V cdist = one + V(kc[0])*r2 + V(kc[1])*r4 + V(kc[4])*r6;
+
+	const V a1 = two*xu0*xu1;
+	const V a2 = r2 + two*(xu0*xu0);
+	const V a3 = r2 + two*(xu1*xu1);
+
+	(xu0*cdist + (V(kc[2])*a1 + V(kc[3])*a2)).store(ox);
+	(xu1*cdist + (V(kc[2])*a3 + V(kc[3])*a1)).store(oy);
+}
+
+
+void CameraAdvImpl::
+observ2IdealBatch(const ARFloat *ox, const ARFloat *oy, ARFloat *ix, ARFloat *iy, int nNum)
+{
+	int i = 0;
+
+	if(undist_iterations <= 0)
+	{
+		for(; i<nNum; i++)
+		{
+			ix[i] = ox[i];
+			iy[i] = oy[i];
+		}
+		return;
+	}
+
+	const ARFloat tolerance = (ARFloat)CAMERA_ADV_UNDIST_TOLERANCE / (fc[0]>fc[1] ? fc[0] : fc[1]);
+
+	for(; i+SimdFloat::WIDTH<=nNum; i+=SimdFloat::WIDTH)
+		observ2IdealKernel<SimdFloat>(cc, fc, kc, undist_iterations, tolerance, ox+i, oy+i, ix+i, iy+i);
+	for(; i<nNum; i++)
+		observ2IdealKernel<SimdScalar>(cc, fc, kc, undist_iterations, tolerance, ox+i, oy+i, ix+i, iy+i);
+}
+
+void CameraAdvImpl::
+ideal2ObservBatch(const ARFloat *ix, const ARFloat *iy, ARFloat *ox, ARFloat *oy, int nNum)
+{
+	int i = 0;
+
+	for(; i+SimdFloat::WIDTH<=nNum; i+=SimdFloat::WIDTH)
+		ideal2ObservKernel<SimdFloat>(cc, fc, kc, ix+i, iy+i, ox+i, oy+i);
+	for(; i<nNum; i++)
+		ideal2ObservKernel<SimdScalar>(cc, fc, kc, ix+i, iy+i, ox+i, oy+i);
+}
+
 Camera* CameraAdvImpl::clone()
 {
 	CameraAdvImpl* pCam = new CameraAdvImpl();
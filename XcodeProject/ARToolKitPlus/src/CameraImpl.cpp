@@ -44,11 +44,13 @@
 
 #include <ARToolKitPlus/CameraImpl.h>
 #include <ARToolKitPlus/byteSwap.h>
+#include <ARToolKitPlus/extra/SimdFloat.h>
 
 
 namespace ARToolKitPlus {
 
 #define PD_LOOP 3
+#define PD_TOLERANCE 0.0001		// pixels; batch undistortion stops once all radii moved less
 
 CameraImpl::CameraImpl()
 {}
@@ -152,6 +154,83 @@ ideal2Observ(ARFloat ix, ARFloat iy, ARFloat *ox, ARFloat *oy)
 	}
 }
 
+// observ2Ideal() for V::WIDTH points. The Newton steps only change the
+// distance from the distortion centre, so the direction is applied once
+// at the end instead of rescaling px/py (and taking a sqrt) in every step.
+//
+template <typename V>
+static inline void
+observ2IdealKernel(const ARFloat dist_factor[4], const ARFloat *ox, const ARFloat *oy, ARFloat *ix, ARFloat *iy)
+{
+	const V d0(dist_factor[0]), d1(dist_factor[1]);
+	const V p(dist_factor[2]/(ARFloat)100000000.0), invD3((ARFloat)1.0/dist_factor[3]);
+	const V zero((ARFloat)0.0), one((ARFloat)1.0), three((ARFloat)3.0);
+	const V tol2((ARFloat)(PD_TOLERANCE*PD_TOLERANCE));
+
+	V px = V::load(ox) - d0;
+	V py = V::load(oy) - d1;
+	V z02 = px*px + py*py;
+	V q = V::sqrt(z02);
+	V z0 = q, z, dz, s = one;
+
+	for(int i=0; i<PD_LOOP; i++)
+	{
+		z = z0 - ((one - p*z02)*z0 - q) / (one - three*p*z02);
+		s = s * z / z0;
+		dz = z - z0;
+		z0 = V::abs(z);
+		z02 = z*z;
+
+		if(!V::anyGreater(dz*dz, tol2))
+			break;
+	}
+
+	// points on the distortion centre stay there (s is 0/0 for them)
+	s = V::selectGreater(q, zero, s*invD3, zero);
+
+	(px*s + d0).store(ix);
+	(py*s + d1).store(iy);
+}
+
+
+template <typename V>
+static inline void
+ideal2ObservKernel(const ARFloat dist_factor[4], const ARFloat *ix, const ARFloat *iy, ARFloat *ox, ARFloat *oy)
+{
+	const V d0(dist_factor[0]), d1(dist_factor[1]), d3(dist_factor[3]);
+	const V p(dist_factor[2]/(ARFloat)100000000.0), one((ARFloat)1.0);
+
+	V x = (V::load(ix) - d0) * d3;
+	V y = (V::load(iy) - d1) * d3;
+	V d = one - p*(x*x + y*y);
+
+	(x*d + d0).store(ox);
+	(y*d + d1).store(oy);
+}
+
+
+void CameraImpl::
+observ2IdealBatch(const ARFloat *ox, const ARFloat *oy, ARFloat *ix, ARFloat *iy, int nNum)
+{
+	int i = 0;
+
+	for(; i+SimdFloat::WIDTH<=nNum; i+=SimdFloat::WIDTH)
+		observ2IdealKernel<SimdFloat>(dist_factor, ox+i, oy+i, ix+i, iy+i);
+	for(; i<nNum; i++)
+		observ2IdealKernel<SimdScalar>(dist_factor, ox+i, oy+i, ix+i, iy+i);
+}
+
+void CameraImpl::
+ideal2ObservBatch(const ARFloat *ix, const ARFloat *iy, ARFloat *ox, ARFloat *oy, int nNum)
+{
+	int i = 0;
+
+	for(; i+SimdFloat::WIDTH<=nNum; i+=SimdFloat::WIDTH)
+		ideal2ObservKernel<SimdFloat>(dist_factor, ix+i, iy+i, ox+i, oy+i);
+	for(; i<nNum; i++)
+		ideal2ObservKernel<SimdScalar>(dist_factor, ix+i, iy+i, ox+i, oy+i);
+}
+
 Camera* CameraImpl::clone()
 {
 	CameraImpl* pCam = new CameraImpl();
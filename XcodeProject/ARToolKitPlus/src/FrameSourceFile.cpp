@@ -0,0 +1,541 @@
+/* ========================================================================
+* PROJECT: ARToolKitPlus
+* ========================================================================
+* This work is based on the original ARToolKit developed by
+*   Hirokazu Kato
+*   Mark Billinghurst
+*   HITLab, University of Washington, Seattle
+* http://www.hitl.washington.edu/artoolkit/
+*
+* Copyright of the derived and new portions of this work
+*     (C) 2006 Graz University of Technology
+*
+* This framework is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 2 of the License, or
+* (at your option) any later version.
+*
+* This framework is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this framework; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+* For further information please contact 
+*   Dieter Schmalstieg
+*   <schmalstieg@icg.tu-graz.ac.at>
+*   Graz University of Technology, 
+*   Institut for Computer Graphics and Vision,
+*   Inffeldgasse 16a, 8010 Graz, Austria.
+* ========================================================================
+** @author   Daniel Wagner
+*
+* $Id$
+* @file
+* ======================================================================== */
+
+
+#include <ARToolKitPlus/FrameSourceFile.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER) || defined(_WIN32_WCE)
+#  include <windows.h>
+#else
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <sys/time.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#  define FRAMESOURCE_USE_MMAP
+#endif
+
+
+namespace ARToolKitPlus
+{
+
+
+#define Y4M_MAX_HEADER		1024		// longest stream or frame header accepted
+
+
+static double
+getMilliseconds()
+{
+#if defined(_MSC_VER) || defined(_WIN32_WCE)
+	LARGE_INTEGER freq, now;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+	return 1000.0*(double)now.QuadPart/(double)freq.QuadPart;
+#else
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec*1000.0 + tv.tv_usec/1000.0;
+#endif
+}
+
+
+static void
+sleepMilliseconds(double nMilliseconds)
+{
+#if defined(_MSC_VER) || defined(_WIN32_WCE)
+	Sleep((DWORD)nMilliseconds);
+#else
+	usleep((useconds_t)(nMilliseconds*1000.0));
+#endif
+}
+
+
+static int
+getBytesPerPixel(PIXEL_FORMAT nFormat)
+{
+	switch(nFormat)
+	{
+	case PIXEL_FORMAT_LUM:
+		return 1;
+	case PIXEL_FORMAT_RGB565:
+		return 2;
+	case PIXEL_FORMAT_RGB:
+	case PIXEL_FORMAT_BGR:
+		return 3;
+	default:
+		return 4;
+	}
+}
+
+
+FrameSourceFile::FrameSourceFile()
+{
+	width = height = 0;
+	format = PIXEL_FORMAT_LUM;
+	frameRate = 0.0;
+	frameSize = 0;
+
+	fileSize = headerSize = frameStride = 0;
+	numFrames = 0;
+
+	numBuffers = 3;
+
+	nextFrame = numDelivered = 0;
+	realTime = loop = endOfStream = false;
+	startTime = 0.0;
+
+	mapping = NULL;
+	fd = -1;
+	file = NULL;
+}
+
+
+FrameSourceFile::~FrameSourceFile()
+{
+	close();
+}
+
+
+void
+FrameSourceFile::setNumBuffers(int nNumBuffers)
+{
+	if(isOpen() || nNumBuffers<1)
+		return;
+
+	numBuffers = nNumBuffers;
+}
+
+
+bool
+FrameSourceFile::openFile(const char* nFileName)
+{
+	close();
+
+#ifdef FRAMESOURCE_USE_MMAP
+	struct stat st;
+
+	if((fd = open(nFileName, O_RDONLY))<0)
+		return false;
+
+	if(fstat(fd, &st)!=0)
+	{
+		close();
+		return false;
+	}
+	fileSize = (FileOffset)st.st_size;
+
+	// no mapping (e.g. a file larger than the address space on 32-bit systems): read frames with pread()
+	void* map = fileSize>0 && fileSize==(FileOffset)(size_t)fileSize ?
+				mmap(NULL, (size_t)fileSize, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+
+	if(map!=MAP_FAILED)
+	{
+		mapping = (unsigned char*)map;
+		madvise(mapping, (size_t)fileSize, MADV_SEQUENTIAL);
+	}
+#else
+	if((file = fopen(nFileName, "rb"))==NULL)
+		return false;
+
+	_fseeki64(file, 0, SEEK_END);
+	fileSize = (FileOffset)_ftelli64(file);
+#endif
+
+	return true;
+}
+
+
+void
+FrameSourceFile::close()
+{
+#ifdef FRAMESOURCE_USE_MMAP
+	if(mapping)
+		munmap(mapping, (size_t)fileSize);
+	if(fd>=0)
+		::close(fd);
+#endif
+	if(file)
+		fclose(file);
+
+	mapping = NULL;
+	fd = -1;
+	file = NULL;
+
+	for(size_t i=0; i<buffers.size(); i++)
+		delete [] buffers[i].memory;
+	buffers.clear();
+	frameOffsets.clear();
+
+	width = height = 0;
+	frameSize = 0;
+	fileSize = headerSize = frameStride = 0;
+	numFrames = 0;
+	nextFrame = numDelivered = 0;
+	endOfStream = false;
+}
+
+
+bool
+FrameSourceFile::readAt(FileOffset nOffset, void* nData, size_t nSize)
+{
+	if(nOffset+nSize>fileSize)
+		return false;
+
+	if(mapping)
+	{
+		memcpy(nData, mapping+nOffset, nSize);
+		return true;
+	}
+
+#ifdef FRAMESOURCE_USE_MMAP
+	unsigned char* data = (unsigned char*)nData;
+
+	while(nSize>0)
+	{
+		ssize_t num = pread(fd, data, nSize, (off_t)nOffset);
+		if(num<=0)
+			return false;
+		data += num;
+		nOffset += num;
+		nSize -= num;
+	}
+	return true;
+#else
+	return _fseeki64(file, nOffset, SEEK_SET)==0 && fread(nData, 1, nSize, file)==nSize;
+#endif
+}
+
+
+void
+FrameSourceFile::allocBuffers()
+{
+	buffers.resize(numBuffers);
+
+	for(int i=0; i<numBuffers; i++)
+	{
+		Buffer& buffer = buffers[i];
+
+		buffer.memory = mapping ? NULL : new unsigned char[frameSize];
+		buffer.offset = 0;
+		buffer.leased = false;
+
+		buffer.frame.data = buffer.memory;
+		buffer.frame.size = frameSize;
+		buffer.frame.width = width;
+		buffer.frame.height = height;
+		buffer.frame.format = format;
+		buffer.frame.frameId = 0;
+		buffer.frame.timestamp = 0.0;
+	}
+
+	prefetch(0);
+}
+
+
+bool
+FrameSourceFile::openRaw(const char* nFileName, int nWidth, int nHeight, PIXEL_FORMAT nFormat,
+						 double nFrameRate, size_t nHeaderSize)
+{
+	if(nWidth<=0 || nHeight<=0 || !openFile(nFileName))
+		return false;
+
+	width = nWidth;
+	height = nHeight;
+	format = nFormat;
+	frameRate = nFrameRate;
+	frameSize = (size_t)width*height*getBytesPerPixel(format);
+
+	headerSize = nHeaderSize;
+	frameStride = frameSize;
+	numFrames = fileSize>headerSize ? (unsigned int)((fileSize-headerSize)/frameStride) : 0;
+
+	allocBuffers();
+	return true;
+}
+
+
+bool
+FrameSourceFile::openY4M(const char* nFileName)
+{
+	if(!openFile(nFileName))
+		return false;
+
+	char header[Y4M_MAX_HEADER+1];
+	size_t headerLen = fileSize<Y4M_MAX_HEADER ? (size_t)fileSize : Y4M_MAX_HEADER;
+
+	if(!readAt(0, header, headerLen) || headerLen<10 || strncmp(header, "YUV4MPEG2 ", 10)!=0)
+	{
+		close();
+		return false;
+	}
+	header[headerLen] = 0;
+
+	char* end = strchr(header, '\n');
+	if(!end)
+	{
+		close();
+		return false;
+	}
+	*end = 0;
+
+	// stream parameters: W<width> H<height> F<num>:<den> C<chroma>, the others are not needed
+	//
+	int w = 0, h = 0, rateNum = 30, rateDen = 1;
+	const char* chroma = "420";
+
+	for(char* tok=strtok(header+10, " "); tok; tok=strtok(NULL, " "))
+		switch(tok[0])
+		{
+		case 'W':  w = atoi(tok+1);  break;
+		case 'H':  h = atoi(tok+1);  break;
+		case 'F':  sscanf(tok+1, "%d:%d", &rateNum, &rateDen);  break;
+		case 'C':  chroma = tok+1;  break;
+		}
+
+	if(w<=0 || h<=0)
+	{
+		close();
+		return false;
+	}
+
+	FileOffset lumSize = (FileOffset)w*h, cw = (w+1)/2, ch = (h+1)/2, chromaSize;
+
+	if(strncmp(chroma, "mono", 4)==0)
+		chromaSize = 0;
+	else if(strncmp(chroma, "444alpha", 8)==0)
+		chromaSize = 3*lumSize;
+	else if(strncmp(chroma, "444", 3)==0)
+		chromaSize = 2*lumSize;
+	else if(strncmp(chroma, "422", 3)==0)
+		chromaSize = 2*cw*h;
+	else if(strncmp(chroma, "411", 3)==0)
+		chromaSize = 2*((w+3)/4)*h;
+	else
+		chromaSize = 2*cw*ch;
+
+	width = w;
+	height = h;
+	format = PIXEL_FORMAT_LUM;
+	frameRate = rateDen>0 ? (double)rateNum/rateDen : 0.0;
+	frameSize = (size_t)lumSize;
+	headerSize = (FileOffset)(end-header)+1;
+
+	// usually every frame header is just "FRAME\n": then the frames are equally spaced.
+	// otherwise the frames are looked up one by one.
+	//
+	char frameHeader[Y4M_MAX_HEADER];
+	FileOffset pos = headerSize;
+
+	if(readAt(pos, frameHeader, 6) && memcmp(frameHeader, "FRAME\n", 6)==0 &&
+	   (fileSize-headerSize)%(6+lumSize+chromaSize)==0)
+	{
+		frameStride = 6+lumSize+chromaSize;
+		numFrames = (unsigned int)((fileSize-headerSize)/frameStride);
+		headerSize += 6;
+	}
+	else
+	{
+		frameStride = 0;
+
+		while(pos<fileSize)
+		{
+			size_t len = fileSize-pos<Y4M_MAX_HEADER ? (size_t)(fileSize-pos) : Y4M_MAX_HEADER;
+
+			if(!readAt(pos, frameHeader, len) || len<6 || memcmp(frameHeader, "FRAME", 5)!=0)
+				break;
+
+			char* lineEnd = (char*)memchr(frameHeader, '\n', len);
+			if(!lineEnd)
+				break;
+
+			FileOffset data = pos + (lineEnd-frameHeader) + 1;
+			if(data+lumSize+chromaSize>fileSize)
+				break;
+
+			frameOffsets.push_back(data);
+			pos = data+lumSize+chromaSize;
+		}
+
+		numFrames = (unsigned int)frameOffsets.size();
+	}
+
+	allocBuffers();
+	return true;
+}
+
+
+unsigned int
+FrameSourceFile::getNumFrames() const
+{
+	return numFrames;
+}
+
+
+FrameSourceFile::FileOffset
+FrameSourceFile::getFrameOffset(unsigned int nFrame) const
+{
+	return frameOffsets.empty() ? headerSize + nFrame*frameStride : frameOffsets[nFrame];
+}
+
+
+bool
+FrameSourceFile::seek(unsigned int nFrame)
+{
+	if(!isOpen() || nFrame>=numFrames)
+		return false;
+
+	nextFrame = nFrame;
+	endOfStream = false;
+	prefetch(nextFrame);
+	return true;
+}
+
+
+// asks the kernel to read the frames that will be acquired next in the background
+//
+void
+FrameSourceFile::prefetch(unsigned int nFrame)
+{
+#ifdef FRAMESOURCE_USE_MMAP
+	if(!mapping || nFrame>=numFrames)
+		return;
+
+	unsigned int last = nFrame+numBuffers-1 < numFrames ? nFrame+numBuffers-1 : numFrames-1;
+	size_t pageSize = (size_t)sysconf(_SC_PAGESIZE),
+		   begin = (size_t)getFrameOffset(nFrame) & ~(pageSize-1),
+		   end = (size_t)getFrameOffset(last) + frameSize;
+
+	madvise(mapping+begin, end-begin, MADV_WILLNEED);
+#endif
+}
+
+
+const FrameSource::Frame*
+FrameSourceFile::acquire(bool nWait)
+{
+	if(!isOpen() || endOfStream)
+		return NULL;
+
+	Buffer* buffer = NULL;
+
+	for(size_t i=0; i<buffers.size() && !buffer; i++)
+		if(!buffers[i].leased)
+			buffer = &buffers[i];
+
+	if(!buffer)
+		return NULL;
+
+	if(nextFrame>=numFrames)
+	{
+		if(!loop || numFrames==0)
+		{
+			endOfStream = true;
+			return NULL;
+		}
+		nextFrame = 0;
+	}
+
+	double timestamp = frameRate>0.0 ? numDelivered*1000.0/frameRate : 0.0;
+
+	if(numDelivered==0)
+		startTime = getMilliseconds();
+	else if(realTime)
+	{
+		double wait = startTime+timestamp - getMilliseconds();
+
+		if(wait>0.0)
+		{
+			if(!nWait)
+				return NULL;
+			sleepMilliseconds(wait);
+		}
+	}
+
+	buffer->offset = getFrameOffset(nextFrame);
+
+	if(mapping)
+		buffer->frame.data = mapping+buffer->offset;
+	else if(!readAt(buffer->offset, buffer->memory, frameSize))
+	{
+		endOfStream = true;
+		return NULL;
+	}
+
+	buffer->frame.frameId = numDelivered++;
+	buffer->frame.timestamp = timestamp;
+	buffer->leased = true;
+
+	prefetch(++nextFrame);
+
+	return &buffer->frame;
+}
+
+
+void
+FrameSourceFile::release(const Frame* nFrame)
+{
+	for(size_t i=0; i<buffers.size(); i++)
+	{
+		Buffer& buffer = buffers[i];
+
+		if(&buffer.frame!=nFrame || !buffer.leased)
+			continue;
+
+		buffer.leased = false;
+
+#ifdef FRAMESOURCE_USE_MMAP
+		// drop the pages that only belong to this frame, they are read again if needed
+		if(mapping)
+		{
+			size_t pageSize = (size_t)sysconf(_SC_PAGESIZE),
+				   begin = ((size_t)buffer.offset + pageSize-1) & ~(pageSize-1),
+				   end = ((size_t)buffer.offset + frameSize) & ~(pageSize-1);
+
+			if(end>begin)
+				madvise(mapping+begin, end-begin, MADV_DONTNEED);
+		}
+#endif
+		return;
+	}
+}
+
+
+}  // namespace ARToolKitPlus
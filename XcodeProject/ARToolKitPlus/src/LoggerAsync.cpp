@@ -0,0 +1,840 @@
+/* ========================================================================
+* PROJECT: ARToolKitPlus
+* ========================================================================
+* This work is based on the original ARToolKit developed by
+*   Hirokazu Kato
+*   Mark Billinghurst
+*   HITLab, University of Washington, Seattle
+* http://www.hitl.washington.edu/artoolkit/
+*
+* Copyright of the derived and new portions of this work
+*     (C) 2006 Graz University of Technology
+*
+* This framework is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 2 of the License, or
+* (at your option) any later version.
+*
+* This framework is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this framework; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+* For further information please contact 
+*   Dieter Schmalstieg
+*   <schmalstieg@icg.tu-graz.ac.at>
+*   Graz University of Technology, 
+*   Institut for Computer Graphics and Vision,
+*   Inffeldgasse 16a, 8010 Graz, Austria.
+* ========================================================================
+** @author   Daniel Wagner
+*
+* $Id$
+* @file
+* ======================================================================== */
+
+
+#include <ARToolKitPlus/LoggerAsync.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+#if !defined(_MSC_VER) && !defined(_WIN32_WCE)
+#  include <sys/time.h>
+#  define LOGGERASYNC_USE_THREADS
+#endif
+
+
+namespace ARToolKitPlus
+{
+
+
+#ifdef LOGGERASYNC_USE_THREADS
+
+enum {
+	MAX_RECORD_SIZE = 1024,			// a record never gets larger, long strings are cut
+	MAX_STRING_SIZE = 256,
+	MAX_MESSAGE_SIZE = 1024,
+	RATE_TABLE_SIZE = 16,
+	POLL_INTERVAL_MS = 5
+};
+
+
+enum ARG_TYPE {
+	ARG_NONE,			// "%%" or the end of the format string
+	ARG_INT,
+	ARG_LONG,
+	ARG_LLONG,
+	ARG_SIZE,
+	ARG_PTRDIFF,
+	ARG_DOUBLE,
+	ARG_LDOUBLE,
+	ARG_STRING,
+	ARG_POINTER,
+	ARG_COUNT			// %n, not written
+};
+
+
+// one conversion of a format string: text before it, the conversion itself
+// (begin..end) and the arguments it takes ('*' widths come first)
+//
+struct FormatSpec {
+	const char*		begin;
+	const char*		end;
+	int				numStars;
+	ARG_TYPE		type;
+};
+
+
+// head of each record in a ring, followed by the arguments
+//
+struct RecordHeader {
+	unsigned int	size;			// including the header, a multiple of 8
+	unsigned int	suppressed,		// messages of this rate key held back by the rate limit before
+					dropped,		// messages of this thread lost because the ring was full
+					pad;
+	const char*		format;
+};
+
+
+struct RateEntry {
+	const void*		key;			// format string, or the string passed to artLog()
+	double			windowStart;
+	int				count;
+	unsigned int	suppressed;
+};
+
+
+struct LoggerAsync::Ring {
+	char*					data;
+	unsigned int			size;			// power of two
+	volatile unsigned int	head, tail;		// bytes written by the owning thread, read by the formatting thread
+	volatile unsigned int	closed,			// the owning thread exited
+							dropped;		// messages lost since the last recorded one
+	RateEntry				rates[RATE_TABLE_SIZE];
+	bool					finished;		// closed and drained, only used by the formatting thread
+	Ring*					next;
+};
+
+
+// the ring counters are shared by exactly one writer and one reader,
+// everything written before a counter was advanced is visible with it
+//
+static inline unsigned int
+loadAcquire(volatile const unsigned int& nValue)
+{
+#if defined(__ATOMIC_ACQUIRE)
+	return __atomic_load_n(&nValue, __ATOMIC_ACQUIRE);
+#else
+	return __sync_fetch_and_add(const_cast<volatile unsigned int*>(&nValue), 0);
+#endif
+}
+
+
+static inline void
+storeRelease(volatile unsigned int& nValue, unsigned int nNewValue)
+{
+#if defined(__ATOMIC_RELEASE)
+	__atomic_store_n(&nValue, nNewValue, __ATOMIC_RELEASE);
+#else
+	__sync_synchronize();
+	nValue = nNewValue;
+#endif
+}
+
+
+static double
+getMilliseconds()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec*1000.0 + tv.tv_usec/1000.0;
+}
+
+
+// finds the next conversion in nFormat, returns false at the end of the string
+//
+static bool
+nextFormatSpec(const char*& nFormat, FormatSpec& nSpec)
+{
+	const char* p = nFormat;
+
+	while(*p && *p!='%')
+		p++;
+
+	nSpec.begin = p;
+	nSpec.numStars = 0;
+	nSpec.type = ARG_NONE;
+
+	if(*p==0)
+	{
+		nSpec.end = nFormat = p;
+		return false;
+	}
+
+	p++;
+	while(*p && strchr("-+ #0", *p))
+		p++;
+
+	if(*p=='*')
+		nSpec.numStars++, p++;
+	else while(*p>='0' && *p<='9')
+		p++;
+
+	if(*p=='.')
+	{
+		p++;
+		if(*p=='*')
+			nSpec.numStars++, p++;
+		else while(*p>='0' && *p<='9')
+			p++;
+	}
+
+	int longs = 0;
+	bool isSize = false, isPtrdiff = false, isLongDouble = false;
+
+	for(;; p++)
+	{
+		if(*p=='l')				longs++;
+		else if(*p=='L')		isLongDouble = true;
+		else if(*p=='q' || *p=='j')	longs = 2;
+		else if(*p=='z')		isSize = true;
+		else if(*p=='t')		isPtrdiff = true;
+		else if(*p!='h')		break;
+	}
+
+	switch(*p)
+	{
+	case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+		nSpec.type = isSize ? ARG_SIZE : isPtrdiff ? ARG_PTRDIFF : longs>=2 ? ARG_LLONG : longs==1 ? ARG_LONG : ARG_INT;
+		break;
+	case 'c':
+		nSpec.type = ARG_INT;
+		break;
+	case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+		nSpec.type = isLongDouble ? ARG_LDOUBLE : ARG_DOUBLE;
+		break;
+	case 's':
+		nSpec.type = longs ? ARG_POINTER : ARG_STRING;
+		break;
+	case 'p':
+		nSpec.type = ARG_POINTER;
+		break;
+	case 'n':
+		nSpec.type = ARG_COUNT;
+		break;
+	case 0:
+		nSpec.end = nFormat = p;
+		return true;
+	default:		// "%%" and unknown conversions are copied as they are
+		break;
+	}
+
+	nSpec.end = nFormat = p+1;
+	return true;
+}
+
+
+// appends nSize bytes to a record under construction, 8 byte aligned
+//
+static inline bool
+appendArg(char* nRecord, unsigned int& nSize, const void* nData, unsigned int nDataSize)
+{
+	unsigned int alignedSize = (nDataSize+7) & ~7u;
+	if(nSize+alignedSize>MAX_RECORD_SIZE)
+		return false;
+
+	memcpy(nRecord+nSize, nData, nDataSize);
+	nSize += alignedSize;
+	return true;
+}
+
+
+template<typename T> static inline T
+readArg(const char*& nArgs)
+{
+	T value;
+	memcpy(&value, nArgs, sizeof(T));
+	nArgs += (sizeof(T)+7) & ~7u;
+	return value;
+}
+
+
+// formats one conversion; nSpec holds the conversion only
+//
+template<typename T> static inline int
+formatValue(char* nDst, size_t nDstSize, const char* nSpec, int nNumStars, const int nStars[2], T nValue)
+{
+	switch(nNumStars)
+	{
+	case 0:
+		return snprintf(nDst, nDstSize, nSpec, nValue);
+	case 1:
+		return snprintf(nDst, nDstSize, nSpec, nStars[0], nValue);
+	default:
+		return snprintf(nDst, nDstSize, nSpec, nStars[0], nStars[1], nValue);
+	}
+}
+
+#endif //LOGGERASYNC_USE_THREADS
+
+
+
+LoggerAsync::LoggerAsync(Logger* nTarget, int nRingSize, int nMaxPerSecond)
+{
+	target = nTarget;
+	maxPerSecond = nMaxPerSecond;
+
+	// a ring has to hold at least a few of the largest records
+	ringSize = 4096;
+	while(ringSize<nRingSize)
+		ringSize *= 2;
+
+#ifdef LOGGERASYNC_USE_THREADS
+	rings = NULL;
+	flushRequests = flushesDone = 0;
+	quit = false;
+
+	pthread_key_create(&ringKey, releaseRing);
+	pthread_mutex_init(&mutex, NULL);
+	pthread_cond_init(&wakeup, NULL);
+	pthread_cond_init(&flushed, NULL);
+
+	running = pthread_create(&thread, NULL, threadMain, this)==0;
+#endif
+}
+
+
+LoggerAsync::~LoggerAsync()
+{
+#ifdef LOGGERASYNC_USE_THREADS
+	if(running)
+	{
+		pthread_mutex_lock(&mutex);
+		quit = true;
+		pthread_cond_signal(&wakeup);
+		pthread_mutex_unlock(&mutex);
+		pthread_join(thread, NULL);
+	}
+
+	// exiting threads must not touch their rings anymore
+	pthread_key_delete(ringKey);
+
+	drain(true);
+
+	while(rings)
+	{
+		Ring* next = rings->next;
+		delete [] rings->data;
+		delete rings;
+		rings = next;
+	}
+
+	pthread_cond_destroy(&flushed);
+	pthread_cond_destroy(&wakeup);
+	pthread_mutex_destroy(&mutex);
+#endif
+}
+
+
+// all artLog() messages have the format "%s": they are rate limited by their string
+//
+void
+LoggerAsync::artLog(const char* nStr)
+{
+	recordEx(nStr, "%s", nStr);
+}
+
+
+void
+LoggerAsync::artLogEx(const char* nStr, ...)
+{
+	va_list args;
+
+	va_start(args, nStr);
+	record(nStr, nStr, args);
+	va_end(args);
+}
+
+
+void
+LoggerAsync::recordEx(const void* nRateKey, const char* nFormat, ...)
+{
+	va_list args;
+
+	va_start(args, nFormat);
+	record(nRateKey, nFormat, args);
+	va_end(args);
+}
+
+
+#ifndef LOGGERASYNC_USE_THREADS
+
+
+void
+LoggerAsync::record(const void*, const char* nFormat, va_list nArgs)
+{
+	char message[1024];
+
+	_vsnprintf(message, sizeof(message)-1, nFormat, nArgs);
+	message[sizeof(message)-1] = 0;
+
+	if(target)
+		target->artLog(message);
+}
+
+
+void
+LoggerAsync::flush()
+{
+}
+
+
+#else //LOGGERASYNC_USE_THREADS
+
+
+// returns the calling thread's ring, creating it on the first call
+//
+LoggerAsync::Ring*
+LoggerAsync::getRing()
+{
+	Ring* ring = (Ring*)pthread_getspecific(ringKey);
+	if(ring)
+		return ring;
+
+	ring = new Ring;
+	ring->data = new char[ringSize];
+	ring->size = ringSize;
+	ring->head = ring->tail = 0;
+	ring->closed = 0;
+	ring->dropped = 0;
+	ring->finished = false;
+	memset(ring->rates, 0, sizeof(ring->rates));
+
+	pthread_mutex_lock(&mutex);
+	ring->next = rings;
+	rings = ring;
+	pthread_mutex_unlock(&mutex);
+
+	pthread_setspecific(ringKey, ring);
+	return ring;
+}
+
+
+// called when a thread that has logged exits; the formatting thread
+// frees the ring as soon as it is empty
+//
+void
+LoggerAsync::releaseRing(void* nRing)
+{
+	storeRelease(((Ring*)nRing)->closed, 1);
+}
+
+
+void
+LoggerAsync::record(const void* nRateKey, const char* nFormat, va_list nArgs)
+{
+	if(!running)
+	{
+		char message[MAX_MESSAGE_SIZE];
+		vsnprintf(message, sizeof(message), nFormat, nArgs);
+		if(target)
+			target->artLog(message);
+		return;
+	}
+
+	Ring* ring = getRing();
+
+	// rate limit per format string (per string for artLog())
+	RateEntry& rate = ring->rates[((size_t)nRateKey/sizeof(void*)) % RATE_TABLE_SIZE];
+
+	if(maxPerSecond>0)
+	{
+		double now = getMilliseconds();
+
+		if(rate.key!=nRateKey)
+		{
+			rate.key = nRateKey;
+			rate.windowStart = now;
+			rate.count = 0;
+			rate.suppressed = 0;
+		}
+		else if(now-rate.windowStart>=1000.0)
+		{
+			rate.windowStart = now;
+			rate.count = 0;
+		}
+
+		if(rate.count>=maxPerSecond)
+		{
+			rate.suppressed++;
+			return;
+		}
+		rate.count++;
+	}
+
+	// build the record: header, then the raw arguments in the order of the format string
+	char recordData[MAX_RECORD_SIZE];
+	RecordHeader* header = (RecordHeader*)recordData;
+	unsigned int size = sizeof(RecordHeader);
+	const char* format = nFormat;
+	FormatSpec spec;
+	bool complete = true;
+
+	while(complete && nextFormatSpec(format, spec))
+	{
+		for(int i=0; i<spec.numStars; i++)
+		{
+			int star = va_arg(nArgs, int);
+			complete = appendArg(recordData, size, &star, sizeof(star));
+		}
+
+		long long intValue = 0;
+		double doubleValue;
+		long double longDoubleValue;
+		const void* pointerValue;
+
+		switch(spec.type)
+		{
+		case ARG_INT:		intValue = va_arg(nArgs, int);  break;
+		case ARG_LONG:		intValue = va_arg(nArgs, long);  break;
+		case ARG_LLONG:		intValue = va_arg(nArgs, long long);  break;
+		case ARG_SIZE:		intValue = (long long)va_arg(nArgs, size_t);  break;
+		case ARG_PTRDIFF:	intValue = va_arg(nArgs, ptrdiff_t);  break;
+		default:			break;
+		}
+
+		switch(spec.type)
+		{
+		case ARG_INT:
+		case ARG_LONG:
+		case ARG_LLONG:
+		case ARG_SIZE:
+		case ARG_PTRDIFF:
+			complete = complete && appendArg(recordData, size, &intValue, sizeof(intValue));
+			break;
+
+		case ARG_DOUBLE:
+			doubleValue = va_arg(nArgs, double);
+			complete = complete && appendArg(recordData, size, &doubleValue, sizeof(doubleValue));
+			break;
+
+		case ARG_LDOUBLE:
+			longDoubleValue = va_arg(nArgs, long double);
+			complete = complete && appendArg(recordData, size, &longDoubleValue, sizeof(longDoubleValue));
+			break;
+
+		case ARG_POINTER:
+		case ARG_COUNT:
+			pointerValue = va_arg(nArgs, const void*);
+			complete = complete && appendArg(recordData, size, &pointerValue, sizeof(pointerValue));
+			break;
+
+		case ARG_STRING:
+			{
+				const char* str = va_arg(nArgs, const char*);
+				if(!str)
+					str = "(null)";
+
+				// length, then the characters including a terminating zero
+				unsigned int len = (unsigned int)strlen(str);
+				if(len>MAX_STRING_SIZE)
+					len = MAX_STRING_SIZE;
+				if(size+8+len+1>MAX_RECORD_SIZE)
+				{
+					complete = false;
+					break;
+				}
+
+				appendArg(recordData, size, &len, sizeof(len));
+				memcpy(recordData+size, str, len);
+				recordData[size+len] = 0;
+				size += (len+8) & ~7u;
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	// too many arguments: the message is lost, the formatter must not read past the record
+	if(!complete)
+		return;
+
+	header->size = size;
+	header->suppressed = maxPerSecond>0 ? rate.suppressed : 0;
+	header->dropped = ring->dropped;
+	header->pad = 0;
+	header->format = nFormat;
+
+	// copy the record into the ring, it might wrap around
+	unsigned int head = ring->head, tail = loadAcquire(ring->tail);
+	if(ring->size-(head-tail)<size)
+	{
+		storeRelease(ring->dropped, ring->dropped+1);
+		return;
+	}
+
+	unsigned int pos = head & (ring->size-1), first = ring->size-pos;
+	if(first>=size)
+		memcpy(ring->data+pos, recordData, size);
+	else
+	{
+		memcpy(ring->data+pos, recordData, first);
+		memcpy(ring->data, recordData+first, size-first);
+	}
+
+	storeRelease(ring->head, head+size);
+
+	// don't wait for the next poll if a burst fills the ring; the only system call made here
+	if(head-tail<ring->size/2 && head+size-tail>=ring->size/2)
+		pthread_cond_signal(&wakeup);
+
+	ring->dropped = 0;
+	if(maxPerSecond>0)
+		rate.suppressed = 0;
+}
+
+
+// formats a record and passes it to the target
+//
+void
+LoggerAsync::format(const char* nRecord)
+{
+	const RecordHeader* header = (const RecordHeader*)nRecord;
+	const char* args = nRecord+sizeof(RecordHeader);
+	const char* fmt = header->format;
+	char message[MAX_MESSAGE_SIZE];
+	size_t len = 0;
+	FormatSpec spec;
+
+	if(header->dropped && target)
+	{
+		snprintf(message, sizeof(message), "ARToolKitPlus: %u log messages lost", header->dropped);
+		target->artLog(message);
+	}
+
+	message[0] = 0;
+
+	for(bool more=true; more && len<sizeof(message)-1; )
+	{
+		const char* textBegin = fmt;
+		more = nextFormatSpec(fmt, spec);
+
+		// text up to the conversion
+		size_t textLen = spec.begin-textBegin;
+		if(textLen>sizeof(message)-1-len)
+			textLen = sizeof(message)-1-len;
+		memcpy(message+len, textBegin, textLen);
+		len += textLen;
+		message[len] = 0;
+
+		if(!more)
+			break;
+
+		char conversion[64];
+		size_t specLen = spec.end-spec.begin;
+		if(specLen>=sizeof(conversion))
+			specLen = sizeof(conversion)-1;
+		memcpy(conversion, spec.begin, specLen);
+		conversion[specLen] = 0;
+
+		int stars[2] = { 0, 0 };
+		for(int i=0; i<spec.numStars; i++)
+			stars[i] = readArg<int>(args);
+
+		char* dst = message+len;
+		size_t dstSize = sizeof(message)-len;
+		int n = 0;
+
+		switch(spec.type)
+		{
+		case ARG_INT:		n = formatValue(dst, dstSize, conversion, spec.numStars, stars, (int)readArg<long long>(args));  break;
+		case ARG_LONG:		n = formatValue(dst, dstSize, conversion, spec.numStars, stars, (long)readArg<long long>(args));  break;
+		case ARG_LLONG:		n = formatValue(dst, dstSize, conversion, spec.numStars, stars, readArg<long long>(args));  break;
+		case ARG_SIZE:		n = formatValue(dst, dstSize, conversion, spec.numStars, stars, (size_t)readArg<long long>(args));  break;
+		case ARG_PTRDIFF:	n = formatValue(dst, dstSize, conversion, spec.numStars, stars, (ptrdiff_t)readArg<long long>(args));  break;
+		case ARG_DOUBLE:	n = formatValue(dst, dstSize, conversion, spec.numStars, stars, readArg<double>(args));  break;
+		case ARG_LDOUBLE:	n = formatValue(dst, dstSize, conversion, spec.numStars, stars, readArg<long double>(args));  break;
+		case ARG_POINTER:	n = formatValue(dst, dstSize, "%p", 0, stars, readArg<const void*>(args));  break;
+		case ARG_COUNT:		readArg<const void*>(args);  break;
+		case ARG_STRING:
+			{
+				unsigned int strLen = readArg<unsigned int>(args);
+				n = formatValue(dst, dstSize, conversion, spec.numStars, stars, (const char*)args);
+				args += (strLen+8) & ~7u;
+			}
+			break;
+		default:
+			// "%%" prints a single '%', anything else is copied
+			n = spec.end-spec.begin==2 && spec.begin[1]=='%' ? snprintf(dst, dstSize, "%%") : snprintf(dst, dstSize, "%s", conversion);
+			break;
+		}
+
+		if(n>0)
+			len = len+n<sizeof(message) ? len+n : sizeof(message)-1;
+	}
+
+	if(header->suppressed)
+		snprintf(message+len, sizeof(message)-len, " (%u similar messages suppressed)", header->suppressed);
+
+	if(target)
+		target->artLog(message);
+}
+
+
+// formats all recorded messages; returns true if there were any. messages
+// lost by threads that exited (or all threads with nFinal) are reported.
+// the target is called without holding the mutex: getRing() only adds rings
+// at the front of the list, everything behind it is only changed here.
+//
+bool
+LoggerAsync::drain(bool nFinal)
+{
+	bool found = false, finished = false;
+	char recordData[MAX_RECORD_SIZE];
+
+	pthread_mutex_lock(&mutex);
+	Ring* first = rings;
+	pthread_mutex_unlock(&mutex);
+
+	for(Ring* ring=first; ring; ring=ring->next)
+	{
+		bool closed = loadAcquire(ring->closed)!=0;
+		unsigned int tail = ring->tail, head = loadAcquire(ring->head);
+
+		while(tail!=head)
+		{
+			unsigned int pos = tail & (ring->size-1), first = ring->size-pos;
+			RecordHeader header;
+
+			if(first>=sizeof(header))
+				memcpy(&header, ring->data+pos, sizeof(header));
+			else
+			{
+				memcpy(&header, ring->data+pos, first);
+				memcpy((char*)&header+first, ring->data, sizeof(header)-first);
+			}
+
+			if(first>=header.size)
+				memcpy(recordData, ring->data+pos, header.size);
+			else
+			{
+				memcpy(recordData, ring->data+pos, first);
+				memcpy(recordData+first, ring->data, header.size-first);
+			}
+
+			format(recordData);
+
+			tail += header.size;
+			storeRelease(ring->tail, tail);
+			found = true;
+		}
+
+		unsigned int dropped = (closed || nFinal) ? loadAcquire(ring->dropped) : 0;
+		if(dropped && target)
+		{
+			snprintf(recordData, sizeof(recordData), "ARToolKitPlus: %u log messages lost", dropped);
+			target->artLog(recordData);
+		}
+
+		// the thread is gone and everything it logged is done
+		if(closed)
+			ring->finished = finished = true;
+	}
+
+	if(finished)
+	{
+		pthread_mutex_lock(&mutex);
+		for(Ring** link=&rings; *link; )
+		{
+			Ring* ring = *link;
+			if(ring->finished)
+			{
+				*link = ring->next;
+				delete [] ring->data;
+				delete ring;
+			}
+			else
+				link = &ring->next;
+		}
+		pthread_mutex_unlock(&mutex);
+	}
+
+	return found;
+}
+
+
+void*
+LoggerAsync::threadMain(void* nLogger)
+{
+	LoggerAsync* logger = (LoggerAsync*)nLogger;
+
+	pthread_mutex_lock(&logger->mutex);
+
+	for(;;)
+	{
+		unsigned int requests = logger->flushRequests;
+		bool quit = logger->quit;
+
+		// a slow target must not hold up flush() or threads that log their first message
+		pthread_mutex_unlock(&logger->mutex);
+		logger->drain();
+		pthread_mutex_lock(&logger->mutex);
+
+		if(requests!=logger->flushesDone)
+		{
+			logger->flushesDone = requests;
+			pthread_cond_broadcast(&logger->flushed);
+		}
+
+		if(quit)
+			break;
+
+		// logging threads only signal when a ring gets half full, other messages are picked up on the next round
+		struct timeval now;
+		struct timespec timeout;
+		gettimeofday(&now, NULL);
+		timeout.tv_sec = now.tv_sec;
+		timeout.tv_nsec = (now.tv_usec+POLL_INTERVAL_MS*1000)*1000;
+		if(timeout.tv_nsec>=1000000000)
+		{
+			timeout.tv_sec++;
+			timeout.tv_nsec -= 1000000000;
+		}
+
+		if(logger->flushRequests==logger->flushesDone && !logger->quit)
+			pthread_cond_timedwait(&logger->wakeup, &logger->mutex, &timeout);
+	}
+
+	pthread_mutex_unlock(&logger->mutex);
+	return NULL;
+}
+
+
+void
+LoggerAsync::flush()
+{
+	if(!running)
+		return;
+
+	pthread_mutex_lock(&mutex);
+
+	unsigned int request = ++flushRequests;
+	pthread_cond_signal(&wakeup);
+
+	while((int)(flushesDone-request)<0)
+		pthread_cond_wait(&flushed, &mutex);
+
+	pthread_mutex_unlock(&mutex);
+}
+
+
+#endif //LOGGERASYNC_USE_THREADS
+
+
+}  // namespace ARToolKitPlus
@@ -0,0 +1,313 @@
+/* ========================================================================
+* PROJECT: ARToolKitPlus
+* ========================================================================
+* This work is based on the original ARToolKit developed by
+*   Hirokazu Kato
+*   Mark Billinghurst
+*   HITLab, University of Washington, Seattle
+* http://www.hitl.washington.edu/artoolkit/
+*
+* Copyright of the derived and new portions of this work
+*     (C) 2006 Graz University of Technology
+*
+* This framework is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 2 of the License, or
+* (at your option) any later version.
+*
+* This framework is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this framework; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+* For further information please contact 
+*   Dieter Schmalstieg
+*   <schmalstieg@icg.tu-graz.ac.at>
+*   Graz University of Technology, 
+*   Institut for Computer Graphics and Vision,
+*   Inffeldgasse 16a, 8010 Graz, Austria.
+* ========================================================================
+** @author   Daniel Wagner
+*
+* $Id$
+* @file
+* ======================================================================== */
+
+
+#include <ARToolKitPlus/MemoryManagerArena.h>
+#include <stdlib.h>
+
+#if !defined(_MSC_VER) && !defined(_WIN32_WCE)
+#  include <sys/mman.h>
+#  define ARENA_USE_MMAP
+#  if defined(MAP_HUGETLB)
+#    define ARENA_USE_HUGETLB
+#  endif
+#endif
+
+
+namespace ARToolKitPlus
+{
+
+
+// all memory handed out is aligned for SIMD loads
+#define ARENA_ALIGNMENT			16
+#define ARENA_ALIGN(x)			(((x) + (ARENA_ALIGNMENT-1)) & ~(size_t)(ARENA_ALIGNMENT-1))
+#define ARENA_HEADER_SIZE		ARENA_ALIGN(sizeof(Block))
+#define ARENA_PAGE_SIZE			4096
+#define ARENA_HUGE_PAGE_SIZE	(2*1024*1024)
+
+
+MemoryManagerArena::MemoryManagerArena()
+{
+	_didInit = false;
+	useHugePages = usesHugePages = false;
+
+	first = current = NULL;
+	numBlocks = 0;
+
+	fullSize = growSize = peakUsed = 0;
+}
+
+
+MemoryManagerArena::~MemoryManagerArena()
+{
+	deinit();
+}
+
+
+bool
+MemoryManagerArena::init(size_t nNumInitialBytes, size_t nNumGrowBytes)
+{
+	if(_didInit)
+		return false;
+
+	growSize = nNumGrowBytes;
+	first = current = mapBlock(nNumInitialBytes);
+
+	_didInit = first!=NULL;
+	return _didInit;
+}
+
+
+bool
+MemoryManagerArena::deinit()
+{
+	if(!_didInit)
+		return false;
+
+	while(first)
+	{
+		Block* next = first->next;
+		unmapBlock(first);
+		first = next;
+	}
+
+	current = NULL;
+	usesHugePages = false;
+
+	_didInit = false;
+	return true;
+}
+
+
+bool
+MemoryManagerArena::didInit()
+{
+	return _didInit;
+}
+
+
+void*
+MemoryManagerArena::getMemory(size_t nNumBytes)
+{
+	if(!_didInit)
+		return NULL;
+
+	nNumBytes = ARENA_ALIGN(nNumBytes);
+
+	// blocks behind the current one are left over from before the last
+	// rewind() and can be reused before a new block has to be mapped
+	//
+	while(current->used+nNumBytes > current->size)
+	{
+		if(current->next)
+		{
+			current = current->next;
+			current->used = 0;
+			continue;
+		}
+
+		if(growSize==0)
+			return NULL;
+
+		Block* block = mapBlock(nNumBytes>growSize ? nNumBytes : growSize);
+		if(!block)
+			return NULL;
+
+		current->next = block;
+		current = block;
+	}
+
+	void* newBlock = reinterpret_cast<unsigned char*>(current) + ARENA_HEADER_SIZE + current->used;
+	current->used += nNumBytes;
+
+	size_t used = getBytesUsed();
+	if(used>peakUsed)
+		peakUsed = used;
+
+	return newBlock;
+}
+
+
+void
+MemoryManagerArena::releaseMemory(void* /*nMemoryBlock*/)
+{
+	// single blocks can not be released from an arena.
+	// see rewind(), reset() and deinit()
+}
+
+
+MemoryManagerArena::Mark
+MemoryManagerArena::getMark() const
+{
+	Mark mark;
+
+	mark.block = current;
+	mark.used = current ? current->used : 0;
+	return mark;
+}
+
+
+void
+MemoryManagerArena::rewind(const Mark& nMark)
+{
+	if(!_didInit || !nMark.block)
+		return;
+
+	current = reinterpret_cast<Block*>(nMark.block);
+	current->used = nMark.used;
+}
+
+
+void
+MemoryManagerArena::reset()
+{
+	if(!_didInit)
+		return;
+
+	// the arena had to grow: replace all blocks by a single one
+	// that is large enough for everything that was needed so far
+	//
+	if(first->next)
+	{
+		Block* block = mapBlock(fullSize);
+
+		if(block)
+		{
+			while(first)
+			{
+				Block* next = first->next;
+				unmapBlock(first);
+				first = next;
+			}
+
+			first = block;
+			usesHugePages = block->hugePages;
+		}
+	}
+
+	current = first;
+	current->used = 0;
+}
+
+
+size_t
+MemoryManagerArena::getBytesUsed() const
+{
+	size_t used = 0;
+
+	for(const Block* block=first; block; block=block->next)
+	{
+		if(block==current)
+			return used + block->used;
+		used += block->size;
+	}
+
+	return used;
+}
+
+
+MemoryManagerArena::Block*
+MemoryManagerArena::mapBlock(size_t nMinBytes)
+{
+	size_t mapSize = ARENA_HEADER_SIZE + ARENA_ALIGN(nMinBytes);
+	bool hugePages = false;
+	void* mem = NULL;
+
+#ifdef ARENA_USE_MMAP
+#  ifdef ARENA_USE_HUGETLB
+	if(useHugePages)
+	{
+		size_t hugeSize = (mapSize + ARENA_HUGE_PAGE_SIZE-1) & ~(size_t)(ARENA_HUGE_PAGE_SIZE-1);
+
+		mem = mmap(NULL, hugeSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB, -1, 0);
+		if(mem==MAP_FAILED)
+			mem = NULL;
+		else
+		{
+			mapSize = hugeSize;
+			hugePages = true;
+		}
+	}
+#  endif //ARENA_USE_HUGETLB
+
+	if(!mem)
+	{
+		mapSize = (mapSize + ARENA_PAGE_SIZE-1) & ~(size_t)(ARENA_PAGE_SIZE-1);
+
+		mem = mmap(NULL, mapSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+		if(mem==MAP_FAILED)
+			return NULL;
+	}
+#else
+	mem = malloc(mapSize);
+	if(!mem)
+		return NULL;
+#endif //ARENA_USE_MMAP
+
+	Block* block = reinterpret_cast<Block*>(mem);
+
+	block->next = NULL;
+	block->size = mapSize - ARENA_HEADER_SIZE;
+	block->mapSize = mapSize;
+	block->used = 0;
+	block->hugePages = hugePages;
+
+	fullSize += block->size;
+	numBlocks++;
+	usesHugePages |= hugePages;
+
+	return block;
+}
+
+
+void
+MemoryManagerArena::unmapBlock(Block* nBlock)
+{
+	fullSize -= nBlock->size;
+	numBlocks--;
+
+#ifdef ARENA_USE_MMAP
+	munmap(nBlock, nBlock->mapSize);
+#else
+	free(nBlock);
+#endif //ARENA_USE_MMAP
+}
+
+
+}  // namespace ARToolKitPlus
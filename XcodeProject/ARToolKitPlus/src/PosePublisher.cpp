@@ -0,0 +1,511 @@
+/* ========================================================================
+* PROJECT: ARToolKitPlus
+* ========================================================================
+* This work is based on the original ARToolKit developed by
+*   Hirokazu Kato
+*   Mark Billinghurst
+*   HITLab, University of Washington, Seattle
+* http://www.hitl.washington.edu/artoolkit/
+*
+* Copyright of the derived and new portions of this work
+*     (C) 2006 Graz University of Technology
+*
+* This framework is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 2 of the License, or
+* (at your option) any later version.
+*
+* This framework is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this framework; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+* For further information please contact 
+*   Dieter Schmalstieg
+*   <schmalstieg@icg.tu-graz.ac.at>
+*   Graz University of Technology, 
+*   Institut for Computer Graphics and Vision,
+*   Inffeldgasse 16a, 8010 Graz, Austria.
+* ========================================================================
+** @author   Daniel Wagner
+*
+* $Id$
+* @file
+* ======================================================================== */
+
+
+#include <ARToolKitPlus/PosePublisher.h>
+#include <string.h>
+#include <stdlib.h>
+
+#if !defined(_MSC_VER) && !defined(_WIN32_WCE)
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <sys/time.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#  define POSEPUBLISHER_USE_SHM
+#endif
+
+
+namespace ARToolKitPlus
+{
+
+
+enum {
+	PUBLISH_MAGIC = 0x50534b41,			// "AKSP"
+	PUBLISH_VERSION = 1,
+	PUBLISH_MAX_RETRIES = 64
+};
+
+
+struct PosePublisher::Header {
+	unsigned int			magic, version,
+							frameSize,		// sizeof(PublishedFrame), catches readers built with another layout
+							numSlots;
+	volatile unsigned int	numPublished;
+};
+
+struct PosePublisher::Slot {
+	volatile unsigned int	lock;			// odd while the slot is written
+	PublishedFrame			frame;
+};
+
+
+// the publisher and the subscribers run in different processes, so only
+// the atomic builtins (no locks) can be used to order the accesses
+//
+static inline unsigned int
+loadAcquire(volatile const unsigned int& nValue)
+{
+#if defined(__ATOMIC_ACQUIRE)
+	return __atomic_load_n(&nValue, __ATOMIC_ACQUIRE);
+#elif defined(POSEPUBLISHER_USE_SHM)
+	return __sync_fetch_and_add(const_cast<volatile unsigned int*>(&nValue), 0);
+#else
+	return nValue;
+#endif
+}
+
+
+static inline void
+storeRelease(volatile unsigned int& nValue, unsigned int nNewValue)
+{
+#if defined(__ATOMIC_RELEASE)
+	__atomic_store_n(&nValue, nNewValue, __ATOMIC_RELEASE);
+#elif defined(POSEPUBLISHER_USE_SHM)
+	__sync_synchronize();
+	nValue = nNewValue;
+#else
+	nValue = nNewValue;
+#endif
+}
+
+
+// keeps the slot's data accesses after the preceding lock store (writer)
+// or before the following lock load (reader)
+//
+static inline void
+fenceRelease()
+{
+#if defined(__ATOMIC_RELEASE)
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+#elif defined(POSEPUBLISHER_USE_SHM)
+	__sync_synchronize();
+#endif
+}
+
+
+static inline void
+fenceAcquire()
+{
+#if defined(__ATOMIC_ACQUIRE)
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+#elif defined(POSEPUBLISHER_USE_SHM)
+	__sync_synchronize();
+#endif
+}
+
+
+static double
+getPublishTime()
+{
+#ifdef POSEPUBLISHER_USE_SHM
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec*1000.0 + tv.tv_usec/1000.0;
+#else
+	return 0.0;
+#endif
+}
+
+
+static void
+copyMarker(PublishedMarker& nDst, const ARMarkerInfo& nSrc)
+{
+	nDst.id = nSrc.id;
+	nDst.cf = (float)nSrc.cf;
+	for(int i=0; i<4; i++)
+	{
+		nDst.vertex[i][0] = (float)nSrc.vertex[i][0];
+		nDst.vertex[i][1] = (float)nSrc.vertex[i][1];
+	}
+}
+
+
+static void
+copyPose(PublishedPose& nDst, int nId, const ARFloat nTrans[3][4])
+{
+	nDst.id = nId;
+	for(int r=0; r<3; r++)
+		for(int c=0; c<4; c++)
+			nDst.trans[r][c] = (float)nTrans[r][c];
+}
+
+
+PosePublisher::PosePublisher()
+{
+	header = NULL;
+	slots = NULL;
+	size = 0;
+	name = NULL;
+}
+
+
+PosePublisher::~PosePublisher()
+{
+	close();
+}
+
+
+bool
+PosePublisher::create(const char* nName, int nNumSlots)
+{
+	close();
+
+#ifdef POSEPUBLISHER_USE_SHM
+	if(nNumSlots<1)
+		return false;
+
+	size_t newSize = sizeof(Header) + nNumSlots*sizeof(Slot);
+
+	// start from an empty object, readers of an older one keep their own mapping
+	shm_unlink(nName);
+
+	int fd = shm_open(nName, O_RDWR|O_CREAT|O_EXCL, 0644);
+	if(fd<0)
+		return false;
+
+	void* mem = ftruncate(fd, (off_t)newSize)==0 ?
+				mmap(NULL, newSize, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+	::close(fd);
+
+	if(mem==MAP_FAILED)
+	{
+		shm_unlink(nName);
+		return false;
+	}
+
+	// the object is zero filled, so all slot locks start out even
+	header = (Header*)mem;
+	slots = (Slot*)(header+1);
+	size = newSize;
+	name = strdup(nName);
+
+	header->version = PUBLISH_VERSION;
+	header->frameSize = sizeof(PublishedFrame);
+	header->numSlots = nNumSlots;
+	header->numPublished = 0;
+
+	// readers check the magic last
+	storeRelease(*(volatile unsigned int*)&header->magic, PUBLISH_MAGIC);
+	return true;
+#else
+	(void)nName;
+	(void)nNumSlots;
+	return false;
+#endif
+}
+
+
+void
+PosePublisher::close()
+{
+#ifdef POSEPUBLISHER_USE_SHM
+	if(header)
+		munmap(header, size);
+	if(name)
+		shm_unlink(name);
+#endif
+
+	free(name);
+	header = NULL;
+	slots = NULL;
+	size = 0;
+	name = NULL;
+}
+
+
+unsigned int
+PosePublisher::getNumPublished() const
+{
+	return header ? loadAcquire(header->numPublished) : 0;
+}
+
+
+// locks the slot of the next frame and returns the frame to fill in
+//
+PublishedFrame*
+PosePublisher::beginFrame()
+{
+	if(!header)
+		return NULL;
+
+	unsigned int sequence = header->numPublished;
+	Slot& slot = slots[sequence%header->numSlots];
+
+	storeRelease(slot.lock, slot.lock+1);
+	fenceRelease();
+
+	slot.frame.sequence = sequence;
+	slot.frame.numMarkers = 0;
+	slot.frame.numPoses = 0;
+	return &slot.frame;
+}
+
+
+// unlocks the slot and makes the frame visible as the latest one
+//
+void
+PosePublisher::endFrame()
+{
+	unsigned int sequence = header->numPublished;
+	Slot& slot = slots[sequence%header->numSlots];
+
+	slot.frame.publishTime = getPublishTime();
+
+	storeRelease(slot.lock, slot.lock+1);
+	storeRelease(header->numPublished, sequence+1);
+}
+
+
+bool
+PosePublisher::publish(const PublishedFrame& nFrame)
+{
+	PublishedFrame* frame = beginFrame();
+	if(!frame)
+		return false;
+
+	int numMarkers = nFrame.numMarkers<PUBLISH_MAX_MARKERS ? nFrame.numMarkers : PUBLISH_MAX_MARKERS,
+		numPoses = nFrame.numPoses<PUBLISH_MAX_POSES ? nFrame.numPoses : PUBLISH_MAX_POSES;
+
+	frame->frameId = nFrame.frameId;
+	frame->timestamp = nFrame.timestamp;
+	frame->numMarkers = numMarkers>0 ? numMarkers : 0;
+	frame->numPoses = numPoses>0 ? numPoses : 0;
+	memcpy(frame->markers, nFrame.markers, frame->numMarkers*sizeof(PublishedMarker));
+	memcpy(frame->poses, nFrame.poses, frame->numPoses*sizeof(PublishedPose));
+
+	endFrame();
+	return true;
+}
+
+
+bool
+PosePublisher::publish(const TrackerSingleMarker* nTracker, const ARMarkerInfo* nMarkers, int nNumMarkers,
+					   int nMarkerId, unsigned int nFrameId, double nTimestamp)
+{
+	PublishedFrame* frame = beginFrame();
+	if(!frame)
+		return false;
+
+	frame->frameId = nFrameId;
+	frame->timestamp = nTimestamp;
+
+	for(int i=0; i<nNumMarkers && frame->numMarkers<PUBLISH_MAX_MARKERS; i++)
+		copyMarker(frame->markers[frame->numMarkers++], nMarkers[i]);
+
+	if(nMarkerId>=0)
+	{
+		ARFloat trans[3][4];
+		nTracker->getARMatrix(trans);
+		copyPose(frame->poses[frame->numPoses++], nMarkerId, trans);
+	}
+
+	endFrame();
+	return true;
+}
+
+
+bool
+PosePublisher::publish(const TrackerMultiMarker* nTracker, unsigned int nFrameId, double nTimestamp)
+{
+	PublishedFrame* frame = beginFrame();
+	if(!frame)
+		return false;
+
+	frame->frameId = nFrameId;
+	frame->timestamp = nTimestamp;
+
+	for(int i=0; i<nTracker->getNumDetectedMarkers() && frame->numMarkers<PUBLISH_MAX_MARKERS; i++)
+		copyMarker(frame->markers[frame->numMarkers++], nTracker->getDetectedMarker(i));
+
+	for(int n=0; n<nTracker->getNumMultiMarkerConfigs() && frame->numPoses<PUBLISH_MAX_POSES; n++)
+		if(nTracker->isMultiMarkerConfigTracked(n))
+		{
+			ARFloat trans[3][4];
+			nTracker->getARMatrix(n, trans);
+			copyPose(frame->poses[frame->numPoses++], n, trans);
+		}
+
+	endFrame();
+	return true;
+}
+
+
+PoseSubscriber::PoseSubscriber()
+{
+	header = NULL;
+	slots = NULL;
+	size = 0;
+}
+
+
+PoseSubscriber::~PoseSubscriber()
+{
+	close();
+}
+
+
+bool
+PoseSubscriber::open(const char* nName)
+{
+	close();
+
+#ifdef POSEPUBLISHER_USE_SHM
+	int fd = shm_open(nName, O_RDONLY, 0);
+	if(fd<0)
+		return false;
+
+	struct stat info;
+	void* mem = MAP_FAILED;
+
+	if(fstat(fd, &info)==0 && (size_t)info.st_size>=sizeof(Header))
+		mem = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+
+	if(mem==MAP_FAILED)
+		return false;
+
+	const Header* newHeader = (const Header*)mem;
+
+	if(loadAcquire(*(volatile const unsigned int*)&newHeader->magic)!=PUBLISH_MAGIC ||
+	   newHeader->version!=PUBLISH_VERSION || newHeader->frameSize!=sizeof(PublishedFrame) ||
+	   sizeof(Header)+newHeader->numSlots*sizeof(Slot)>(size_t)info.st_size)
+	{
+		munmap(mem, (size_t)info.st_size);
+		return false;
+	}
+
+	header = newHeader;
+	slots = (const Slot*)(header+1);
+	size = (size_t)info.st_size;
+	return true;
+#else
+	(void)nName;
+	return false;
+#endif
+}
+
+
+void
+PoseSubscriber::close()
+{
+#ifdef POSEPUBLISHER_USE_SHM
+	if(header)
+		munmap(const_cast<Header*>(header), size);
+#endif
+
+	header = NULL;
+	slots = NULL;
+	size = 0;
+}
+
+
+unsigned int
+PoseSubscriber::getNumPublished() const
+{
+	return header ? loadAcquire(header->numPublished) : 0;
+}
+
+
+int
+PoseSubscriber::getNumSlots() const
+{
+	return header ? (int)header->numSlots : 0;
+}
+
+
+bool
+PoseSubscriber::readLatest(PublishedFrame& nFrame) const
+{
+	// if the latest frame gets overwritten while it is copied, try the one after it
+	for(int i=0; i<PUBLISH_MAX_RETRIES; i++)
+	{
+		unsigned int numPublished = getNumPublished();
+		if(numPublished==0)
+			return false;
+
+		if(read(numPublished-1, nFrame))
+			return true;
+	}
+
+	return false;
+}
+
+
+bool
+PoseSubscriber::read(unsigned int nSequence, PublishedFrame& nFrame) const
+{
+	if(!header)
+		return false;
+
+	unsigned int numPublished = getNumPublished();
+	if(nSequence>=numPublished || numPublished-nSequence>header->numSlots)
+		return false;
+
+	const Slot& slot = slots[nSequence%header->numSlots];
+
+	for(int i=0; i<PUBLISH_MAX_RETRIES; i++)
+	{
+		unsigned int lock = loadAcquire(slot.lock);
+		if(lock&1)
+			continue;
+
+		// copy only the used part of the frame
+		memcpy(&nFrame, (const void*)&slot.frame, (size_t)((const char*)nFrame.markers-(const char*)&nFrame));
+
+		int numMarkers = nFrame.numMarkers, numPoses = nFrame.numPoses;
+		if(numMarkers>=0 && numMarkers<=PUBLISH_MAX_MARKERS && numPoses>=0 && numPoses<=PUBLISH_MAX_POSES)
+		{
+			memcpy(nFrame.markers, (const void*)slot.frame.markers, numMarkers*sizeof(PublishedMarker));
+			memcpy(nFrame.poses, (const void*)slot.frame.poses, numPoses*sizeof(PublishedPose));
+		}
+
+		fenceAcquire();
+		if(*(volatile const unsigned int*)&slot.lock!=lock)
+			continue;
+
+		// a slot that was reused meanwhile holds a newer frame
+		return nFrame.sequence==nSequence;
+	}
+
+	return false;
+}
+
+
+}  // namespace ARToolKitPlus
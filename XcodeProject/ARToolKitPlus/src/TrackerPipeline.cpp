@@ -0,0 +1,459 @@
+/* ========================================================================
+* PROJECT: ARToolKitPlus
+* ========================================================================
+* This work is based on the original ARToolKit developed by
+*   Hirokazu Kato
+*   Mark Billinghurst
+*   HITLab, University of Washington, Seattle
+* http://www.hitl.washington.edu/artoolkit/
+*
+* Copyright of the derived and new portions of this work
+*     (C) 2006 Graz University of Technology
+*
+* This framework is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 2 of the License, or
+* (at your option) any later version.
+*
+* This framework is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this framework; if not, write to the Free Software
+* Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*
+* For further information please contact 
+*   Dieter Schmalstieg
+*   <schmalstieg@icg.tu-graz.ac.at>
+*   Graz University of Technology, 
+*   Institut for Computer Graphics and Vision,
+*   Inffeldgasse 16a, 8010 Graz, Austria.
+* ========================================================================
+** @author   Daniel Wagner
+*
+* $Id$
+* @file
+* ======================================================================== */
+
+
+#include <ARToolKitPlus/TrackerPipeline.h>
+#include <string.h>
+
+#if defined(_MSC_VER) || defined(_WIN32_WCE)
+#  include <windows.h>
+#else
+#  include <sys/time.h>
+#  define PIPELINE_USE_THREADS
+#endif
+
+
+namespace ARToolKitPlus
+{
+
+
+// reads a counter another thread advances; everything written to the
+// slots before the counter was advanced is visible afterwards
+//
+static inline unsigned int
+loadCounter(volatile const unsigned int& nCounter)
+{
+#if defined(PIPELINE_USE_THREADS) && defined(__ATOMIC_SEQ_CST)
+	return __atomic_load_n(&nCounter, __ATOMIC_SEQ_CST);
+#elif defined(PIPELINE_USE_THREADS)
+	return __sync_fetch_and_add(const_cast<volatile unsigned int*>(&nCounter), 0);
+#else
+	return nCounter;
+#endif
+}
+
+
+TrackerPipeline::TrackerPipeline(TrackerSingleMarker* nTracker, int nQueueSize, int nMaxMarkers)
+{
+	singleTracker = nTracker;
+	multiTracker = NULL;
+	init(nQueueSize, nMaxMarkers);
+}
+
+
+TrackerPipeline::TrackerPipeline(TrackerMultiMarker* nTracker, int nQueueSize, int nMaxMarkers)
+{
+	singleTracker = NULL;
+	multiTracker = nTracker;
+	init(nQueueSize, nMaxMarkers);
+}
+
+
+TrackerPipeline::~TrackerPipeline()
+{
+	stop();
+	freeSlots();
+
+#ifdef PIPELINE_USE_THREADS
+	pthread_cond_destroy(&wakeup);
+	pthread_mutex_destroy(&mutex);
+#endif
+}
+
+
+void
+TrackerPipeline::init(int nQueueSize, int nMaxMarkers)
+{
+	queueSize = nQueueSize>0 ? nQueueSize : 1;
+	maxMarkers = nMaxMarkers>0 ? nMaxMarkers : 1;
+	numPoses = 0;
+
+	slots = NULL;
+	markerMemory = NULL;
+	trackedMemory = NULL;
+	transMemory = NULL;
+	modelViewMemory = NULL;
+
+	callback = NULL;
+	userData = NULL;
+
+	numSubmitted = numDetected = numPosed = numReleased = 0;
+	pollPending = false;
+	running = quit = false;
+
+#ifdef PIPELINE_USE_THREADS
+	pthread_mutex_init(&mutex, NULL);
+	pthread_cond_init(&wakeup, NULL);
+	numSleeping = 0;
+#endif
+}
+
+
+void
+TrackerPipeline::freeSlots()
+{
+	delete [] slots;
+	delete [] markerMemory;
+	delete [] trackedMemory;
+	delete [] transMemory;
+	delete [] modelViewMemory;
+
+	slots = NULL;
+	markerMemory = NULL;
+	trackedMemory = NULL;
+	transMemory = NULL;
+	modelViewMemory = NULL;
+}
+
+
+bool
+TrackerPipeline::start(ResultCallback nCallback, void* nUserData)
+{
+	if(running)
+		return false;
+
+	// the number of configs is only known now, so the slots
+	// are (re)allocated here. results still unpolled are dropped.
+	//
+	freeSlots();
+
+	numPoses = singleTracker ? 1 : multiTracker->getNumMultiMarkerConfigs();
+	if(numPoses<1)
+		numPoses = 1;
+
+	slots = new Slot[queueSize];
+	markerMemory = new ARMarkerInfo[queueSize*maxMarkers];
+	trackedMemory = new bool[queueSize*numPoses];
+	transMemory = new ARFloat[queueSize*numPoses][3][4];
+	modelViewMemory = new ARFloat[queueSize*numPoses][16];
+
+	for(int i=0; i<queueSize; i++)
+	{
+		Result& result = slots[i].result;
+
+		result.markers = markerMemory + i*maxMarkers;
+		result.numPoses = numPoses;
+		result.tracked = trackedMemory + i*numPoses;
+		result.trans = transMemory + i*numPoses;
+		result.modelView = modelViewMemory + i*numPoses;
+	}
+
+	callback = nCallback;
+	userData = nUserData;
+
+	numSubmitted = numDetected = numPosed = numReleased = 0;
+	pollPending = false;
+	quit = false;
+
+#ifdef PIPELINE_USE_THREADS
+	if(pthread_create(&detector, NULL, detectThread, this)!=0)
+		return false;
+
+	if(pthread_create(&estimator, NULL, poseThread, this)!=0)
+	{
+		pthread_mutex_lock(&mutex);
+		quit = true;
+		pthread_cond_broadcast(&wakeup);
+		pthread_mutex_unlock(&mutex);
+
+		pthread_join(detector, NULL);
+		return false;
+	}
+#endif
+
+	running = true;
+	return true;
+}
+
+
+void
+TrackerPipeline::stop()
+{
+	if(!running)
+		return;
+
+#ifdef PIPELINE_USE_THREADS
+	// finish all frames that were submitted
+	for(unsigned int posed=loadCounter(numPosed); posed!=loadCounter(numSubmitted); posed=loadCounter(numPosed))
+		waitWhileEqual(numPosed, posed);
+
+	pthread_mutex_lock(&mutex);
+	quit = true;
+	pthread_cond_broadcast(&wakeup);
+	pthread_mutex_unlock(&mutex);
+
+	pthread_join(detector, NULL);
+	pthread_join(estimator, NULL);
+#endif
+
+	running = false;
+}
+
+
+bool
+TrackerPipeline::submit(const unsigned char* nImage, unsigned int nFrameId, double nTimestamp, bool nWait)
+{
+	if(!running || nImage==NULL)
+		return false;
+
+	// all slots are in use until the oldest result is given back
+	for(unsigned int released=loadCounter(numReleased); numSubmitted-released>=(unsigned int)queueSize; released=loadCounter(numReleased))
+	{
+		if(!nWait)
+			return false;
+		waitWhileEqual(numReleased, released);
+	}
+
+	Slot& slot = slots[numSubmitted%queueSize];
+
+	slot.result.frameId = nFrameId;
+	slot.result.timestamp = nTimestamp;
+	slot.result.image = nImage;
+	slot.result.submitTime = getTime();
+
+#ifdef PIPELINE_USE_THREADS
+	advance(numSubmitted);
+#else
+	numSubmitted++;
+
+	detect(slot);
+	numDetected++;
+
+	estimate(slot);
+	numPosed++;
+
+	if(callback)
+	{
+		callback(slot.result, userData);
+		numReleased++;
+	}
+#endif
+
+	return true;
+}
+
+
+const TrackerPipeline::Result*
+TrackerPipeline::poll(bool nWait)
+{
+	if(pollPending)
+	{
+		pollPending = false;
+		advance(numReleased);
+	}
+
+	if(callback || slots==NULL)
+		return NULL;
+
+	while(loadCounter(numPosed)==numReleased)
+	{
+		if(!nWait || !running || loadCounter(numSubmitted)==numReleased)
+			return NULL;
+		waitWhileEqual(numPosed, numReleased);
+	}
+
+	pollPending = true;
+	return &slots[numReleased%queueSize].result;
+}
+
+
+int
+TrackerPipeline::getNumPending() const
+{
+	return (int)(loadCounter(numSubmitted)-loadCounter(numReleased));
+}
+
+
+double
+TrackerPipeline::getTime()
+{
+#if defined(_MSC_VER) || defined(_WIN32_WCE)
+	LARGE_INTEGER freq, now;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+	return 1000.0*(double)now.QuadPart/(double)freq.QuadPart;
+#else
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec*1000.0 + tv.tv_usec/1000.0;
+#endif
+}
+
+
+void
+TrackerPipeline::detect(Slot& nSlot)
+{
+	Result& result = nSlot.result;
+
+	result.detectTime = getTime();
+	nSlot.markersUnchanged = false;
+
+	if(singleTracker)
+		result.numMarkers = singleTracker->calcDetect(result.image, result.markers, maxMarkers, &nSlot.markersUnchanged);
+	else
+		result.numMarkers = multiTracker->calcDetect(result.image, result.markers, maxMarkers, &nSlot.markersUnchanged);
+}
+
+
+void
+TrackerPipeline::estimate(Slot& nSlot)
+{
+	Result& result = nSlot.result;
+
+	result.poseTime = getTime();
+
+	if(singleTracker)
+	{
+		// calc() returns before the pose half if detection failed
+		result.result = result.numMarkers<0 ? -1 : singleTracker->calcPose(result.markers, result.numMarkers, nSlot.markersUnchanged);
+		result.confidence = result.result<0 ? 0.0f : singleTracker->getConfidence();
+		result.tracked[0] = result.result>=0;
+		singleTracker->getARMatrix(result.trans[0]);
+		memcpy(result.modelView[0], singleTracker->getModelViewMatrix(), sizeof(result.modelView[0]));
+	}
+	else
+	{
+		result.result = result.numMarkers<0 ? 0 : multiTracker->calcPose(result.markers, result.numMarkers, nSlot.markersUnchanged);
+		result.confidence = 0.0f;
+
+		for(int i=0; i<numPoses; i++)
+		{
+			result.tracked[i] = multiTracker->isMultiMarkerConfigTracked(i);
+			multiTracker->getARMatrix(i, result.trans[i]);
+			memcpy(result.modelView[i], multiTracker->getModelViewMatrix(i), sizeof(result.modelView[i]));
+		}
+	}
+
+	result.doneTime = getTime();
+}
+
+
+// publishes the slot of the counter's frame to the next stage
+// and wakes up threads that wait for it
+//
+void
+TrackerPipeline::advance(volatile unsigned int& nCounter)
+{
+#ifdef PIPELINE_USE_THREADS
+	__sync_fetch_and_add(&nCounter, 1);
+
+	// a thread that goes to sleep counts itself before it checks the
+	// counters again, so either it sees the new value or we see it
+	if(loadCounter(numSleeping)>0)
+	{
+		pthread_mutex_lock(&mutex);
+		pthread_cond_broadcast(&wakeup);
+		pthread_mutex_unlock(&mutex);
+	}
+#else
+	nCounter = nCounter+1;
+#endif
+}
+
+
+void
+TrackerPipeline::waitWhileEqual(volatile const unsigned int& nCounter, unsigned int nValue)
+{
+#ifdef PIPELINE_USE_THREADS
+	if(loadCounter(nCounter)!=nValue)
+		return;
+
+	pthread_mutex_lock(&mutex);
+	__sync_fetch_and_add(&numSleeping, 1);
+
+	while(loadCounter(nCounter)==nValue && !quit)
+		pthread_cond_wait(&wakeup, &mutex);
+
+	__sync_fetch_and_sub(&numSleeping, 1);
+	pthread_mutex_unlock(&mutex);
+#endif
+}
+
+
+void*
+TrackerPipeline::detectThread(void* nPipeline)
+{
+#ifdef PIPELINE_USE_THREADS
+	TrackerPipeline* pipeline = reinterpret_cast<TrackerPipeline*>(nPipeline);
+
+	for(;;)
+	{
+		pipeline->waitWhileEqual(pipeline->numSubmitted, pipeline->numDetected);
+		if(loadCounter(pipeline->numSubmitted)==pipeline->numDetected)
+			break;		// woken up by stop()
+
+		pipeline->detect(pipeline->slots[pipeline->numDetected%pipeline->queueSize]);
+		pipeline->advance(pipeline->numDetected);
+	}
+#endif
+
+	return NULL;
+}
+
+
+void*
+TrackerPipeline::poseThread(void* nPipeline)
+{
+#ifdef PIPELINE_USE_THREADS
+	TrackerPipeline* pipeline = reinterpret_cast<TrackerPipeline*>(nPipeline);
+
+	for(;;)
+	{
+		pipeline->waitWhileEqual(pipeline->numDetected, pipeline->numPosed);
+		if(loadCounter(pipeline->numDetected)==pipeline->numPosed)
+			break;
+
+		Slot& slot = pipeline->slots[pipeline->numPosed%pipeline->queueSize];
+
+		pipeline->estimate(slot);
+		pipeline->advance(pipeline->numPosed);
+
+		if(pipeline->callback)
+		{
+			pipeline->callback(slot.result, pipeline->userData);
+			pipeline->advance(pipeline->numReleased);
+		}
+	}
+#endif
+
+	return NULL;
+}
+
+
+}  // namespace ARToolKitPlus
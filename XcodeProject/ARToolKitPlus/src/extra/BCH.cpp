@@ -125,241 +125,45 @@ printBitArray(int bb[], int bb_length)
 */
 
 
-BCH::BCH()
-{
-	initialize(BCH_DEFAULT_M, BCH_DEFAULT_LENGTH, BCH_DEFAULT_T);
-}
-
-BCH::BCH(int _m, int _length, int _t)
-{
-	initialize(_m,_length,_t);
-}
-
+// The tables below belong to the (36, 12, 9) code over GF(2**6) with the
+// primitive polynomial p(X) = 1 + X + X^6. They are the output of
+// generate_gf() and gen_poly() of the original implementation (see
+// BCH_original.txt) for m=6, length=36, t=4.
+//
+// index->polynomial form: alpha_to[i] = alpha^i
+const int BCH::alpha_to[BCH_MAX_LUT] = {
+	 1,  2,  4,  8, 16, 32,  3,  6, 12, 24, 48, 35,  5, 10, 20, 40,
+	19, 38, 15, 30, 60, 59, 53, 41, 17, 34,  7, 14, 28, 56, 51, 37,
+	 9, 18, 36, 11, 22, 44, 27, 54, 47, 29, 58, 55, 45, 25, 50, 39,
+	13, 26, 52, 43, 21, 42, 23, 46, 31, 62, 63, 61, 57, 49, 33,  0
+};
+
+// polynomial form -> index form: index_of[alpha^i] = i
+const int BCH::index_of[BCH_MAX_LUT] = {
+	-1,  0,  1,  6,  2, 12,  7, 26,  3, 32, 13, 35,  8, 48, 27, 18,
+	 4, 24, 33, 16, 14, 52, 36, 54,  9, 45, 49, 38, 28, 41, 19, 56,
+	 5, 62, 25, 11, 34, 31, 17, 47, 15, 23, 53, 51, 37, 44, 55, 40,
+	10, 61, 46, 30, 50, 22, 39, 43, 29, 60, 42, 21, 20, 59, 57, 58
+};
+
+// coefficients of the generator polynomial g(x), degree length-k = 24
+const int BCH::g[BCH_MAX_LUT] = {
+	 1,  1,  1,  0,  1,  1,  1,  0,  1,  1,  1,  0,  0,  1,  0,  0,
+	 1,  1,  0,  1,  1,  0,  1,  1,  1
+};
 
-void BCH::initialize(int _m, int _length, int _t)
-{
-	int i, ninf;
-
-	m = _m;
-	length = _length;
-	t = _t;
-
-	p.resize(BCH_MAX_P);
-	alpha_to.resize(BCH_MAX_LUT);
-	index_of.resize(BCH_MAX_LUT);
-	g.resize(BCH_MAX_LUT);
-
-	_elp.resize(BCH_MAX_LUT);
-	for(i=0; i<BCH_MAX_LUT; i++) _elp[i].resize(BCH_MAX_LUT);
-	_d.resize(BCH_MAX_LUT);
-	_l.resize(BCH_MAX_LUT);
-	_u_lu.resize(BCH_MAX_LUT);
-	_s.resize(BCH_MAX_LUT);
-	_root.resize(BCH_MAX_LUT);
-	_loc.resize(BCH_MAX_LUT);
-	_reg.resize(BCH_MAX_LUT);
-
-
-	for (i=1; i<m; i++)
-		p[i] = 0;
-	p[0] = p[m] = 1;
-	if (m == 2)			p[1] = 1;
-	else if (m == 3)	p[1] = 1;
-	else if (m == 4)	p[1] = 1;
-	else if (m == 5)	p[2] = 1;
-	else if (m == 6)	p[1] = 1;
-	else if (m == 7)	p[1] = 1;
-	else if (m == 8)	p[4] = p[5] = p[6] = 1;
-	else if (m == 9)	p[4] = 1;
-	else if (m == 10)	p[3] = 1;
-	else if (m == 11)	p[2] = 1;
-	else if (m == 12)	p[3] = p[4] = p[7] = 1;
-	else if (m == 13)	p[1] = p[3] = p[4] = 1;
-	else if (m == 14)	p[1] = p[11] = p[12] = 1;
-	else if (m == 15)	p[1] = 1;
-	else if (m == 16)	p[2] = p[3] = p[5] = 1;
-	else if (m == 17)	p[3] = 1;
-	else if (m == 18)	p[7] = 1;
-	else if (m == 19)	p[1] = p[5] = p[6] = 1;
-	else if (m == 20)	p[3] = 1;
-
-    n = 1;
-	for (i = 0; i <= m; i++) 
-	{
-        n *= 2;
-    }
-	n = n / 2 - 1;
-	ninf = (n + 1) / 2 - 1;
-
-	generate_gf();          /* Construct the Galois Field GF(2**m) */
-	gen_poly(t);            /* Compute the generator polynomial of BCH code */
-}
 
-
-void BCH::generate_gf()
-/*
- * Generate field GF(2**m) from the irreducible polynomial p(X) with
- * coefficients in p[0]..p[m].
- *
- * Lookup tables:
- *   index->polynomial form: alpha_to[] contains j=alpha^i;
- *   polynomial form -> index form:	index_of[j=alpha^i] = i
- *
- * alpha=2 is the primitive element of GF(2**m) 
- */
-{
-	int    i, mask;
-
-	mask = 1;
-	alpha_to[m] = 0;
-	for (i = 0; i < m; i++) {
-		alpha_to[i] = mask;
-		index_of[alpha_to[i]] = i;
-		if (p[i] != 0)
-			alpha_to[m] ^= mask;
-		mask <<= 1;
-	}
-	index_of[alpha_to[m]] = m;
-	mask >>= 1;
-	for (i = m + 1; i < n; i++) {
-		if (alpha_to[i - 1] >= mask)
-		  alpha_to[i] = alpha_to[m] ^ ((alpha_to[i - 1] ^ mask) << 1);
-		else
-		  alpha_to[i] = alpha_to[i - 1] << 1;
-		index_of[alpha_to[i]] = i;
-	}
-	index_of[0] = -1;
-}
-
-
-bool BCH::gen_poly(int _t)
-/*
- * Compute the generator polynomial of a binary BCH code. Fist generate the
- * cycle sets modulo 2**m - 1, cycle[][] =  (i, 2*i, 4*i, ..., 2^l*i). Then
- * determine those cycle sets that contain integers in the set of (d-1)
- * consecutive integers {1..(d-1)}. The generator polynomial is calculated
- * as the product of linear factors of the form (x+alpha^i), for every i in
- * the above cycle sets.
- */
+BCH::BCH()
 {
-	int	ii, jj, ll, kaux;
-	int	test, aux, nocycles, root, noterms, rdncy;
-	int             cycle[1024][21], size[1024], min[1024], zeros[1024];
-
-	/* Generate cycle sets modulo n, n = 2**m - 1 */
-	cycle[0][0] = 0;
-	size[0] = 1;
-	cycle[1][0] = 1;
-	size[1] = 1;
-	jj = 1;			/* cycle set index */
-
-	#ifdef _BCH_VERBOSE_
-		if (m > 9)  {
-			printf("Computing cycle sets modulo %d\n", n);
-			printf("(This may take some time)...\n");
-		}
-	#endif
-	
-	do {
-		/* Generate the jj-th cycle set */
-		ii = 0;
-		do {
-			ii++;
-			cycle[jj][ii] = (cycle[jj][ii - 1] * 2) % n;
-			size[jj]++;
-			aux = (cycle[jj][ii] * 2) % n;
-		} while (aux != cycle[jj][0]);
-		/* Next cycle set representative */
-		ll = 0;
-		do {
-			ll++;
-			test = 0;
-			for (ii = 1; ((ii <= jj) && (!test)); ii++)	
-			/* Examine previous cycle sets */
-			  for (kaux = 0; ((kaux < size[ii]) && (!test)); kaux++)
-			     if (ll == cycle[ii][kaux])
-			        test = 1;
-		} while ((test) && (ll < (n - 1)));
-		if (!(test)) {
-			jj++;	/* next cycle set index */
-			cycle[jj][0] = ll;
-			size[jj] = 1;
-		}
-	} while (ll < (n - 1));
-	nocycles = jj;		/* number of cycle sets modulo n */
-
-	//printf("Enter the error correcting capability, t: ");
-	//scanf("%d", &t);
-	t = _t;
-
-	d = 2 * t + 1;
-
-	/* Search for roots 1, 2, ..., d-1 in cycle sets */
-	kaux = 0;
-	rdncy = 0;
-	for (ii = 1; ii <= nocycles; ii++) {
-		min[kaux] = 0;
-		test = 0;
-		for (jj = 0; ((jj < size[ii]) && (!test)); jj++)
-			for (root = 1; ((root < d) && (!test)); root++)
-				if (root == cycle[ii][jj])  {
-					test = 1;
-					min[kaux] = ii;
-				}
-		if (min[kaux]) {
-			rdncy += size[min[kaux]];
-			kaux++;
-		}
-	}
-	noterms = kaux;
-	kaux = 1;
-	for (ii = 0; ii < noterms; ii++)
-		for (jj = 0; jj < size[min[ii]]; jj++) {
-			zeros[kaux] = cycle[min[ii]][jj];
-			kaux++;
-		}
-
-	k = length - rdncy;
-
-    if (k<0)
-      {
-		#ifdef _BCH_VERBOSE_
-			printf("Parameters invalid!\n");
-		#endif
-         return(false);
-      }
-
-	#ifdef _BCH_VERBOSE_
-		printf("This is a (%d, %d, %d) binary BCH code\n", length, k, d);
-	#endif
-
-	/* Compute the generator polynomial */
-	g[0] = alpha_to[zeros[1]];
-	g[1] = 1;		/* g(x) = (X + zeros[1]) initially */
-	for (ii = 2; ii <= rdncy; ii++) {
-	  g[ii] = 1;
-	  for (jj = ii - 1; jj > 0; jj--)
-	    if (g[jj] != 0)
-	      g[jj] = g[jj - 1] ^ alpha_to[(index_of[g[jj]] + zeros[ii]) % n];
-	    else
-	      g[jj] = g[jj - 1];
-	  g[0] = alpha_to[(index_of[g[0]] + zeros[ii]) % n];
-	}
-
-	#ifdef _BCH_VERBOSE_
-		printf("Generator polynomial:\ng(x) = ");
-		for (ii = 0; ii <= rdncy; ii++) {
-		  printf("%d", g[ii]);
-		  if (ii && ((ii % 50) == 0))
-			printf("\n");
-		}
-		printf("\n");
-	#endif
-	return(true);
+	m = BCH_DEFAULT_M;
+	length = BCH_DEFAULT_LENGTH;
+	t = BCH_DEFAULT_T;
+	k = BCH_DEFAULT_K;
+	n = (1<<m) - 1;
+	d = 2*t + 1;
 }
 
 
-
 void BCH::encode_bch(int *bb, const int *data)
 /*
  * Compute redundacy bb[], the coefficients of b(x). The redundancy
@@ -73,25 +73,9 @@ namespace ARToolKitPlus {
 #define FIXED28_2_OVER_PI FIXED_Float_To_Fixed_n(DOUBLE_2_OVER_PI, 28)
 
 
-static I32 *sinLUT_28 = 0;
-
-
-static I32*
-createSinLUT(int nSize, int nBits)
-{
-	I32* lut = new I32[nSize];
-
-	for(int i=0; i<nSize; i++)
-	{
-		double phi = i*DOUBLE_PI_OVER_2/nSize;
-		double sinPhi = sin(phi);
-
-		I32 sinPhiFixed = FIXED_Float_To_Fixed_n(sinPhi, nBits);
-		lut[i] = sinPhiFixed;
-	}
-
-	return lut;
-}
+// precomputed sinLUT_28[SIN_LUT_SIZE]
+//
+#include "FixedPointSinLUT.h"
 
 
 inline void
@@ -186,21 +170,6 @@ checkPrecisionSinCos()
 }
 
 
-void
-Fixed28_Init()
-{
-	if(!sinLUT_28)
-		sinLUT_28 = createSinLUT(SIN_LUT_SIZE, SIN_LUT_BITS);
-}
-
-
-void
-Fixed28_Deinit()
-{
-	delete sinLUT_28;
-}
-
-
 
 #endif //_USE_GENERIC_TRIGONOMETRIC_
 
@@ -153,9 +153,6 @@ typedef GPP_VEC3D FIXED_VEC3D;
 
 #ifdef _USE_GENERIC_TRIGONOMETRIC_
 
-void Fixed28_Init();
-void Fixed28_Deinit();
-
 inline void Fixed28_SinCos(I32 phi, I32 &sin, I32 &cos);
 
 #define FIXED_SINCOS(theta, sin_theta, cos_theta, n) \
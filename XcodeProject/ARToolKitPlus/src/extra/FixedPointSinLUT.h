@@ -0,0 +1,568 @@
+/* ========================================================================
+ * PROJECT: ARToolKitPlus
+ * ========================================================================
+ * This work is based on the original ARToolKit developed by
+ *   Hirokazu Kato
+ *   Mark Billinghurst
+ *   HITLab, University of Washington, Seattle
+ * http://www.hitl.washington.edu/artoolkit/
+ *
+ * Copyright of the derived and new portions of this work
+ *     (C) 2006 Graz University of Technology
+ *
+ * This framework is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this framework; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * For further information please contact 
+ *   Dieter Schmalstieg
+ *   <schmalstieg@icg.tu-graz.ac.at>
+ *   Graz University of Technology, 
+ *   Institut for Computer Graphics and Vision,
+ *   Inffeldgasse 16a, 8010 Graz, Austria.
+ * ========================================================================
+ ** @author   Daniel Wagner
+ *
+ * $Id$
+ * @file
+ * ======================================================================== */
+
+
+
+
+#ifndef __FIXEDPOINTSINLUT_HEADERFILE__
+#define __FIXEDPOINTSINLUT_HEADERFILE__
+
+
+// sin() for the first quadrant in 28-bit fixed point, used by Fixed28_SinCos().
+// entry i holds FIXED_Float_To_Fixed_n(sin(i*PI/2/SIN_LUT_SIZE), 28) for
+// SIN_LUT_SIZEBITS=12. it has to be regenerated if SIN_LUT_SIZEBITS or
+// SIN_LUT_BITS are changed.
+//
+static const I32 sinLUT_28[4096] = {
+	         0,    102944,    205887,    308831,    411775,    514718,    617662,    720605,
+	    823548,    926492,   1029435,   1132377,   1235320,   1338263,   1441205,   1544147,
+	   1647089,   1750031,   1852972,   1955913,   2058854,   2161795,   2264735,   2367675,
+	   2470614,   2573553,   2676492,   2779430,   2882368,   2985306,   3088243,   3191180,
+	   3294116,   3397052,   3499987,   3602922,   3705856,   3808789,   3911722,   4014655,
+	   4117587,   4220518,   4323449,   4426379,   4529308,   4632237,   4735165,   4838092,
+	   4941019,   5043945,   5146870,   5249794,   5352718,   5455641,   5558563,   5661484,
+	   5764405,   5867324,   5970243,   6073161,   6176077,   6278993,   6381909,   6484823,
+	   6587736,   6690648,   6793559,   6896470,   6999379,   7102287,   7205194,   7308100,
+	   7411005,   7513909,   7616812,   7719714,   7822614,   7925514,   8028412,   8131309,
+	   8234205,   8337099,   8439993,   8542885,   8645776,   8748666,   8851554,   8954441,
+	   9057327,   9160211,   9263094,   9365976,   9468856,   9571735,   9674613,   9777489,
+	   9880364,   9983237,  10086109,  10188979,  10291848,  10394715,  10497581,  10600445,
+	  10703307,  10806169,  10909028,  11011886,  11114742,  11217597,  11320450,  11423301,
+	  11526151,  11628998,  11731845,  11834689,  11937532,  12040373,  12143212,  12246050,
+	  12348885,  12451719,  12554551,  12657381,  12760209,  12863036,  12965860,  13068683,
+	  13171504,  13274322,  13377139,  13479954,  13582767,  13685578,  13788386,  13891193,
+	  13993998,  14096801,  14199601,  14302400,  14405196,  14507991,  14610783,  14713573,
+	  14816361,  14919146,  15021930,  15124711,  15227490,  15330267,  15433041,  15535814,
+	  15638584,  15741352,  15844117,  15946880,  16049641,  16152399,  16255155,  16357909,
+	  16460660,  16563409,  16666155,  16768899,  16871640,  16974379,  17077116,  17179849,
+	  17282581,  17385310,  17488036,  17590760,  17693481,  17796199,  17898915,  18001629,
+	  18104339,  18207047,  18309753,  18412455,  18515155,  18617852,  18720547,  18823238,
+	  18925927,  19028613,  19131297,  19233977,  19336655,  19439330,  19542002,  19644671,
+	  19747337,  19850000,  19952661,  20055318,  20157973,  20260624,  20363273,  20465919,
+	  20568561,  20671201,  20773837,  20876471,  20979101,  21081728,  21184353,  21286974,
+	  21389592,  21492206,  21594818,  21697426,  21800032,  21902634,  22005233,  22107828,
+	  22210421,  22313010,  22415596,  22518178,  22620757,  22723333,  22825906,  22928475,
+	  23031041,  23133603,  23236162,  23338718,  23441270,  23543819,  23646364,  23748906,
+	  23851444,  23953979,  24056510,  24159038,  24261562,  24364082,  24466599,  24569113,
+	  24671623,  24774129,  24876631,  24979130,  25081625,  25184117,  25286605,  25389089,
+	  25491569,  25594046,  25696519,  25798988,  25901453,  26003914,  26106372,  26208826,
+	  26311276,  26413722,  26516164,  26618602,  26721037,  26823467,  26925894,  27028316,
+	  27130735,  27233149,  27335560,  27437966,  27540369,  27642767,  27745162,  27847552,
+	  27949938,  28052320,  28154698,  28257072,  28359442,  28461807,  28564169,  28666526,
+	  28768879,  28871227,  28973572,  29075912,  29178248,  29280580,  29382907,  29485230,
+	  29587548,  29689863,  29792173,  29894478,  29996779,  30099076,  30201368,  30303656,
+	  30405940,  30508219,  30610493,  30712763,  30815028,  30917289,  31019546,  31121798,
+	  31224045,  31326287,  31428525,  31530759,  31632988,  31735212,  31837431,  31939646,
+	  32041856,  32144061,  32246262,  32348458,  32450649,  32552835,  32655017,  32757193,
+	  32859365,  32961533,  33063695,  33165852,  33268005,  33370152,  33472295,  33574433,
+	  33676566,  33778694,  33880817,  33982934,  34085047,  34187155,  34289258,  34391356,
+	  34493449,  34595537,  34697619,  34799697,  34901769,  35003837,  35105899,  35207956,
+	  35310008,  35412054,  35514096,  35616132,  35718163,  35820188,  35922209,  36024224,
+	  36126234,  36228238,  36330238,  36432231,  36534220,  36636203,  36738181,  36840153,
+	  36942120,  37044082,  37146038,  37247988,  37349933,  37451873,  37553807,  37655736,
+	  37757659,  37859576,  37961488,  38063394,  38165295,  38267190,  38369080,  38470964,
+	  38572842,  38674714,  38776581,  38878442,  38980298,  39082147,  39183991,  39285829,
+	  39387662,  39489488,  39591309,  39693124,  39794933,  39896737,  39998534,  40100326,
+	  40202111,  40303891,  40405665,  40507433,  40609194,  40710950,  40812700,  40914444,
+	  41016182,  41117914,  41219640,  41321360,  41423073,  41524781,  41626482,  41728178,
+	  41829867,  41931550,  42033227,  42134898,  42236562,  42338221,  42439873,  42541519,
+	  42643158,  42744791,  42846419,  42948039,  43049654,  43151262,  43252864,  43354459,
+	  43456048,  43557631,  43659207,  43760777,  43862340,  43963897,  44065447,  44166991,
+	  44268529,  44370060,  44471584,  44573102,  44674613,  44776118,  44877616,  44979108,
+	  45080593,  45182071,  45283543,  45385008,  45486466,  45587918,  45689363,  45790801,
+	  45892233,  45993657,  46095075,  46196487,  46297891,  46399289,  46500679,  46602063,
+	  46703440,  46804811,  46906174,  47007530,  47108880,  47210223,  47311558,  47412887,
+	  47514209,  47615523,  47716831,  47818132,  47919426,  48020712,  48121992,  48223264,
+	  48324530,  48425788,  48527039,  48628283,  48729520,  48830750,  48931972,  49033188,
+	  49134396,  49235597,  49336790,  49437977,  49539156,  49640328,  49741492,  49842650,
+	  49943799,  50044942,  50146077,  50247205,  50348326,  50449439,  50550544,  50651642,
+	  50752733,  50853816,  50954892,  51055960,  51157021,  51258074,  51359120,  51460158,
+	  51561189,  51662212,  51763227,  51864235,  51965235,  52066228,  52167213,  52268190,
+	  52369160,  52470121,  52571075,  52672022,  52772960,  52873891,  52974814,  53075730,
+	  53176637,  53277537,  53378429,  53479313,  53580189,  53681057,  53781917,  53882770,
+	  53983614,  54084451,  54185280,  54286100,  54386913,  54487718,  54588514,  54689303,
+	  54790083,  54890856,  54991620,  55092377,  55193125,  55293865,  55394597,  55495321,
+	  55596037,  55696744,  55797444,  55898135,  55998818,  56099492,  56200159,  56300817,
+	  56401467,  56502108,  56602742,  56703367,  56803983,  56904591,  57005191,  57105783,
+	  57206366,  57306941,  57407507,  57508065,  57608614,  57709155,  57809687,  57910211,
+	  58010727,  58111233,  58211732,  58312222,  58412703,  58513175,  58613639,  58714095,
+	  58814541,  58914979,  59015409,  59115830,  59216242,  59316645,  59417039,  59517425,
+	  59617802,  59718171,  59818530,  59918881,  60019223,  60119556,  60219880,  60320196,
+	  60420502,  60520800,  60621089,  60721369,  60821640,  60921902,  61022155,  61122399,
+	  61222634,  61322860,  61423077,  61523285,  61623484,  61723674,  61823854,  61924026,
+	  62024189,  62124342,  62224486,  62324622,  62424748,  62524865,  62624972,  62725071,
+	  62825160,  62925240,  63025311,  63125372,  63225424,  63325467,  63425501,  63525525,
+	  63625540,  63725545,  63825541,  63925528,  64025506,  64125474,  64225432,  64325381,
+	  64425321,  64525251,  64625172,  64725083,  64824984,  64924876,  65024759,  65124632,
+	  65224495,  65324349,  65424193,  65524028,  65623853,  65723668,  65823474,  65923270,
+	  66023056,  66122833,  66222599,  66322357,  66422104,  66521841,  66621569,  66721287,
+	  66820995,  66920694,  67020382,  67120061,  67219730,  67319388,  67419037,  67518677,
+	  67618306,  67717925,  67817534,  67917133,  68016723,  68116302,  68215871,  68315430,
+	  68414980,  68514519,  68614048,  68713567,  68813075,  68912574,  69012063,  69111541,
+	  69211009,  69310468,  69409915,  69509353,  69608781,  69708198,  69807605,  69907002,
+	  70006388,  70105764,  70205130,  70304485,  70403831,  70503165,  70602490,  70701804,
+	  70801108,  70900401,  70999684,  71098956,  71198218,  71297469,  71396710,  71495941,
+	  71595161,  71694370,  71793569,  71892757,  71991935,  72091102,  72190259,  72289405,
+	  72388540,  72487665,  72586779,  72685882,  72784975,  72884056,  72983128,  73082188,
+	  73181238,  73280277,  73379305,  73478322,  73577329,  73676325,  73775310,  73874284,
+	  73973247,  74072199,  74171141,  74270071,  74368991,  74467900,  74566797,  74665684,
+	  74764560,  74863425,  74962278,  75061121,  75159953,  75258773,  75357583,  75456382,
+	  75555169,  75653945,  75752710,  75851464,  75950207,  76048939,  76147660,  76246369,
+	  76345067,  76443754,  76542429,  76641094,  76739747,  76838389,  76937019,  77035638,
+	  77134246,  77232843,  77331428,  77430002,  77528564,  77627115,  77725655,  77824183,
+	  77922700,  78021205,  78119699,  78218181,  78316652,  78415111,  78513559,  78611995,
+	  78710420,  78808833,  78907234,  79005624,  79104002,  79202369,  79300724,  79399067,
+	  79497399,  79595719,  79694027,  79792323,  79890608,  79988881,  80087142,  80185392,
+	  80283630,  80381855,  80480069,  80578272,  80676462,  80774641,  80872807,  80970962,
+	  81069105,  81167236,  81265355,  81363462,  81461557,  81559640,  81657711,  81755770,
+	  81853817,  81951852,  82049875,  82147886,  82245884,  82343871,  82441846,  82539808,
+	  82637759,  82735697,  82833623,  82931536,  83029438,  83127328,  83225205,  83323070,
+	  83420922,  83518763,  83616591,  83714407,  83812210,  83910002,  84007780,  84105547,
+	  84203301,  84301043,  84398772,  84496489,  84594194,  84691886,  84789565,  84887232,
+	  84984887,  85082529,  85180159,  85277776,  85375381,  85472973,  85570552,  85668119,
+	  85765673,  85863215,  85960744,  86058260,  86155764,  86253255,  86350734,  86448199,
+	  86545652,  86643093,  86740520,  86837935,  86935337,  87032726,  87130102,  87227466,
+	  87324817,  87422155,  87519480,  87616792,  87714091,  87811377,  87908651,  88005911,
+	  88103159,  88200394,  88297615,  88394824,  88492020,  88589202,  88686372,  88783529,
+	  88880672,  88977803,  89074920,  89172024,  89269115,  89366194,  89463258,  89560310,
+	  89657349,  89754374,  89851386,  89948385,  90045371,  90142344,  90239303,  90336249,
+	  90433181,  90530101,  90627007,  90723900,  90820779,  90917645,  91014498,  91111337,
+	  91208163,  91304975,  91401774,  91498560,  91595332,  91692091,  91788836,  91885568,
+	  91982286,  92078991,  92175682,  92272359,  92369023,  92465674,  92562310,  92658934,
+	  92755543,  92852139,  92948721,  93045290,  93141845,  93238386,  93334914,  93431427,
+	  93527927,  93624414,  93720886,  93817345,  93913790,  94010221,  94106638,  94203042,
+	  94299431,  94395807,  94492169,  94588517,  94684851,  94781171,  94877477,  94973769,
+	  95070047,  95166312,  95262562,  95358798,  95455020,  95551229,  95647423,  95743603,
+	  95839769,  95935921,  96032059,  96128182,  96224292,  96320387,  96416468,  96512535,
+	  96608588,  96704627,  96800651,  96896661,  96992657,  97088639,  97184606,  97280560,
+	  97376498,  97472423,  97568333,  97664229,  97760110,  97855977,  97951830,  98047668,
+	  98143492,  98239301,  98335096,  98430877,  98526643,  98622394,  98718131,  98813854,
+	  98909562,  99005255,  99100934,  99196598,  99292248,  99387883,  99483503,  99579109,
+	  99674700,  99770277,  99865839,  99961386, 100056918, 100152436, 100247939, 100343427,
+	 100438901, 100534360, 100629804, 100725233, 100820647, 100916047, 101011431, 101106801,
+	 101202156, 101297496, 101392821, 101488132, 101583427, 101678707, 101773973, 101869223,
+	 101964459, 102059679, 102154885, 102250075, 102345251, 102440411, 102535556, 102630687,
+	 102725802, 102820902, 102915987, 103011056, 103106111, 103201150, 103296175, 103391184,
+	 103486178, 103581156, 103676120, 103771068, 103866001, 103960919, 104055821, 104150708,
+	 104245580, 104340436, 104435277, 104530103, 104624913, 104719708, 104814488, 104909252,
+	 105004000, 105098734, 105193452, 105288154, 105382841, 105477512, 105572168, 105666808,
+	 105761433, 105856042, 105950636, 106045214, 106139776, 106234323, 106328854, 106423370,
+	 106517870, 106612354, 106706823, 106801276, 106895713, 106990134, 107084540, 107178930,
+	 107273304, 107367663, 107462005, 107556332, 107650643, 107744939, 107839218, 107933481,
+	 108027729, 108121961, 108216177, 108310377, 108404561, 108498729, 108592881, 108687017,
+	 108781137, 108875241, 108969329, 109063401, 109157457, 109251497, 109345521, 109439529,
+	 109533521, 109627497, 109721456, 109815400, 109909327, 110003238, 110097133, 110191011,
+	 110284874, 110378720, 110472550, 110566364, 110660162, 110753943, 110847708, 110941457,
+	 111035189, 111128905, 111222605, 111316288, 111409955, 111503606, 111597240, 111690858,
+	 111784459, 111878044, 111971612, 112065164, 112158700, 112252219, 112345721, 112439207,
+	 112532677, 112626129, 112719566, 112812986, 112906389, 112999775, 113093145, 113186498,
+	 113279835, 113373155, 113466458, 113559745, 113653015, 113746268, 113839505, 113932724,
+	 114025927, 114119114, 114212283, 114305436, 114398572, 114491691, 114584793, 114677878,
+	 114770946, 114863998, 114957033, 115050050, 115143051, 115236035, 115329002, 115421952,
+	 115514885, 115607801, 115700700, 115793582, 115886447, 115979295, 116072126, 116164940,
+	 116257737, 116350516, 116443279, 116536024, 116628753, 116721464, 116814158, 116906834,
+	 116999494, 117092136, 117184762, 117277369, 117369960, 117462533, 117555090, 117647628,
+	 117740150, 117832654, 117925141, 118017611, 118110063, 118202498, 118294915, 118387315,
+	 118479698, 118572063, 118664411, 118756741, 118849054, 118941349, 119033627, 119125888,
+	 119218130, 119310356, 119402563, 119494754, 119586926, 119679081, 119771219, 119863339,
+	 119955441, 120047525, 120139592, 120231642, 120323673, 120415687, 120507683, 120599662,
+	 120691622, 120783565, 120875490, 120967398, 121059287, 121151159, 121243013, 121334849,
+	 121426668, 121518468, 121610251, 121702015, 121793762, 121885491, 121977202, 122068895,
+	 122160570, 122252227, 122343866, 122435488, 122527091, 122618676, 122710243, 122801792,
+	 122893323, 122984836, 123076331, 123167807, 123259266, 123350706, 123442129, 123533533,
+	 123624919, 123716287, 123807636, 123898968, 123990281, 124081576, 124172853, 124264111,
+	 124355351, 124446573, 124537777, 124628962, 124720129, 124811278, 124902408, 124993520,
+	 125084613, 125175688, 125266745, 125357783, 125448803, 125539804, 125630787, 125721752,
+	 125812698, 125903625, 125994534, 126085424, 126176296, 126267150, 126357984, 126448800,
+	 126539598, 126630377, 126721137, 126811879, 126902602, 126993306, 127083992, 127174659,
+	 127265307, 127355937, 127446548, 127537140, 127627713, 127718268, 127808804, 127899321,
+	 127989819, 128080298, 128170759, 128261200, 128351623, 128442027, 128532412, 128622778,
+	 128713125, 128803454, 128893763, 128984054, 129074325, 129164577, 129254811, 129345025,
+	 129435221, 129525397, 129615554, 129705693, 129795812, 129885912, 129975993, 130066055,
+	 130156098, 130246121, 130336126, 130426111, 130516077, 130606024, 130695952, 130785860,
+	 130875750, 130965620, 131055470, 131145302, 131235114, 131324907, 131414680, 131504435,
+	 131594170, 131683885, 131773581, 131863258, 131952916, 132042554, 132132172, 132221771,
+	 132311351, 132400911, 132490452, 132579973, 132669475, 132758957, 132848420, 132937863,
+	 133027287, 133116691, 133206076, 133295441, 133384786, 133474112, 133563418, 133652704,
+	 133741971, 133831218, 133920446, 134009653, 134098841, 134188010, 134277158, 134366287,
+	 134455396, 134544485, 134633555, 134722605, 134811634, 134900645, 134989635, 135078605,
+	 135167556, 135256486, 135345397, 135434288, 135523159, 135612010, 135700841, 135789652,
+	 135878443, 135967214, 136055965, 136144696, 136233407, 136322098, 136410770, 136499420,
+	 136588051, 136676662, 136765253, 136853823, 136942374, 137030904, 137119414, 137207904,
+	 137296374, 137384824, 137473253, 137561662, 137650051, 137738420, 137826768, 137915097,
+	 138003405, 138091692, 138179959, 138268206, 138356433, 138444639, 138532825, 138620991,
+	 138709136, 138797261, 138885365, 138973449, 139061513, 139149556, 139237578, 139325580,
+	 139413562, 139501523, 139589464, 139677384, 139765283, 139853162, 139941021, 140028859,
+	 140116676, 140204472, 140292248, 140380004, 140467738, 140555453, 140643146, 140730819,
+	 140818471, 140906102, 140993713, 141081302, 141168872, 141256420, 141343947, 141431454,
+	 141518940, 141606405, 141693850, 141781273, 141868676, 141956058, 142043418, 142130758,
+	 142218078, 142305376, 142392653, 142479909, 142567145, 142654359, 142741553, 142828725,
+	 142915876, 143003007, 143090116, 143177205, 143264272, 143351318, 143438343, 143525347,
+	 143612330, 143699292, 143786233, 143873152, 143960050, 144046928, 144133784, 144220618,
+	 144307432, 144394224, 144480995, 144567745, 144654474, 144741181, 144827867, 144914532,
+	 145001176, 145087798, 145174399, 145260978, 145347536, 145434073, 145520588, 145607082,
+	 145693554, 145780005, 145866435, 145952843, 146039230, 146125595, 146211939, 146298261,
+	 146384562, 146470841, 146557099, 146643335, 146729549, 146815742, 146901914, 146988063,
+	 147074192, 147160298, 147246383, 147332446, 147418488, 147504508, 147590506, 147676482,
+	 147762437, 147848370, 147934281, 148020171, 148106039, 148191884, 148277709, 148363511,
+	 148449292, 148535050, 148620787, 148706502, 148792195, 148877867, 148963516, 149049143,
+	 149134749, 149220332, 149305894, 149391434, 149476952, 149562447, 149647921, 149733373,
+	 149818802, 149904210, 149989596, 150074959, 150160301, 150245620, 150330918, 150416193,
+	 150501446, 150586677, 150671886, 150757072, 150842237, 150927379, 151012499, 151097597,
+	 151182673, 151267726, 151352757, 151437766, 151522753, 151607717, 151692659, 151777579,
+	 151862477, 151947352, 152032204, 152117035, 152201843, 152286629, 152371392, 152456133,
+	 152540851, 152625547, 152710221, 152794872, 152879500, 152964106, 153048690, 153133251,
+	 153217790, 153302306, 153386799, 153471270, 153555719, 153640145, 153724548, 153808928,
+	 153893286, 153977622, 154061934, 154146224, 154230492, 154314737, 154398959, 154483158,
+	 154567334, 154651488, 154735619, 154819728, 154903813, 154987876, 155071916, 155155933,
+	 155239928, 155323899, 155407848, 155491774, 155575677, 155659557, 155743414, 155827248,
+	 155911060, 155994848, 156078614, 156162356, 156246076, 156329772, 156413446, 156497097,
+	 156580724, 156664329, 156747910, 156831469, 156915004, 156998517, 157082006, 157165472,
+	 157248915, 157332335, 157415732, 157499105, 157582456, 157665783, 157749087, 157832368,
+	 157915626, 157998860, 158082071, 158165259, 158248424, 158331565, 158414684, 158497778,
+	 158580850, 158663898, 158746923, 158829925, 158912903, 158995858, 159078789, 159161697,
+	 159244582, 159327443, 159410281, 159493095, 159575886, 159658653, 159741397, 159824118,
+	 159906814, 159989488, 160072138, 160154764, 160237367, 160319946, 160402502, 160485034,
+	 160567542, 160650027, 160732488, 160814926, 160897340, 160979730, 161062096, 161144439,
+	 161226759, 161309054, 161391326, 161473574, 161555798, 161637999, 161720175, 161802328,
+	 161884457, 161966563, 162048644, 162130702, 162212736, 162294746, 162376732, 162458694,
+	 162540633, 162622547, 162704437, 162786304, 162868147, 162949965, 163031760, 163113531,
+	 163195278, 163277001, 163358699, 163440374, 163522025, 163603651, 163685254, 163766833,
+	 163848387, 163929917, 164011424, 164092906, 164174364, 164255797, 164337207, 164418593,
+	 164499954, 164581291, 164662604, 164743893, 164825157, 164906397, 164987613, 165068805,
+	 165149973, 165231116, 165312235, 165393329, 165474399, 165555445, 165636467, 165717464,
+	 165798437, 165879385, 165960309, 166041209, 166122084, 166202935, 166283761, 166364563,
+	 166445340, 166526093, 166606822, 166687526, 166768205, 166848860, 166929490, 167010096,
+	 167090677, 167171234, 167251766, 167332274, 167412756, 167493215, 167573648, 167654057,
+	 167734442, 167814801, 167895136, 167975447, 168055732, 168135993, 168216229, 168296440,
+	 168376627, 168456789, 168536926, 168617038, 168697126, 168777189, 168857227, 168937240,
+	 169017228, 169097191, 169177130, 169257043, 169336932, 169416796, 169496635, 169576449,
+	 169656238, 169736002, 169815741, 169895455, 169975144, 170054808, 170134447, 170214061,
+	 170293651, 170373215, 170452754, 170532267, 170611756, 170691220, 170770659, 170850072,
+	 170929461, 171008824, 171088162, 171167475, 171246763, 171326025, 171405263, 171484475,
+	 171563662, 171642824, 171721960, 171801071, 171880157, 171959218, 172038253, 172117263,
+	 172196248, 172275208, 172354142, 172433051, 172511934, 172590792, 172669625, 172748432,
+	 172827214, 172905970, 172984701, 173063407, 173142087, 173220742, 173299371, 173377975,
+	 173456553, 173535105, 173613633, 173692134, 173770610, 173849061, 173927486, 174005885,
+	 174084259, 174162607, 174240930, 174319227, 174397498, 174475744, 174553964, 174632158,
+	 174710327, 174788470, 174866587, 174944678, 175022744, 175100784, 175178799, 175256787,
+	 175334750, 175412687, 175490598, 175568484, 175646343, 175724177, 175801985, 175879767,
+	 175957523, 176035253, 176112958, 176190636, 176268289, 176345915, 176423516, 176501091,
+	 176578640, 176656163, 176733659, 176811130, 176888575, 176965994, 177043387, 177120754,
+	 177198094, 177275409, 177352698, 177429960, 177507197, 177584407, 177661591, 177738749,
+	 177815881, 177892987, 177970067, 178047120, 178124148, 178201149, 178278123, 178355072,
+	 178431995, 178508891, 178585761, 178662604, 178739422, 178816213, 178892978, 178969716,
+	 179046428, 179123114, 179199774, 179276407, 179353014, 179429594, 179506148, 179582676,
+	 179659177, 179735652, 179812100, 179888522, 179964917, 180041286, 180117629, 180193945,
+	 180270234, 180346497, 180422734, 180498944, 180575127, 180651284, 180727414, 180803518,
+	 180879595, 180955645, 181031669, 181107667, 181183637, 181259581, 181335499, 181411389,
+	 181487253, 181563090, 181638901, 181714685, 181790442, 181866172, 181941876, 182017553,
+	 182093203, 182168827, 182244423, 182319993, 182395536, 182471052, 182546541, 182622004,
+	 182697439, 182772848, 182848230, 182923585, 182998913, 183074214, 183149488, 183224735,
+	 183299956, 183375149, 183450315, 183525455, 183600567, 183675653, 183750711, 183825742,
+	 183900747, 183975724, 184050674, 184125597, 184200494, 184275363, 184350204, 184425019,
+	 184499807, 184574567, 184649301, 184724007, 184798686, 184873338, 184947963, 185022560,
+	 185097131, 185171674, 185246189, 185320678, 185395139, 185469573, 185543980, 185618360,
+	 185692712, 185767037, 185841334, 185915605, 185989848, 186064063, 186138251, 186212412,
+	 186286546, 186360652, 186434730, 186508781, 186582805, 186656802, 186730770, 186804712,
+	 186878626, 186952512, 187026371, 187100203, 187174007, 187247783, 187321532, 187395253,
+	 187468947, 187542613, 187616252, 187689863, 187763446, 187837002, 187910530, 187984031,
+	 188057504, 188130949, 188204366, 188277756, 188351119, 188424453, 188497760, 188571039,
+	 188644290, 188717514, 188790710, 188863878, 188937018, 189010131, 189083215, 189156272,
+	 189229301, 189302303, 189375276, 189448222, 189521139, 189594029, 189666891, 189739725,
+	 189812531, 189885309, 189958060, 190030782, 190103477, 190176143, 190248782, 190321392,
+	 190393975, 190466529, 190539056, 190611554, 190684025, 190756467, 190828881, 190901268,
+	 190973626, 191045956, 191118258, 191190532, 191262778, 191334995, 191407185, 191479346,
+	 191551480, 191623585, 191695662, 191767710, 191839731, 191911723, 191983687, 192055623,
+	 192127530, 192199410, 192271261, 192343084, 192414878, 192486644, 192558382, 192630092,
+	 192701773, 192773426, 192845050, 192916646, 192988214, 193059754, 193131265, 193202747,
+	 193274202, 193345627, 193417025, 193488394, 193559734, 193631046, 193702329, 193773585,
+	 193844811, 193916009, 193987179, 194058319, 194129432, 194200516, 194271571, 194342598,
+	 194413596, 194484566, 194555506, 194626419, 194697303, 194768158, 194838984, 194909782,
+	 194980551, 195051291, 195122003, 195192686, 195263341, 195333966, 195404563, 195475131,
+	 195545671, 195616182, 195686663, 195757117, 195827541, 195897936, 195968303, 196038641,
+	 196108950, 196179230, 196249482, 196319704, 196389898, 196460063, 196530198, 196600305,
+	 196670384, 196740433, 196810453, 196880444, 196950406, 197020340, 197090244, 197160119,
+	 197229966, 197299783, 197369571, 197439331, 197509061, 197578762, 197648435, 197718078,
+	 197787692, 197857277, 197926832, 197996359, 198065857, 198135325, 198204765, 198274175,
+	 198343556, 198412908, 198482230, 198551524, 198620788, 198690023, 198759229, 198828406,
+	 198897553, 198966671, 199035760, 199104820, 199173850, 199242851, 199311823, 199380765,
+	 199449678, 199518562, 199587417, 199656242, 199725037, 199793804, 199862541, 199931248,
+	 199999926, 200068575, 200137194, 200205784, 200274345, 200342876, 200411377, 200479849,
+	 200548292, 200616705, 200685088, 200753443, 200821767, 200890062, 200958327, 201026563,
+	 201094770, 201162946, 201231094, 201299211, 201367299, 201435357, 201503386, 201571385,
+	 201639355, 201707295, 201775205, 201843085, 201910936, 201978757, 202046548, 202114310,
+	 202182042, 202249744, 202317416, 202385059, 202452672, 202520255, 202587809, 202655332,
+	 202722826, 202790290, 202857724, 202925128, 202992503, 203059847, 203127162, 203194447,
+	 203261702, 203328927, 203396122, 203463288, 203530423, 203597528, 203664604, 203731649,
+	 203798665, 203865650, 203932606, 203999532, 204066427, 204133293, 204200128, 204266934,
+	 204333709, 204400455, 204467170, 204533856, 204600511, 204667136, 204733731, 204800296,
+	 204866831, 204933335, 204999810, 205066254, 205132669, 205199053, 205265407, 205331730,
+	 205398024, 205464287, 205530520, 205596723, 205662896, 205729038, 205795150, 205861232,
+	 205927284, 205993305, 206059296, 206125257, 206191187, 206257087, 206322957, 206388796,
+	 206454605, 206520384, 206586132, 206651850, 206717538, 206783195, 206848821, 206914418,
+	 206979983, 207045519, 207111024, 207176498, 207241942, 207307356, 207372739, 207438091,
+	 207503414, 207568705, 207633966, 207699197, 207764396, 207829566, 207894705, 207959813,
+	 208024891, 208089938, 208154954, 208219940, 208284895, 208349820, 208414714, 208479577,
+	 208544410, 208609212, 208673983, 208738723, 208803433, 208868112, 208932761, 208997379,
+	 209061966, 209126522, 209191047, 209255542, 209320006, 209384439, 209448842, 209513213,
+	 209577554, 209641864, 209706143, 209770391, 209834609, 209898795, 209962951, 210027076,
+	 210091170, 210155233, 210219265, 210283266, 210347236, 210411176, 210475084, 210538961,
+	 210602808, 210666623, 210730408, 210794161, 210857884, 210921575, 210985236, 211048865,
+	 211112464, 211176031, 211239568, 211303073, 211366547, 211429990, 211493402, 211556783,
+	 211620133, 211683451, 211746739, 211809995, 211873221, 211936415, 211999578, 212062709,
+	 212125810, 212188879, 212251917, 212314924, 212377900, 212440844, 212503758, 212566640,
+	 212629490, 212692310, 212755098, 212817855, 212880580, 212943275, 213005937, 213068569,
+	 213131169, 213193738, 213256276, 213318782, 213381257, 213443700, 213506112, 213568493,
+	 213630842, 213693160, 213755447, 213817702, 213879925, 213942117, 214004278, 214066407,
+	 214128505, 214190571, 214252605, 214314609, 214376580, 214438520, 214500429, 214562306,
+	 214624151, 214685965, 214747748, 214809498, 214871218, 214932905, 214994561, 215056185,
+	 215117778, 215179339, 215240869, 215302366, 215363832, 215425267, 215486670, 215548041,
+	 215609380, 215670688, 215731964, 215793208, 215854420, 215915601, 215976750, 216037867,
+	 216098952, 216160006, 216221028, 216282018, 216342976, 216403903, 216464797, 216525660,
+	 216586491, 216647290, 216708057, 216768793, 216829496, 216890168, 216950807, 217011415,
+	 217071991, 217132535, 217193047, 217253527, 217313975, 217374391, 217434775, 217495127,
+	 217555448, 217615736, 217675992, 217736216, 217796408, 217856568, 217916697, 217976793,
+	 218036857, 218096889, 218156888, 218216856, 218276792, 218336695, 218396567, 218456406,
+	 218516213, 218575988, 218635731, 218695442, 218755121, 218814767, 218874381, 218933964,
+	 218993513, 219053031, 219112516, 219171970, 219231391, 219290779, 219350136, 219409460,
+	 219468752, 219528012, 219587239, 219646434, 219705597, 219764728, 219823826, 219882892,
+	 219941925, 220000926, 220059895, 220118832, 220177736, 220236607, 220295447, 220354254,
+	 220413028, 220471770, 220530480, 220589157, 220647802, 220706414, 220764994, 220823541,
+	 220882056, 220940539, 220998989, 221057406, 221115791, 221174143, 221232463, 221290751,
+	 221349006, 221407228, 221465417, 221523575, 221581699, 221639791, 221697850, 221755877,
+	 221813871, 221871833, 221929762, 221987658, 222045522, 222103353, 222161151, 222218916,
+	 222276649, 222334350, 222392017, 222449652, 222507254, 222564823, 222622360, 222679864,
+	 222737335, 222794774, 222852179, 222909552, 222966892, 223024199, 223081474, 223138716,
+	 223195925, 223253101, 223310244, 223367354, 223424432, 223481476, 223538488, 223595467,
+	 223652413, 223709326, 223766206, 223823054, 223879868, 223936650, 223993398, 224050114,
+	 224106797, 224163446, 224220063, 224276647, 224333198, 224389715, 224446200, 224502652,
+	 224559071, 224615456, 224671809, 224728129, 224784415, 224840669, 224896889, 224953077,
+	 225009231, 225065352, 225121440, 225177495, 225233517, 225289506, 225345462, 225401384,
+	 225457274, 225513130, 225568953, 225624743, 225680499, 225736223, 225791913, 225847570,
+	 225903194, 225958785, 226014342, 226069866, 226125357, 226180815, 226236239, 226291630,
+	 226346988, 226402313, 226457604, 226512862, 226568087, 226623278, 226678436, 226733561,
+	 226788652, 226843710, 226898735, 226953726, 227008684, 227063608, 227118499, 227173357,
+	 227228181, 227282972, 227337729, 227392453, 227447144, 227501801, 227556425, 227611015,
+	 227665572, 227720095, 227774584, 227829041, 227883463, 227937853, 227992208, 228046530,
+	 228100819, 228155074, 228209296, 228263483, 228317638, 228371759, 228425846, 228479899,
+	 228533919, 228587906, 228641859, 228695778, 228749663, 228803515, 228857333, 228911118,
+	 228964869, 229018586, 229072270, 229125920, 229179536, 229233118, 229286667, 229340182,
+	 229393663, 229447111, 229500525, 229553905, 229607251, 229660564, 229713842, 229767087,
+	 229820298, 229873476, 229926619, 229979729, 230032805, 230085847, 230138856, 230191830,
+	 230244771, 230297677, 230350550, 230403389, 230456194, 230508965, 230561703, 230614406,
+	 230667075, 230719711, 230772313, 230824880, 230877414, 230929914, 230982380, 231034811,
+	 231087209, 231139573, 231191903, 231244199, 231296461, 231348689, 231400882, 231453042,
+	 231505168, 231557260, 231609317, 231661341, 231713330, 231765286, 231817207, 231869094,
+	 231920948, 231972767, 232024552, 232076302, 232128019, 232179702, 232231350, 232282964,
+	 232334544, 232386090, 232437602, 232489080, 232540523, 232591932, 232643307, 232694648,
+	 232745954, 232797227, 232848465, 232899668, 232950838, 233001973, 233053074, 233104141,
+	 233155174, 233206172, 233257136, 233308065, 233358960, 233409821, 233460648, 233511440,
+	 233562198, 233612922, 233663611, 233714266, 233764886, 233815473, 233866024, 233916542,
+	 233967025, 234017473, 234067887, 234118267, 234168612, 234218923, 234269199, 234319441,
+	 234369649, 234419822, 234469960, 234520064, 234570134, 234620169, 234670169, 234720135,
+	 234770067, 234819964, 234869826, 234919654, 234969447, 235019206, 235068930, 235118620,
+	 235168275, 235217896, 235267482, 235317033, 235366550, 235416032, 235465479, 235514892,
+	 235564270, 235613614, 235662923, 235712197, 235761436, 235810641, 235859811, 235908947,
+	 235958048, 236007114, 236056145, 236105142, 236154104, 236203031, 236251924, 236300782,
+	 236349605, 236398393, 236447146, 236495865, 236544549, 236593198, 236641812, 236690392,
+	 236738937, 236787447, 236835922, 236884362, 236932767, 236981138, 237029474, 237077775,
+	 237126041, 237174272, 237222468, 237270629, 237318756, 237366847, 237414904, 237462926,
+	 237510913, 237558864, 237606781, 237654663, 237702510, 237750323, 237798100, 237845842,
+	 237893549, 237941221, 237988858, 238036461, 238084028, 238131560, 238179057, 238226519,
+	 238273946, 238321338, 238368695, 238416017, 238463304, 238510556, 238557773, 238604954,
+	 238652101, 238699212, 238746289, 238793330, 238840336, 238887307, 238934243, 238981144,
+	 239028009, 239074839, 239121635, 239168395, 239215120, 239261809, 239308464, 239355083,
+	 239401668, 239448216, 239494730, 239541209, 239587652, 239634060, 239680433, 239726770,
+	 239773073, 239819340, 239865571, 239911768, 239957929, 240004055, 240050146, 240096201,
+	 240142221, 240188206, 240234155, 240280069, 240325948, 240371791, 240417599, 240463372,
+	 240509109, 240554811, 240600477, 240646108, 240691704, 240737264, 240782789, 240828279,
+	 240873733, 240919152, 240964535, 241009883, 241055195, 241100472, 241145713, 241190919,
+	 241236090, 241281225, 241326325, 241371389, 241416417, 241461410, 241506368, 241551290,
+	 241596176, 241641027, 241685843, 241730623, 241775367, 241820076, 241864749, 241909387,
+	 241953989, 241998555, 242043086, 242087581, 242132041, 242176465, 242220854, 242265207,
+	 242309524, 242353805, 242398051, 242442262, 242486436, 242530575, 242574679, 242618746,
+	 242662778, 242706774, 242750735, 242794660, 242838549, 242882402, 242926220, 242970002,
+	 243013748, 243057459, 243101134, 243144773, 243188376, 243231944, 243275475, 243318971,
+	 243362431, 243405856, 243449244, 243492597, 243535914, 243579195, 243622441, 243665650,
+	 243708824, 243751961, 243795063, 243838130, 243881160, 243924154, 243967113, 244010035,
+	 244052922, 244095773, 244138588, 244181367, 244224110, 244266817, 244309489, 244352124,
+	 244394723, 244437287, 244479814, 244522306, 244564762, 244607181, 244649565, 244691913,
+	 244734224, 244776500, 244818740, 244860944, 244903111, 244945243, 244987339, 245029398,
+	 245071422, 245113409, 245155361, 245197276, 245239156, 245280999, 245322806, 245364578,
+	 245406313, 245448012, 245489675, 245531301, 245572892, 245614447, 245655965, 245697447,
+	 245738894, 245780304, 245821677, 245863015, 245904317, 245945582, 245986811, 246028005,
+	 246069161, 246110282, 246151367, 246192415, 246233427, 246274403, 246315343, 246356246,
+	 246397113, 246437944, 246478739, 246519497, 246560220, 246600906, 246641555, 246682169,
+	 246722746, 246763287, 246803791, 246844260, 246884692, 246925087, 246965447, 247005770,
+	 247046056, 247086307, 247126521, 247166698, 247206840, 247246945, 247287013, 247327045,
+	 247367041, 247407001, 247446924, 247486811, 247526661, 247566475, 247606252, 247645993,
+	 247685698, 247725366, 247764998, 247804594, 247844152, 247883675, 247923161, 247962611,
+	 248002024, 248041400, 248080740, 248120044, 248159311, 248198542, 248237736, 248276894,
+	 248316015, 248355099, 248394147, 248433159, 248472134, 248511073, 248549974, 248588840,
+	 248627669, 248666461, 248705217, 248743936, 248782618, 248821264, 248859874, 248898446,
+	 248936982, 248975482, 249013945, 249052371, 249090761, 249129114, 249167430, 249205710,
+	 249243953, 249282160, 249320329, 249358462, 249396559, 249434619, 249472642, 249510628,
+	 249548578, 249586491, 249624367, 249662207, 249700009, 249737776, 249775505, 249813198,
+	 249850854, 249888473, 249926055, 249963601, 250001110, 250038582, 250076017, 250113416,
+	 250150778, 250188103, 250225391, 250262642, 250299857, 250337035, 250374176, 250411280,
+	 250448347, 250485378, 250522372, 250559328, 250596248, 250633132, 250669978, 250706787,
+	 250743560, 250780295, 250816994, 250853656, 250890281, 250926869, 250963420, 250999935,
+	 251036412, 251072852, 251109256, 251145622, 251181952, 251218245, 251254501, 251290719,
+	 251326901, 251363046, 251399154, 251435225, 251471259, 251507256, 251543216, 251579139,
+	 251615025, 251650874, 251686686, 251722461, 251758199, 251793900, 251829564, 251865191,
+	 251900781, 251936333, 251971849, 252007328, 252042769, 252078174, 252113541, 252148872,
+	 252184165, 252219421, 252254640, 252289822, 252324967, 252360075, 252395146, 252430179,
+	 252465176, 252500135, 252535057, 252569943, 252604790, 252639601, 252674375, 252709111,
+	 252743810, 252778473, 252813098, 252847685, 252882236, 252916749, 252951225, 252985664,
+	 253020066, 253054431, 253088758, 253123048, 253157301, 253191517, 253225695, 253259836,
+	 253293940, 253328007, 253362036, 253396028, 253429983, 253463901, 253497781, 253531624,
+	 253565430, 253599199, 253632930, 253666624, 253700280, 253733900, 253767482, 253801026,
+	 253834534, 253868004, 253901436, 253934832, 253968189, 254001510, 254034793, 254068039,
+	 254101248, 254134419, 254167553, 254200649, 254233708, 254266730, 254299714, 254332661,
+	 254365570, 254398442, 254431277, 254464074, 254496834, 254529556, 254562241, 254594888,
+	 254627499, 254660071, 254692606, 254725104, 254757564, 254789987, 254822372, 254854720,
+	 254887030, 254919303, 254951538, 254983736, 255015896, 255048019, 255080105, 255112152,
+	 255144163, 255176135, 255208071, 255239968, 255271829, 255303651, 255335436, 255367184,
+	 255398894, 255430566, 255462201, 255493798, 255525358, 255556880, 255588365, 255619811,
+	 255651221, 255682593, 255713927, 255745223, 255776482, 255807703, 255838887, 255870033,
+	 255901142, 255932212, 255963246, 255994241, 256025199, 256056119, 256087002, 256117847,
+	 256148654, 256179423, 256210155, 256240849, 256271506, 256302125, 256332706, 256363249,
+	 256393755, 256424223, 256454653, 256485046, 256515401, 256545718, 256575997, 256606239,
+	 256636443, 256666609, 256696738, 256726828, 256756881, 256786896, 256816874, 256846814,
+	 256876715, 256906579, 256936406, 256966194, 256995945, 257025658, 257055333, 257084970,
+	 257114570, 257144132, 257173656, 257203142, 257232590, 257262000, 257291373, 257320708,
+	 257350004, 257379263, 257408485, 257437668, 257466813, 257495921, 257524991, 257554023,
+	 257583017, 257611973, 257640891, 257669771, 257698614, 257727418, 257756185, 257784914,
+	 257813604, 257842257, 257870872, 257899449, 257927988, 257956490, 257984953, 258013378,
+	 258041766, 258070115, 258098426, 258126700, 258154935, 258183133, 258211293, 258239414,
+	 258267498, 258295544, 258323551, 258351521, 258379453, 258407346, 258435202, 258463020,
+	 258490799, 258518541, 258546245, 258573910, 258601538, 258629127, 258656679, 258684192,
+	 258711668, 258739105, 258766504, 258793866, 258821189, 258848474, 258875721, 258902930,
+	 258930101, 258957234, 258984329, 259011385, 259038404, 259065384, 259092327, 259119231,
+	 259146097, 259172925, 259199715, 259226467, 259253181, 259279856, 259306494, 259333093,
+	 259359654, 259386177, 259412662, 259439109, 259465517, 259491888, 259518220, 259544514,
+	 259570770, 259596988, 259623167, 259649309, 259675412, 259701477, 259727504, 259753492,
+	 259779443, 259805355, 259831229, 259857065, 259882862, 259908621, 259934342, 259960025,
+	 259985670, 260011276, 260036845, 260062375, 260087866, 260113320, 260138735, 260164112,
+	 260189450, 260214751, 260240013, 260265237, 260290422, 260315570, 260340679, 260365749,
+	 260390782, 260415776, 260440732, 260465649, 260490529, 260515369, 260540172, 260564936,
+	 260589662, 260614350, 260638999, 260663610, 260688183, 260712717, 260737213, 260761671,
+	 260786090, 260810471, 260834813, 260859118, 260883383, 260907611, 260931800, 260955951,
+	 260980063, 261004137, 261028173, 261052170, 261076129, 261100049, 261123931, 261147775,
+	 261171580, 261195347, 261219075, 261242765, 261266416, 261290029, 261313604, 261337140,
+	 261360638, 261384098, 261407518, 261430901, 261454245, 261477551, 261500818, 261524046,
+	 261547237, 261570388, 261593502, 261616576, 261639613, 261662610, 261685570, 261708491,
+	 261731373, 261754217, 261777022, 261799789, 261822518, 261845208, 261867859, 261890472,
+	 261913046, 261935582, 261958079, 261980538, 262002958, 262025340, 262047683, 262069988,
+	 262092254, 262114482, 262136671, 262158821, 262180933, 262203006, 262225041, 262247037,
+	 262268995, 262290914, 262312795, 262334637, 262356440, 262378205, 262399931, 262421618,
+	 262443267, 262464878, 262486450, 262507983, 262529477, 262550933, 262572351, 262593729,
+	 262615070, 262636371, 262657634, 262678858, 262700044, 262721191, 262742299, 262763369,
+	 262784400, 262805392, 262826346, 262847261, 262868138, 262888975, 262909774, 262930535,
+	 262951257, 262971940, 262992584, 263013190, 263033757, 263054286, 263074775, 263095226,
+	 263115639, 263136012, 263156347, 263176643, 263196901, 263217120, 263237300, 263257441,
+	 263277544, 263297608, 263317633, 263337620, 263357567, 263377477, 263397347, 263417178,
+	 263436971, 263456725, 263476441, 263496117, 263515755, 263535354, 263554915, 263574436,
+	 263593919, 263613363, 263632768, 263652135, 263671463, 263690751, 263710002, 263729213,
+	 263748386, 263767519, 263786614, 263805671, 263824688, 263843667, 263862607, 263881508,
+	 263900370, 263919193, 263937978, 263956724, 263975431, 263994099, 264012728, 264031318,
+	 264049870, 264068383, 264086857, 264105292, 264123688, 264142046, 264160364, 264178644,
+	 264196885, 264215087, 264233250, 264251375, 264269460, 264287507, 264305514, 264323483,
+	 264341413, 264359304, 264377156, 264394970, 264412744, 264430480, 264448177, 264465834,
+	 264483453, 264501033, 264518574, 264536077, 264553540, 264570964, 264588350, 264605696,
+	 264623004, 264640273, 264657502, 264674693, 264691845, 264708958, 264726032, 264743068,
+	 264760064, 264777021, 264793939, 264810819, 264827659, 264844461, 264861223, 264877947,
+	 264894632, 264911277, 264927884, 264944452, 264960981, 264977471, 264993922, 265010333,
+	 265026706, 265043040, 265059335, 265075591, 265091808, 265107986, 265124125, 265140225,
+	 265156286, 265172309, 265188292, 265204236, 265220141, 265236007, 265251834, 265267622,
+	 265283371, 265299081, 265314752, 265330384, 265345977, 265361531, 265377046, 265392521,
+	 265407958, 265423356, 265438715, 265454035, 265469315, 265484557, 265499759, 265514923,
+	 265530048, 265545133, 265560179, 265575187, 265590155, 265605084, 265619974, 265634825,
+	 265649638, 265664410, 265679144, 265693839, 265708495, 265723112, 265737689, 265752228,
+	 265766727, 265781187, 265795609, 265809991, 265824334, 265838638, 265852903, 265867129,
+	 265881315, 265895463, 265909571, 265923641, 265937671, 265951662, 265965614, 265979527,
+	 265993401, 266007235, 266021031, 266034787, 266048505, 266062183, 266075822, 266089422,
+	 266102983, 266116504, 266129987, 266143430, 266156834, 266170200, 266183526, 266196812,
+	 266210060, 266223268, 266236438, 266249568, 266262659, 266275711, 266288724, 266301697,
+	 266314632, 266327527, 266340383, 266353200, 266365977, 266378716, 266391415, 266404075,
+	 266416696, 266429278, 266441821, 266454324, 266466789, 266479214, 266491600, 266503946,
+	 266516254, 266528522, 266540751, 266552941, 266565092, 266577203, 266589276, 266601309,
+	 266613302, 266625257, 266637173, 266649049, 266660886, 266672684, 266684442, 266696162,
+	 266707842, 266719483, 266731084, 266742647, 266754170, 266765654, 266777099, 266788504,
+	 266799871, 266811198, 266822486, 266833734, 266844944, 266856114, 266867244, 266878336,
+	 266889388, 266900402, 266911375, 266922310, 266933205, 266944061, 266954878, 266965656,
+	 266976394, 266987093, 266997753, 267008373, 267018955, 267029497, 267039999, 267050463,
+	 267060887, 267071272, 267081617, 267091924, 267102191, 267112418, 267122607, 267132756,
+	 267142866, 267152937, 267162968, 267172960, 267182913, 267192826, 267202700, 267212535,
+	 267222331, 267232087, 267241804, 267251481, 267261120, 267270719, 267280278, 267289799,
+	 267299280, 267308722, 267318124, 267327487, 267336811, 267346096, 267355341, 267364547,
+	 267373713, 267382841, 267391929, 267400977, 267409987, 267418956, 267427887, 267436778,
+	 267445630, 267454443, 267463216, 267471950, 267480645, 267489300, 267497916, 267506493,
+	 267515030, 267523528, 267531986, 267540406, 267548786, 267557126, 267565427, 267573689,
+	 267581912, 267590095, 267598238, 267606343, 267614408, 267622434, 267630420, 267638367,
+	 267646275, 267654143, 267661972, 267669761, 267677512, 267685222, 267692894, 267700526,
+	 267708119, 267715672, 267723186, 267730660, 267738096, 267745491, 267752848, 267760165,
+	 267767443, 267774681, 267781880, 267789039, 267796160, 267803240, 267810282, 267817284,
+	 267824246, 267831170, 267838053, 267844898, 267851703, 267858469, 267865195, 267871882,
+	 267878529, 267885137, 267891706, 267898235, 267904725, 267911176, 267917587, 267923958,
+	 267930291, 267936584, 267942837, 267949051, 267955226, 267961361, 267967457, 267973513,
+	 267979530, 267985508, 267991446, 267997345, 268003204, 268009024, 268014805, 268020546,
+	 268026248, 268031910, 268037533, 268043116, 268048660, 268054165, 268059630, 268065056,
+	 268070442, 268075789, 268081097, 268086365, 268091593, 268096783, 268101932, 268107043,
+	 268112114, 268117145, 268122137, 268127090, 268132003, 268136877, 268141711, 268146506,
+	 268151262, 268155978, 268160654, 268165291, 268169889, 268174447, 268178966, 268183445,
+	 268187885, 268192286, 268196647, 268200969, 268205251, 268209494, 268213697, 268217861,
+	 268221985, 268226070, 268230115, 268234122, 268238088, 268242015, 268245903, 268249751,
+	 268253560, 268257329, 268261059, 268264750, 268268401, 268272012, 268275584, 268279117,
+	 268282610, 268286064, 268289478, 268292853, 268296188, 268299484, 268302740, 268305957,
+	 268309135, 268312273, 268315372, 268318431, 268321450, 268324431, 268327371, 268330273,
+	 268333134, 268335957, 268338740, 268341483, 268344187, 268346852, 268349477, 268352062,
+	 268354608, 268357115, 268359582, 268362010, 268364398, 268366747, 268369056, 268371326,
+	 268373556, 268375747, 268377899, 268380010, 268382083, 268384116, 268386109, 268388064,
+	 268389978, 268391853, 268393689, 268395485, 268397242, 268398959, 268400637, 268402275,
+	 268403874, 268405433, 268406953, 268408433, 268409874, 268411276, 268412638, 268413960,
+	 268415243, 268416487, 268417691, 268418855, 268419981, 268421066, 268422112, 268423119,
+	 268424086, 268425014, 268425902, 268426751, 268427560, 268428330, 268429061, 268429751,
+	 268430403, 268431015, 268431587, 268432120, 268432614, 268433068, 268433482, 268433857,
+	 268434193, 268434489, 268434745, 268434963, 268435140, 268435278, 268435377, 268435436
+};
+
+
+#endif //__FIXEDPOINTSINLUT_HEADERFILE__
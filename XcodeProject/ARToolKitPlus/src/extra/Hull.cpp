@@ -40,6 +40,7 @@
 
 #include <ARToolKitPlus/extra/Hull.h>
 #include <assert.h>
+#include <stdlib.h>
 
 
 namespace ARToolKitPlus {
@@ -204,11 +205,64 @@ nearHull_2D(const MarkerPoint* P, int n, int k, MarkerPoint* H)
 	if (minmax != minmin)
 		H[++top] = P[minmin];  // push joining endpoint onto stack
 
-	delete B;                  // free bins before returning
+	delete [] B;               // free bins before returning
 	return top+1;              // # of points on the stack
 }
 
 
+static int
+compareMarkerPoints(const void* nA, const void* nB)
+{
+	const MarkerPoint* a = (const MarkerPoint*)nA;
+	const MarkerPoint* b = (const MarkerPoint*)nB;
+
+	if(a->x!=b->x)
+		return a->x<b->x ? -1 : 1;
+	if(a->y!=b->y)
+		return a->y<b->y ? -1 : 1;
+	return 0;
+}
+
+
+int
+convexHull_2D(MarkerPoint* P, int n, MarkerPoint* H)
+{
+	int k=0;
+
+	if(n<=0)
+		return 0;
+
+	qsort(P, n, sizeof(MarkerPoint), compareMarkerPoints);
+
+	if(n<3)
+	{
+		H[k++] = P[0];
+		if(n==2 && compareMarkerPoints(&P[0], &P[1])!=0)
+			H[k++] = P[1];
+		return k;
+	}
+
+	// lower hull from left to right
+	for(int i=0; i<n; i++)
+	{
+		while(k>=2 && isLeft(H[k-2], H[k-1], P[i])<=0)
+			k--;
+		H[k++] = P[i];
+	}
+
+	// upper hull from right to left
+	for(int i=n-2, t=k+1; i>=0; i--)
+	{
+		while(k>=t && isLeft(H[k-2], H[k-1], P[i])<=0)
+			k--;
+		H[k++] = P[i];
+	}
+
+	// the last point is identical to the first one
+	return k>1 ? k-1 : k;
+}
+
+
 inline int distanceSquare(const MarkerPoint& nPoint1, const MarkerPoint& nPoint2)
 {
 	int dx=nPoint1.x-nPoint2.x;
@@ -350,6 +404,74 @@ findFurthestAway(const MarkerPoint* nPoints, int nNumPoints, int nIdx0, int nIdx
 }
 
 
+int
+selectSpreadPoints(const MarkerPoint* nPoints, int nNumPoints, int nMaxPoints, int* nIndices, int* nWork)
+{
+	int num=0, idx0=0, idx1=0;
+
+	if(nNumPoints<=nMaxPoints)
+	{
+		for(int i=0; i<nNumPoints; i++)
+			nIndices[i] = i;
+		return nNumPoints;
+	}
+
+	if(nMaxPoints<=0)
+		return 0;
+
+	// start with the two points that are furthest apart
+	//
+	findLongestDiameter(nPoints, nNumPoints, idx0,idx1);
+	nIndices[num++] = idx0;
+	if(nMaxPoints>1 && idx1!=idx0)
+		nIndices[num++] = idx1;
+
+	for(int i=0; i<nNumPoints; i++)
+	{
+		int d0 = distanceSquare(nPoints[i], nPoints[idx0]);
+		int d1 = distanceSquare(nPoints[i], nPoints[idx1]);
+		nWork[i] = d0<d1 ? d0 : d1;
+	}
+	nWork[idx0] = nWork[idx1] = -1;
+
+	// now repeatedly add the point that is furthest away from all selected ones
+	//
+	while(num<nMaxPoints)
+	{
+		int maxIdx=-1, maxDist=0;
+
+		for(int i=0; i<nNumPoints; i++)
+			if(nWork[i]>maxDist)
+			{
+				maxDist = nWork[i];
+				maxIdx = i;
+			}
+
+		if(maxIdx<0)
+			break;
+
+		nIndices[num++] = maxIdx;
+		nWork[maxIdx] = -1;
+
+		for(int i=0; i<nNumPoints; i++)
+			if(nWork[i]>0)
+			{
+				int d = distanceSquare(nPoints[i], nPoints[maxIdx]);
+				if(d<nWork[i])
+					nWork[i] = d;
+			}
+	}
+
+	// keep the hull order
+	//
+	for(int i=1; i<num; i++)
+		for(int j=i; j>0 && nIndices[j-1]>nIndices[j]; j--)
+			swap(nIndices[j-1], nIndices[j]);
+
+	return num;
+}
+
+
 void
 maximizeArea(const MarkerPoint* nPoints, int nNumPoints, int nIdx0, int nIdx1, int nIdx2, int& nIdxMax)
 {
@@ -13,6 +13,12 @@ QMAKE_CLEAN = $$(ARTKP)/lib/*
 
 DESTDIR  = $$(ARTKP)/lib
 
+# TrackerPipeline runs its stages on POSIX threads
+unix:LIBS += -lpthread
+
+# PosePublisher needs shm_open(), which is in librt on Linux only (macOS has it in libc)
+linux:LIBS += -lrt
+
 debug {
   message("Building ARToolKitPlus in debug mode ...")
 }
@@ -22,6 +28,11 @@ release {
 }
 
 SOURCES = MemoryManager.cpp \
+        MemoryManagerArena.cpp \
+        TrackerPipeline.cpp \
+        FrameSourceFile.cpp \
+        PosePublisher.cpp \
+        LoggerAsync.cpp \
         DLL.cpp \
 	librpp/rpp.cpp \
 	librpp/rpp_quintic.cpp \
@@ -39,12 +50,18 @@ HEADERS = \
         ../include/ARToolKitPlus/CameraImpl.h \
         ../include/ARToolKitPlus/ImageGrabber.h \
         ../include/ARToolKitPlus/Logger.h \
+        ../include/ARToolKitPlus/LoggerAsync.h \
         ../include/ARToolKitPlus/MemoryManager.h \
+        ../include/ARToolKitPlus/MemoryManagerArena.h \
         ../include/ARToolKitPlus/MemoryManagerMemMap.h \
         ../include/ARToolKitPlus/Tracker.h \
         ../include/ARToolKitPlus/TrackerImpl.h \
         ../include/ARToolKitPlus/TrackerMultiMarker.h \
         ../include/ARToolKitPlus/TrackerMultiMarkerImpl.h \
+        ../include/ARToolKitPlus/TrackerPipeline.h \
+        ../include/ARToolKitPlus/FrameSource.h \
+        ../include/ARToolKitPlus/FrameSourceFile.h \
+        ../include/ARToolKitPlus/PosePublisher.h \
         ../include/ARToolKitPlus/TrackerSingleMarker.h \
         ../include/ARToolKitPlus/TrackerSingleMarkerImpl.h \
         ../include/ARToolKitPlus/ar.h \
@@ -0,0 +1,239 @@
+/* ========================================================================
+ * PROJECT: ARToolKitPlus
+ * ========================================================================
+ * This work is based on the original ARToolKit developed by
+ *   Hirokazu Kato
+ *   Mark Billinghurst
+ *   HITLab, University of Washington, Seattle
+ * http://www.hitl.washington.edu/artoolkit/
+ *
+ * Copyright of the derived and new portions of this work
+ *     (C) 2006 Graz University of Technology
+ *
+ * This framework is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this framework; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * For further information please contact 
+ *   Dieter Schmalstieg
+ *   <schmalstieg@icg.tu-graz.ac.at>
+ *   Graz University of Technology, 
+ *   Institut for Computer Graphics and Vision,
+ *   Inffeldgasse 16a, 8010 Graz, Austria.
+ * ========================================================================
+ ** @author   Daniel Wagner
+ *
+ * $Id$
+ * @file
+ * ======================================================================== */
+
+
+
+// AllocCheck verifies that tracking does not touch the heap once the
+// tracker has warmed up: the first frames size the per-frame scratch
+// arena and the label tables, every later calc() must get along with
+// what is there.
+//
+// usage: AllocCheck [-n frames] [-w warmup] [-p orig|cont] [-u none|std|lut|grid] camera_para.dat
+//
+// The input images are synthetic: a single id marker (id 0) that moves
+// by a pixel per frame, so pose estimation and the history of
+// arDetectMarker() do real work. Allocations are counted by replacing
+// malloc(), calloc() and realloc(), which is only done for glibc.
+// UNDIST_LUT builds its table band by band on first use, so it may still
+// allocate when the marker reaches rows it has not visited before.
+//
+// Returns 0 if no allocation happened after the warmup frames.
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <ARToolKitPlus/TrackerSingleMarkerImpl.h>
+#include <ARToolKitPlus/arBitFieldPattern.h>
+
+
+#if defined(__GLIBC__)
+#  define ALLOC_CHECK_SUPPORTED
+
+extern "C" void* __libc_malloc(size_t nSize);
+extern "C" void* __libc_calloc(size_t nNum, size_t nSize);
+extern "C" void* __libc_realloc(void* nPtr, size_t nSize);
+
+static bool	counting = false;
+static int	numAllocs = 0;
+
+extern "C" void*
+malloc(size_t nSize)
+{
+	if(counting)
+		numAllocs++;
+	return __libc_malloc(nSize);
+}
+
+extern "C" void*
+calloc(size_t nNum, size_t nSize)
+{
+	if(counting)
+		numAllocs++;
+	return __libc_calloc(nNum, nSize);
+}
+
+extern "C" void*
+realloc(void* nPtr, size_t nSize)
+{
+	if(counting)
+		numAllocs++;
+	return __libc_realloc(nPtr, nSize);
+}
+#endif //__GLIBC__
+
+
+typedef ARToolKitPlus::TrackerSingleMarkerImpl<6,6,6, 1, 8> CheckTracker;
+
+
+// draws an id marker (8x8 cells: black border of one cell, 6x6 id pattern)
+// with a side length of half the image height, shifted right by nOffset pixels
+//
+static void
+createImage(std::vector<unsigned char>& nImage, int nWidth, int nHeight, int nOffset)
+{
+	ARToolKitPlus::IDPATTERN pattern;
+	ARToolKitPlus::generatePatternBCH(0, pattern);
+
+	int size = nHeight/2, x0 = (nWidth-size)/4+nOffset, y0 = (nHeight-size)/2;
+
+	nImage.resize(nWidth*nHeight);
+
+	for(int y=0; y<nHeight; y++)
+		for(int x=0; x<nWidth; x++)
+		{
+			unsigned char gray = 200;
+
+			if(x>=x0 && x<x0+size && y>=y0 && y<y0+size)
+			{
+				int c = (x-x0)*8/size, r = (y-y0)*8/size;
+
+				if(c==0 || c==7 || r==0 || r==7)
+					gray = 20;
+				else
+					gray = ((pattern>>(35-((r-1)*6+(c-1)))) & 1) ? 200 : 20;
+			}
+
+			nImage[y*nWidth+x] = gray;
+		}
+}
+
+
+static void
+printUsage()
+{
+	printf("usage: AllocCheck [-n frames] [-w warmup] [-p orig|cont] [-u none|std|lut|grid] camera_para.dat\n");
+}
+
+
+int
+main(int argc, char** argv)
+{
+	const int							width = 320, height = 240;
+	int									numFrames = 50, numWarmup = 2;
+	ARToolKitPlus::POSE_ESTIMATOR		poseEstimator = ARToolKitPlus::POSE_ESTIMATOR_ORIGINAL;
+	ARToolKitPlus::UNDIST_MODE			undistMode = ARToolKitPlus::UNDIST_STD;
+	int									i;
+
+	for(i=1; i+1<argc; i+=2)
+	{
+		const char* opt = argv[i];
+		const char* val = argv[i+1];
+
+		if(strcmp(opt, "-n")==0)
+			numFrames = atoi(val);
+		else if(strcmp(opt, "-w")==0)
+			numWarmup = atoi(val);
+		else if(strcmp(opt, "-p")==0)
+		{
+			if(strcmp(val, "orig")==0)			poseEstimator = ARToolKitPlus::POSE_ESTIMATOR_ORIGINAL;
+			else if(strcmp(val, "cont")==0)		poseEstimator = ARToolKitPlus::POSE_ESTIMATOR_ORIGINAL_CONT;
+			else { printUsage(); return 1; }
+		}
+		else if(strcmp(opt, "-u")==0)
+		{
+			if(strcmp(val, "none")==0)			undistMode = ARToolKitPlus::UNDIST_NONE;
+			else if(strcmp(val, "std")==0)		undistMode = ARToolKitPlus::UNDIST_STD;
+			else if(strcmp(val, "lut")==0)		undistMode = ARToolKitPlus::UNDIST_LUT;
+			else if(strcmp(val, "grid")==0)		undistMode = ARToolKitPlus::UNDIST_GRID;
+			else { printUsage(); return 1; }
+		}
+		else
+			break;
+	}
+
+	if(i!=argc-1 || numWarmup<0 || numFrames<=numWarmup)
+	{
+		printUsage();
+		return 1;
+	}
+
+#ifndef ALLOC_CHECK_SUPPORTED
+	printf("allocation counting is only implemented for glibc\n");
+	return 1;
+#else
+	CheckTracker* tracker = new CheckTracker(width, height);
+
+	tracker->setPixelFormat(ARToolKitPlus::PIXEL_FORMAT_LUM);
+	if(!tracker->init(argv[i], 1.0f, 1000.0f))
+	{
+		printf("failed to load camera file '%s'\n", argv[i]);
+		delete tracker;
+		return 1;
+	}
+	tracker->setBorderWidth(0.125f);
+	tracker->setMarkerMode(ARToolKitPlus::MARKER_ID_BCH);
+	tracker->setUndistortionMode(undistMode);
+	tracker->setPoseEstimator(poseEstimator);
+	tracker->setThreshold(110);
+
+	// all images are made up front, only calc() runs while counting
+	std::vector< std::vector<unsigned char> > images(numFrames);
+	for(int f=0; f<numFrames; f++)
+		createImage(images[f], width, height, f%32);
+
+	int found = 0, allocFrames = 0;
+
+	for(int f=0; f<numFrames; f++)
+	{
+		int before = numAllocs;
+
+		counting = f>=numWarmup;
+		int id = tracker->calc(&images[f][0]);
+		counting = false;
+
+		if(id==0)
+			found++;
+		if(numAllocs!=before)
+		{
+			if(allocFrames<10)
+				printf("  frame %d: %d allocations\n", f, numAllocs-before);
+			allocFrames++;
+		}
+	}
+
+	delete tracker;
+
+	printf("%d frames (%d warmup), marker found in %d, %d allocations in %d frames after warmup\n",
+		   numFrames, numWarmup, found, numAllocs, allocFrames);
+
+	return numAllocs==0 ? 0 : 1;
+#endif //ALLOC_CHECK_SUPPORTED
+}
@@ -0,0 +1,27 @@
+################################
+#
+# QMake definitions for AllocCheck
+#
+
+include ($$(ARTKP)/build/linux/options.pro)
+
+TEMPLATE = app
+
+TARGET   = AllocCheck
+
+DESTDIR  = $$(ARTKP)/bin
+
+INCLUDEPATH += ../../include
+
+LIBS += -L$$(ARTKP)/lib -lARToolKitPlus
+
+# the library runs TrackerPipeline stages on POSIX threads
+unix:LIBS += -lpthread
+
+SOURCES = AllocCheck.cpp
+
+target.path = ""/$$PREFIX/bin
+
+INSTALLS += target
+
+################################
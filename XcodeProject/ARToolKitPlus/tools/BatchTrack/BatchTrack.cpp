@@ -0,0 +1,970 @@
+/* ========================================================================
+ * PROJECT: ARToolKitPlus
+ * ========================================================================
+ * This work is based on the original ARToolKit developed by
+ *   Hirokazu Kato
+ *   Mark Billinghurst
+ *   HITLab, University of Washington, Seattle
+ * http://www.hitl.washington.edu/artoolkit/
+ *
+ * Copyright of the derived and new portions of this work
+ *     (C) 2006 Graz University of Technology
+ *
+ * This framework is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this framework; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * For further information please contact 
+ *   Dieter Schmalstieg
+ *   <schmalstieg@icg.tu-graz.ac.at>
+ *   Graz University of Technology, 
+ *   Institut for Computer Graphics and Vision,
+ *   Inffeldgasse 16a, 8010 Graz, Austria.
+ * ========================================================================
+ ** @author   Daniel Wagner
+ *
+ * $Id$
+ * @file
+ * ======================================================================== */
+
+
+
+// BatchTrack runs a tracker over a recorded video offline and writes the
+// markers found in every frame to a CSV or binary file.
+//
+// usage: BatchTrack [options] camera_para.dat input output
+//
+// input is a YUV4MPEG2 file (.y4m), a file of raw frames (-s is required)
+// or a printf() style name of a PGM/PPM image sequence (e.g. img%05d.pgm).
+// output "-" writes to stdout.
+//
+// The video is cut into chunks of -c frames which are tracked on -j threads,
+// each with a tracker of its own. Trackers carry state from frame to frame
+// (auto threshold, hull tracking, motion gate, ...), so a thread that starts
+// on a chunk it did not reach by itself first tracks the -W frames before
+// the chunk without writing them. Chunks are written in frame order.
+// Poses refined from the previous frame's pose (-e cont, multi-marker configs
+// with the original estimators) can still end up slightly different from a
+// run with -j 1 after a chunk boundary; -e rpp does not depend on earlier frames.
+//
+// CSV output has one row per marker (type M) and per tracked multi-marker
+// config (type C, id is the config index):
+//   frame,time,type,id,cf,x0,y0,x1,y1,x2,y2,x3,y3,m00,m01,m02,m03,m10,...,m23
+// m is the 3x4 pose matrix. Single marker mode writes a pose for every
+// marker, multi-marker mode writes poses for configs only. Binary output
+// starts with a BatchFileHeader followed by one BatchRecord per row.
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <ARToolKitPlus/TrackerSingleMarkerImpl.h>
+#include <ARToolKitPlus/TrackerMultiMarkerImpl.h>
+#include <ARToolKitPlus/FrameSourceFile.h>
+
+#if defined(WIN32) || defined(_WIN32_WCE)
+#  include <windows.h>
+#else
+#  include <sys/time.h>
+#  include <unistd.h>
+#endif
+
+// without pthreads all chunks are tracked on the main thread
+#if !defined(_MSC_VER) && !defined(_WIN32_WCE)
+#  define BATCHTRACK_USE_PTHREADS
+#  include <pthread.h>
+#endif
+
+
+enum {
+	MAX_MARKERS = 64,
+	MAX_PATTERNS = 32,
+	MAX_THREADS = 64
+};
+
+typedef ARToolKitPlus::TrackerSingleMarkerImpl<6,6,6, 1, MAX_MARKERS> SingleIdTracker;
+typedef ARToolKitPlus::TrackerSingleMarkerImpl<16,16,64, MAX_PATTERNS, MAX_MARKERS> SingleTemplateTracker;
+typedef ARToolKitPlus::TrackerMultiMarkerImpl<6,6,6, 1, MAX_MARKERS> MultiIdTracker;
+typedef ARToolKitPlus::TrackerMultiMarkerImpl<16,16,64, MAX_PATTERNS, MAX_MARKERS> MultiTemplateTracker;
+
+
+// layout of the binary output
+//
+struct BatchFileHeader
+{
+	char			magic[4];			// "ATKB"
+	unsigned int	version,			// 1
+					recordSize,			// sizeof(BatchRecord)
+					numFrames;
+	int				width, height;
+	float			frameRate;
+};
+
+struct BatchRecord
+{
+	unsigned int	frame;
+	int				id;
+	char			type;				// 'M' marker, 'C' multi-marker config
+	char			pad[3];
+	float			cf;
+	float			vertex[4][2];		// zero for configs
+	float			trans[3][4];		// zero for markers in multi-marker mode
+};
+
+
+struct Options
+{
+	const char*						camFile;
+	std::vector<const char*>		patterns, configs;
+	ARToolKitPlus::MARKER_MODE		markerMode;
+	ARToolKitPlus::UNDIST_MODE		undistMode;
+	ARToolKitPlus::POSE_ESTIMATOR	poseEstimator;
+	ARToolKitPlus::MULTI_POSE_ESTIMATOR	multiPoseEstimator;
+	ARToolKitPlus::PIXEL_FORMAT		rawFormat;
+	int								rawWidth, rawHeight, rawHeader, firstImage;
+	int								threshold;			// -1 for auto threshold
+	float							borderWidth, pattWidth, frameRate;
+	int								numThreads, chunkSize, warmUp;
+	bool							binary;
+};
+
+
+static double
+getMilliseconds()
+{
+#if defined(WIN32) || defined(_WIN32_WCE)
+	LARGE_INTEGER freq, now;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+	return 1000.0*(double)now.QuadPart/(double)freq.QuadPart;
+#else
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec*1000.0 + tv.tv_usec/1000.0;
+#endif
+}
+
+
+static int
+getNumCores()
+{
+#if defined(WIN32) || defined(_WIN32_WCE)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (int)info.dwNumberOfProcessors;
+#else
+	long num = sysconf(_SC_NPROCESSORS_ONLN);
+	return num>0 ? (int)num : 1;
+#endif
+}
+
+
+// gives random access to the frames of the input. every thread has one
+// of its own, so the file sources do not need any locking.
+//
+class FrameReader
+{
+public:
+	FrameReader() : sequence(NULL), lastFrame(-1), leased(NULL)
+	{}
+
+	~FrameReader()
+	{
+		if(leased)
+			source.release(leased);
+	}
+
+	bool open(const char* nInput, const Options& nOptions)
+	{
+		if(strchr(nInput, '%'))
+		{
+			if(strlen(nInput)>900)
+				return false;
+
+			sequence = nInput;
+			firstImage = nOptions.firstImage;
+			return loadImage(0);
+		}
+
+		size_t len = strlen(nInput);
+		if(len>4 && strcmp(nInput+len-4, ".y4m")==0)
+			return source.openY4M(nInput);
+
+		return source.openRaw(nInput, nOptions.rawWidth, nOptions.rawHeight, nOptions.rawFormat,
+							  nOptions.frameRate, nOptions.rawHeader);
+	}
+
+	// counts the images of a sequence, the files must be numbered without gaps
+	unsigned int getNumFrames() const
+	{
+		if(!sequence)
+			return source.getNumFrames();
+
+		unsigned int num = 0;
+		char name[1024];
+		for(;;)
+		{
+			sprintf(name, sequence, firstImage+num);
+			FILE* fp = fopen(name, "rb");
+			if(!fp)
+				return num;
+			fclose(fp);
+			num++;
+		}
+	}
+
+	int getWidth() const  {  return sequence ? imageWidth : source.getWidth();  }
+	int getHeight() const  {  return sequence ? imageHeight : source.getHeight();  }
+	ARToolKitPlus::PIXEL_FORMAT getPixelFormat() const  {  return sequence ? imageFormat : source.getPixelFormat();  }
+	double getFrameRate() const  {  return sequence ? 0.0 : source.getFrameRate();  }
+
+	const unsigned char* read(int nFrame)
+	{
+		if(sequence)
+			return (nFrame==lastFrame || loadImage(nFrame)) ? &image[0] : NULL;
+
+		if(leased)
+		{
+			source.release(leased);
+			leased = NULL;
+		}
+
+		if(nFrame!=lastFrame+1 && !source.seek(nFrame))
+			return NULL;
+
+		if((leased = source.acquire())==NULL)
+			return NULL;
+
+		lastFrame = nFrame;
+		return leased->data;
+	}
+
+protected:
+	// reads binary PGM (P5) or PPM (P6) files with 8 bits per channel
+	bool loadImage(int nFrame)
+	{
+		char name[1024];
+		sprintf(name, sequence, firstImage+nFrame);
+
+		FILE* fp = fopen(name, "rb");
+		if(!fp)
+			return false;
+
+		char magic[3] = { 0, 0, 0 };
+		int values[3], numValues = 0;
+
+		if(fread(magic, 1, 2, fp)!=2 || magic[0]!='P' || (magic[1]!='5' && magic[1]!='6'))
+		{
+			fclose(fp);
+			return false;
+		}
+
+		while(numValues<3)
+		{
+			int c = fgetc(fp);
+			if(c=='#')
+				while(c!='\n' && c!=EOF)
+					c = fgetc(fp);
+			else if(c>='0' && c<='9')
+			{
+				ungetc(c, fp);
+				if(fscanf(fp, "%d", &values[numValues++])!=1)
+					break;
+			}
+			else if(c==EOF)
+				break;
+		}
+		fgetc(fp);		// single white space before the pixels
+
+		ARToolKitPlus::PIXEL_FORMAT format = magic[1]=='5' ? ARToolKitPlus::PIXEL_FORMAT_LUM : ARToolKitPlus::PIXEL_FORMAT_RGB;
+		int bpp = magic[1]=='5' ? 1 : 3;
+
+		if(numValues<3 || values[2]>255 || values[0]<=0 || values[1]<=0 ||
+		   (lastFrame!=-1 && (values[0]!=imageWidth || values[1]!=imageHeight || format!=imageFormat)))
+		{
+			fclose(fp);
+			return false;
+		}
+
+		imageWidth = values[0];
+		imageHeight = values[1];
+		imageFormat = format;
+		image.resize(imageWidth*imageHeight*bpp);
+
+		bool ok = fread(&image[0], 1, image.size(), fp)==image.size();
+		fclose(fp);
+
+		lastFrame = ok ? nFrame : -1;
+		return ok;
+	}
+
+	ARToolKitPlus::FrameSourceFile				source;
+	const char*									sequence;
+	int											firstImage, imageWidth, imageHeight;
+	ARToolKitPlus::PIXEL_FORMAT					imageFormat;
+	std::vector<unsigned char>					image;
+	int											lastFrame;
+	const ARToolKitPlus::FrameSource::Frame*	leased;
+};
+
+
+struct Chunk
+{
+	int				first, count;
+	std::string		output;
+	bool			done, failed;
+};
+
+
+// state shared by all threads; chunks are handed out in order
+//
+struct Job
+{
+	const Options*		options;
+	double				frameRate;
+	std::vector<Chunk>	chunks;
+	int					nextChunk, nextToWrite, maxAhead;
+
+#ifdef BATCHTRACK_USE_PTHREADS
+	pthread_mutex_t		mutex;
+	pthread_cond_t		cond;
+#endif
+};
+
+
+// pose of a marker in the last frame it was seen in (single marker mode)
+//
+struct MarkerPose
+{
+	int										id, frame;
+	ARFloat									trans[3][4];
+};
+
+
+// each thread tracks with a tracker and a frame reader of its own
+//
+struct Worker
+{
+	Job*									job;
+	ARToolKitPlus::Tracker*					tracker;
+	ARToolKitPlus::TrackerSingleMarker*		single;
+	ARToolKitPlus::TrackerMultiMarker*		multi;
+	FrameReader								reader;
+	int										lastFrame;
+	ARToolKitPlus::ARMarkerInfo				markers[MAX_MARKERS];
+	MarkerPose								poses[MAX_MARKERS];
+	int										numPoses;
+};
+
+
+static bool
+createTracker(Worker& nWorker, const Options& nOptions, int nWidth, int nHeight, ARToolKitPlus::PIXEL_FORMAT nFormat)
+{
+	bool useId = nOptions.markerMode!=ARToolKitPlus::MARKER_TEMPLATE;
+	bool ok = true;
+
+	nWorker.single = NULL;
+	nWorker.multi = NULL;
+
+	if(nOptions.configs.empty())
+	{
+		if(useId)
+			nWorker.single = new SingleIdTracker(nWidth, nHeight);
+		else
+			nWorker.single = new SingleTemplateTracker(nWidth, nHeight);
+		nWorker.tracker = nWorker.single;
+
+		nWorker.single->setPixelFormat(nFormat);
+		ok = nWorker.single->init(nOptions.camFile, 1.0f, 1000.0f);
+		for(size_t i=0; ok && i<nOptions.patterns.size(); i++)
+			ok = nWorker.single->addPattern(nOptions.patterns[i])>=0;
+		nWorker.single->setPatternWidth(nOptions.pattWidth);
+	}
+	else
+	{
+		if(useId)
+			nWorker.multi = new MultiIdTracker(nWidth, nHeight);
+		else
+			nWorker.multi = new MultiTemplateTracker(nWidth, nHeight);
+		nWorker.tracker = nWorker.multi;
+
+		nWorker.multi->setPixelFormat(nFormat);
+		ok = nWorker.multi->init(nOptions.camFile, nOptions.configs[0], 1.0f, 1000.0f);
+		for(size_t i=1; ok && i<nOptions.configs.size(); i++)
+			ok = nWorker.multi->addMultiMarkerConfig(nOptions.configs[i])>=0;
+	}
+
+	if(!ok)
+		return false;
+
+	ARToolKitPlus::Tracker* tracker = nWorker.tracker;
+
+	tracker->setMarkerMode(nOptions.markerMode);
+	tracker->setUndistortionMode(nOptions.undistMode);
+	tracker->setPoseEstimator(nOptions.poseEstimator);
+	tracker->setMultiPoseEstimator(nOptions.multiPoseEstimator);
+	if(nOptions.borderWidth>0.0f)
+		tracker->setBorderWidth(nOptions.borderWidth);
+	if(nOptions.threshold<0)
+		tracker->activateAutoThreshold(true);
+	else
+		tracker->setThreshold(nOptions.threshold);
+
+	return true;
+}
+
+
+static void
+appendRecord(std::string& nOutput, bool nBinary, const BatchRecord& nRecord, double nTime, bool nHasCorners, bool nHasPose)
+{
+	if(nBinary)
+	{
+		nOutput.append((const char*)&nRecord, sizeof(nRecord));
+		return;
+	}
+
+	char line[512];
+	int len = sprintf(line, "%u,%.1f,%c,%d,%.3f", nRecord.frame, nTime, nRecord.type, nRecord.id, nRecord.cf);
+
+	for(int i=0; i<4; i++)
+		len += nHasCorners ? sprintf(line+len, ",%.2f,%.2f", nRecord.vertex[i][0], nRecord.vertex[i][1])
+						   : sprintf(line+len, ",,");
+
+	for(int r=0; r<3; r++)
+		for(int c=0; c<4; c++)
+			len += nHasPose ? sprintf(line+len, ",%.6g", nRecord.trans[r][c]) : sprintf(line+len, ",");
+
+	line[len++] = '\n';
+	nOutput.append(line, len);
+}
+
+
+// the pose of marker nId in frame nFrame-1, NULL if it was not seen there.
+// with nCreate a slot for the pose of frame nFrame is returned instead,
+// taken from the markers that were lost the longest time ago if needed
+//
+static MarkerPose*
+findMarkerPose(Worker& nWorker, int nId, int nFrame, bool nCreate)
+{
+	MarkerPose* oldest = NULL;
+
+	for(int i=0; i<nWorker.numPoses; i++)
+	{
+		MarkerPose& pose = nWorker.poses[i];
+		if(pose.id==nId)
+			return (nCreate || pose.frame==nFrame-1) ? &pose : NULL;
+		if(!oldest || pose.frame<oldest->frame)
+			oldest = &pose;
+	}
+
+	if(!nCreate)
+		return NULL;
+	if(nWorker.numPoses<MAX_MARKERS)
+		oldest = &nWorker.poses[nWorker.numPoses++];
+	oldest->id = nId;
+	return oldest;
+}
+
+
+// tracks one frame and appends its rows to nOutput (if not NULL)
+//
+static void
+trackFrame(Worker& nWorker, const unsigned char* nImage, int nFrame, std::string* nOutput)
+{
+	const Options& options = *nWorker.job->options;
+	double time = nWorker.job->frameRate>0.0 ? nFrame*1000.0/nWorker.job->frameRate : 0.0;
+	BatchRecord record;
+	ARFloat trans[3][4];
+
+	if(nWorker.single)
+	{
+		int num = nWorker.single->calcDetect(nImage, nWorker.markers, MAX_MARKERS);
+		ARFloat center[2] = { 0.0f, 0.0f };
+
+		// -e cont refines the marker's pose of the previous frame,
+		// so the warm-up frames have to provide these poses as well
+		const bool cont = options.poseEstimator==ARToolKitPlus::POSE_ESTIMATOR_ORIGINAL_CONT;
+
+		for(int i=0; (nOutput || cont) && i<num; i++)
+		{
+			ARToolKitPlus::ARMarkerInfo& marker = nWorker.markers[i];
+			if(marker.id<0)
+				continue;
+
+			if(cont)
+			{
+				// a marker that was lost (or is seen for the first time) has no pose to start from
+				const MarkerPose* prev = findMarkerPose(nWorker, marker.id, nFrame, false);
+				if(prev)
+				{
+					memcpy(trans, prev->trans, sizeof(trans));
+					nWorker.tracker->executeSingleMarkerPoseEstimator(&marker, center, options.pattWidth, trans);
+				}
+				else
+					nWorker.tracker->arGetTransMat(&marker, center, options.pattWidth, trans);
+
+				MarkerPose* pose = findMarkerPose(nWorker, marker.id, nFrame, true);
+				pose->frame = nFrame;
+				memcpy(pose->trans, trans, sizeof(trans));
+			}
+			else
+				nWorker.tracker->executeSingleMarkerPoseEstimator(&marker, center, options.pattWidth, trans);
+
+			if(!nOutput)
+				continue;
+
+			memset(&record, 0, sizeof(record));
+			record.frame = nFrame;
+			record.id = marker.id;
+			record.type = 'M';
+			record.cf = (float)marker.cf;
+			for(int j=0; j<4; j++)
+				for(int k=0; k<2; k++)
+					record.vertex[j][k] = (float)marker.vertex[j][k];
+			for(int r=0; r<3; r++)
+				for(int c=0; c<4; c++)
+					record.trans[r][c] = (float)trans[r][c];
+			appendRecord(*nOutput, options.binary, record, time, true, true);
+		}
+		return;
+	}
+
+	nWorker.multi->calc(nImage);
+	if(!nOutput)
+		return;
+
+	for(int i=0; i<nWorker.multi->getNumDetectedMarkers(); i++)
+	{
+		const ARToolKitPlus::ARMarkerInfo& marker = nWorker.multi->getDetectedMarker(i);
+
+		memset(&record, 0, sizeof(record));
+		record.frame = nFrame;
+		record.id = marker.id;
+		record.type = 'M';
+		record.cf = (float)marker.cf;
+		for(int j=0; j<4; j++)
+			for(int k=0; k<2; k++)
+				record.vertex[j][k] = (float)marker.vertex[j][k];
+		appendRecord(*nOutput, options.binary, record, time, true, false);
+	}
+
+	for(int n=0; n<nWorker.multi->getNumMultiMarkerConfigs(); n++)
+	{
+		if(!nWorker.multi->isMultiMarkerConfigTracked(n))
+			continue;
+
+		nWorker.multi->getARMatrix(n, trans);
+
+		memset(&record, 0, sizeof(record));
+		record.frame = nFrame;
+		record.id = n;
+		record.type = 'C';
+		for(int r=0; r<3; r++)
+			for(int c=0; c<4; c++)
+				record.trans[r][c] = (float)trans[r][c];
+		appendRecord(*nOutput, options.binary, record, time, false, true);
+	}
+}
+
+
+static bool
+trackChunk(Worker& nWorker, Chunk& nChunk)
+{
+	int first = nChunk.first;
+
+	// continue where this thread stopped or warm up the tracker
+	if(nWorker.lastFrame!=nChunk.first-1)
+		first = nChunk.first>nWorker.job->options->warmUp ? nChunk.first-nWorker.job->options->warmUp : 0;
+
+	for(int frame=first; frame<nChunk.first+nChunk.count; frame++)
+	{
+		const unsigned char* image = nWorker.reader.read(frame);
+		if(!image)
+		{
+			nWorker.lastFrame = -1;
+			return false;
+		}
+
+		trackFrame(nWorker, image, frame, frame>=nChunk.first ? &nChunk.output : NULL);
+		nWorker.lastFrame = frame;
+	}
+
+	return true;
+}
+
+
+#ifdef BATCHTRACK_USE_PTHREADS
+
+static void*
+workerMain(void* nWorker)
+{
+	Worker& worker = *(Worker*)nWorker;
+	Job& job = *worker.job;
+
+	for(;;)
+	{
+		// don't run too far ahead of the writer, the output is kept in memory until then
+		pthread_mutex_lock(&job.mutex);
+		while(job.nextChunk<(int)job.chunks.size() && job.nextChunk>=job.nextToWrite+job.maxAhead)
+			pthread_cond_wait(&job.cond, &job.mutex);
+
+		if(job.nextChunk>=(int)job.chunks.size())
+		{
+			pthread_mutex_unlock(&job.mutex);
+			return NULL;
+		}
+
+		Chunk& chunk = job.chunks[job.nextChunk++];
+		pthread_mutex_unlock(&job.mutex);
+
+		bool ok = trackChunk(worker, chunk);
+
+		pthread_mutex_lock(&job.mutex);
+		chunk.failed = !ok;
+		chunk.done = true;
+		pthread_cond_broadcast(&job.cond);
+		pthread_mutex_unlock(&job.mutex);
+	}
+}
+
+#endif //BATCHTRACK_USE_PTHREADS
+
+
+static void
+deleteWorkers(std::vector<Worker*>& nWorkers)
+{
+	for(size_t i=0; i<nWorkers.size(); i++)
+	{
+		delete nWorkers[i]->tracker;
+		delete nWorkers[i];
+	}
+	nWorkers.clear();
+}
+
+
+static bool
+parseFormat(const char* nName, ARToolKitPlus::PIXEL_FORMAT& nFormat)
+{
+	if(strcmp(nName, "LUM")==0)				nFormat = ARToolKitPlus::PIXEL_FORMAT_LUM;
+	else if(strcmp(nName, "RGB")==0)		nFormat = ARToolKitPlus::PIXEL_FORMAT_RGB;
+	else if(strcmp(nName, "BGR")==0)		nFormat = ARToolKitPlus::PIXEL_FORMAT_BGR;
+	else if(strcmp(nName, "BGRA")==0)		nFormat = ARToolKitPlus::PIXEL_FORMAT_BGRA;
+	else if(strcmp(nName, "RGBA")==0)		nFormat = ARToolKitPlus::PIXEL_FORMAT_RGBA;
+	else if(strcmp(nName, "ABGR")==0)		nFormat = ARToolKitPlus::PIXEL_FORMAT_ABGR;
+	else if(strcmp(nName, "RGB565")==0)		nFormat = ARToolKitPlus::PIXEL_FORMAT_RGB565;
+	else
+		return false;
+	return true;
+}
+
+
+static void
+printUsage()
+{
+	printf("usage: BatchTrack [options] camera_para.dat input output\n");
+	printf("  -p pattern       track a template pattern (single marker mode, repeatable)\n");
+	printf("  -m config        track a multi-marker config (multi-marker mode, repeatable)\n");
+	printf("  -i simple|bch|template  marker mode (default bch, template if -p is used)\n");
+	printf("  -w width         pattern width in mm for single marker poses (default 80)\n");
+	printf("  -b fraction      marker border width (default: tracker default)\n");
+	printf("  -t value|auto    threshold (default 100)\n");
+	printf("  -u none|std|lut|grid  undistortion mode (default lut)\n");
+	printf("  -e original|cont|rpp  pose estimator (default original)\n");
+	printf("  -E default|ransac     multi-marker pose estimator (default default)\n");
+	printf("  -s WxH           frame size of raw input\n");
+	printf("  -f format        pixel format of raw input: LUM|RGB|BGR|BGRA|RGBA|ABGR|RGB565 (default LUM)\n");
+	printf("  -h bytes         size of the file header of raw input (default 0)\n");
+	printf("  -r fps           frame rate of raw input and image sequences (default 30)\n");
+	printf("  -n index         number of the first image of a sequence (default 0)\n");
+	printf("  -j threads       number of tracking threads (default: number of cores)\n");
+	printf("  -c frames        frames per chunk (default 256)\n");
+	printf("  -W frames        warm-up frames before a chunk (default 16)\n");
+	printf("  -o csv|bin       output format (default csv)\n");
+}
+
+
+int
+main(int argc, char** argv)
+{
+	Options		options;
+	bool		markerModeSet = false;
+	int			i;
+
+	options.markerMode = ARToolKitPlus::MARKER_ID_BCH;
+	options.undistMode = ARToolKitPlus::UNDIST_LUT;
+	options.poseEstimator = ARToolKitPlus::POSE_ESTIMATOR_ORIGINAL;
+	options.multiPoseEstimator = ARToolKitPlus::MULTI_POSE_ESTIMATOR_DEFAULT;
+	options.rawFormat = ARToolKitPlus::PIXEL_FORMAT_LUM;
+	options.rawWidth = options.rawHeight = options.rawHeader = options.firstImage = 0;
+	options.threshold = 100;
+	options.borderWidth = 0.0f;
+	options.pattWidth = 80.0f;
+	options.frameRate = 30.0f;
+	options.numThreads = getNumCores();
+	options.chunkSize = 256;
+	options.warmUp = 16;
+	options.binary = false;
+
+	for(i=1; i+1<argc && argv[i][0]=='-' && argv[i][1]!=0; i+=2)
+	{
+		const char* opt = argv[i];
+		const char* val = argv[i+1];
+		bool ok = true;
+
+		if(strcmp(opt, "-p")==0)
+			options.patterns.push_back(val);
+		else if(strcmp(opt, "-m")==0)
+			options.configs.push_back(val);
+		else if(strcmp(opt, "-i")==0)
+		{
+			markerModeSet = true;
+			if(strcmp(val, "simple")==0)			options.markerMode = ARToolKitPlus::MARKER_ID_SIMPLE;
+			else if(strcmp(val, "bch")==0)			options.markerMode = ARToolKitPlus::MARKER_ID_BCH;
+			else if(strcmp(val, "template")==0)		options.markerMode = ARToolKitPlus::MARKER_TEMPLATE;
+			else ok = false;
+		}
+		else if(strcmp(opt, "-w")==0)
+			options.pattWidth = (float)atof(val);
+		else if(strcmp(opt, "-b")==0)
+			options.borderWidth = (float)atof(val);
+		else if(strcmp(opt, "-t")==0)
+			options.threshold = strcmp(val, "auto")==0 ? -1 : atoi(val);
+		else if(strcmp(opt, "-u")==0)
+		{
+			if(strcmp(val, "none")==0)				options.undistMode = ARToolKitPlus::UNDIST_NONE;
+			else if(strcmp(val, "std")==0)			options.undistMode = ARToolKitPlus::UNDIST_STD;
+			else if(strcmp(val, "lut")==0)			options.undistMode = ARToolKitPlus::UNDIST_LUT;
+			else if(strcmp(val, "grid")==0)			options.undistMode = ARToolKitPlus::UNDIST_GRID;
+			else ok = false;
+		}
+		else if(strcmp(opt, "-e")==0)
+		{
+			if(strcmp(val, "original")==0)			options.poseEstimator = ARToolKitPlus::POSE_ESTIMATOR_ORIGINAL;
+			else if(strcmp(val, "cont")==0)			options.poseEstimator = ARToolKitPlus::POSE_ESTIMATOR_ORIGINAL_CONT;
+			else if(strcmp(val, "rpp")==0)			options.poseEstimator = ARToolKitPlus::POSE_ESTIMATOR_RPP;
+			else ok = false;
+		}
+		else if(strcmp(opt, "-E")==0)
+		{
+			if(strcmp(val, "default")==0)			options.multiPoseEstimator = ARToolKitPlus::MULTI_POSE_ESTIMATOR_DEFAULT;
+			else if(strcmp(val, "ransac")==0)		options.multiPoseEstimator = ARToolKitPlus::MULTI_POSE_ESTIMATOR_RANSAC;
+			else ok = false;
+		}
+		else if(strcmp(opt, "-s")==0)
+			ok = sscanf(val, "%dx%d", &options.rawWidth, &options.rawHeight)==2;
+		else if(strcmp(opt, "-f")==0)
+			ok = parseFormat(val, options.rawFormat);
+		else if(strcmp(opt, "-h")==0)
+			options.rawHeader = atoi(val);
+		else if(strcmp(opt, "-r")==0)
+			options.frameRate = (float)atof(val);
+		else if(strcmp(opt, "-n")==0)
+			options.firstImage = atoi(val);
+		else if(strcmp(opt, "-j")==0)
+			options.numThreads = atoi(val);
+		else if(strcmp(opt, "-c")==0)
+			options.chunkSize = atoi(val);
+		else if(strcmp(opt, "-W")==0)
+			options.warmUp = atoi(val);
+		else if(strcmp(opt, "-o")==0)
+		{
+			options.binary = strcmp(val, "bin")==0;
+			ok = options.binary || strcmp(val, "csv")==0;
+		}
+		else
+			ok = false;
+
+		if(!ok)
+		{
+			printUsage();
+			return 1;
+		}
+	}
+
+	if(!markerModeSet && !options.patterns.empty())
+		options.markerMode = ARToolKitPlus::MARKER_TEMPLATE;
+
+	if(i!=argc-3 || options.numThreads<1 || options.chunkSize<1 || options.warmUp<0 ||
+	   (!options.patterns.empty() && !options.configs.empty()) ||
+	   (int)options.patterns.size()>MAX_PATTERNS)
+	{
+		printUsage();
+		return 1;
+	}
+
+	options.camFile = argv[i];
+	const char* input = argv[i+1];
+	const char* outName = argv[i+2];
+
+	// the main thread's reader only finds out the video's size and length
+	FrameReader probe;
+	if(!probe.open(input, options))
+	{
+		fprintf(stderr, "failed to open input '%s'\n", input);
+		return 1;
+	}
+
+	int numFrames = (int)probe.getNumFrames();
+	int width = probe.getWidth(), height = probe.getHeight();
+	ARToolKitPlus::PIXEL_FORMAT format = probe.getPixelFormat();
+
+	Job job;
+	job.options = &options;
+	job.frameRate = probe.getFrameRate()>0.0 ? probe.getFrameRate() : options.frameRate;
+	job.nextChunk = job.nextToWrite = 0;
+
+	for(int first=0; first<numFrames; first+=options.chunkSize)
+	{
+		Chunk chunk;
+		chunk.first = first;
+		chunk.count = first+options.chunkSize<=numFrames ? options.chunkSize : numFrames-first;
+		chunk.done = chunk.failed = false;
+		job.chunks.push_back(chunk);
+	}
+
+	int numThreads = options.numThreads;
+	if(numThreads>(int)job.chunks.size())
+		numThreads = job.chunks.size()>0 ? (int)job.chunks.size() : 1;
+	if(numThreads>MAX_THREADS)
+		numThreads = MAX_THREADS;
+#ifndef BATCHTRACK_USE_PTHREADS
+	numThreads = 1;
+#endif
+	job.maxAhead = 4*numThreads;
+
+	std::vector<Worker*> workers;
+	for(int w=0; w<numThreads; w++)
+	{
+		Worker* worker = new Worker;
+		worker->job = &job;
+		worker->lastFrame = -1;
+		worker->tracker = NULL;
+		worker->numPoses = 0;
+		workers.push_back(worker);
+
+		if(!worker->reader.open(input, options) ||
+		   !createTracker(*worker, options, width, height, format))
+		{
+			fprintf(stderr, "failed to set up the tracker (camera file '%s')\n", options.camFile);
+			deleteWorkers(workers);
+			return 1;
+		}
+	}
+
+	FILE* out = strcmp(outName, "-")==0 ? stdout : fopen(outName, "wb");
+	if(!out)
+	{
+		fprintf(stderr, "failed to create output '%s'\n", outName);
+		deleteWorkers(workers);
+		return 1;
+	}
+
+	if(options.binary)
+	{
+		BatchFileHeader header;
+		memcpy(header.magic, "ATKB", 4);
+		header.version = 1;
+		header.recordSize = sizeof(BatchRecord);
+		header.numFrames = numFrames;
+		header.width = width;
+		header.height = height;
+		header.frameRate = (float)job.frameRate;
+		fwrite(&header, sizeof(header), 1, out);
+	}
+	else
+		fprintf(out, "frame,time,type,id,cf,x0,y0,x1,y1,x2,y2,x3,y3,"
+					 "m00,m01,m02,m03,m10,m11,m12,m13,m20,m21,m22,m23\n");
+
+	double startTime = getMilliseconds();
+	bool failed = false;
+
+#ifdef BATCHTRACK_USE_PTHREADS
+	pthread_mutex_init(&job.mutex, NULL);
+	pthread_cond_init(&job.cond, NULL);
+
+	// workers take the chunks one by one, so the job is done by as many threads as could be started
+	std::vector<pthread_t> threads(numThreads);
+	int numStarted = 0;
+	while(numStarted<numThreads && pthread_create(&threads[numStarted], NULL, workerMain, workers[numStarted])==0)
+		numStarted++;
+
+	if(numStarted==0)
+	{
+		fprintf(stderr, "failed to start a tracking thread\n");
+		pthread_cond_destroy(&job.cond);
+		pthread_mutex_destroy(&job.mutex);
+		if(out!=stdout)
+			fclose(out);
+		deleteWorkers(workers);
+		return 1;
+	}
+
+	if(numStarted<numThreads)
+		fprintf(stderr, "could only start %d of %d tracking threads\n", numStarted, numThreads);
+	numThreads = numStarted;
+
+	// write the chunks in order as they get done
+	for(size_t c=0; c<job.chunks.size(); c++)
+	{
+		Chunk& chunk = job.chunks[c];
+
+		pthread_mutex_lock(&job.mutex);
+		while(!chunk.done)
+			pthread_cond_wait(&job.cond, &job.mutex);
+		pthread_mutex_unlock(&job.mutex);
+
+		failed = failed || chunk.failed;
+		fwrite(chunk.output.data(), 1, chunk.output.size(), out);
+		std::string().swap(chunk.output);
+
+		pthread_mutex_lock(&job.mutex);
+		job.nextToWrite = (int)c+1;
+		pthread_cond_broadcast(&job.cond);
+		pthread_mutex_unlock(&job.mutex);
+	}
+
+	for(int w=0; w<numThreads; w++)
+		pthread_join(threads[w], NULL);
+
+	pthread_cond_destroy(&job.cond);
+	pthread_mutex_destroy(&job.mutex);
+#else
+	for(size_t c=0; c<job.chunks.size(); c++)
+	{
+		Chunk& chunk = job.chunks[c];
+
+		failed = failed || !trackChunk(*workers[0], chunk);
+		fwrite(chunk.output.data(), 1, chunk.output.size(), out);
+		std::string().swap(chunk.output);
+	}
+#endif
+
+	double time = getMilliseconds()-startTime;
+
+	if(out!=stdout)
+		fclose(out);
+
+	deleteWorkers(workers);
+
+	if(failed)
+	{
+		fprintf(stderr, "failed to read frames from '%s'\n", input);
+		return 1;
+	}
+
+	fprintf(stderr, "%d frames, %d threads, %.1f secs, %.1f frames/sec\n",
+			numFrames, numThreads, time/1000.0, time>0.0 ? numFrames*1000.0/time : 0.0);
+	return 0;
+}
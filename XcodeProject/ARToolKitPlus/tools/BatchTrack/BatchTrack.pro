@@ -0,0 +1,27 @@
+################################
+#
+# QMake definitions for BatchTrack
+#
+
+include ($$(ARTKP)/build/linux/options.pro)
+
+TEMPLATE = app
+
+TARGET   = BatchTrack
+
+DESTDIR  = $$(ARTKP)/bin
+
+INCLUDEPATH += ../../include
+
+LIBS += -L$$(ARTKP)/lib -lARToolKitPlus
+
+# chunks are tracked on POSIX threads, and so are the library's TrackerPipeline stages
+unix:LIBS += -lpthread
+
+SOURCES = BatchTrack.cpp
+
+target.path = ""/$$PREFIX/bin
+
+INSTALLS += target
+
+################################
@@ -0,0 +1,316 @@
+/* ========================================================================
+ * PROJECT: ARToolKitPlus
+ * ========================================================================
+ * This work is based on the original ARToolKit developed by
+ *   Hirokazu Kato
+ *   Mark Billinghurst
+ *   HITLab, University of Washington, Seattle
+ * http://www.hitl.washington.edu/artoolkit/
+ *
+ * Copyright of the derived and new portions of this work
+ *     (C) 2006 Graz University of Technology
+ *
+ * This framework is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this framework; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * For further information please contact 
+ *   Dieter Schmalstieg
+ *   <schmalstieg@icg.tu-graz.ac.at>
+ *   Graz University of Technology, 
+ *   Institut for Computer Graphics and Vision,
+ *   Inffeldgasse 16a, 8010 Graz, Austria.
+ * ========================================================================
+ ** @author   Daniel Wagner
+ *
+ * $Id$
+ * @file
+ * ======================================================================== */
+
+
+
+
+// FrameStatsCheck runs the tracker on synthetic images whose counts are
+// known and compares them with getFrameStats() and getFrameStatsSummary():
+//
+//  - a single id marker (id 0) found with the first threshold: one
+//    candidate, one marker, no retry, the same labels for arDetectMarker()
+//    and arDetectMarkerLite()
+//  - the same image with a threshold below all pixels: the histogram
+//    retry finds the marker with its first candidate
+//  - an empty image with random retries: every retry is counted
+//  - a sequence with a marker in every fourth frame, once by calc() and
+//    once through a TrackerPipeline: the summary only counts the posed
+//    frames among the last FrameStatsSummary::WINDOW detected ones, and
+//    both runs give the same means
+//  - the same sequence by calc() after many arDetectMarker() calls that
+//    were not followed by a pose stage: it gives the same means again
+//
+// usage: FrameStatsCheck camera_para.dat
+//
+// Returns 0 if all counts match.
+
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <ARToolKitPlus/TrackerSingleMarkerImpl.h>
+#include <ARToolKitPlus/TrackerPipeline.h>
+#include <ARToolKitPlus/arBitFieldPattern.h>
+
+
+typedef ARToolKitPlus::TrackerSingleMarkerImpl<6,6,6, 1, 8> CheckTracker;
+
+
+// frames of the sequence, more than the summary window
+static const int numFrames = ARToolKitPlus::FrameStatsSummary::WINDOW+36;
+
+static int numFailed = 0;
+
+
+static void
+check(bool nOk, const char* nWhat, int nValue, int nExpected)
+{
+	if(nOk)
+		return;
+
+	printf("  FAILED: %s is %d, expected %d\n", nWhat, nValue, nExpected);
+	numFailed++;
+}
+
+
+// draws an id marker (8x8 cells: black border of one cell, 6x6 id pattern)
+// with a side length of half the image height, shifted right by nOffset pixels.
+// without nMarker the image is empty.
+//
+static void
+createImage(std::vector<unsigned char>& nImage, int nWidth, int nHeight, int nOffset, bool nMarker)
+{
+	ARToolKitPlus::IDPATTERN pattern;
+	ARToolKitPlus::generatePatternBCH(0, pattern);
+
+	int size = nHeight/2, x0 = (nWidth-size)/4+nOffset, y0 = (nHeight-size)/2;
+
+	nImage.resize(nWidth*nHeight);
+
+	for(int y=0; y<nHeight; y++)
+		for(int x=0; x<nWidth; x++)
+		{
+			unsigned char gray = 200;
+
+			if(nMarker && x>=x0 && x<x0+size && y>=y0 && y<y0+size)
+			{
+				int c = (x-x0)*8/size, r = (y-y0)*8/size;
+
+				if(c==0 || c==7 || r==0 || r==7)
+					gray = 20;
+				else
+					gray = ((pattern>>(35-((r-1)*6+(c-1)))) & 1) ? 200 : 20;
+			}
+
+			nImage[y*nWidth+x] = gray;
+		}
+}
+
+
+static CheckTracker*
+createTracker(const char* nCamParamFile, int nWidth, int nHeight)
+{
+	CheckTracker* tracker = new CheckTracker(nWidth, nHeight);
+
+	tracker->setPixelFormat(ARToolKitPlus::PIXEL_FORMAT_LUM);
+	if(!tracker->init(nCamParamFile, 1.0f, 1000.0f))
+	{
+		delete tracker;
+		return NULL;
+	}
+	tracker->setBorderWidth(0.125f);
+	tracker->setMarkerMode(ARToolKitPlus::MARKER_ID_BCH);
+	tracker->setThreshold(110);
+
+	return tracker;
+}
+
+
+// counts the frames of the last window the pipeline found the marker in
+//
+static void
+countPosed(const ARToolKitPlus::TrackerPipeline::Result& nResult, void* nCount)
+{
+	if(nResult.result>=0 && (int)nResult.frameId>=numFrames-ARToolKitPlus::FrameStatsSummary::WINDOW)
+		(*(int*)nCount)++;
+}
+
+
+// one detection with arDetectMarker() or arDetectMarkerLite()
+//
+static const ARToolKitPlus::FrameStats&
+detect(CheckTracker* nTracker, std::vector<unsigned char>& nImage, int nThresh, bool nLite)
+{
+	ARToolKitPlus::ARMarkerInfo* markers;
+	int num;
+
+	if(nLite)
+		nTracker->arDetectMarkerLite(&nImage[0], nThresh, &markers, &num);
+	else
+		nTracker->arDetectMarker(&nImage[0], nThresh, &markers, &num);
+
+	return nTracker->getFrameStats();
+}
+
+
+// every frame that returned the marker was posed once
+//
+static void
+checkSummary(const ARToolKitPlus::FrameStatsSummary& nSummary, int nFrames, int nPoseFrames)
+{
+	int numMarkers = (int)(nSummary.meanMarkers*nFrames+0.5f);
+
+	check(nSummary.numFrames==nFrames, "numFrames", nSummary.numFrames, nFrames);
+	check(nSummary.numPoseFrames==nPoseFrames, "numPoseFrames", nSummary.numPoseFrames, nPoseFrames);
+	check(numMarkers==nPoseFrames, "meanMarkers * numFrames", numMarkers, nPoseFrames);
+}
+
+
+int
+main(int argc, char** argv)
+{
+	const int	width = 320, height = 240;
+	const int	window = ARToolKitPlus::FrameStatsSummary::WINDOW;
+	int			labels[2], i;
+
+	if(argc!=2)
+	{
+		printf("usage: FrameStatsCheck camera_para.dat\n");
+		return 1;
+	}
+
+	CheckTracker* tracker = createTracker(argv[1], width, height);
+	if(!tracker)
+	{
+		printf("failed to load camera file '%s'\n", argv[1]);
+		return 1;
+	}
+	delete tracker;
+
+	std::vector<unsigned char> markerImage, emptyImage;
+	createImage(markerImage, width, height, 0, true);
+	createImage(emptyImage, width, height, 0, false);
+
+	for(int lite=0; lite<2; lite++)
+	{
+		const char* name = lite ? "arDetectMarkerLite" : "arDetectMarker";
+
+		printf("%s, marker at the first threshold\n", name);
+		tracker = createTracker(argv[1], width, height);
+		const ARToolKitPlus::FrameStats& f = detect(tracker, markerImage, 110, lite!=0);
+		check(f.numMarkers==1, "numMarkers", f.numMarkers, 1);
+		check(f.numCandidates==1, "numCandidates", f.numCandidates, 1);
+		check(f.numRetries==0, "numRetries", f.numRetries, 0);
+		check(f.threshold==110, "threshold", f.threshold, 110);
+		check(f.numLabels>0, "numLabels", f.numLabels, 1);
+		labels[lite] = f.numLabels;
+		delete tracker;
+
+		printf("%s, marker after a histogram retry\n", name);
+		tracker = createTracker(argv[1], width, height);
+		tracker->activateAutoThreshold(true);
+		tracker->setAutoThresholdMode(ARToolKitPlus::AUTO_THRESHOLD_HISTOGRAM);
+		tracker->setNumAutoThresholdRetries(4);
+		const ARToolKitPlus::FrameStats& g = detect(tracker, markerImage, 10, lite!=0);
+		check(g.numMarkers==1, "numMarkers", g.numMarkers, 1);
+		check(g.numCandidates==1, "numCandidates", g.numCandidates, 1);
+		check(g.numRetries==1, "numRetries", g.numRetries, 1);
+		check(g.threshold>=20 && g.threshold<200, "threshold", g.threshold, 20);
+		check(g.numLabels==labels[0], "numLabels", g.numLabels, labels[0]);
+		delete tracker;
+
+		printf("%s, empty image with random retries\n", name);
+		tracker = createTracker(argv[1], width, height);
+		tracker->activateAutoThreshold(true);
+		tracker->setAutoThresholdMode(ARToolKitPlus::AUTO_THRESHOLD_RANDOM);
+		tracker->setNumAutoThresholdRetries(3);
+		const ARToolKitPlus::FrameStats& e = detect(tracker, emptyImage, 110, lite!=0);
+		check(e.numMarkers==0, "numMarkers", e.numMarkers, 0);
+		check(e.numRetries==3, "numRetries", e.numRetries, 3);
+		delete tracker;
+	}
+
+	check(labels[1]==labels[0], "numLabels of arDetectMarkerLite", labels[1], labels[0]);
+
+	// a marker in every fourth frame, the window holds the last frames only. arDetectMarker()
+	// keeps a marker of the previous frames for a while, so the posed frames are counted.
+	std::vector< std::vector<unsigned char> > images(numFrames);
+	for(i=0; i<numFrames; i++)
+		createImage(images[i], width, height, i%32, i%4==0);
+
+	printf("calc(), marker in every fourth frame\n");
+	tracker = createTracker(argv[1], width, height);
+	int numPoseFrames = 0;
+	for(i=0; i<numFrames; i++)
+		if(tracker->calc(&images[i][0])>=0 && i>=numFrames-window)
+			numPoseFrames++;
+
+	ARToolKitPlus::FrameStatsSummary summary;
+	tracker->getFrameStatsSummary(summary);
+	checkSummary(summary, window, numPoseFrames);
+	delete tracker;
+
+	printf("TrackerPipeline, marker in every fourth frame\n");
+	tracker = createTracker(argv[1], width, height);
+	ARToolKitPlus::TrackerPipeline* pipeline = new ARToolKitPlus::TrackerPipeline(tracker);
+	int numPipelinePoseFrames = 0;
+	if(pipeline->start(countPosed, &numPipelinePoseFrames))
+	{
+		for(i=0; i<numFrames; i++)
+			pipeline->submit(&images[i][0], i, 0.0, true);
+		pipeline->stop();
+	}
+	else
+		check(false, "TrackerPipeline::start()", 0, 1);
+	delete pipeline;
+
+	ARToolKitPlus::FrameStatsSummary pipelineSummary;
+	tracker->getFrameStatsSummary(pipelineSummary);
+	check(numPipelinePoseFrames==numPoseFrames, "frames with a marker", numPipelinePoseFrames, numPoseFrames);
+	checkSummary(pipelineSummary, window, numPoseFrames);
+	check(pipelineSummary.meanLabels==summary.meanLabels, "meanLabels * 100",
+		  (int)(pipelineSummary.meanLabels*100), (int)(summary.meanLabels*100));
+	check(pipelineSummary.meanCandidates==summary.meanCandidates, "meanCandidates * 100",
+		  (int)(pipelineSummary.meanCandidates*100), (int)(summary.meanCandidates*100));
+	check(pipelineSummary.meanPoseIterations==summary.meanPoseIterations, "meanPoseIterations * 100",
+		  (int)(pipelineSummary.meanPoseIterations*100), (int)(summary.meanPoseIterations*100));
+	delete tracker;
+
+	// detections without a pose stage must not leave the poses of later frames behind
+	printf("calc() after arDetectMarker() without a pose stage\n");
+	tracker = createTracker(argv[1], width, height);
+	for(i=0; i<numFrames; i++)
+		detect(tracker, images[i], 110, false);
+	for(i=0; i<numFrames; i++)
+		tracker->calc(&images[i][0]);
+
+	ARToolKitPlus::FrameStatsSummary detectSummary;
+	tracker->getFrameStatsSummary(detectSummary);
+	checkSummary(detectSummary, window, numPoseFrames);
+	check(detectSummary.meanPoseIterations==summary.meanPoseIterations, "meanPoseIterations * 100",
+		  (int)(detectSummary.meanPoseIterations*100), (int)(summary.meanPoseIterations*100));
+	delete tracker;
+
+	if(numFailed)
+		printf("%d checks failed\n", numFailed);
+	else
+		printf("all checks passed\n");
+
+	return numFailed ? 1 : 0;
+}
@@ -0,0 +1,27 @@
+################################
+#
+# QMake definitions for FrameStatsCheck
+#
+
+include ($$(ARTKP)/build/linux/options.pro)
+
+TEMPLATE = app
+
+TARGET   = FrameStatsCheck
+
+DESTDIR  = $$(ARTKP)/bin
+
+INCLUDEPATH += ../../include
+
+LIBS += -L$$(ARTKP)/lib -lARToolKitPlus
+
+# the check runs a TrackerPipeline, whose stages are POSIX threads
+unix:LIBS += -lpthread
+
+SOURCES = FrameStatsCheck.cpp
+
+target.path = ""/$$PREFIX/bin
+
+INSTALLS += target
+
+################################
@@ -0,0 +1,157 @@
+/* ========================================================================
+ * PROJECT: ARToolKitPlus
+ * ========================================================================
+ * This work is based on the original ARToolKit developed by
+ *   Hirokazu Kato
+ *   Mark Billinghurst
+ *   HITLab, University of Washington, Seattle
+ * http://www.hitl.washington.edu/artoolkit/
+ *
+ * Copyright of the derived and new portions of this work
+ *     (C) 2006 Graz University of Technology
+ *
+ * This framework is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this framework; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * For further information please contact 
+ *   Dieter Schmalstieg
+ *   <schmalstieg@icg.tu-graz.ac.at>
+ *   Graz University of Technology, 
+ *   Institut for Computer Graphics and Vision,
+ *   Inffeldgasse 16a, 8010 Graz, Austria.
+ * ========================================================================
+ ** @author   Daniel Wagner
+ *
+ * $Id$
+ * @file
+ * ======================================================================== */
+
+
+
+// MultiBundleGen converts a standard ARToolKit multi-marker config file
+// (plus the pattern files it references) into a binary bundle which
+// TrackerImpl::arMultiReadConfigFile() maps into memory at startup.
+//
+// usage: MultiBundleGen [-s size] [-b threshold] config.dat config.bundle
+//
+// -s and -b must match the application: -s the pattern size the tracker
+// was instantiated with (PATTERN_SIZE_X/Y, 16 for standard pattern files)
+// and -b the value passed to activateBinaryMarker(). The bundle header
+// stores both, a tracker with different settings rejects the bundle.
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <ARToolKitPlus/TrackerMultiMarkerImpl.h>
+
+
+class ConsoleLogger : public ARToolKitPlus::Logger
+{
+	void artLog(const char* nStr)
+	{
+		fputs(nStr, stdout);
+	}
+};
+
+
+// the pattern size is a template parameter of the tracker, so every
+// size that can be selected with -s gets its own instantiation. the
+// number of pattern slots is generous, the application checks that the
+// bundle fits into its own tracker when loading it.
+//
+static const int supportedSizes[] = { 8, 12, 16, 24, 32 };
+
+
+template <int SIZE>
+static int
+writeBundle(const char* nConfigFile, const char* nBundleFile, int nBinaryThreshold)
+{
+	typedef ARToolKitPlus::TrackerMultiMarkerImpl<SIZE,SIZE,64, 256, 32> BundleTracker;
+
+	ConsoleLogger	logger;
+	BundleTracker*	tracker = new BundleTracker();
+	tracker->setLogger(&logger);
+
+	if(nBinaryThreshold!=-1)
+		tracker->activateBinaryMarker(nBinaryThreshold);
+
+	int ret = tracker->arMultiWriteConfigBundle(nConfigFile, nBundleFile);
+
+	delete tracker;
+	return ret;
+}
+
+
+static void
+printUsage()
+{
+	printf("usage: MultiBundleGen [-s size] [-b threshold] config.dat config.bundle\n");
+	printf("  -s size        pattern size of the application's tracker (default 16):");
+	for(size_t i=0; i<sizeof(supportedSizes)/sizeof(int); i++)
+		printf(" %d", supportedSizes[i]);
+	printf("\n");
+	printf("  -b threshold   convert template patterns to black/white (see activateBinaryMarker())\n");
+}
+
+
+int
+main(int argc, char** argv)
+{
+	int				size = 16;
+	int				binaryThreshold = -1;
+	int				i = 1;
+
+	while(i+1<argc && argv[i][0]=='-')
+	{
+		if(strcmp(argv[i], "-s")==0)
+			size = atoi(argv[i+1]);
+		else if(strcmp(argv[i], "-b")==0)
+			binaryThreshold = atoi(argv[i+1]);
+		else
+			break;
+		i += 2;
+	}
+
+	if(argc-i != 2)
+	{
+		printUsage();
+		return 1;
+	}
+
+	int ret = -1;
+
+	switch(size)
+	{
+	case 8:		ret = writeBundle<8>(argv[i], argv[i+1], binaryThreshold);  break;
+	case 12:	ret = writeBundle<12>(argv[i], argv[i+1], binaryThreshold);  break;
+	case 16:	ret = writeBundle<16>(argv[i], argv[i+1], binaryThreshold);  break;
+	case 24:	ret = writeBundle<24>(argv[i], argv[i+1], binaryThreshold);  break;
+	case 32:	ret = writeBundle<32>(argv[i], argv[i+1], binaryThreshold);  break;
+	default:
+		printf("unsupported pattern size %d\n", size);
+		printUsage();
+		return 1;
+	}
+
+	if(ret!=0)
+	{
+		printf("failed to convert '%s'\n", argv[i]);
+		return 1;
+	}
+
+	printf("wrote '%s'\n", argv[i+1]);
+	return 0;
+}
@@ -0,0 +1,27 @@
+################################
+#
+# QMake definitions for MultiBundleGen
+#
+
+include ($$(ARTKP)/build/linux/options.pro)
+
+TEMPLATE = app
+
+TARGET   = MultiBundleGen
+
+DESTDIR  = $$(ARTKP)/bin
+
+INCLUDEPATH += ../../include
+
+LIBS += -L$$(ARTKP)/lib -lARToolKitPlus
+
+# the library runs TrackerPipeline stages on POSIX threads
+unix:LIBS += -lpthread
+
+SOURCES = MultiBundleGen.cpp
+
+target.path = ""/$$PREFIX/bin
+
+INSTALLS += target
+
+################################
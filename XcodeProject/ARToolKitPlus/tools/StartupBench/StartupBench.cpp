@@ -0,0 +1,255 @@
+/* ========================================================================
+ * PROJECT: ARToolKitPlus
+ * ========================================================================
+ * This work is based on the original ARToolKit developed by
+ *   Hirokazu Kato
+ *   Mark Billinghurst
+ *   HITLab, University of Washington, Seattle
+ * http://www.hitl.washington.edu/artoolkit/
+ *
+ * Copyright of the derived and new portions of this work
+ *     (C) 2006 Graz University of Technology
+ *
+ * This framework is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this framework; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * For further information please contact 
+ *   Dieter Schmalstieg
+ *   <schmalstieg@icg.tu-graz.ac.at>
+ *   Graz University of Technology, 
+ *   Institut for Computer Graphics and Vision,
+ *   Inffeldgasse 16a, 8010 Graz, Austria.
+ * ========================================================================
+ ** @author   Daniel Wagner
+ *
+ * $Id$
+ * @file
+ * ======================================================================== */
+
+
+
+// StartupBench measures how long it takes to get a tracker ready: from
+// the constructor through init() up to the first calc() that returns a
+// marker. Applications that create trackers on demand (e.g. one per video
+// stream) pay this on every new stream.
+//
+// usage: StartupBench [-n runs] [-s WxH] [-f LUM|RGB|BGR|BGRA|RGB565]
+//                     [-u none|std|lut|grid] [-m simple|bch] camera_para.dat
+//
+// The input image is synthetic: a single fronto-parallel id marker (id 0)
+// on a light background, so the first calc() runs the full pipeline
+// including id decoding.
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <ARToolKitPlus/TrackerSingleMarkerImpl.h>
+#include <ARToolKitPlus/arBitFieldPattern.h>
+
+#if defined(WIN32) || defined(_WIN32_WCE)
+#  include <windows.h>
+#else
+#  include <sys/time.h>
+#endif
+
+
+typedef ARToolKitPlus::TrackerSingleMarkerImpl<6,6,6, 1, 8> BenchTracker;
+
+
+static double
+getMilliseconds()
+{
+#if defined(WIN32) || defined(_WIN32_WCE)
+	LARGE_INTEGER freq, now;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+	return 1000.0*(double)now.QuadPart/(double)freq.QuadPart;
+#else
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec*1000.0 + tv.tv_usec/1000.0;
+#endif
+}
+
+
+static void
+writePixel(unsigned char* nPixel, ARToolKitPlus::PIXEL_FORMAT nFormat, unsigned char nGray)
+{
+	switch(nFormat)
+	{
+	case ARToolKitPlus::PIXEL_FORMAT_LUM:
+		nPixel[0] = nGray;
+		break;
+	case ARToolKitPlus::PIXEL_FORMAT_RGB565:
+		*(unsigned short*)nPixel = (unsigned short)(((nGray>>3)<<11) | ((nGray>>2)<<5) | (nGray>>3));
+		break;
+	case ARToolKitPlus::PIXEL_FORMAT_RGB:
+	case ARToolKitPlus::PIXEL_FORMAT_BGR:
+		nPixel[0] = nPixel[1] = nPixel[2] = nGray;
+		break;
+	default:
+		nPixel[0] = nPixel[1] = nPixel[2] = nPixel[3] = nGray;
+		break;
+	}
+}
+
+
+// draws an id marker (8x8 cells: black border of one cell, 6x6 id pattern)
+// centered into the image with a side length of half the image height
+//
+static void
+createImage(std::vector<unsigned char>& nImage, int nWidth, int nHeight, ARToolKitPlus::PIXEL_FORMAT nFormat,
+			int nBPP, bool nBCH)
+{
+	ARToolKitPlus::IDPATTERN pattern;
+	if(nBCH)
+		ARToolKitPlus::generatePatternBCH(0, pattern);
+	else
+		ARToolKitPlus::generatePatternSimple(0, pattern);
+
+	int size = nHeight/2, x0 = (nWidth-size)/2, y0 = (nHeight-size)/2;
+
+	nImage.resize(nWidth*nHeight*nBPP);
+
+	for(int y=0; y<nHeight; y++)
+		for(int x=0; x<nWidth; x++)
+		{
+			unsigned char gray = 200;
+
+			if(x>=x0 && x<x0+size && y>=y0 && y<y0+size)
+			{
+				int c = (x-x0)*8/size, r = (y-y0)*8/size;
+
+				if(c==0 || c==7 || r==0 || r==7)
+					gray = 20;
+				else
+					gray = ((pattern>>(35-((r-1)*6+(c-1)))) & 1) ? 200 : 20;
+			}
+
+			writePixel(&nImage[(y*nWidth+x)*nBPP], nFormat, gray);
+		}
+}
+
+
+static void
+printUsage()
+{
+	printf("usage: StartupBench [-n runs] [-s WxH] [-f LUM|RGB|BGR|BGRA|RGB565] [-u none|std|lut|grid] [-m simple|bch] camera_para.dat\n");
+}
+
+
+int
+main(int argc, char** argv)
+{
+	int									numRuns = 20, width = 320, height = 240;
+	ARToolKitPlus::PIXEL_FORMAT			format = ARToolKitPlus::PIXEL_FORMAT_LUM;
+	ARToolKitPlus::UNDIST_MODE			undistMode = ARToolKitPlus::UNDIST_LUT;
+	bool								useBCH = true;
+	int									i;
+
+	for(i=1; i+1<argc; i+=2)
+	{
+		const char* opt = argv[i];
+		const char* val = argv[i+1];
+
+		if(strcmp(opt, "-n")==0)
+			numRuns = atoi(val);
+		else if(strcmp(opt, "-s")==0)
+			sscanf(val, "%dx%d", &width, &height);
+		else if(strcmp(opt, "-f")==0)
+		{
+			if(strcmp(val, "LUM")==0)			format = ARToolKitPlus::PIXEL_FORMAT_LUM;
+			else if(strcmp(val, "RGB")==0)		format = ARToolKitPlus::PIXEL_FORMAT_RGB;
+			else if(strcmp(val, "BGR")==0)		format = ARToolKitPlus::PIXEL_FORMAT_BGR;
+			else if(strcmp(val, "BGRA")==0)		format = ARToolKitPlus::PIXEL_FORMAT_BGRA;
+			else if(strcmp(val, "RGB565")==0)	format = ARToolKitPlus::PIXEL_FORMAT_RGB565;
+			else { printUsage(); return 1; }
+		}
+		else if(strcmp(opt, "-u")==0)
+		{
+			if(strcmp(val, "none")==0)			undistMode = ARToolKitPlus::UNDIST_NONE;
+			else if(strcmp(val, "std")==0)		undistMode = ARToolKitPlus::UNDIST_STD;
+			else if(strcmp(val, "lut")==0)		undistMode = ARToolKitPlus::UNDIST_LUT;
+			else if(strcmp(val, "grid")==0)		undistMode = ARToolKitPlus::UNDIST_GRID;
+			else { printUsage(); return 1; }
+		}
+		else if(strcmp(opt, "-m")==0)
+			useBCH = strcmp(val, "bch")==0;
+		else
+			break;
+	}
+
+	if(i!=argc-1 || numRuns<1 || width<16 || height<16)
+	{
+		printUsage();
+		return 1;
+	}
+
+	const char* camFile = argv[i];
+	std::vector<unsigned char> image;
+	double tCtor = 0.0, tInit = 0.0, tFirst = 0.0, tNext = 0.0, tTotalMin = 1e30;
+	int found = 0;
+
+	for(int run=0; run<numRuns; run++)
+	{
+		double t0 = getMilliseconds();
+
+		BenchTracker* tracker = new BenchTracker(width, height);
+		double t1 = getMilliseconds();
+
+		tracker->setPixelFormat(format);
+		if(!tracker->init(camFile, 1.0f, 1000.0f))
+		{
+			printf("failed to load camera file '%s'\n", camFile);
+			delete tracker;
+			return 1;
+		}
+		tracker->setBorderWidth(0.125f);
+		tracker->setMarkerMode(useBCH ? ARToolKitPlus::MARKER_ID_BCH : ARToolKitPlus::MARKER_ID_SIMPLE);
+		tracker->setUndistortionMode(undistMode);
+		tracker->setThreshold(110);
+		double t2 = getMilliseconds();
+
+		if(image.empty())
+			createImage(image, width, height, format, tracker->getBitsPerPixel()/8, useBCH);
+
+		double t3 = getMilliseconds();
+		if(tracker->calc(&image[0])==0)
+			found++;
+		double t4 = getMilliseconds();
+
+		tracker->calc(&image[0]);
+		double t5 = getMilliseconds();
+
+		delete tracker;
+
+		tCtor += t1-t0;
+		tInit += t2-t1;
+		tFirst += t4-t3;
+		tNext += t5-t4;
+		if((t1-t0)+(t2-t1)+(t4-t3) < tTotalMin)
+			tTotalMin = (t1-t0)+(t2-t1)+(t4-t3);
+	}
+
+	printf("%dx%d, %d runs, marker found in %d/%d first frames\n", width, height, numRuns, found, numRuns);
+	printf("  constructor:   %8.3f msecs\n", tCtor/numRuns);
+	printf("  init:          %8.3f msecs\n", tInit/numRuns);
+	printf("  first calc():  %8.3f msecs\n", tFirst/numRuns);
+	printf("  second calc(): %8.3f msecs\n", tNext/numRuns);
+	printf("  startup total: %8.3f msecs (best run %.3f msecs)\n", (tCtor+tInit+tFirst)/numRuns, tTotalMin);
+
+	return 0;
+}
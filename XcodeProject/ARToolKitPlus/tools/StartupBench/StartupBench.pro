@@ -0,0 +1,27 @@
+################################
+#
+# QMake definitions for StartupBench
+#
+
+include ($$(ARTKP)/build/linux/options.pro)
+
+TEMPLATE = app
+
+TARGET   = StartupBench
+
+DESTDIR  = $$(ARTKP)/bin
+
+INCLUDEPATH += ../../include
+
+LIBS += -L$$(ARTKP)/lib -lARToolKitPlus
+
+# the library runs TrackerPipeline stages on POSIX threads
+unix:LIBS += -lpthread
+
+SOURCES = StartupBench.cpp
+
+target.path = ""/$$PREFIX/bin
+
+INSTALLS += target
+
+################################